@@ -0,0 +1,76 @@
+/**
+ * @file dsp_buf.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP aligned and padded signal buffers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The buffers start at DSP_BUF_ALIGN byte boundary and their size is rounded up to
+ * DSP_BUF_ALIGN bytes, the padding is zero. Internal buffers that are always allocated
+ * here (FIR spectrum multiplication) run on whole blocks without scalar head and tail.
+ */
+
+#ifndef __DSP_BUF_H__
+#define __DSP_BUF_H__
+
+#include <stdint.h>
+#include "dsp_common.h"
+
+
+/*Alignment and padding of the buffers in bytes (cache line, AVX-512 register)*/
+#define DSP_BUF_ALIGN                   64UL
+
+/*Elements of one aligned block*/
+#define DSP_BUF_BLOCK_LEN(elem_size)    (DSP_BUF_ALIGN / (elem_size))
+
+/*Length rounded up to whole aligned blocks*/
+#define DSP_BUF_PADDED_LEN(len, elem_size) \
+    (((len) + DSP_BUF_BLOCK_LEN(elem_size) - 1) / DSP_BUF_BLOCK_LEN(elem_size) * DSP_BUF_BLOCK_LEN(elem_size))
+
+/*Pointer is aligned to DSP_BUF_ALIGN*/
+#define DSP_BUF_IS_ALIGNED(ptr)         ((((uintptr_t)(ptr)) & (DSP_BUF_ALIGN - 1)) == 0)
+
+/*Aligned pointer for the compiler, only after DSP_BUF_IS_ALIGNED check*/
+#if defined(__GNUC__)
+    #define DSP_BUF_ASSUME_ALIGNED(ptr) __builtin_assume_aligned((ptr), DSP_BUF_ALIGN)
+#else
+    #define DSP_BUF_ASSUME_ALIGNED(ptr) (ptr)
+#endif
+
+
+/**
+ * @brief Allocate aligned, zero initialized, padded signal buffer
+ *
+ * @param len number of elements, the buffer has DSP_BUF_PADDED_LEN(len, sizeof(dsp_val_t)) elements
+ * @return dsp_val_t* buffer, free with dsp_buf_free, NULL if the allocation failed
+ */
+dsp_val_t *dsp_buf_alloc(dsp_size_t len);
+
+
+/**
+ * @brief Allocate aligned, zero initialized, padded buffer of any element type
+ *
+ * @param len number of elements
+ * @param elem_size bytes of one element
+ * @return void* buffer, free with dsp_buf_free, NULL if the allocation failed
+ */
+void *dsp_buf_alloc_elem(dsp_size_t len, dsp_size_t elem_size);
+
+
+/**
+ * @brief Free buffer allocated by dsp_buf_alloc or dsp_buf_alloc_elem
+ *
+ * @param buf buffer, can be NULL
+ */
+void dsp_buf_free(void *buf);
+
+
+/**
+ * @brief Single and double precision variants
+ */
+dsp_f32_t *dsp_buf_alloc_f32(dsp_size_t len);
+dsp_f64_t *dsp_buf_alloc_f64(dsp_size_t len);
+
+#endif
@@ -34,4 +34,30 @@
 void dsp_cdft(dsp_val_t *input_sig_tdomain_rex, dsp_val_t *input_sig_tdomain_imx, 
               dsp_val_t *output_sig_fdomain_rex, dsp_val_t *output_sig_fdomain_imx, dsp_size_t sig_len);
 
+
+/**
+ * @brief Complex Discrete Fourier Transform of interleaved complex signal
+ * Input and output are interleaved, see dsp_iq.h, without scaling:
+ *
+ * X[k] = sum (x[n] * exp(-j * 2 * k * PI * n / N)) | from n = 0 to n = N - 1
+ *
+ * @param input_sig_tdomain_iq input time domain signal, 2 * sig_len long
+ * @param output_sig_fdomain_iq output frequency domain signal, 2 * sig_len long
+ * @param sig_len number of complex samples
+ */
+void dsp_cdft_iq(dsp_val_t *input_sig_tdomain_iq, dsp_val_t *output_sig_fdomain_iq, dsp_size_t sig_len);
+
+
+/**
+ * @brief Single and double precision variants
+ * Same calculations as the dsp_val_t function, the precision is selected per call.
+ */
+void dsp_cdft_f32(dsp_f32_t *input_sig_tdomain_rex, dsp_f32_t *input_sig_tdomain_imx, 
+                  dsp_f32_t *output_sig_fdomain_rex, dsp_f32_t *output_sig_fdomain_imx, dsp_size_t sig_len);
+void dsp_cdft_iq_f32(dsp_f32_t *input_sig_tdomain_iq, dsp_f32_t *output_sig_fdomain_iq, dsp_size_t sig_len);
+
+void dsp_cdft_f64(dsp_f64_t *input_sig_tdomain_rex, dsp_f64_t *input_sig_tdomain_imx, 
+                  dsp_f64_t *output_sig_fdomain_rex, dsp_f64_t *output_sig_fdomain_imx, dsp_size_t sig_len);
+void dsp_cdft_iq_f64(dsp_f64_t *input_sig_tdomain_iq, dsp_f64_t *output_sig_fdomain_iq, dsp_size_t sig_len);
+
 #endif
\ No newline at end of file
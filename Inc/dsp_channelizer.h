@@ -0,0 +1,92 @@
+/**
+ * @file dsp_channelizer.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP polyphase FFT channelizer
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef __DSP_CHANNELIZER_H__
+#define __DSP_CHANNELIZER_H__
+
+#include "dsp_common.h"
+#include "dsp_fft.h"
+
+
+/**
+ * @brief Polyphase filter bank channelizer
+ * M equally spaced channels, channel k is centered at k * fs / M.
+ * One output frame (M complex channel samples) is produced after every D input samples.
+ * D == M: critically sampled, D < M: oversampled by M / D
+ */
+typedef struct {
+    dsp_size_t channels;        // M, number of channels, power of two
+    dsp_size_t decimation;      // D, input samples per output frame
+    dsp_size_t taps_per_branch; // P, prototype taps per polyphase branch
+    dsp_size_t proto_len;       // L = M * P, prototype filter length
+    dsp_val_t *prototype;       // prototype low-pass filter, L elements
+    dsp_val_t *history;         // input history, doubled circular buffer, 2 * L elements
+    dsp_size_t hist_pos;        // next write position in the history
+    dsp_size_t sample_cnt;      // received input samples modulo M
+    dsp_size_t pending;         // input samples since the last frame
+    dsp_fft_plan_t *plan;       // M point FFT plan
+    dsp_val_t *work_rex;        // M element work array real part
+    dsp_val_t *work_imx;        // M element work array imaginary part
+} dsp_channelizer_t;
+
+
+/**
+ * @brief Create polyphase channelizer
+ * The prototype is a windowed sinc low-pass filter (dsp_lp_win_sinc_filter) with cutoff fs / (2 * M),
+ * normalized to unity DC gain.
+ *
+ * Cost per output frame: M * P MAC + one M point FFT
+ *
+ * @param channels number of channels (M), power of two
+ * @param decimation input samples per output frame (D), must divide M
+ * @param taps_per_branch prototype taps per polyphase branch (P)
+ * @param window_calc window calculation function of the prototype, NULL: Hamming window
+ * @return dsp_channelizer_t* created channelizer, NULL if the arguments are invalid or the allocation failed
+ */
+dsp_channelizer_t *dsp_channelizer_create(dsp_size_t channels, dsp_size_t decimation, dsp_size_t taps_per_branch,
+                                          dsp_val_t (*window_calc)(int, dsp_size_t));
+
+
+/**
+ * @brief Destroy polyphase channelizer
+ *
+ * @param ch channelizer created by dsp_channelizer_create, can be NULL
+ */
+void dsp_channelizer_destroy(dsp_channelizer_t *ch);
+
+
+/**
+ * @brief Reset history of the channelizer
+ *
+ * @param ch channelizer
+ */
+void dsp_channelizer_reset(dsp_channelizer_t *ch);
+
+
+/**
+ * @brief Process input samples
+ * The state is kept between calls, the input can be split into any blocks.
+ * Complex baseband output of channel k in frame f: out_rex[f * M + k], out_imx[f * M + k]
+ *
+ * y_k[n] = sum (h[l] * x[n - l] * exp(-j * 2 * PI * k * (n - l) / M)) | from l = 0 to l = L - 1
+ *
+ * @param ch channelizer
+ * @param out_rex output real part array, at least (input_sig_len / D + 1) * M elements
+ * @param out_imx output imaginary part array, at least (input_sig_len / D + 1) * M elements
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @return dsp_size_t number of output frames
+ */
+dsp_size_t dsp_channelizer_process(dsp_channelizer_t *ch, dsp_val_t *out_rex, dsp_val_t *out_imx,
+                                   dsp_val_t *input_sig, dsp_size_t input_sig_len);
+
+
+#endif
@@ -16,6 +16,13 @@
 #include <math.h>
 
 
+/*
+Build options
+DSP_USE_PTHREAD:    the *_mt functions and the execution context (dsp_exec.h) use POSIX threads (link with -pthread),
+                    otherwise they run serially
+DSP_INSTR:          hot path instrumentation counters, see dsp_instr.h, otherwise compiled out
+*/
+
 #ifndef NULL
     #define NULL    ((void *)0)
 #endif
@@ -27,4 +34,7 @@
 typedef double dsp_val_t; 					// signal value typedef
 typedef unsigned long dsp_size_t;			// signal length typedef
 
+typedef float dsp_f32_t;					// single precision signal value, *_f32 functions
+typedef double dsp_f64_t;					// double precision signal value, *_f64 functions
+
 #endif
\ No newline at end of file
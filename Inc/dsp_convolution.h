@@ -14,6 +14,12 @@
 #define __DSP_CONVOLUTION_H__
 
 #include "dsp_common.h"
+#include "dsp_exec.h"
+
+/*Minimal output block of dsp_convolution_exec, one task of the execution context*/
+#ifndef DSP_CONV_EXEC_BLOCK_LEN
+    #define DSP_CONV_EXEC_BLOCK_LEN     (16384UL)
+#endif
 
 /**
  * @brief DSP Convolution
@@ -28,6 +34,22 @@ void dsp_convolution(dsp_val_t *dest_sig, dsp_val_t *input_sig, dsp_size_t input
                 dsp_val_t *impulse_resp, dsp_size_t impulse_resp_len);
 
 
+/**
+ * @brief Convolution calculated in output blocks by the threads of an execution context
+ * Every block is calculated from the inputs reaching it, in the same order as the serial
+ * convolution, so the result is the same bit by bit.
+ *
+ * @param dest_sig destination output array, length: input_sig_len + impulse_resp_len
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @param impulse_resp impulse response signal array
+ * @param impulse_resp_len impulse response signal length
+ * @param ctx execution context, NULL: serial
+ */
+void dsp_convolution_exec(dsp_val_t *dest_sig, dsp_val_t *input_sig, dsp_size_t input_sig_len,
+                dsp_val_t *impulse_resp, dsp_size_t impulse_resp_len, dsp_exec_ctx_t *ctx);
+
+
 /**
  * @brief Calculate running sum
  * 
@@ -38,4 +60,21 @@ void dsp_convolution(dsp_val_t *dest_sig, dsp_val_t *input_sig, dsp_size_t input
 void dsp_running_sum(dsp_val_t *dest_sig,  dsp_val_t *input_sig, dsp_size_t input_sig_len);
 
 
+/**
+ * @brief Single and double precision variants
+ * Same calculations as the dsp_val_t functions, the precision is selected per call.
+ */
+void dsp_convolution_f32(dsp_f32_t *dest_sig, dsp_f32_t *input_sig, dsp_size_t input_sig_len, 
+                dsp_f32_t *impulse_resp, dsp_size_t impulse_resp_len);
+void dsp_convolution_exec_f32(dsp_f32_t *dest_sig, dsp_f32_t *input_sig, dsp_size_t input_sig_len,
+                dsp_f32_t *impulse_resp, dsp_size_t impulse_resp_len, dsp_exec_ctx_t *ctx);
+void dsp_running_sum_f32(dsp_f32_t *dest_sig,  dsp_f32_t *input_sig, dsp_size_t input_sig_len);
+
+void dsp_convolution_f64(dsp_f64_t *dest_sig, dsp_f64_t *input_sig, dsp_size_t input_sig_len, 
+                dsp_f64_t *impulse_resp, dsp_size_t impulse_resp_len);
+void dsp_convolution_exec_f64(dsp_f64_t *dest_sig, dsp_f64_t *input_sig, dsp_size_t input_sig_len,
+                dsp_f64_t *impulse_resp, dsp_size_t impulse_resp_len, dsp_exec_ctx_t *ctx);
+void dsp_running_sum_f64(dsp_f64_t *dest_sig,  dsp_f64_t *input_sig, dsp_size_t input_sig_len);
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,156 @@
+/**
+ * @file dsp_correlation.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP auto- and cross-correlation, direct or FFT based
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef __DSP_CORRELATION_H__
+#define __DSP_CORRELATION_H__
+
+#include "dsp_common.h"
+#include "dsp_fft.h"
+
+
+/**
+ * @brief Relative cost of the FFT compared to one multiply-accumulate
+ * Same meaning as DSP_FIR_FFT_COST_FACTOR, it can be overridden at build time.
+ */
+#ifndef DSP_CORR_FFT_COST_FACTOR
+    #define DSP_CORR_FFT_COST_FACTOR    (2.5)
+#endif
+
+
+/**
+ * @brief Output lag range of dsp_xcorr
+ *
+ */
+typedef enum {
+    DSP_CORR_FULL = 0,          // every lag with overlap, x_len + y_len - 1 outputs
+    DSP_CORR_SAME               // x_len outputs, centered on the full output
+} dsp_corr_mode_t;
+
+
+/**
+ * @brief Normalization of the correlation
+ *
+ */
+typedef enum {
+    DSP_CORR_NORM_NONE = 0,     // raw sum of products
+    DSP_CORR_NORM_BIASED,       // divided by x_len
+    DSP_CORR_NORM_UNBIASED,     // divided by the number of overlapping samples of the lag
+    DSP_CORR_NORM_COEFF         // divided by sqrt(sum(pow(xi, 2)) * sum(pow(yi, 2))), range [-1, 1]
+} dsp_corr_norm_t;
+
+
+/**
+ * @brief Calculation path
+ *
+ */
+typedef enum {
+    DSP_CORR_PATH_AUTO = 0,     // select the cheaper path for the requested lags
+    DSP_CORR_PATH_DIRECT,       // sum of products per lag
+    DSP_CORR_PATH_FFT           // one packed FFT of x and y, one inverse FFT
+} dsp_corr_path_t;
+
+
+/**
+ * @brief Cross-correlation for a limited lag range
+ * Only the requested lags are calculated:
+ *
+ * r[k] = sum (x[n + k] * y[n]) | for every n, where both indexes are valid, k = min_lag .. max_lag
+ *
+ * Cost:
+ * direct:  sum of the overlaps of the requested lags, MAC
+ * FFT:     3 * c * N * log2(N) + 6 * N, N >= max(x_len - min_lag, y_len + max_lag), power of two
+ * The FFT length depends on the lag range, so short lag ranges need smaller FFT.
+ *
+ * @param dest destination array, max_lag - min_lag + 1 elements
+ * @param x first signal
+ * @param x_len length of first signal
+ * @param y second signal
+ * @param y_len length of second signal
+ * @param min_lag first lag, can be negative
+ * @param max_lag last lag, not less than min_lag
+ * @param norm normalization
+ * @param path calculation path
+ */
+void dsp_xcorr_lags(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+                    long min_lag, long max_lag, dsp_corr_norm_t norm, dsp_corr_path_t path);
+
+
+/**
+ * @brief Cross-correlation for a limited lag range with scratch buffers from workspace
+ * Same as dsp_xcorr_lags. If the workspace is NULL the buffers are allocated,
+ * if it is too small the direct path is used.
+ *
+ * @param dest destination array, max_lag - min_lag + 1 elements
+ * @param x first signal
+ * @param x_len length of first signal
+ * @param y second signal
+ * @param y_len length of second signal
+ * @param min_lag first lag, can be negative
+ * @param max_lag last lag, not less than min_lag
+ * @param norm normalization
+ * @param path calculation path
+ * @param ws workspace, the used buffers are released before return
+ */
+void dsp_xcorr_lags_ws(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+                       long min_lag, long max_lag, dsp_corr_norm_t norm, dsp_corr_path_t path,
+                       dsp_workspace_t *ws);
+
+
+/**
+ * @brief Workspace bytes of dsp_xcorr_lags_ws (FFT path)
+ * dsp_xcorr full: min_lag = -(y_len - 1), max_lag = x_len - 1
+ * dsp_autocorr: y_len = x_len, min_lag = 0
+ *
+ * @param x_len length of first signal
+ * @param y_len length of second signal
+ * @param min_lag first lag
+ * @param max_lag last lag
+ * @return dsp_size_t workspace bytes, 0 if no lag overlaps the signals
+ */
+dsp_size_t dsp_xcorr_workspace_size(dsp_size_t x_len, dsp_size_t y_len, long min_lag, long max_lag);
+
+
+/**
+ * @brief Cross-correlation
+ * full: lags -(y_len - 1) .. x_len - 1
+ * same: x_len lags from -ceil((y_len - 1) / 2)
+ * A positive peak at lag k means y is delayed by k samples in x.
+ *
+ * @param dest destination array, x_len + y_len - 1 (full) or x_len (same) elements
+ * @param x first signal
+ * @param x_len length of first signal
+ * @param y second signal
+ * @param y_len length of second signal
+ * @param mode output lag range
+ * @param norm normalization
+ * @param path calculation path
+ */
+void dsp_xcorr(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+               dsp_corr_mode_t mode, dsp_corr_norm_t norm, dsp_corr_path_t path);
+
+
+/**
+ * @brief Autocorrelation for lags 0 .. max_lag (the negative lags are symmetric)
+ *
+ * r[k] = sum (x[n + k] * x[n]) | from n = 0 to n = len - 1 - k
+ *
+ * @param dest destination array, max_lag + 1 elements
+ * @param x signal
+ * @param len length of signal
+ * @param max_lag last lag, less than len
+ * @param norm normalization, DSP_CORR_NORM_COEFF gives r[0] = 1
+ * @param path calculation path
+ */
+void dsp_autocorr(dsp_val_t *dest, dsp_val_t *x, dsp_size_t len, dsp_size_t max_lag,
+                  dsp_corr_norm_t norm, dsp_corr_path_t path);
+
+
+#endif
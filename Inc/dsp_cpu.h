@@ -0,0 +1,90 @@
+/**
+ * @file dsp_cpu.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP runtime CPU feature detection and kernel variant selection
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The double precision hot kernels (convolution sum, FFT butterfly stages, magnitude,
+ * statistic lanes) are compiled in more instruction set variants. The best variant
+ * supported by the CPU is selected at the first call of a kernel (cpuid), the DSP_ISA
+ * environment variable (generic, sse2, avx2, avx512) forces a variant.
+ *
+ * The variants do not use fused multiply-add, so their results are identical.
+ */
+
+#ifndef __DSP_CPU_H__
+#define __DSP_CPU_H__
+
+#include "dsp_common.h"
+
+
+/*Environment variable to force a kernel variant*/
+#define DSP_CPU_ISA_ENV     "DSP_ISA"
+
+/*
+Instruction set of the kernel variants
+*/
+typedef enum {
+    DSP_ISA_GENERIC = 0,    // portable C
+    DSP_ISA_SSE2,           // x86 SSE2, 2 doubles
+    DSP_ISA_AVX2,           // x86 AVX2, 4 doubles
+    DSP_ISA_AVX512,         // x86 AVX-512F, 8 doubles
+    DSP_ISA_N
+} dsp_isa_t;
+
+
+/**
+ * @brief Select the kernel variants: DSP_ISA environment variable if set and supported,
+ * best supported instruction set otherwise. Called by the first kernel call, explicit
+ * call is needed only to make the selection at a known point.
+ */
+void dsp_cpu_init(void);
+
+
+/**
+ * @brief Instruction set of the selected kernel variants
+ *
+ * @return dsp_isa_t selected instruction set
+ */
+dsp_isa_t dsp_cpu_isa(void);
+
+
+/**
+ * @brief Best instruction set supported by the CPU (and the compiler)
+ *
+ * @return dsp_isa_t best instruction set
+ */
+dsp_isa_t dsp_cpu_best_isa(void);
+
+
+/**
+ * @brief Check if the instruction set is supported by the CPU
+ *
+ * @param isa instruction set
+ * @return int 1 if supported, 0 otherwise
+ */
+int dsp_cpu_isa_supported(dsp_isa_t isa);
+
+
+/**
+ * @brief Force kernel variants, e.g. for testing or benchmarking
+ * Not thread safe, call it when no kernel is running.
+ *
+ * @param isa instruction set
+ * @return int 0 on success, -1 if the instruction set is not supported
+ */
+int dsp_cpu_set_isa(dsp_isa_t isa);
+
+
+/**
+ * @brief Name of the instruction set
+ *
+ * @param isa instruction set
+ * @return char* name (generic, sse2, avx2, avx512), "unknown" if invalid
+ */
+char *dsp_cpu_isa_name(dsp_isa_t isa);
+
+#endif
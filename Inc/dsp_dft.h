@@ -93,4 +93,63 @@ void dsp_rect2polar(dsp_val_t *mag_output, dsp_val_t *phase_output,
                     dsp_size_t sig_len);
 
 
+/**
+ * @brief Calculate Discrete Fourier transform with interleaved complex output
+ * Same as dsp_dft, bin k is (dest_iq[2 * k], dest_iq[2 * k + 1])
+ *
+ * @param input_sig input signal
+ * @param dest_iq interleaved destination array, 2 * (input_sig_len / 2) long
+ * @param input_sig_len input signal length
+ */
+void dsp_dft_iq(dsp_val_t *input_sig, dsp_val_t *dest_iq, dsp_size_t input_sig_len);
+
+
+/**
+ * @brief Calculate magnitude of interleaved complex signal
+ * Same as dsp_dft_magnitude on the interleaved layout, see dsp_iq.h
+ *
+ * @param dest_mag destination signal
+ * @param iq interleaved complex signal, 2 * mag_len long
+ * @param mag_len length of magnitude
+ */
+void dsp_dft_magnitude_iq(dsp_val_t *dest_mag, dsp_val_t *iq, dsp_size_t mag_len);
+
+
+/**
+ * @brief Convert interleaved complex signal to Polar notation
+ * Same rules as dsp_rect2polar on the interleaved layout, see dsp_iq.h
+ *
+ * @param mag_output magnitude output destination array
+ * @param phase_output phase output destination array
+ * @param iq_input interleaved complex input signal, 2 * sig_len long
+ * @param sig_len number of complex samples
+ */
+void dsp_rect2polar_iq(dsp_val_t *mag_output, dsp_val_t *phase_output, dsp_val_t *iq_input, dsp_size_t sig_len);
+
+
+/**
+ * @brief Single and double precision variants
+ * Same calculations as the dsp_val_t functions, the precision is selected per call.
+ */
+void dsp_dft_f32(dsp_f32_t *input_sig, dsp_f32_t *dest_rex,  dsp_f32_t *dest_imx, dsp_size_t input_sig_len);
+void dsp_idft_f32(dsp_f32_t *dest_sig, dsp_f32_t *input_rex,  dsp_f32_t *input_imx, dsp_size_t idft_len);
+void dsp_dft_magnitude_f32(dsp_f32_t *dest_mag, dsp_f32_t *rex, dsp_f32_t *imx, dsp_size_t mag_len);
+void dsp_rect2polar_f32(dsp_f32_t *mag_output, dsp_f32_t *phase_output,
+                        dsp_f32_t *rex_input, dsp_f32_t *imx_input, 
+                        dsp_size_t sig_len);
+void dsp_dft_iq_f32(dsp_f32_t *input_sig, dsp_f32_t *dest_iq, dsp_size_t input_sig_len);
+void dsp_dft_magnitude_iq_f32(dsp_f32_t *dest_mag, dsp_f32_t *iq, dsp_size_t mag_len);
+void dsp_rect2polar_iq_f32(dsp_f32_t *mag_output, dsp_f32_t *phase_output, dsp_f32_t *iq_input, dsp_size_t sig_len);
+
+void dsp_dft_f64(dsp_f64_t *input_sig, dsp_f64_t *dest_rex,  dsp_f64_t *dest_imx, dsp_size_t input_sig_len);
+void dsp_idft_f64(dsp_f64_t *dest_sig, dsp_f64_t *input_rex,  dsp_f64_t *input_imx, dsp_size_t idft_len);
+void dsp_dft_magnitude_f64(dsp_f64_t *dest_mag, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t mag_len);
+void dsp_rect2polar_f64(dsp_f64_t *mag_output, dsp_f64_t *phase_output,
+                        dsp_f64_t *rex_input, dsp_f64_t *imx_input, 
+                        dsp_size_t sig_len);
+void dsp_dft_iq_f64(dsp_f64_t *input_sig, dsp_f64_t *dest_iq, dsp_size_t input_sig_len);
+void dsp_dft_magnitude_iq_f64(dsp_f64_t *dest_mag, dsp_f64_t *iq, dsp_size_t mag_len);
+void dsp_rect2polar_iq_f64(dsp_f64_t *mag_output, dsp_f64_t *phase_output, dsp_f64_t *iq_input, dsp_size_t sig_len);
+
+
 #endif
\ No newline at end of file
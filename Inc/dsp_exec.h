@@ -0,0 +1,82 @@
+/**
+ * @file dsp_exec.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP execution context: work-stealing thread pool of the parallel functions
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The parallel functions (*_exec, dsp_fft_batch) accept an optional execution context,
+ * NULL means serial calculation in the caller thread. One context is created for the
+ * application, so the library never starts more threads than configured.
+ *
+ * dsp_exec_parallel_for splits the tasks into contiguous ranges, one per thread. Every
+ * thread takes the tasks from the front of its own range, an idle thread steals the back
+ * half of the range of another thread. The caller thread also runs tasks.
+ *
+ * Threads are used only if the library is built with DSP_USE_PTHREAD, otherwise every
+ * context runs the tasks serially.
+ *
+ * In the instrumented build (dsp_instr.h) every worker hands over its counters at the end
+ * of the job and dsp_exec_parallel_for adds them to the calling thread, so the work of
+ * the pool is counted in the thread that started it.
+ */
+
+#ifndef __DSP_EXEC_H__
+#define __DSP_EXEC_H__
+
+#include "dsp_common.h"
+
+
+/*Execution context, content is library internal*/
+typedef struct _dsp_exec_ctx dsp_exec_ctx_t;
+
+/*Task function: arg is the argument of dsp_exec_parallel_for, task is the task index*/
+typedef void (*dsp_exec_task_fn_t)(void *arg, dsp_size_t task);
+
+
+/**
+ * @brief Create execution context with worker threads
+ *
+ * @param n_threads number of threads including the caller, <= 0: number of online CPUs
+ * @param cpus CPU indices of the worker threads, worker t (1 ... n_threads - 1) is pinned to
+ *             cpus[(t - 1) % n_cpus], the caller thread (thread 0) is not pinned,
+ *             NULL: no affinity (pinning is supported on Linux only)
+ * @param n_cpus length of the cpus array
+ * @return dsp_exec_ctx_t* created context, NULL if the allocation failed
+ */
+dsp_exec_ctx_t *dsp_exec_ctx_create(int n_threads, int *cpus, int n_cpus);
+
+
+/**
+ * @brief Stop the worker threads and destroy the context
+ *
+ * @param ctx context, can be NULL
+ */
+void dsp_exec_ctx_destroy(dsp_exec_ctx_t *ctx);
+
+
+/**
+ * @brief Number of threads including the caller
+ *
+ * @param ctx context, NULL: 1
+ * @return int number of threads
+ */
+int dsp_exec_ctx_threads(dsp_exec_ctx_t *ctx);
+
+
+/**
+ * @brief Run fn(arg, task) for task = 0 ... n_tasks - 1, returns when every task is finished
+ * The order of the tasks is not defined, the tasks must write disjoint memory.
+ * Called from a task (nested parallelism) the tasks run serially in the calling task,
+ * concurrent calls from more threads wait for each other, so the pool is never oversubscribed.
+ *
+ * @param ctx context, NULL: serial in the caller thread
+ * @param n_tasks number of tasks
+ * @param fn task function
+ * @param arg argument of the task function
+ */
+void dsp_exec_parallel_for(dsp_exec_ctx_t *ctx, dsp_size_t n_tasks, dsp_exec_task_fn_t fn, void *arg);
+
+#endif
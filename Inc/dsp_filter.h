@@ -139,6 +139,71 @@ dsp_val_t dsp_hamming_window(int idx, dsp_size_t filter_len);
  */
 dsp_val_t dsp_blackman_window(int idx, dsp_size_t filter_len);
 
+/**
+ * @brief Calculate Kaiser window
+ * w[i] = I0(beta * sqrt(1 - pow((i - N/2) / (N/2), 2))) / I0(beta)
+ * I0: zeroth order modified Bessel function of the first kind
+ *
+ * The shape parameter is set by dsp_kaiser_set_beta, it is stored globally because the
+ * window_calc slot has no context argument. dsp_kaiser_win_sinc_filter does not use it,
+ * the filter design is safe to call from more threads.
+ *
+ * @param idx index of filter
+ * @param filter_len filter len
+ * @return dsp_val_t calculation result
+ */
+dsp_val_t dsp_kaiser_window(int idx, dsp_size_t filter_len);
+
+/**
+ * @brief Set the shape parameter of the Kaiser window
+ *
+ * @param beta shape parameter, 0.0 is the rectangle window
+ */
+void dsp_kaiser_set_beta(dsp_val_t beta);
+
+/**
+ * @brief Calculate the minimal Kaiser windowed sinc filter length and shape parameter
+ * Kaiser formulas:
+ *      N = (A - 7.95) / (14.36 * df) + 1, df = |stop - pass| / sample_freq
+ *      beta = 0.1102 * (A - 8.7)                               A > 50
+ *      beta = 0.5842 * pow(A - 21, 0.4) + 0.07886 * (A - 21)   21 <= A <= 50
+ *      beta = 0                                                A < 21
+ * The length is rounded up to odd number, so the kernel is symmetric around filter_len / 2.
+ *
+ * @param input_sample_freq_khz known filterable signal sample frequency in kHz
+ * @param pass_freq_khz passband edge frequency in kHz
+ * @param stop_freq_khz stopband edge frequency in kHz
+ * @param atten_db stopband attenuation (and passband ripple) in dB, positive number
+ * @param beta calculated shape parameter output, can be NULL
+ * @return dsp_size_t minimal filter length, 0 if pass and stop frequencies are equal
+ */
+dsp_size_t dsp_kaiser_filter_len(dsp_val_t input_sample_freq_khz, dsp_val_t pass_freq_khz, dsp_val_t stop_freq_khz,
+                                 dsp_val_t atten_db, dsp_val_t *beta);
+
+/**
+ * @brief Create Kaiser windowed sinc filter with minimal length
+ * Low-pass filter if pass_freq_khz < stop_freq_khz, high-pass filter otherwise.
+ * Cutoff frequency is the middle of the transition band, passband gain is 1.0.
+ *
+ * Steps:
+ * 1. calculate minimal length and beta (dsp_kaiser_filter_len)
+ * 2. create low-pass filter with dsp_lp_win_sinc_filter using rectangle window
+ * 3. apply Kaiser window of the calculated beta
+ * 4. normalize to unity DC gain
+ * 5. spectral inversion for high-pass filter
+ *
+ * @param output_filter filter output result
+ * @param max_filter_len size of output_filter array
+ * @param input_sample_freq_khz known filterable signal sample frequency in kHz
+ * @param pass_freq_khz passband edge frequency in kHz
+ * @param stop_freq_khz stopband edge frequency in kHz
+ * @param atten_db stopband attenuation (and passband ripple) in dB, positive number
+ * @return dsp_size_t created filter length, 0 if the filter does not fit into max_filter_len
+ */
+dsp_size_t dsp_kaiser_win_sinc_filter(dsp_val_t *output_filter, dsp_size_t max_filter_len,
+                                      dsp_val_t input_sample_freq_khz, dsp_val_t pass_freq_khz,
+                                      dsp_val_t stop_freq_khz, dsp_val_t atten_db);
+
 /**
  * @brief Calculate spectral inversion for given index
  * 
@@ -148,4 +213,40 @@ dsp_val_t dsp_blackman_window(int idx, dsp_size_t filter_len);
  */
 void dsp_specteral_inversion(dsp_val_t *filter, int idx, dsp_size_t filter_len);
 
+
+/**
+ * @brief Single and double precision variants
+ * Same calculations as the dsp_val_t functions, the precision is selected per call.
+ * The window function must have the same precision as the filter.
+ */
+void dsp_lp_win_sinc_filter_f32(dsp_f32_t *output_filter, dsp_f32_t input_sample_freq_khz, dsp_f32_t cutoff_freq_khz,
+                                dsp_f32_t (*window_calc)(int, dsp_size_t), dsp_size_t filter_len);
+void dsp_hp_win_sinc_filter_f32(dsp_f32_t *output_filter, dsp_f32_t input_sample_freq_khz, dsp_f32_t cutoff_freq_khz,
+                                dsp_f32_t (*window_calc)(int, dsp_size_t), dsp_size_t filter_len);
+void dsp_bp_win_sinc_filter_f32(dsp_f32_t *output_filter, dsp_f32_t input_sample_freq_khz, 
+                                dsp_f32_t lower_cutoff_freq_khz, dsp_f32_t upper_cutoff_freq_khz,
+                                dsp_f32_t (*window_calc)(int, dsp_size_t), dsp_size_t filter_len);
+dsp_f32_t dsp_hamming_window_f32(int idx, dsp_size_t filter_len);
+dsp_f32_t dsp_blackman_window_f32(int idx, dsp_size_t filter_len);
+dsp_f32_t dsp_kaiser_window_f32(int idx, dsp_size_t filter_len);
+dsp_size_t dsp_kaiser_win_sinc_filter_f32(dsp_f32_t *output_filter, dsp_size_t max_filter_len,
+                                          dsp_f32_t input_sample_freq_khz, dsp_f32_t pass_freq_khz,
+                                          dsp_f32_t stop_freq_khz, dsp_f32_t atten_db);
+void dsp_specteral_inversion_f32(dsp_f32_t *filter, int idx, dsp_size_t filter_len);
+
+void dsp_lp_win_sinc_filter_f64(dsp_f64_t *output_filter, dsp_f64_t input_sample_freq_khz, dsp_f64_t cutoff_freq_khz,
+                                dsp_f64_t (*window_calc)(int, dsp_size_t), dsp_size_t filter_len);
+void dsp_hp_win_sinc_filter_f64(dsp_f64_t *output_filter, dsp_f64_t input_sample_freq_khz, dsp_f64_t cutoff_freq_khz,
+                                dsp_f64_t (*window_calc)(int, dsp_size_t), dsp_size_t filter_len);
+void dsp_bp_win_sinc_filter_f64(dsp_f64_t *output_filter, dsp_f64_t input_sample_freq_khz, 
+                                dsp_f64_t lower_cutoff_freq_khz, dsp_f64_t upper_cutoff_freq_khz,
+                                dsp_f64_t (*window_calc)(int, dsp_size_t), dsp_size_t filter_len);
+dsp_f64_t dsp_hamming_window_f64(int idx, dsp_size_t filter_len);
+dsp_f64_t dsp_blackman_window_f64(int idx, dsp_size_t filter_len);
+dsp_f64_t dsp_kaiser_window_f64(int idx, dsp_size_t filter_len);
+dsp_size_t dsp_kaiser_win_sinc_filter_f64(dsp_f64_t *output_filter, dsp_size_t max_filter_len,
+                                          dsp_f64_t input_sample_freq_khz, dsp_f64_t pass_freq_khz,
+                                          dsp_f64_t stop_freq_khz, dsp_f64_t atten_db);
+void dsp_specteral_inversion_f64(dsp_f64_t *filter, int idx, dsp_size_t filter_len);
+
 #endif 
\ No newline at end of file
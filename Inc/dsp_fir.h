@@ -0,0 +1,100 @@
+/**
+ * @file dsp_fir.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP prepared FIR filter, time or frequency domain application
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef __DSP_FIR_H__
+#define __DSP_FIR_H__
+
+#include "dsp_common.h"
+#include "dsp_fft.h"
+
+
+/**
+ * @brief Relative cost of the FFT compared to one multiply-accumulate
+ * FFT cost ~= DSP_FIR_FFT_COST_FACTOR * N * log2(N) MAC
+ * Measured crossover with the radix-2 dsp_fft, it can be overridden at build time.
+ */
+#ifndef DSP_FIR_FFT_COST_FACTOR
+    #define DSP_FIR_FFT_COST_FACTOR     (2.5)
+#endif
+
+
+/**
+ * @brief Filter application path
+ *
+ */
+typedef enum {
+    DSP_FIR_PATH_AUTO = 0,      // select the cheaper path at creation
+    DSP_FIR_PATH_TIME,          // direct convolution
+    DSP_FIR_PATH_FREQ           // FFT overlap-add with cached kernel spectrum
+} dsp_fir_path_t;
+
+
+/**
+ * @brief Prepared FIR filter
+ * The kernel is zero padded and transformed once at creation.
+ * The work arrays are modified by dsp_fir_apply, one filter object must not be used
+ * from more threads at the same time.
+ */
+typedef struct {
+    dsp_fir_path_t path;        // selected application path
+    dsp_val_t *kernel;          // time domain kernel copy
+    dsp_size_t kernel_len;      // kernel length
+    dsp_size_t block_len;       // input samples per FFT block
+    dsp_fft_plan_t *plan;       // FFT plan, NULL in time domain path
+    dsp_val_t *kernel_rex;      // kernel spectrum real part
+    dsp_val_t *kernel_imx;      // kernel spectrum imaginary part
+    dsp_val_t *work_rex;        // FFT work array real part
+    dsp_val_t *work_imx;        // FFT work array imaginary part
+} dsp_fir_t;
+
+
+/**
+ * @brief Create prepared FIR filter
+ * The filter kernel is usually created by dsp_lp_win_sinc_filter, dsp_hp_win_sinc_filter or dsp_bp_win_sinc_filter.
+ *
+ * Cost per output sample:
+ * time domain:         K MAC
+ * frequency domain:    (2 * c * N * log2(N) + 4 * N) / (2 * B) MAC
+ *                      two blocks are transformed together as real and imaginary part
+ * K: kernel length, B: block length, N: FFT length >= B + K - 1
+ *
+ * With DSP_FIR_PATH_AUTO the cheaper path and the cheapest FFT length are selected.
+ *
+ * @param kernel filter kernel array, it is copied
+ * @param kernel_len filter kernel length
+ * @param max_block_len expected maximal input length of one dsp_fir_apply call
+ * @param path application path
+ * @return dsp_fir_t* prepared filter, NULL if the allocation failed
+ */
+dsp_fir_t *dsp_fir_create(dsp_val_t *kernel, dsp_size_t kernel_len, dsp_size_t max_block_len, dsp_fir_path_t path);
+
+
+/**
+ * @brief Destroy prepared FIR filter
+ *
+ * @param fir filter created by dsp_fir_create, can be NULL
+ */
+void dsp_fir_destroy(dsp_fir_t *fir);
+
+
+/**
+ * @brief Apply prepared FIR filter on the input signal
+ * Same result as dsp_convolution with the filter kernel, any input length is accepted.
+ *
+ * @param fir prepared filter
+ * @param dest_sig destination output array, length: input_sig_len + kernel_len
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ */
+void dsp_fir_apply(dsp_fir_t *fir, dsp_val_t *dest_sig, dsp_val_t *input_sig, dsp_size_t input_sig_len);
+
+
+#endif
@@ -0,0 +1,198 @@
+/**
+ * @file dsp_fixed.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP fixed-point (Q15, Q31) calculations
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef __DSP_FIXED_H__
+#define __DSP_FIXED_H__
+
+#include "dsp_common.h"
+
+/**
+ * @brief Fixed-point value types
+ * Q15: 1 sign bit, 15 fractional bits, range [-1.0, 1.0 - pow(2, -15)]
+ * Q31: 1 sign bit, 31 fractional bits, range [-1.0, 1.0 - pow(2, -31)]
+ *
+ * All the calculations use 64-bit accumulators, results are rounded and saturated.
+ */
+typedef int16_t dsp_q15_t;
+typedef int32_t dsp_q31_t;
+
+#define DSP_Q15_MAX     ((dsp_q15_t)0x7FFF)
+#define DSP_Q15_MIN     ((dsp_q15_t)(-0x7FFF - 1))
+#define DSP_Q31_MAX     ((dsp_q31_t)0x7FFFFFFF)
+#define DSP_Q31_MIN     ((dsp_q31_t)(-0x7FFFFFFF - 1))
+
+
+/**
+ * @brief Convert floating point array to Q15 with rounding and saturation
+ *
+ * @param dest destination Q15 array
+ * @param src source array
+ * @param len length of arrays
+ */
+void dsp_quantize_q15(dsp_q15_t *dest, dsp_val_t *src, dsp_size_t len);
+
+/**
+ * @brief Convert floating point array to Q31 with rounding and saturation
+ *
+ * @param dest destination Q31 array
+ * @param src source array
+ * @param len length of arrays
+ */
+void dsp_quantize_q31(dsp_q31_t *dest, dsp_val_t *src, dsp_size_t len);
+
+/**
+ * @brief Convert Q15 array to floating point
+ *
+ * @param dest destination array
+ * @param src source Q15 array
+ * @param len length of arrays
+ */
+void dsp_dequantize_q15(dsp_val_t *dest, dsp_q15_t *src, dsp_size_t len);
+
+/**
+ * @brief Convert Q31 array to floating point
+ *
+ * @param dest destination array
+ * @param src source Q31 array
+ * @param len length of arrays
+ */
+void dsp_dequantize_q31(dsp_val_t *dest, dsp_q31_t *src, dsp_size_t len);
+
+
+/**
+ * @brief Quantize filter kernel to Q15 coefficients
+ * The windowed sinc designers can produce coefficients out of the Q15 range,
+ * so the kernel is scaled down by pow(2, coef_shift):
+ *      dest[i] = filter[i] / pow(2, coef_shift)
+ * coef_shift is the minimal shift, where all coefficients fit into Q15.
+ * The shift must be passed to dsp_convolution_q15.
+ *
+ * @param dest destination Q15 coefficient array
+ * @param filter filter kernel, e.g. output of dsp_lp_win_sinc_filter
+ * @param filter_len filter length
+ * @return int coef_shift, -1 if a coefficient is not finite or needs a shift above 15
+ *         (dest is not written)
+ */
+int dsp_filter_quantize_q15(dsp_q15_t *dest, dsp_val_t *filter, dsp_size_t filter_len);
+
+/**
+ * @brief Quantize filter kernel to Q31 coefficients
+ * Same as dsp_filter_quantize_q15 with Q31 coefficients.
+ *
+ * @param dest destination Q31 coefficient array
+ * @param filter filter kernel, e.g. output of dsp_lp_win_sinc_filter
+ * @param filter_len filter length
+ * @return int coef_shift, -1 if a coefficient is not finite or needs a shift above 31
+ *         (dest is not written)
+ */
+int dsp_filter_quantize_q31(dsp_q31_t *dest, dsp_val_t *filter, dsp_size_t filter_len);
+
+
+/**
+ * @brief Q15 Convolution
+ * y[n] = sum (x[n - j] * h[j]) * pow(2, coef_shift)
+ * One 64-bit accumulator per output sample, the output is rounded and saturated once.
+ *
+ * @param dest_sig destination output array, length: input_sig_len + impulse_resp_len
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @param impulse_resp impulse response signal array
+ * @param impulse_resp_len impulse response signal length
+ * @param coef_shift coefficient scale returned by dsp_filter_quantize_q15, 0 for plain Q15 impulse response
+ */
+void dsp_convolution_q15(dsp_q15_t *dest_sig, dsp_q15_t *input_sig, dsp_size_t input_sig_len,
+                         dsp_q15_t *impulse_resp, dsp_size_t impulse_resp_len, int coef_shift);
+
+/**
+ * @brief Q31 Convolution
+ * Same as dsp_convolution_q15 with Q31 values.
+ * The products are rounded to Q31 before accumulation, the sum is kept in 64 bit.
+ *
+ * @param dest_sig destination output array, length: input_sig_len + impulse_resp_len
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @param impulse_resp impulse response signal array
+ * @param impulse_resp_len impulse response signal length
+ * @param coef_shift coefficient scale returned by dsp_filter_quantize_q31, 0 for plain Q31 impulse response
+ */
+void dsp_convolution_q31(dsp_q31_t *dest_sig, dsp_q31_t *input_sig, dsp_size_t input_sig_len,
+                         dsp_q31_t *impulse_resp, dsp_size_t impulse_resp_len, int coef_shift);
+
+
+/**
+ * @brief Q15 Discrete Fourier Transform magnitude
+ * mag[k] = sqrt(pow(rex[k], 2) + pow(imx[k], 2)), integer square root, saturated
+ *
+ * @param dest_mag destination signal
+ * @param rex real part array
+ * @param imx imaginary part array
+ * @param mag_len length of magnitude
+ */
+void dsp_dft_magnitude_q15(dsp_q15_t *dest_mag, dsp_q15_t *rex, dsp_q15_t *imx, dsp_size_t mag_len);
+
+/**
+ * @brief Q31 Discrete Fourier Transform magnitude
+ * mag[k] = sqrt(pow(rex[k], 2) + pow(imx[k], 2)), integer square root, saturated
+ *
+ * @param dest_mag destination signal
+ * @param rex real part array
+ * @param imx imaginary part array
+ * @param mag_len length of magnitude
+ */
+void dsp_dft_magnitude_q31(dsp_q31_t *dest_mag, dsp_q31_t *rex, dsp_q31_t *imx, dsp_size_t mag_len);
+
+
+/**
+ * @brief Q15 signal mean
+ * mu = 1/N * sum(xi), 64-bit sum
+ *
+ * @param sig signal array
+ * @param len length of array
+ * @return dsp_q15_t mean value, 0 for empty signal
+ */
+dsp_q15_t dsp_sig_mean_q15(dsp_q15_t *sig, dsp_size_t len);
+
+/**
+ * @brief Q31 signal mean
+ * mu = 1/N * sum(xi), 64-bit sum
+ *
+ * @param sig signal array
+ * @param len length of array
+ * @return dsp_q31_t mean value, 0 for empty signal
+ */
+dsp_q31_t dsp_sig_mean_q31(dsp_q31_t *sig, dsp_size_t len);
+
+/**
+ * @brief Variance of Q15 signal
+ * pow(sigma, 2) = (1/(N-1)) * sum(pow(xi-u, 2))
+ * The result is Q31, because the variance of a Q15 signal is too small for Q15 precision.
+ *
+ * @param sig signal array
+ * @param sig_mean signal mean value
+ * @param len length of signal
+ * @return dsp_q31_t variance value
+ */
+dsp_q31_t dsp_sig_variance_q15(dsp_q15_t *sig, dsp_q15_t sig_mean, dsp_size_t len);
+
+/**
+ * @brief Variance of Q31 signal
+ * pow(sigma, 2) = (1/(N-1)) * sum(pow(xi-u, 2))
+ * The squares are rounded to Q31 before accumulation.
+ *
+ * @param sig signal array
+ * @param sig_mean signal mean value
+ * @param len length of signal
+ * @return dsp_q31_t variance value
+ */
+dsp_q31_t dsp_sig_variance_q31(dsp_q31_t *sig, dsp_q31_t sig_mean, dsp_size_t len);
+
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file dsp_instr.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP hot path instrumentation: call count, time and processed bytes per function
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The instrumentation is compiled in only with the DSP_INSTR build option, otherwise
+ * the DSP_INSTR_BEGIN / DSP_INSTR_END macros are empty and the counters stay zero.
+ * The counters are per thread (no locking on the hot path), the times are inclusive:
+ * a function calling another instrumented function contains its time too.
+ * The counters of the pool workers (dsp_exec.h) are added to the thread calling
+ * dsp_exec_parallel_for at the end of every job, so their ticks are CPU time: the sum
+ * can be more than the wall time of the parallel call.
+ */
+
+#ifndef __DSP_INSTR_H__
+#define __DSP_INSTR_H__
+
+#include <stdint.h>
+#include "dsp_common.h"
+
+
+/**
+ * @brief Instrumented functions
+ * The single and double precision variants are counted together.
+ */
+typedef enum {
+    DSP_INSTR_SIG_MEAN = 0,
+    DSP_INSTR_SIG_VARIANCE,
+    DSP_INSTR_SIG_STATS,
+    DSP_INSTR_SIG_STATS_MT,
+    DSP_INSTR_SIG_METRICS,
+    DSP_INSTR_STAT_ACC_UPDATE,
+    DSP_INSTR_CONVOLUTION,
+    DSP_INSTR_RUNNING_SUM,
+    DSP_INSTR_DFT,
+    DSP_INSTR_IDFT,
+    DSP_INSTR_DFT_MAGNITUDE,
+    DSP_INSTR_RECT2POLAR,
+    DSP_INSTR_CDFT,
+    DSP_INSTR_FFT,
+    DSP_INSTR_IFFT,
+    DSP_INSTR_LP_WIN_SINC_FILTER,
+    DSP_INSTR_HP_WIN_SINC_FILTER,
+    DSP_INSTR_BP_WIN_SINC_FILTER,
+    DSP_INSTR_KAISER_WIN_SINC_FILTER,
+    DSP_INSTR_FIR_APPLY,
+    DSP_INSTR_CHANNELIZER_PROCESS,
+    DSP_INSTR_CONVOLUTION_Q15,
+    DSP_INSTR_CONVOLUTION_Q31,
+    DSP_INSTR_XCORR,
+    DSP_INSTR_ROLLING_PROCESS,
+    DSP_INSTR_QUANTILE_ACC_UPDATE,
+    DSP_INSTR_HIST_UPDATE,
+    DSP_INSTR_PIPELINE_PROCESS,
+    DSP_INSTR_STFT,
+    DSP_INSTR_ISTFT,
+    DSP_INSTR_WELCH_UPDATE,
+    DSP_INSTR_N_FUNCTIONS
+} dsp_instr_id_t;
+
+
+/**
+ * @brief Counters of one function
+ */
+typedef struct {
+    uint64_t calls;             // number of calls
+    uint64_t total_ticks;       // sum of the call times
+    uint64_t max_ticks;         // longest call
+    uint64_t bytes;             // sum of the processed input bytes
+} dsp_instr_counter_t;
+
+
+/**
+ * @brief Counters of every function
+ */
+typedef struct {
+    int ticks_are_cycles;       // 1: ticks are CPU cycles (rdtsc), 0: ticks are ns (clock_gettime)
+    dsp_instr_counter_t counter[DSP_INSTR_N_FUNCTIONS];
+} dsp_instr_snapshot_t;
+
+
+#ifdef DSP_INSTR
+    #define DSP_INSTR_BEGIN()           uint64_t _dsp_instr_t0 = dsp_instr_ticks()
+    #define DSP_INSTR_END(id, bytes)    dsp_instr_record((id), dsp_instr_ticks() - _dsp_instr_t0, (uint64_t)(bytes))
+#else
+    #define DSP_INSTR_BEGIN()
+    #define DSP_INSTR_END(id, bytes)
+#endif
+
+
+/**
+ * @brief Current time stamp of the instrumentation clock
+ *
+ * @return uint64_t CPU cycles on x86 with GCC compatible compiler, ns otherwise
+ */
+uint64_t dsp_instr_ticks(void);
+
+
+/**
+ * @brief Record one call into the counters of the calling thread
+ *
+ * @param id instrumented function
+ * @param ticks time of the call
+ * @param bytes processed input bytes
+ */
+void dsp_instr_record(dsp_instr_id_t id, uint64_t ticks, uint64_t bytes);
+
+
+/**
+ * @brief Copy of the counters of the calling thread
+ *
+ * @param snapshot output
+ */
+void dsp_instr_snapshot(dsp_instr_snapshot_t *snapshot);
+
+
+/**
+ * @brief Add the counters of an other snapshot (e.g. of a worker thread)
+ *
+ * @param snapshot accumulated snapshot
+ * @param other added snapshot
+ */
+void dsp_instr_merge(dsp_instr_snapshot_t *snapshot, dsp_instr_snapshot_t *other);
+
+
+/**
+ * @brief Add the counters of a snapshot (e.g. of a worker thread) to the calling thread
+ *
+ * @param other added snapshot
+ */
+void dsp_instr_add(dsp_instr_snapshot_t *other);
+
+
+/**
+ * @brief Clear the counters of the calling thread
+ */
+void dsp_instr_reset(void);
+
+
+/**
+ * @brief Name of an instrumented function
+ *
+ * @param id instrumented function
+ * @return char* public function name, "unknown" for invalid id
+ */
+char *dsp_instr_name(dsp_instr_id_t id);
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file dsp_iq.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP interleaved complex (I/Q) sample layout conversion
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * Interleaved complex signal of len samples is 2 * len values long:
+ *
+ *  iq[2 * n]       I, real part of sample n
+ *  iq[2 * n + 1]   Q, imaginary part of sample n
+ *
+ * The *_iq variants of the complex transforms (dsp_cdft_iq, dsp_fft_iq), the magnitude and
+ * the polar conversion (dsp_dft_magnitude_iq, dsp_rect2polar_iq) work on this layout directly.
+ * The conversions below are needed only for functions without interleaved variant.
+ */
+
+#ifndef __DSP_IQ_H__
+#define __DSP_IQ_H__
+
+#include "dsp_common.h"
+
+
+/**
+ * @brief Split interleaved complex signal into real and imaginary part arrays
+ *
+ * @param dest_rex real part destination array, len long
+ * @param dest_imx imaginary part destination array, len long
+ * @param iq interleaved input signal, 2 * len long
+ * @param len number of complex samples
+ */
+void dsp_iq_deinterleave(dsp_val_t *dest_rex, dsp_val_t *dest_imx, dsp_val_t *iq, dsp_size_t len);
+
+
+/**
+ * @brief Merge real and imaginary part arrays into interleaved complex signal
+ *
+ * @param dest_iq interleaved destination array, 2 * len long
+ * @param rex real part array, len long
+ * @param imx imaginary part array, len long
+ * @param len number of complex samples
+ */
+void dsp_iq_interleave(dsp_val_t *dest_iq, dsp_val_t *rex, dsp_val_t *imx, dsp_size_t len);
+
+
+/**
+ * @brief Single and double precision variants
+ * Same calculations as the dsp_val_t functions, the precision is selected per call.
+ */
+void dsp_iq_deinterleave_f32(dsp_f32_t *dest_rex, dsp_f32_t *dest_imx, dsp_f32_t *iq, dsp_size_t len);
+void dsp_iq_interleave_f32(dsp_f32_t *dest_iq, dsp_f32_t *rex, dsp_f32_t *imx, dsp_size_t len);
+
+void dsp_iq_deinterleave_f64(dsp_f64_t *dest_rex, dsp_f64_t *dest_imx, dsp_f64_t *iq, dsp_size_t len);
+void dsp_iq_interleave_f64(dsp_f64_t *dest_iq, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len);
+
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * @file dsp_pipeline.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP block processing pipeline: chain of stages with ping-pong buffers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The input signal is pushed block by block through the stages, the output of a stage
+ * is the input of the next one. Two buffers are allocated for the whole chain, the
+ * stages write them alternately, so the intermediate data of a block stays in the cache
+ * and no full length intermediate array is needed. The first stage reads the caller's
+ * block and the last output is returned as pointer, nothing is copied between the stages.
+ * In-place stages (decimation, magnitude, statistic tap) write over their input.
+ *
+ * Typical chain: win-sinc FIR filter -> decimation -> DFT frames -> magnitude -> statistic
+ */
+
+#ifndef __DSP_PIPELINE_H__
+#define __DSP_PIPELINE_H__
+
+#include "dsp_common.h"
+#include "dsp_fir.h"
+#include "dsp_fft.h"
+#include "dsp_stat.h"
+
+
+/*Initial capacity of the stage array, it is grown on demand*/
+#ifndef DSP_PIPELINE_INIT_STAGES
+    #define DSP_PIPELINE_INIT_STAGES    8
+#endif
+
+
+/**
+ * @brief Stage process function
+ * Reads in_len samples from in, writes the output to out and returns its length.
+ * For in-place stages out can be the same as in.
+ */
+typedef dsp_size_t (*dsp_pipeline_process_fn_t)(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len);
+
+/*Stage reset function, clears the history of the stage*/
+typedef void (*dsp_pipeline_reset_fn_t)(void *state);
+
+/*Stage destroy function, frees the state*/
+typedef void (*dsp_pipeline_destroy_fn_t)(void *state);
+
+
+/**
+ * @brief Pipeline stage
+ *
+ */
+typedef struct {
+    dsp_pipeline_process_fn_t process;  // process function
+    dsp_pipeline_reset_fn_t reset;      // reset function, can be NULL
+    dsp_pipeline_destroy_fn_t destroy;  // destroy function, NULL if the state is not owned by the pipeline
+    void *state;                        // stage state
+    dsp_size_t max_in_len;              // maximal input length of one call
+    dsp_size_t max_out_len;             // maximal output length of one call
+    int in_place;                       // nonzero if out can be the same as in
+} dsp_pipeline_stage_t;
+
+
+/**
+ * @brief Block processing pipeline
+ *
+ */
+typedef struct {
+    dsp_size_t block_len;               // maximal input length of one dsp_pipeline_process call
+    dsp_pipeline_stage_t *stages;       // stage array
+    dsp_size_t n_stages;                // number of stages
+    dsp_size_t stages_cap;              // capacity of the stage array
+    dsp_val_t *buf[2];                  // ping-pong buffers, aligned
+    dsp_size_t buf_len;                 // allocated length of one ping-pong buffer
+    dsp_size_t max_len;                 // maximal output length of the last stage
+} dsp_pipeline_t;
+
+
+/**
+ * @brief Create empty pipeline
+ *
+ * @param block_len maximal input length of one dsp_pipeline_process call
+ * @return dsp_pipeline_t* created pipeline, NULL if block length is 0 or the allocation failed
+ */
+dsp_pipeline_t *dsp_pipeline_create(dsp_size_t block_len);
+
+
+/**
+ * @brief Destroy pipeline and the owned stage states
+ *
+ * @param pl pipeline created by dsp_pipeline_create, can be NULL
+ */
+void dsp_pipeline_destroy(dsp_pipeline_t *pl);
+
+
+/**
+ * @brief Reset the history of every stage (filter tail, decimation phase, partial frame)
+ *
+ * @param pl pipeline
+ */
+void dsp_pipeline_reset(dsp_pipeline_t *pl);
+
+
+/**
+ * @brief Append user defined stage to the end of the chain
+ * The maximal input length of the stage is the maximal output length of the previous
+ * stage (or the block length), see dsp_pipeline_max_len.
+ *
+ * @param pl pipeline
+ * @param process process function
+ * @param reset reset function, can be NULL
+ * @param destroy destroy function called by dsp_pipeline_destroy, NULL: state is owned by the caller
+ * @param state stage state
+ * @param max_out_len maximal output length of one call
+ * @param in_place nonzero if the output can be written over the input
+ * @return int 0 on success, -1 if the allocation failed
+ */
+int dsp_pipeline_add(dsp_pipeline_t *pl, dsp_pipeline_process_fn_t process, dsp_pipeline_reset_fn_t reset,
+                     dsp_pipeline_destroy_fn_t destroy, void *state, dsp_size_t max_out_len, int in_place);
+
+
+/**
+ * @brief Maximal output length of the last stage, maximal input length of the next stage
+ *
+ * @param pl pipeline
+ * @return dsp_size_t maximal length, block length for empty pipeline
+ */
+dsp_size_t dsp_pipeline_max_len(dsp_pipeline_t *pl);
+
+
+/**
+ * @brief Append streaming FIR filter stage
+ * Output length is the input length, the convolution tail is carried to the next block,
+ * so the concatenated output is the first samples of dsp_convolution on the whole signal.
+ *
+ * @param pl pipeline
+ * @param kernel filter kernel, it is copied
+ * @param kernel_len filter kernel length
+ * @param path application path, see dsp_fir_create
+ * @return int 0 on success, -1 if the allocation failed
+ */
+int dsp_pipeline_add_fir(dsp_pipeline_t *pl, dsp_val_t *kernel, dsp_size_t kernel_len, dsp_fir_path_t path);
+
+
+/**
+ * @brief Append decimation stage, every factor-th sample is kept (in-place)
+ * The phase is carried to the next block. No anti-aliasing filter, add a low-pass
+ * FIR stage before it.
+ *
+ * @param pl pipeline
+ * @param factor decimation factor, >= 1
+ * @return int 0 on success, -1 if factor is 0 or the allocation failed
+ */
+int dsp_pipeline_add_decimate(dsp_pipeline_t *pl, dsp_size_t factor);
+
+
+/**
+ * @brief Append DFT framing stage
+ * Input samples are collected into frames of frame_len samples, partial frame is carried
+ * to the next block. The output of every complete frame is frame_len / 2 real parts followed by
+ * frame_len / 2 imaginary parts, the same as dsp_dft. Power of two frames are transformed by FFT.
+ *
+ * @param pl pipeline
+ * @param frame_len frame length, >= 2
+ * @return int 0 on success, -1 if the frame length is too short or the allocation failed
+ */
+int dsp_pipeline_add_dft(dsp_pipeline_t *pl, dsp_size_t frame_len);
+
+
+/**
+ * @brief Append magnitude stage after a DFT stage (in-place)
+ * Every bins * 2 input samples (real parts, imaginary parts) give bins magnitudes.
+ *
+ * @param pl pipeline
+ * @param bins number of frequency bins in one spectrum (frame_len / 2 of the DFT stage)
+ * @return int 0 on success, -1 if bins is 0 or the allocation failed
+ */
+int dsp_pipeline_add_magnitude(dsp_pipeline_t *pl, dsp_size_t bins);
+
+
+/**
+ * @brief Append statistic tap stage, the input is accumulated and passed through (in-place)
+ *
+ * @param pl pipeline
+ * @param acc accumulator initialized by dsp_stat_acc_init, owned by the caller
+ * @return int 0 on success, -1 if the allocation failed
+ */
+int dsp_pipeline_add_stats(dsp_pipeline_t *pl, dsp_stat_acc_t *acc);
+
+
+/**
+ * @brief Process one block through every stage
+ * The returned pointer is valid until the next call, it points to one of the ping-pong
+ * buffers (or to the input for empty pipeline).
+ *
+ * @param pl pipeline
+ * @param input_sig input block
+ * @param input_sig_len length of input block, <= block length
+ * @param out_len output length of the last stage
+ * @return dsp_val_t* output of the last stage, NULL if the block is too long
+ */
+dsp_val_t *dsp_pipeline_process(dsp_pipeline_t *pl, dsp_val_t *input_sig, dsp_size_t input_sig_len,
+                                dsp_size_t *out_len);
+
+
+/**
+ * @brief Process the whole signal block by block
+ * The outputs of the blocks are concatenated into the destination array.
+ *
+ * @param pl pipeline
+ * @param dest_sig destination array, NULL if only the side effects are needed (e.g. statistic tap)
+ * @param dest_sig_len length of destination array, the rest of the output is dropped
+ * @param input_sig input signal
+ * @param input_sig_len length of input signal
+ * @return dsp_size_t total output length of the last stage
+ */
+dsp_size_t dsp_pipeline_run(dsp_pipeline_t *pl, dsp_val_t *dest_sig, dsp_size_t dest_sig_len,
+                            dsp_val_t *input_sig, dsp_size_t input_sig_len);
+
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file dsp_psd.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP power spectral density estimation by Welch's method
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The signal is split into overlapped segments, every segment is windowed, zero padded to
+ * the FFT length (next power of two) and transformed. The estimate is the average of the
+ * segment periodograms, one-sided, scaled to density (unit^2 / Hz):
+ *
+ * P[k] = c[k] * mean(pow(|X[k]|, 2)) / (fs * sum(pow(w[n], 2))) | k = 0 .. fft_len / 2
+ * c[k] = 1 for DC and Nyquist, 2 otherwise
+ *
+ * Bin k is at k * fs / fft_len Hz. The segments are collected into a fixed batch, two real
+ * segments per complex row, and transformed by dsp_fft_batch. The estimator keeps only the
+ * running sum of the periodograms, so the memory depends on the segment length, not on the
+ * length of the input.
+ */
+
+#ifndef __DSP_PSD_H__
+#define __DSP_PSD_H__
+
+#include "dsp_common.h"
+#include "dsp_fft.h"
+#include "dsp_workspace.h"
+
+
+/*Complex transforms per dsp_fft_batch call, two real segments are packed into one transform*/
+#ifndef DSP_WELCH_BATCH
+    #define DSP_WELCH_BATCH     8
+#endif
+
+
+/**
+ * @brief Welch estimator
+ * The segment buffers and the stream state are modified by the update, one estimator
+ * must not be used from more threads at the same time.
+ */
+typedef struct {
+    dsp_size_t seg_len;         // samples per segment
+    dsp_size_t hop;             // samples between the segment starts: seg_len - overlap
+    dsp_size_t fft_len;         // transform length, power of two >= seg_len
+    dsp_size_t bins;            // one-sided bins: fft_len / 2 + 1
+    dsp_val_t sample_rate;      // sample rate in Hz
+    dsp_val_t scale;            // 1 / (fs * sum(pow(w[n], 2)))
+    dsp_val_t *window;          // window, seg_len long
+    dsp_fft_plan_t *plan;       // FFT plan of fft_len
+    dsp_val_t *batch_rex;       // windowed even segments of the batch, DSP_WELCH_BATCH * fft_len long
+    dsp_val_t *batch_imx;       // windowed odd segments of the batch, DSP_WELCH_BATCH * fft_len long
+    dsp_size_t batch_fill;      // segments in the batch, at most 2 * DSP_WELCH_BATCH
+    dsp_val_t *hist;            // start of the next segment from the previous updates, seg_len long
+    dsp_size_t hist_fill;       // samples in hist
+    dsp_val_t *acc;             // sum of pow(|X[k]|, 2) of the transformed segments, bins long
+    dsp_size_t n_segments;      // number of segments, transformed and in the batch
+    dsp_exec_ctx_t *ctx;        // execution context of the batch transform, NULL: serial
+    dsp_workspace_t *own_ws;    // workspace created by dsp_welch_create, NULL for caller workspace
+} dsp_welch_t;
+
+
+/**
+ * @brief Workspace bytes of a Welch estimator created by dsp_welch_create_ws
+ *
+ * @param seg_len samples per segment
+ * @return dsp_size_t workspace bytes
+ */
+dsp_size_t dsp_welch_workspace_size(dsp_size_t seg_len);
+
+
+/**
+ * @brief Create Welch estimator
+ *
+ * @param seg_len samples per segment, >= 2
+ * @param overlap overlapping samples of the neighbour segments, less than seg_len (typically seg_len / 2)
+ * @param window_calc window function (dsp_hamming_window, dsp_blackman_window, ...), NULL: Hamming
+ * @param sample_rate sample rate in Hz, <= 0: 1 (density per normalized frequency)
+ * @param ctx execution context of the batch transform, NULL: serial
+ * @return dsp_welch_t* created estimator, NULL if the parameters are invalid or the allocation failed
+ */
+dsp_welch_t *dsp_welch_create(dsp_size_t seg_len, dsp_size_t overlap, dsp_val_t (*window_calc)(int, dsp_size_t),
+                              dsp_val_t sample_rate, dsp_exec_ctx_t *ctx);
+
+
+/**
+ * @brief Create Welch estimator in workspace
+ * The estimator lives until the workspace is released, it must not be destroyed.
+ *
+ * @param seg_len samples per segment, >= 2
+ * @param overlap overlapping samples of the neighbour segments, less than seg_len
+ * @param window_calc window function, NULL: Hamming
+ * @param sample_rate sample rate in Hz, <= 0: 1
+ * @param ctx execution context of the batch transform, NULL: serial
+ * @param ws workspace, at least dsp_welch_workspace_size(seg_len) bytes free
+ * @return dsp_welch_t* created estimator, NULL if the parameters are invalid or the workspace is full
+ */
+dsp_welch_t *dsp_welch_create_ws(dsp_size_t seg_len, dsp_size_t overlap, dsp_val_t (*window_calc)(int, dsp_size_t),
+                                 dsp_val_t sample_rate, dsp_exec_ctx_t *ctx, dsp_workspace_t *ws);
+
+
+/**
+ * @brief Destroy Welch estimator created by dsp_welch_create
+ *
+ * @param welch estimator, can be NULL
+ */
+void dsp_welch_destroy(dsp_welch_t *welch);
+
+
+/**
+ * @brief Drop the accumulated segments and the stream state
+ *
+ * @param welch estimator
+ */
+void dsp_welch_reset(dsp_welch_t *welch);
+
+
+/**
+ * @brief Add the next block of the input stream
+ * The blocks can have any length, the segments are the same as in the concatenated signal.
+ *
+ * @param welch estimator
+ * @param input_sig input block
+ * @param input_sig_len input block length
+ */
+void dsp_welch_update(dsp_welch_t *welch, dsp_val_t *input_sig, dsp_size_t input_sig_len);
+
+
+/**
+ * @brief Get the estimate of the segments so far
+ * The stream can be continued, the estimate is the running average of every segment.
+ *
+ * @param welch estimator
+ * @param dest_psd one-sided power spectral density, bins long, 0 if there is no complete segment
+ * @return dsp_size_t number of averaged segments
+ */
+dsp_size_t dsp_welch_get(dsp_welch_t *welch, dsp_val_t *dest_psd);
+
+
+/**
+ * @brief Power spectral density of a whole signal by Welch's method
+ *
+ * @param dest_psd one-sided power spectral density, next_pow2(seg_len) / 2 + 1 long
+ * @param input_sig input signal
+ * @param input_sig_len input signal length
+ * @param seg_len samples per segment, >= 2
+ * @param overlap overlapping samples of the neighbour segments, less than seg_len
+ * @param window_calc window function, NULL: Hamming
+ * @param sample_rate sample rate in Hz, <= 0: 1
+ * @return dsp_size_t number of averaged segments, 0 if the parameters are invalid, the signal
+ * is shorter than a segment or the allocation failed
+ */
+dsp_size_t dsp_welch_psd(dsp_val_t *dest_psd, dsp_val_t *input_sig, dsp_size_t input_sig_len,
+                         dsp_size_t seg_len, dsp_size_t overlap, dsp_val_t (*window_calc)(int, dsp_size_t),
+                         dsp_val_t sample_rate);
+
+
+#endif
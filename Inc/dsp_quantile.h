@@ -0,0 +1,166 @@
+/**
+ * @file dsp_quantile.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP streaming quantile estimation (t-digest) and fixed-bin histogram
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef __DSP_QUANTILE_H__
+#define __DSP_QUANTILE_H__
+
+#include "dsp_common.h"
+
+
+/**
+ * @brief Size limits of the quantile accumulator
+ * The number of centroids is at most about the compression, the buffer collects
+ * the new samples between two compressions. The accumulator has fixed size:
+ * (DSP_QUANTILE_MAX_CENTROIDS + DSP_QUANTILE_BUF_LEN) * 2 values.
+ */
+#ifndef DSP_QUANTILE_MAX_CENTROIDS
+    #define DSP_QUANTILE_MAX_CENTROIDS      (256UL)
+#endif
+
+#ifndef DSP_QUANTILE_BUF_LEN
+    #define DSP_QUANTILE_BUF_LEN            (512UL)
+#endif
+
+#define DSP_QUANTILE_DEF_COMPRESSION        (100.0)
+
+
+/**
+ * @brief Centroid of the t-digest: mean of the merged samples and their number
+ */
+typedef struct {
+    dsp_val_t mean;             // mean of the samples
+    dsp_val_t weight;           // number of the samples
+} dsp_centroid_t;
+
+
+/**
+ * @brief Streaming quantile accumulator (merging t-digest)
+ * The centroids are sorted by mean, the size limit of a centroid is given by the
+ * k1 scale function: k(q) = compression / (2 * PI) * asin(2 * q - 1).
+ * The centroids near the tails are small, so the extreme quantiles (p1, p99) are accurate.
+ */
+typedef struct {
+    dsp_val_t compression;      // compression parameter (delta)
+    dsp_size_t n_centroids;     // number of compressed centroids
+    dsp_size_t n_buf;           // number of uncompressed entries after the centroids
+    dsp_val_t total_weight;     // number of samples
+    dsp_val_t min;              // minimum value
+    dsp_val_t max;              // maximum value
+    dsp_centroid_t centroid[DSP_QUANTILE_MAX_CENTROIDS + DSP_QUANTILE_BUF_LEN];
+} dsp_quantile_acc_t;
+
+
+/**
+ * @brief Fixed-bin histogram, the bins are stored in caller provided array
+ * Bin i counts the samples in [lo + i * width, lo + (i + 1) * width)
+ */
+typedef struct {
+    dsp_val_t lo;               // lower limit of the first bin
+    dsp_val_t hi;               // upper limit of the last bin
+    dsp_val_t width;            // bin width
+    dsp_size_t n_bins;          // number of bins
+    dsp_size_t *bins;           // bin counters
+    dsp_size_t underflow;       // samples below lo
+    dsp_size_t overflow;        // samples at or above hi
+    dsp_size_t count;           // number of all samples
+} dsp_hist_t;
+
+
+/**
+ * @brief Initialize quantile accumulator
+ *
+ * @param acc accumulator
+ * @param compression accuracy parameter, larger is more accurate, 0: DSP_QUANTILE_DEF_COMPRESSION
+ *                    limited to DSP_QUANTILE_MAX_CENTROIDS / 2
+ */
+void dsp_quantile_acc_init(dsp_quantile_acc_t *acc, dsp_val_t compression);
+
+
+/**
+ * @brief Update quantile accumulator with a block of samples
+ * The samples are buffered, the buffer is compressed into the centroids when it is full.
+ * Amortized cost per sample: O(log(DSP_QUANTILE_MAX_CENTROIDS + DSP_QUANTILE_BUF_LEN))
+ *
+ * @param acc accumulator
+ * @param sig signal block
+ * @param len length of block
+ */
+void dsp_quantile_acc_update(dsp_quantile_acc_t *acc, dsp_val_t *sig, dsp_size_t len);
+
+
+/**
+ * @brief Merge quantile accumulator of other samples into the accumulator
+ *
+ * @param acc accumulator, updated
+ * @param other accumulator to merge, not modified
+ */
+void dsp_quantile_acc_merge(dsp_quantile_acc_t *acc, dsp_quantile_acc_t *other);
+
+
+/**
+ * @brief Estimate quantiles of the accumulated samples
+ * Linear interpolation between the centroid means, min and max are exact.
+ * The buffer is compressed, the accumulator can be updated further.
+ *
+ * @param acc accumulator
+ * @param quantiles quantiles to estimate, in [0, 1], e.g. 0.5 for the median
+ * @param output estimated values, 0 if the accumulator is empty
+ * @param n number of quantiles
+ */
+void dsp_quantile_acc_finalize(dsp_quantile_acc_t *acc, dsp_val_t *quantiles, dsp_val_t *output, dsp_size_t n);
+
+
+/**
+ * @brief Initialize histogram
+ *
+ * @param hist histogram
+ * @param bins bin counter array, n_bins elements, it is zeroed
+ * @param n_bins number of bins
+ * @param lo lower limit of the first bin
+ * @param hi upper limit of the last bin, greater than lo
+ */
+void dsp_hist_init(dsp_hist_t *hist, dsp_size_t *bins, dsp_size_t n_bins, dsp_val_t lo, dsp_val_t hi);
+
+
+/**
+ * @brief Update histogram with a block of samples
+ *
+ * @param hist histogram
+ * @param sig signal block
+ * @param len length of block
+ */
+void dsp_hist_update(dsp_hist_t *hist, dsp_val_t *sig, dsp_size_t len);
+
+
+/**
+ * @brief Merge histogram of other samples into the histogram
+ * Both histograms must have the same limits and number of bins, otherwise nothing happens.
+ *
+ * @param hist histogram, updated
+ * @param other histogram to merge, not modified
+ */
+void dsp_hist_merge(dsp_hist_t *hist, dsp_hist_t *other);
+
+
+/**
+ * @brief Estimate quantiles from the histogram
+ * Linear interpolation inside the bins, the samples out of range are
+ * counted at the limits. Error is at most one bin width inside the range.
+ *
+ * @param hist histogram
+ * @param quantiles quantiles to estimate, in [0, 1]
+ * @param output estimated values, 0 if the histogram is empty
+ * @param n number of quantiles
+ */
+void dsp_hist_finalize(dsp_hist_t *hist, dsp_val_t *quantiles, dsp_val_t *output, dsp_size_t n);
+
+
+#endif
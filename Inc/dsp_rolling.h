@@ -0,0 +1,109 @@
+/**
+ * @file dsp_rolling.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP rolling window statistic
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#ifndef __DSP_ROLLING_H__
+#define __DSP_ROLLING_H__
+
+#include "dsp_common.h"
+#include "dsp_stat.h"
+
+
+/**
+ * @brief Rolling window statistic
+ * Mean and variance from running sums of the samples shifted by a reference value,
+ * the sums are recalculated from the window at every resync period to stop the drift.
+ * Min and max from monotonic deques of sample indexes.
+ * Every per-sample cost is O(1) amortized, independent of the window length.
+ */
+typedef struct {
+    dsp_size_t win_len;         // window length
+    dsp_size_t resync_period;   // samples between exact recalculation of the sums
+    dsp_size_t resync_cnt;      // samples since the last recalculation
+    dsp_size_t sample_cnt;      // number of pushed samples
+    dsp_val_t *window;          // circular buffer of the last win_len samples
+    dsp_val_t shift;            // reference value of the sums
+    dsp_val_t sum;              // sum(xi - shift) in the window
+    dsp_val_t sum_sq;           // sum(pow(xi - shift, 2)) in the window
+    dsp_size_t *min_deque;      // sample indexes with increasing values, circular
+    dsp_size_t min_head;        // first element of min deque
+    dsp_size_t min_cnt;         // number of elements in min deque
+    dsp_size_t *max_deque;      // sample indexes with decreasing values, circular
+    dsp_size_t max_head;        // first element of max deque
+    dsp_size_t max_cnt;         // number of elements in max deque
+} dsp_rolling_t;
+
+
+/**
+ * @brief Create rolling window statistic
+ *
+ * @param win_len window length
+ * @param resync_period samples between exact recalculation of the running sums, 0: window length
+ * @return dsp_rolling_t* created object, NULL if the window length is 0 or the allocation failed
+ */
+dsp_rolling_t *dsp_rolling_create(dsp_size_t win_len, dsp_size_t resync_period);
+
+
+/**
+ * @brief Destroy rolling window statistic
+ *
+ * @param rs object created by dsp_rolling_create, can be NULL
+ */
+void dsp_rolling_destroy(dsp_rolling_t *rs);
+
+
+/**
+ * @brief Reset rolling window statistic, the window becomes empty
+ *
+ * @param rs rolling window statistic
+ */
+void dsp_rolling_reset(dsp_rolling_t *rs);
+
+
+/**
+ * @brief Push new sample into the window, the oldest sample leaves if the window is full
+ *
+ * @param rs rolling window statistic
+ * @param sample new sample
+ */
+void dsp_rolling_push(dsp_rolling_t *rs, dsp_val_t sample);
+
+
+/**
+ * @brief Get statistic of the current window
+ * Until the window is full, the statistic of the pushed samples.
+ * mean = shift + S1 / N
+ * variance = (S2 - pow(S1, 2) / N) / (N - 1)
+ * skewness and kurtosis are not calculated (0).
+ *
+ * @param rs rolling window statistic
+ * @param stats output statistics, all zero if the window is empty
+ */
+void dsp_rolling_get(dsp_rolling_t *rs, dsp_sig_stats_t *stats);
+
+
+/**
+ * @brief Push every input sample and store the statistic after each of them
+ * The output arrays are input_sig_len long, any of them can be NULL.
+ *
+ * @param rs rolling window statistic
+ * @param mean_out rolling mean output array
+ * @param variance_out rolling variance output array
+ * @param min_out rolling min output array
+ * @param max_out rolling max output array
+ * @param input_sig input signal
+ * @param input_sig_len length of input signal
+ */
+void dsp_rolling_process(dsp_rolling_t *rs, dsp_val_t *mean_out, dsp_val_t *variance_out,
+                         dsp_val_t *min_out, dsp_val_t *max_out,
+                         dsp_val_t *input_sig, dsp_size_t input_sig_len);
+
+
+#endif
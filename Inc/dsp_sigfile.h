@@ -0,0 +1,200 @@
+/**
+ * @file dsp_sigfile.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP binary signal file: header + raw interleaved samples, memory mapped reader
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * File layout (native byte order, the reader rejects foreign byte order):
+ *
+ *  offset  size  field
+ *  0       4     magic "DSIG"
+ *  4       4     byte order mark 0x01020304
+ *  8       2     version
+ *  10      2     sample type (dsp_sigfile_dtype_t)
+ *  12      4     channels
+ *  16      8     sample rate in Hz (double), 0 if unknown
+ *  24      8     length: samples per channel
+ *  32      32    reserved, 0
+ *  64            samples, channels are interleaved: s[0][0], s[0][1], ... s[1][0], ...
+ *
+ * The header is DSP_SIGFILE_HEADER_SIZE (64) bytes long, so the samples of an opened file
+ * are aligned like dsp_buf_alloc buffers. On POSIX systems the reader maps the file,
+ * the samples are not copied and pages are loaded on first access, so opening a multi-GB
+ * recording is instant. Elsewhere the file is read into a dsp_buf_alloc_elem buffer.
+ */
+
+#ifndef __DSP_SIGFILE_H__
+#define __DSP_SIGFILE_H__
+
+#include <stdio.h>
+#include "dsp_common.h"
+#include "dsp_fixed.h"
+
+
+#define DSP_SIGFILE_MAGIC           "DSIG"
+#define DSP_SIGFILE_BOM             0x01020304UL
+#define DSP_SIGFILE_VERSION         1
+#define DSP_SIGFILE_HEADER_SIZE     64
+
+
+/**
+ * @brief Sample type of the file
+ *
+ */
+typedef enum {
+    DSP_SIGFILE_F32 = 1,        // dsp_f32_t
+    DSP_SIGFILE_F64 = 2,        // dsp_f64_t, dsp_val_t
+    DSP_SIGFILE_Q15 = 3,        // dsp_q15_t
+    DSP_SIGFILE_Q31 = 4         // dsp_q31_t
+} dsp_sigfile_dtype_t;
+
+
+/**
+ * @brief Opened signal file
+ * data points into the mapping, it is valid until dsp_sigfile_close.
+ */
+typedef struct {
+    dsp_sigfile_dtype_t dtype;  // sample type
+    dsp_size_t channels;        // number of channels
+    dsp_val_t sample_rate;      // sample rate in Hz, 0 if unknown
+    dsp_size_t len;             // samples per channel
+    void *data;                 // first sample
+    void *map;                  // mapping (or buffer) of the whole file
+    dsp_size_t map_len;         // length of the mapping in bytes
+} dsp_sigfile_t;
+
+
+/**
+ * @brief Signal file writer
+ * The length in the header is written by dsp_sigfile_writer_close.
+ */
+typedef struct {
+    FILE *fd;                   // output file
+    dsp_sigfile_dtype_t dtype;  // sample type
+    dsp_size_t channels;        // number of channels
+    dsp_val_t sample_rate;      // sample rate in Hz
+    dsp_size_t len;             // written samples per channel
+} dsp_sigfile_writer_t;
+
+
+/**
+ * @brief Size of one sample of the type in bytes
+ *
+ * @param dtype sample type
+ * @return dsp_size_t sample size, 0 for invalid type
+ */
+dsp_size_t dsp_sigfile_dtype_size(dsp_sigfile_dtype_t dtype);
+
+
+/**
+ * @brief Open and map signal file
+ *
+ * @param path file path
+ * @return dsp_sigfile_t* opened file, NULL if it can not be opened or the header is invalid
+ */
+dsp_sigfile_t *dsp_sigfile_open(char *path);
+
+
+/**
+ * @brief Unmap and close signal file
+ *
+ * @param sf file opened by dsp_sigfile_open, can be NULL
+ */
+void dsp_sigfile_close(dsp_sigfile_t *sf);
+
+
+/**
+ * @brief Zero-copy view of the samples of a DSP_SIGFILE_F64 file
+ * Channels are interleaved, sample i of channel c: view[i * channels + c]
+ *
+ * @param sf opened file
+ * @return dsp_val_t* samples, NULL if the sample type is not DSP_SIGFILE_F64
+ */
+dsp_val_t *dsp_sigfile_view(dsp_sigfile_t *sf);
+
+
+/**
+ * @brief Zero-copy view of the samples of a DSP_SIGFILE_F32 file
+ *
+ * @param sf opened file
+ * @return dsp_f32_t* samples, NULL if the sample type is not DSP_SIGFILE_F32
+ */
+dsp_f32_t *dsp_sigfile_view_f32(dsp_sigfile_t *sf);
+
+
+/**
+ * @brief Copy samples of one channel converted to dsp_val_t
+ * Q15 and Q31 samples are converted to the [-1, 1) range.
+ *
+ * @param sf opened file
+ * @param dest destination array, len long
+ * @param channel channel index
+ * @param start first sample
+ * @param len number of samples
+ * @return dsp_size_t number of copied samples, less than len at the end of the file
+ */
+dsp_size_t dsp_sigfile_read(dsp_sigfile_t *sf, dsp_val_t *dest, dsp_size_t channel, dsp_size_t start, dsp_size_t len);
+
+
+/**
+ * @brief Drop the loaded pages of a processed sample range from the memory
+ * Streaming readers call it after every chunk, so a large file does not stay resident.
+ * The range can be read again, the pages are reloaded from the file. No effect without mapping.
+ *
+ * @param sf opened file
+ * @param start first sample
+ * @param len number of samples
+ */
+void dsp_sigfile_release(dsp_sigfile_t *sf, dsp_size_t start, dsp_size_t len);
+
+
+/**
+ * @brief Write whole signal into a DSP_SIGFILE_F64 file
+ *
+ * @param path file path
+ * @param sig interleaved samples, len * channels long
+ * @param len samples per channel
+ * @param channels number of channels
+ * @param sample_rate sample rate in Hz, 0 if unknown
+ * @return int 0 on success, -1 on error
+ */
+int dsp_sigfile_write(char *path, dsp_val_t *sig, dsp_size_t len, dsp_size_t channels, dsp_val_t sample_rate);
+
+
+/**
+ * @brief Create signal file for appending
+ *
+ * @param path file path
+ * @param dtype sample type
+ * @param channels number of channels
+ * @param sample_rate sample rate in Hz, 0 if unknown
+ * @return dsp_sigfile_writer_t* writer, NULL if the file can not be created or the parameters are invalid
+ */
+dsp_sigfile_writer_t *dsp_sigfile_writer_open(char *path, dsp_sigfile_dtype_t dtype, dsp_size_t channels,
+                                              dsp_val_t sample_rate);
+
+
+/**
+ * @brief Append interleaved samples
+ *
+ * @param wr writer
+ * @param samples samples of the writer type, len * channels long
+ * @param len samples per channel
+ * @return int 0 on success, -1 on write error
+ */
+int dsp_sigfile_writer_append(dsp_sigfile_writer_t *wr, void *samples, dsp_size_t len);
+
+
+/**
+ * @brief Write the final header and close the file
+ *
+ * @param wr writer, can be NULL
+ * @return int 0 on success, -1 on write error
+ */
+int dsp_sigfile_writer_close(dsp_sigfile_writer_t *wr);
+
+
+#endif
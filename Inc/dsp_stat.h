@@ -13,6 +13,105 @@
 #define __DSP_STAT_H__
 
 #include "dsp_common.h"
+#include "dsp_workspace.h"
+#include "dsp_exec.h"
+
+
+/**
+ * @brief Samples per chunk of the multithreaded statistic
+ * The chunks and their merge order are fixed, the result does not depend on the thread count.
+ */
+#ifndef DSP_STAT_CHUNK_LEN
+    #define DSP_STAT_CHUNK_LEN      (65536UL)
+#endif
+
+
+/**
+ * @brief Signal statistic results of one pass calculation
+ * skewness and kurtosis are calculated only by the accumulator with 4 moments, otherwise 0
+ */
+typedef struct {
+    dsp_f32_t mean;             // mean value
+    dsp_f32_t variance;         // variance, 1/(N-1) normalized
+    dsp_f32_t std_dev;          // standard deviation
+    dsp_f32_t rms;              // root mean square, sqrt(1/N * sum(pow(xi, 2)))
+    dsp_f32_t min;              // minimum value
+    dsp_f32_t max;              // maximum value
+    dsp_f32_t skewness;         // sqrt(N) * M3 / pow(M2, 1.5)
+    dsp_f32_t kurtosis;         // excess kurtosis, N * M4 / pow(M2, 2) - 3
+} dsp_sig_stats_f32_t;
+
+typedef struct {
+    dsp_f64_t mean;             // mean value
+    dsp_f64_t variance;         // variance, 1/(N-1) normalized
+    dsp_f64_t std_dev;          // standard deviation
+    dsp_f64_t rms;              // root mean square, sqrt(1/N * sum(pow(xi, 2)))
+    dsp_f64_t min;              // minimum value
+    dsp_f64_t max;              // maximum value
+    dsp_f64_t skewness;         // sqrt(N) * M3 / pow(M2, 1.5)
+    dsp_f64_t kurtosis;         // excess kurtosis, N * M4 / pow(M2, 2) - 3
+} dsp_sig_stats_f64_t;
+
+typedef dsp_sig_stats_f64_t dsp_sig_stats_t;
+
+
+/**
+ * @brief Mergeable statistic accumulator
+ * Central moment sums of the samples seen so far. Accumulators of independent
+ * chunks (threads, files) can be merged in O(1), the result is the same as the
+ * statistic of the concatenated data.
+ */
+typedef struct {
+    dsp_size_t count;           // number of samples
+    int moments;                // highest calculated moment, 2 or 4
+    dsp_f32_t mean;             // mean value
+    dsp_f32_t m2;               // sum(pow(xi-u, 2))
+    dsp_f32_t m3;               // sum(pow(xi-u, 3)), only with 4 moments
+    dsp_f32_t m4;               // sum(pow(xi-u, 4)), only with 4 moments
+    dsp_f32_t min;              // minimum value
+    dsp_f32_t max;              // maximum value
+} dsp_stat_acc_f32_t;
+
+typedef struct {
+    dsp_size_t count;           // number of samples
+    int moments;                // highest calculated moment, 2 or 4
+    dsp_f64_t mean;             // mean value
+    dsp_f64_t m2;               // sum(pow(xi-u, 2))
+    dsp_f64_t m3;               // sum(pow(xi-u, 3)), only with 4 moments
+    dsp_f64_t m4;               // sum(pow(xi-u, 4)), only with 4 moments
+    dsp_f64_t min;              // minimum value
+    dsp_f64_t max;              // maximum value
+} dsp_stat_acc_f64_t;
+
+typedef dsp_stat_acc_f64_t dsp_stat_acc_t;
+
+
+/**
+ * @brief Signal metrics of one frame
+ * snr_db is 0, if neither reference nor noise power is given.
+ */
+typedef struct {
+    dsp_f32_t mean;             // mean value
+    dsp_f32_t variance;         // variance, 1/(N-1) normalized
+    dsp_f32_t rms;              // root mean square
+    dsp_f32_t peak;             // maximum of abs(xi)
+    dsp_f32_t crest_factor;     // peak / rms
+    dsp_size_t zero_crossings;  // number of sign changes between neighbour samples
+    dsp_f32_t snr_db;           // signal to noise ratio in dB
+} dsp_sig_metrics_f32_t;
+
+typedef struct {
+    dsp_f64_t mean;             // mean value
+    dsp_f64_t variance;         // variance, 1/(N-1) normalized
+    dsp_f64_t rms;              // root mean square
+    dsp_f64_t peak;             // maximum of abs(xi)
+    dsp_f64_t crest_factor;     // peak / rms
+    dsp_size_t zero_crossings;  // number of sign changes between neighbour samples
+    dsp_f64_t snr_db;           // signal to noise ratio in dB
+} dsp_sig_metrics_f64_t;
+
+typedef dsp_sig_metrics_f64_t dsp_sig_metrics_t;
+
 
 /**
  * @brief Signal mean calculation
@@ -45,5 +144,168 @@ dsp_val_t dsp_sig_variance(dsp_val_t *sig, dsp_val_t sig_mean, dsp_size_t len);
 dsp_val_t dsp_sig_std_dev(dsp_val_t sig_variance);
 
 
+/**
+ * @brief Signal mean, variance and standard deviation in one pass
+ * The signal is read only once. Every lane updates its own Welford accumulator
+ * on the interleaved samples (independent dependency chains, vectorizable),
+ * the lanes are merged at the end:
+ * mean(k) = mean(k-1) + (xk - mean(k-1)) / k
+ * M2(k) = M2(k-1) + (xk - mean(k-1)) * (xk - mean(k))
+ * The variance is zero, if the signal is shorter than 2 samples.
+ * @param sig signal array
+ * @param len length of signal
+ * @param stats output statistics (mean, variance, std_dev, rms, min, max)
+ */
+void dsp_sig_stats(dsp_val_t *sig, dsp_size_t len, dsp_sig_stats_t *stats);
+
+
+/**
+ * @brief Signal statistic calculated by more threads, for large arrays
+ * The signal is split into DSP_STAT_CHUNK_LEN long chunks, each chunk is reduced
+ * with the lane-wise Welford update, and the chunk accumulators are merged in chunk order.
+ * The chunks are the tasks of a temporary execution context (see dsp_exec.h).
+ * The result is the same bit by bit for every thread count.
+ * Threads are used only if the library is built with DSP_USE_PTHREAD, otherwise
+ * the chunks are calculated serially.
+ * @param sig signal array
+ * @param len length of signal
+ * @param stats output statistics (mean, variance, std_dev, rms, min, max)
+ * @param n_threads number of threads including the caller, <= 1: serial
+ */
+void dsp_sig_stats_mt(dsp_val_t *sig, dsp_size_t len, dsp_sig_stats_t *stats, int n_threads);
+
+
+/**
+ * @brief Signal statistic calculated by more threads, chunk accumulators from workspace
+ * Same as dsp_sig_stats_mt. If the workspace is NULL the accumulators are allocated,
+ * if it is too small the chunks are calculated serially (same result).
+ * @param sig signal array
+ * @param len length of signal
+ * @param stats output statistics (mean, variance, std_dev, rms, min, max)
+ * @param n_threads number of threads including the caller, <= 1: serial
+ * @param ws workspace, the used buffer is released before return
+ */
+void dsp_sig_stats_mt_ws(dsp_val_t *sig, dsp_size_t len, dsp_sig_stats_t *stats, int n_threads,
+                         dsp_workspace_t *ws);
+
+
+/**
+ * @brief Signal statistic calculated by the threads of an execution context
+ * Same chunks and merge order as dsp_sig_stats_mt, so the same result, without starting
+ * threads per call.
+ * @param sig signal array
+ * @param len length of signal
+ * @param stats output statistics (mean, variance, std_dev, rms, min, max)
+ * @param ctx execution context, NULL: serial
+ * @param ws workspace of the chunk accumulators, NULL: allocated, the used buffer is released before return
+ */
+void dsp_sig_stats_exec(dsp_val_t *sig, dsp_size_t len, dsp_sig_stats_t *stats, dsp_exec_ctx_t *ctx,
+                        dsp_workspace_t *ws);
+
+
+/**
+ * @brief Workspace bytes of dsp_sig_stats_mt_ws and dsp_sig_stats_exec
+ * @param len length of signal
+ * @return dsp_size_t workspace bytes
+ */
+dsp_size_t dsp_sig_stats_mt_workspace_size(dsp_size_t len);
+
+
+/**
+ * @brief Signal metrics in one pass
+ * Mean, variance, RMS, peak, crest factor and zero crossings are calculated from
+ * one read of the signal, in lanes like dsp_sig_stats. Optional SNR estimation:
+ * with reference:      SNR = 10 * log10(sum(pow(ri, 2)) / sum(pow(xi - ri, 2)))
+ * with noise power:    SNR = 10 * log10((pow(rms, 2) - Pn) / Pn), -INFINITY if pow(rms, 2) <= Pn
+ * A zero crossing is counted, when the sign of two neighbour samples differs (0 is positive).
+ * @param sig signal array
+ * @param len length of signal
+ * @param ref clean reference signal, same length, NULL if not used
+ * @param noise_power noise power (e.g. measured in a noise band), used if ref is NULL and it is > 0
+ * @param metrics output metrics
+ */
+void dsp_sig_metrics(dsp_val_t *sig, dsp_size_t len, dsp_val_t *ref, dsp_val_t noise_power,
+                     dsp_sig_metrics_t *metrics);
+
+
+/**
+ * @brief Initialize statistic accumulator
+ * @param acc accumulator
+ * @param moments 2: mean, variance, min and max, 4: skewness and kurtosis also
+ */
+void dsp_stat_acc_init(dsp_stat_acc_t *acc, int moments);
+
+
+/**
+ * @brief Update statistic accumulator with a block of samples
+ * With 2 moments the block is calculated in lanes and merged, with 4 moments
+ * every sample is added one by one.
+ * @param acc accumulator
+ * @param sig signal block
+ * @param len length of block
+ */
+void dsp_stat_acc_update(dsp_stat_acc_t *acc, dsp_val_t *sig, dsp_size_t len);
+
+
+/**
+ * @brief Merge accumulator of other samples into the accumulator (Chan's combining formulas)
+ * n = na + nb, delta = mean_b - mean_a
+ * mean = mean_a + delta * nb / n
+ * M2 = M2a + M2b + pow(delta, 2) * na * nb / n
+ * The higher moments are kept only if both accumulators have 4 moments.
+ * @param acc accumulator, updated
+ * @param other accumulator to merge, not modified
+ */
+void dsp_stat_acc_merge(dsp_stat_acc_t *acc, dsp_stat_acc_t *other);
+
+
+/**
+ * @brief Calculate the statistic of the accumulated samples
+ * The accumulator is not modified, it can be updated further.
+ * @param acc accumulator
+ * @param stats output statistics
+ */
+void dsp_stat_acc_finalize(dsp_stat_acc_t *acc, dsp_sig_stats_t *stats);
+
+
+/**
+ * @brief Single and double precision variants
+ * Same calculations as the dsp_val_t functions, the precision is selected per call.
+ */
+dsp_f32_t dsp_sig_mean_f32(dsp_f32_t *sig, dsp_size_t len);
+dsp_f32_t dsp_sig_variance_f32(dsp_f32_t *sig, dsp_f32_t sig_mean, dsp_size_t len);
+dsp_f32_t dsp_sig_std_dev_f32(dsp_f32_t sig_variance);
+void dsp_sig_stats_f32(dsp_f32_t *sig, dsp_size_t len, dsp_sig_stats_f32_t *stats);
+void dsp_sig_stats_mt_f32(dsp_f32_t *sig, dsp_size_t len, dsp_sig_stats_f32_t *stats, int n_threads);
+void dsp_sig_stats_mt_ws_f32(dsp_f32_t *sig, dsp_size_t len, dsp_sig_stats_f32_t *stats, int n_threads,
+                             dsp_workspace_t *ws);
+void dsp_sig_stats_exec_f32(dsp_f32_t *sig, dsp_size_t len, dsp_sig_stats_f32_t *stats, dsp_exec_ctx_t *ctx,
+                            dsp_workspace_t *ws);
+dsp_size_t dsp_sig_stats_mt_workspace_size_f32(dsp_size_t len);
+void dsp_sig_metrics_f32(dsp_f32_t *sig, dsp_size_t len, dsp_f32_t *ref, dsp_f32_t noise_power,
+                         dsp_sig_metrics_f32_t *metrics);
+void dsp_stat_acc_init_f32(dsp_stat_acc_f32_t *acc, int moments);
+void dsp_stat_acc_update_f32(dsp_stat_acc_f32_t *acc, dsp_f32_t *sig, dsp_size_t len);
+void dsp_stat_acc_merge_f32(dsp_stat_acc_f32_t *acc, dsp_stat_acc_f32_t *other);
+void dsp_stat_acc_finalize_f32(dsp_stat_acc_f32_t *acc, dsp_sig_stats_f32_t *stats);
+
+dsp_f64_t dsp_sig_mean_f64(dsp_f64_t *sig, dsp_size_t len);
+dsp_f64_t dsp_sig_variance_f64(dsp_f64_t *sig, dsp_f64_t sig_mean, dsp_size_t len);
+dsp_f64_t dsp_sig_std_dev_f64(dsp_f64_t sig_variance);
+void dsp_sig_stats_f64(dsp_f64_t *sig, dsp_size_t len, dsp_sig_stats_f64_t *stats);
+void dsp_sig_stats_mt_f64(dsp_f64_t *sig, dsp_size_t len, dsp_sig_stats_f64_t *stats, int n_threads);
+void dsp_sig_stats_mt_ws_f64(dsp_f64_t *sig, dsp_size_t len, dsp_sig_stats_f64_t *stats, int n_threads,
+                             dsp_workspace_t *ws);
+void dsp_sig_stats_exec_f64(dsp_f64_t *sig, dsp_size_t len, dsp_sig_stats_f64_t *stats, dsp_exec_ctx_t *ctx,
+                            dsp_workspace_t *ws);
+dsp_size_t dsp_sig_stats_mt_workspace_size_f64(dsp_size_t len);
+void dsp_sig_metrics_f64(dsp_f64_t *sig, dsp_size_t len, dsp_f64_t *ref, dsp_f64_t noise_power,
+                         dsp_sig_metrics_f64_t *metrics);
+void dsp_stat_acc_init_f64(dsp_stat_acc_f64_t *acc, int moments);
+void dsp_stat_acc_update_f64(dsp_stat_acc_f64_t *acc, dsp_f64_t *sig, dsp_size_t len);
+void dsp_stat_acc_merge_f64(dsp_stat_acc_f64_t *acc, dsp_stat_acc_f64_t *other);
+void dsp_stat_acc_finalize_f64(dsp_stat_acc_f64_t *acc, dsp_sig_stats_f64_t *stats);
+
+
 #endif
 
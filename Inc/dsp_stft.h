@@ -0,0 +1,221 @@
+/**
+ * @file dsp_stft.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP short-time Fourier transform with overlapped windows, inverse by weighted overlap-add
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * Frame f starts at sample f * hop, it is multiplied by the window, zero padded to the
+ * FFT length (next power of two) and transformed. One frame gives bins = fft_len / 2 + 1
+ * frequency bins (DC ... Nyquist), the bin width is sample rate / fft_len.
+ * The frames are rows of the caller's matrices: bin k of frame f is dest[f * bins + k].
+ *
+ * Every buffer (plan, window, work arrays, stream history) is allocated once at creation,
+ * from one workspace, the transform functions do not allocate.
+ */
+
+#ifndef __DSP_STFT_H__
+#define __DSP_STFT_H__
+
+#include "dsp_common.h"
+#include "dsp_fft.h"
+#include "dsp_workspace.h"
+
+
+/*Overlap-add weight below which the output sample is 0 (window zeros are not divided)*/
+#ifndef DSP_STFT_NORM_EPS
+    #define DSP_STFT_NORM_EPS   1e-10
+#endif
+
+
+/**
+ * @brief STFT object
+ * The work arrays and the stream state are modified by the transforms, one object
+ * must not be used from more threads at the same time.
+ */
+typedef struct {
+    dsp_size_t frame_len;       // samples per frame
+    dsp_size_t hop;             // samples between the frame starts
+    dsp_size_t fft_len;         // transform length, power of two >= frame_len
+    dsp_size_t bins;            // bins per frame: fft_len / 2 + 1
+    dsp_val_t *window;          // analysis and synthesis window, frame_len long
+    dsp_fft_plan_t *plan;       // FFT plan of fft_len
+    dsp_val_t *work_rex;        // FFT work array real part
+    dsp_val_t *work_imx;        // FFT work array imaginary part
+    dsp_val_t *spec;            // spectrum scratch of two frames, 4 * bins long
+    dsp_val_t *hist;            // push: samples of the next frame, frame_len long
+    dsp_size_t hist_fill;       // push: samples in hist
+    dsp_size_t hist_skip;       // push: samples to drop before the next frame (hop > frame_len)
+    dsp_val_t *ola;             // inverse: overlap-add accumulator, frame_len long
+    dsp_size_t ola_frames;      // inverse: pushed frames
+    dsp_workspace_t *own_ws;    // workspace created by dsp_stft_create, NULL for caller workspace
+} dsp_stft_t;
+
+
+/**
+ * @brief Workspace bytes of an STFT object created by dsp_stft_create_ws
+ *
+ * @param frame_len samples per frame
+ * @return dsp_size_t workspace bytes
+ */
+dsp_size_t dsp_stft_workspace_size(dsp_size_t frame_len);
+
+
+/**
+ * @brief Create STFT object
+ *
+ * @param frame_len samples per frame, >= 2
+ * @param hop samples between the frame starts, >= 1
+ * @param window_calc window function (dsp_hamming_window, dsp_blackman_window, ...), NULL: Hamming
+ * @return dsp_stft_t* created object, NULL if the parameters are invalid or the allocation failed
+ */
+dsp_stft_t *dsp_stft_create(dsp_size_t frame_len, dsp_size_t hop, dsp_val_t (*window_calc)(int, dsp_size_t));
+
+
+/**
+ * @brief Create STFT object in workspace
+ * The object lives until the workspace is released, it must not be destroyed.
+ *
+ * @param frame_len samples per frame, >= 2
+ * @param hop samples between the frame starts, >= 1
+ * @param window_calc window function, NULL: Hamming
+ * @param ws workspace, at least dsp_stft_workspace_size(frame_len) bytes free
+ * @return dsp_stft_t* created object, NULL if the parameters are invalid or the workspace is full
+ */
+dsp_stft_t *dsp_stft_create_ws(dsp_size_t frame_len, dsp_size_t hop, dsp_val_t (*window_calc)(int, dsp_size_t),
+                               dsp_workspace_t *ws);
+
+
+/**
+ * @brief Destroy STFT object created by dsp_stft_create
+ *
+ * @param stft object, can be NULL
+ */
+void dsp_stft_destroy(dsp_stft_t *stft);
+
+
+/**
+ * @brief Clear the stream state of dsp_stft_push and dsp_istft_push
+ *
+ * @param stft STFT object
+ */
+void dsp_stft_reset(dsp_stft_t *stft);
+
+
+/**
+ * @brief Number of complete frames in a signal
+ *
+ * @param stft STFT object
+ * @param sig_len signal length
+ * @return dsp_size_t (sig_len - frame_len) / hop + 1, 0 if the signal is shorter than a frame
+ */
+dsp_size_t dsp_stft_frames(dsp_stft_t *stft, dsp_size_t sig_len);
+
+
+/**
+ * @brief Short-time Fourier transform of the whole signal
+ * Two real frames are transformed together as real and imaginary part.
+ *
+ * @param stft STFT object
+ * @param dest_rex real part matrix, dsp_stft_frames(sig_len) * bins long
+ * @param dest_imx imaginary part matrix, dsp_stft_frames(sig_len) * bins long
+ * @param input_sig input signal
+ * @param input_sig_len input signal length
+ * @return dsp_size_t number of frames
+ */
+dsp_size_t dsp_stft(dsp_stft_t *stft, dsp_val_t *dest_rex, dsp_val_t *dest_imx,
+                    dsp_val_t *input_sig, dsp_size_t input_sig_len);
+
+
+/**
+ * @brief Magnitude spectrogram of the whole signal
+ *
+ * @param stft STFT object
+ * @param dest_mag magnitude matrix, dsp_stft_frames(sig_len) * bins long
+ * @param input_sig input signal
+ * @param input_sig_len input signal length
+ * @return dsp_size_t number of frames
+ */
+dsp_size_t dsp_spectrogram(dsp_stft_t *stft, dsp_val_t *dest_mag, dsp_val_t *input_sig, dsp_size_t input_sig_len);
+
+
+/**
+ * @brief Number of frames completed by the next dsp_stft_push call
+ *
+ * @param stft STFT object
+ * @param input_sig_len length of the next pushed block
+ * @return dsp_size_t number of frames
+ */
+dsp_size_t dsp_stft_push_frames(dsp_stft_t *stft, dsp_size_t input_sig_len);
+
+
+/**
+ * @brief Push the next block of a stream, the completed frames are transformed
+ * The concatenated output of the pushes matches dsp_stft of the concatenated blocks up to
+ * rounding: two frames share one complex FFT only within a push, so a frame can have another
+ * pair than in dsp_stft, the difference is a few ulps of the largest bin magnitude.
+ *
+ * @param stft STFT object
+ * @param dest_rex real part matrix, dsp_stft_push_frames(input_sig_len) * bins long
+ * @param dest_imx imaginary part matrix, dsp_stft_push_frames(input_sig_len) * bins long
+ * @param input_sig input block
+ * @param input_sig_len input block length
+ * @return dsp_size_t number of completed frames
+ */
+dsp_size_t dsp_stft_push(dsp_stft_t *stft, dsp_val_t *dest_rex, dsp_val_t *dest_imx,
+                         dsp_val_t *input_sig, dsp_size_t input_sig_len);
+
+
+/**
+ * @brief Length of the signal resynthesized from n_frames frames
+ *
+ * @param stft STFT object
+ * @param n_frames number of frames
+ * @return dsp_size_t (n_frames - 1) * hop + frame_len, 0 for no frame
+ */
+dsp_size_t dsp_istft_len(dsp_stft_t *stft, dsp_size_t n_frames);
+
+
+/**
+ * @brief Inverse STFT by weighted overlap-add
+ * Every frame is inverse transformed, multiplied by the window and added at f * hop.
+ * Sample n is divided by sum(pow(w[n - f * hop], 2)) of the frames covering it,
+ * so the transform of dsp_stft is inverted exactly where the sum is not zero.
+ * Samples covered by no frame or only by window zeros are 0.
+ *
+ * @param stft STFT object, its inverse stream state is reset
+ * @param dest_sig output signal, dsp_istft_len(n_frames) long
+ * @param rex real part matrix
+ * @param imx imaginary part matrix
+ * @param n_frames number of frames
+ * @return dsp_size_t output length
+ */
+dsp_size_t dsp_istft(dsp_stft_t *stft, dsp_val_t *dest_sig, dsp_val_t *rex, dsp_val_t *imx, dsp_size_t n_frames);
+
+
+/**
+ * @brief Push the next frame of an inverse stream
+ * The hop samples before the start of the next frame are completed.
+ *
+ * @param stft STFT object
+ * @param dest_sig output, hop long
+ * @param rex real part of the frame, bins long
+ * @param imx imaginary part of the frame, bins long
+ * @return dsp_size_t hop
+ */
+dsp_size_t dsp_istft_push(dsp_stft_t *stft, dsp_val_t *dest_sig, dsp_val_t *rex, dsp_val_t *imx);
+
+
+/**
+ * @brief Output the rest of the last frame of an inverse stream and reset the inverse state
+ *
+ * @param stft STFT object
+ * @param dest_sig output, frame_len - hop long
+ * @return dsp_size_t number of samples: frame_len - hop, 0 if hop >= frame_len or no frame was pushed
+ */
+dsp_size_t dsp_istft_flush(dsp_stft_t *stft, dsp_val_t *dest_sig);
+
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file dsp_workspace.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP workspace: caller owned scratch memory with bump allocation
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The workspace is created once with the size reported by the *_workspace_size functions.
+ * The *_ws functions take their scratch buffers from it and give them back before returning,
+ * so the steady state has no malloc / free. Buffers of the caller can be allocated too,
+ * dsp_workspace_reset frees everything at once (e.g. at the end of a frame).
+ */
+
+#ifndef __DSP_WORKSPACE_H__
+#define __DSP_WORKSPACE_H__
+
+#include "dsp_common.h"
+#include "dsp_buf.h"
+
+
+/*Alignment of every workspace allocation in bytes, same as the aligned buffers*/
+#define DSP_WORKSPACE_ALIGN             DSP_BUF_ALIGN
+
+/*Workspace bytes of one allocation*/
+#define DSP_WORKSPACE_ROUND(bytes)      (((bytes) + DSP_WORKSPACE_ALIGN - 1) & ~(DSP_WORKSPACE_ALIGN - 1))
+
+
+/**
+ * @brief Workspace
+ */
+typedef struct {
+    unsigned char *mem;         // first aligned byte
+    dsp_size_t size;            // usable bytes from mem
+    dsp_size_t used;            // allocated bytes
+    dsp_size_t peak;            // maximum of used since creation
+    void *own_mem;              // memory allocated by dsp_workspace_create, NULL for caller memory
+} dsp_workspace_t;
+
+
+/**
+ * @brief Create workspace with own memory
+ *
+ * @param size usable bytes, e.g. sum of the *_workspace_size results
+ * @return dsp_workspace_t* created workspace, NULL if the allocation failed
+ */
+dsp_workspace_t *dsp_workspace_create(dsp_size_t size);
+
+
+/**
+ * @brief Destroy workspace created by dsp_workspace_create
+ *
+ * @param ws workspace, can be NULL
+ */
+void dsp_workspace_destroy(dsp_workspace_t *ws);
+
+
+/**
+ * @brief Initialize workspace on caller memory (static array, stack, ...)
+ * The start of the memory is aligned, so up to DSP_WORKSPACE_ALIGN - 1 bytes are lost.
+ *
+ * @param ws workspace
+ * @param mem caller memory, must live as long as the workspace
+ * @param size bytes of mem
+ */
+void dsp_workspace_init(dsp_workspace_t *ws, void *mem, dsp_size_t size);
+
+
+/**
+ * @brief Allocate aligned buffer from the workspace
+ *
+ * @param ws workspace
+ * @param bytes size of the buffer
+ * @return void* buffer, NULL if the workspace is NULL or full
+ */
+void *dsp_workspace_alloc(dsp_workspace_t *ws, dsp_size_t bytes);
+
+
+/**
+ * @brief Current allocation position, to release the later allocations with dsp_workspace_release
+ *
+ * @param ws workspace
+ * @return dsp_size_t allocation mark
+ */
+dsp_size_t dsp_workspace_mark(dsp_workspace_t *ws);
+
+
+/**
+ * @brief Release every allocation after the mark
+ *
+ * @param ws workspace
+ * @param mark result of dsp_workspace_mark
+ */
+void dsp_workspace_release(dsp_workspace_t *ws, dsp_size_t mark);
+
+
+/**
+ * @brief Release every allocation
+ *
+ * @param ws workspace
+ */
+void dsp_workspace_reset(dsp_workspace_t *ws);
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file dsp_buf.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP aligned and padded signal buffers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The start of the malloc block is stored just before the aligned buffer.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_buf.h"
+
+
+/**
+ * @brief Allocate aligned, zero initialized, padded signal buffer
+ *
+ * @param len number of elements, the buffer has DSP_BUF_PADDED_LEN(len, sizeof(dsp_val_t)) elements
+ * @return dsp_val_t* buffer, free with dsp_buf_free, NULL if the allocation failed
+ */
+dsp_val_t *dsp_buf_alloc(dsp_size_t len)
+{
+    return (dsp_val_t *) dsp_buf_alloc_elem(len, sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Allocate aligned, zero initialized, padded buffer of any element type
+ *
+ * @param len number of elements
+ * @param elem_size bytes of one element
+ * @return void* buffer, free with dsp_buf_free, NULL if the allocation failed
+ */
+void *dsp_buf_alloc_elem(dsp_size_t len, dsp_size_t elem_size)
+{
+    dsp_size_t bytes;
+    unsigned char *raw, *buf;
+
+    if(elem_size == 0) {
+        return NULL;
+    }
+
+    /*padded to whole aligned blocks, at least one block*/
+    bytes = (len * elem_size + DSP_BUF_ALIGN - 1) & ~(DSP_BUF_ALIGN - 1);
+    bytes = (bytes == 0) ? DSP_BUF_ALIGN : bytes;
+
+    raw = (unsigned char *) malloc(bytes + DSP_BUF_ALIGN + sizeof(void *));
+    if(raw == NULL) {
+        return NULL;
+    }
+
+    buf = raw + sizeof(void *);
+    buf += (DSP_BUF_ALIGN - ((uintptr_t)buf & (DSP_BUF_ALIGN - 1))) & (DSP_BUF_ALIGN - 1);
+    memcpy(buf - sizeof(void *), &raw, sizeof(void *));
+    memset(buf, 0, bytes);
+    return buf;
+}
+
+
+/**
+ * @brief Free buffer allocated by dsp_buf_alloc or dsp_buf_alloc_elem
+ *
+ * @param buf buffer, can be NULL
+ */
+void dsp_buf_free(void *buf)
+{
+    void *raw;
+
+    if(buf == NULL) {
+        return;
+    }
+
+    memcpy(&raw, (unsigned char *)buf - sizeof(void *), sizeof(void *));
+    free(raw);
+}
+
+
+/**
+ * @brief Single precision aligned buffer
+ *
+ * @param len number of elements
+ * @return dsp_f32_t* buffer, free with dsp_buf_free, NULL if the allocation failed
+ */
+dsp_f32_t *dsp_buf_alloc_f32(dsp_size_t len)
+{
+    return (dsp_f32_t *) dsp_buf_alloc_elem(len, sizeof(dsp_f32_t));
+}
+
+
+/**
+ * @brief Double precision aligned buffer
+ *
+ * @param len number of elements
+ * @return dsp_f64_t* buffer, free with dsp_buf_free, NULL if the allocation failed
+ */
+dsp_f64_t *dsp_buf_alloc_f64(dsp_size_t len)
+{
+    return (dsp_f64_t *) dsp_buf_alloc_elem(len, sizeof(dsp_f64_t));
+}
@@ -10,6 +10,20 @@
  */
 
 #include "dsp_cdft.h"
+#include "dsp_instr.h"
+
+
+/*Single precision functions*/
+#define DSP_PREC 32
+#include "dsp_prec.h"
+#include "dsp_cdft_tmpl.h"
+#undef DSP_PREC
+
+/*Double precision functions*/
+#define DSP_PREC 64
+#include "dsp_prec.h"
+#include "dsp_cdft_tmpl.h"
+#undef DSP_PREC
 
 /**
  * @brief Complex Discrete Fourier Transform
@@ -42,25 +56,22 @@
 void dsp_cdft(dsp_val_t *input_sig_tdomain_rex, dsp_val_t *input_sig_tdomain_imx, 
               dsp_val_t *output_sig_fdomain_rex, dsp_val_t *output_sig_fdomain_imx, dsp_size_t sig_len)
 {
-    dsp_size_t k, i;
-    dsp_val_t SR, SI, sin_cos_arg;
-    
-    for(k = 0; k < sig_len; k++) {
-        
-        *(output_sig_fdomain_imx + k) = *(output_sig_fdomain_rex + k) = 0;
-        
-        for(i = 0; i < sig_len; i++) {
-
-            // calculate common argument for sin and cos
-            sin_cos_arg = 2 * M_PI * k * i / sig_len;
+    dsp_cdft_f64(input_sig_tdomain_rex, input_sig_tdomain_imx, 
+                 output_sig_fdomain_rex, output_sig_fdomain_imx, sig_len);
+}
 
-            // calculate real and imaginary coefficients
-            SR = cos(sin_cos_arg);
-            SI = -sin(sin_cos_arg);
 
-            // calculate output
-            *(output_sig_fdomain_rex + k) += *(input_sig_tdomain_rex + i) * SR - *(input_sig_tdomain_imx + i) * SI;
-            *(output_sig_fdomain_imx + k) += *(input_sig_tdomain_imx + i) * SI - *(input_sig_tdomain_imx + i) * SR;
-        }
-    }
-}
\ No newline at end of file
+/**
+ * @brief Complex Discrete Fourier Transform of interleaved complex signal
+ * Input and output are interleaved, see dsp_iq.h, without scaling:
+ *
+ * X[k] = sum (x[n] * exp(-j * 2 * k * PI * n / N)) | from n = 0 to n = N - 1
+ *
+ * @param input_sig_tdomain_iq input time domain signal, 2 * sig_len long
+ * @param output_sig_fdomain_iq output frequency domain signal, 2 * sig_len long
+ * @param sig_len number of complex samples
+ */
+void dsp_cdft_iq(dsp_val_t *input_sig_tdomain_iq, dsp_val_t *output_sig_fdomain_iq, dsp_size_t sig_len)
+{
+    dsp_cdft_iq_f64(input_sig_tdomain_iq, output_sig_fdomain_iq, sig_len);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file dsp_cdft_tmpl.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief Complex Discrete Fourier Transform, precision template (library internal)
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Included by dsp_cdft.c once per precision, see dsp_prec.h
+ */
+
+/**
+ * @brief Complex Discrete Fourier Transform
+ * 
+ * Euler relations
+ * exp(j * x) = cos(x) + j * sin(x)
+ * cos(x) = (exp(j * x) + exp(-j * x)) / 2
+ * sin(x) = (exp(j * x) + exp(-j * x)) / 2
+ * 
+ * cos(omega * t) = exp(-j * omega * t) / 2 + exp(j * omega * t) / 2
+ * sin(omega * t) = exp(-j * omega * t) / 2 + exp(j * omega * t) / 2
+ * 
+ * Complex DFT
+ * ------------
+ * 
+ * X[k] = 1/N * sum (x[n] * exp(-j * 2 * k * PI * n / N)) | from n = 0 to n = N - 1
+ * 
+ * X[k] = 1/N * sum (x[n] * (cos(2 * PI * k * n / N) - j * sin(2 * PI * k * n / N))) | from n = 0 to n = N - 1
+ * 
+ * Inverse Complex DFT
+ * -------------------
+ * X[k] = (1 / N) * sum (x[n] * exp(j * 2 * k * PI * n / N))
+ * 
+ * @param input_sig_tdomain_rex input time domain signal real part
+ * @param input_sig_tdomain_imx input time domain signal imaginary part
+ * @param output_sig_fdomain_rex output frequency domain signal real part
+ * @param output_sig_fdomain_imx output frequency domain signal imaginary part
+ * @param sig_len signal length
+ */
+void DSP_FN(dsp_cdft)(DSP_T *input_sig_tdomain_rex, DSP_T *input_sig_tdomain_imx, 
+              DSP_T *output_sig_fdomain_rex, DSP_T *output_sig_fdomain_imx, dsp_size_t sig_len)
+{
+    dsp_size_t k, i;
+    DSP_T SR, SI, sin_cos_arg;
+    DSP_INSTR_BEGIN();
+    
+    for(k = 0; k < sig_len; k++) {
+        
+        *(output_sig_fdomain_imx + k) = *(output_sig_fdomain_rex + k) = 0;
+        
+        for(i = 0; i < sig_len; i++) {
+
+            // calculate common argument for sin and cos, phase reduced modulo N in integer
+            sin_cos_arg = (DSP_T)(2.0 * M_PI) * ((k * i) % sig_len) / sig_len;
+
+            // calculate real and imaginary coefficients
+            SR = DSP_COS(sin_cos_arg);
+            SI = -DSP_SIN(sin_cos_arg);
+
+            // calculate output
+            *(output_sig_fdomain_rex + k) += *(input_sig_tdomain_rex + i) * SR - *(input_sig_tdomain_imx + i) * SI;
+            *(output_sig_fdomain_imx + k) += *(input_sig_tdomain_imx + i) * SI - *(input_sig_tdomain_imx + i) * SR;
+        }
+    }
+    DSP_INSTR_END(DSP_INSTR_CDFT, 2 * sig_len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Complex Discrete Fourier Transform of interleaved complex signal
+ * Input and output are interleaved, see dsp_iq.h, without scaling:
+ *
+ * X[k] = sum (x[n] * exp(-j * 2 * k * PI * n / N)) | from n = 0 to n = N - 1
+ *
+ * @param input_sig_tdomain_iq input time domain signal, 2 * sig_len long
+ * @param output_sig_fdomain_iq output frequency domain signal, 2 * sig_len long
+ * @param sig_len number of complex samples
+ */
+void DSP_FN(dsp_cdft_iq)(DSP_T *input_sig_tdomain_iq, DSP_T *output_sig_fdomain_iq, dsp_size_t sig_len)
+{
+    dsp_size_t k, i;
+    DSP_T SR, SI, sin_cos_arg, re, im;
+    DSP_INSTR_BEGIN();
+
+    for(k = 0; k < sig_len; k++) {
+
+        re = im = 0;
+
+        for(i = 0; i < sig_len; i++) {
+
+            // calculate common argument for sin and cos, phase reduced modulo N in integer
+            sin_cos_arg = (DSP_T)(2.0 * M_PI) * ((k * i) % sig_len) / sig_len;
+
+            // calculate real and imaginary coefficients
+            SR = DSP_COS(sin_cos_arg);
+            SI = -DSP_SIN(sin_cos_arg);
+
+            // complex product of the sample and the coefficient
+            re += *(input_sig_tdomain_iq + 2 * i) * SR - *(input_sig_tdomain_iq + 2 * i + 1) * SI;
+            im += *(input_sig_tdomain_iq + 2 * i) * SI + *(input_sig_tdomain_iq + 2 * i + 1) * SR;
+        }
+
+        *(output_sig_fdomain_iq + 2 * k) = re;
+        *(output_sig_fdomain_iq + 2 * k + 1) = im;
+    }
+    DSP_INSTR_END(DSP_INSTR_CDFT, 2 * sig_len * sizeof(DSP_T));
+}
@@ -0,0 +1,192 @@
+/**
+ * @file dsp_channelizer.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP polyphase FFT channelizer
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_channelizer.h"
+#include "dsp_filter.h"
+#include "dsp_instr.h"
+
+
+static void _dsp_channelizer_frame(dsp_channelizer_t *ch, dsp_val_t *out_rex, dsp_val_t *out_imx);
+
+
+/**
+ * @brief Create polyphase channelizer
+ * The prototype is a windowed sinc low-pass filter (dsp_lp_win_sinc_filter) with cutoff fs / (2 * M),
+ * normalized to unity DC gain.
+ *
+ * Cost per output frame: M * P MAC + one M point FFT
+ *
+ * @param channels number of channels (M), power of two
+ * @param decimation input samples per output frame (D), must divide M
+ * @param taps_per_branch prototype taps per polyphase branch (P)
+ * @param window_calc window calculation function of the prototype, NULL: Hamming window
+ * @return dsp_channelizer_t* created channelizer, NULL if the arguments are invalid or the allocation failed
+ */
+dsp_channelizer_t *dsp_channelizer_create(dsp_size_t channels, dsp_size_t decimation, dsp_size_t taps_per_branch,
+                                          dsp_val_t (*window_calc)(int, dsp_size_t))
+{
+    dsp_channelizer_t *ch;
+    dsp_size_t i;
+    dsp_val_t gain = 0.0;
+
+    if(decimation == 0 || taps_per_branch == 0 || decimation > channels || (channels % decimation) != 0) {
+        return NULL;
+    }
+
+    ch = (dsp_channelizer_t *) calloc(1, sizeof(dsp_channelizer_t));
+    if(ch == NULL) {
+        return NULL;
+    }
+
+    ch->channels = channels;
+    ch->decimation = decimation;
+    ch->taps_per_branch = taps_per_branch;
+    ch->proto_len = channels * taps_per_branch;
+
+    ch->plan = dsp_fft_plan_create(channels);
+    ch->prototype = (dsp_val_t *) calloc(ch->proto_len, sizeof(dsp_val_t));
+    ch->history = (dsp_val_t *) calloc(2 * ch->proto_len, sizeof(dsp_val_t));
+    ch->work_rex = (dsp_val_t *) calloc(channels, sizeof(dsp_val_t));
+    ch->work_imx = (dsp_val_t *) calloc(channels, sizeof(dsp_val_t));
+
+    if(ch->plan == NULL || ch->prototype == NULL || ch->history == NULL ||
+       ch->work_rex == NULL || ch->work_imx == NULL) {
+        dsp_channelizer_destroy(ch);
+        return NULL;
+    }
+
+    /*prototype low-pass filter, cutoff at half channel spacing*/
+    dsp_lp_win_sinc_filter(ch->prototype, 1.0, 0.5 / (dsp_val_t)channels, window_calc, ch->proto_len);
+
+    /*unity DC gain*/
+    for(i = 0; i < ch->proto_len; gain += *(ch->prototype + i), i++);
+    for(i = 0; i < ch->proto_len; *(ch->prototype + i) /= gain, i++);
+
+    return ch;
+}
+
+
+/**
+ * @brief Destroy polyphase channelizer
+ *
+ * @param ch channelizer created by dsp_channelizer_create, can be NULL
+ */
+void dsp_channelizer_destroy(dsp_channelizer_t *ch)
+{
+    if(ch == NULL) {
+        return;
+    }
+
+    dsp_fft_plan_destroy(ch->plan);
+    free(ch->prototype);
+    free(ch->history);
+    free(ch->work_rex);
+    free(ch->work_imx);
+    free(ch);
+}
+
+
+/**
+ * @brief Reset history of the channelizer
+ *
+ * @param ch channelizer
+ */
+void dsp_channelizer_reset(dsp_channelizer_t *ch)
+{
+    memset(ch->history, 0, 2 * ch->proto_len * sizeof(dsp_val_t));
+    ch->hist_pos = 0;
+    ch->sample_cnt = 0;
+    ch->pending = 0;
+}
+
+
+/**
+ * @brief Process input samples
+ * The state is kept between calls, the input can be split into any blocks.
+ * Complex baseband output of channel k in frame f: out_rex[f * M + k], out_imx[f * M + k]
+ *
+ * y_k[n] = sum (h[l] * x[n - l] * exp(-j * 2 * PI * k * (n - l) / M)) | from l = 0 to l = L - 1
+ *
+ * @param ch channelizer
+ * @param out_rex output real part array, at least (input_sig_len / D + 1) * M elements
+ * @param out_imx output imaginary part array, at least (input_sig_len / D + 1) * M elements
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @return dsp_size_t number of output frames
+ */
+dsp_size_t dsp_channelizer_process(dsp_channelizer_t *ch, dsp_val_t *out_rex, dsp_val_t *out_imx,
+                                   dsp_val_t *input_sig, dsp_size_t input_sig_len)
+{
+    dsp_size_t i, frames = 0;
+    DSP_INSTR_BEGIN();
+
+    for(i = 0; i < input_sig_len; i++) {
+
+        /*doubled circular buffer, the last L samples are always contiguous*/
+        *(ch->history + ch->hist_pos) = *(input_sig + i);
+        *(ch->history + ch->hist_pos + ch->proto_len) = *(input_sig + i);
+        ch->hist_pos = (ch->hist_pos + 1 == ch->proto_len) ? 0 : ch->hist_pos + 1;
+        ch->sample_cnt = (ch->sample_cnt + 1 == ch->channels) ? 0 : ch->sample_cnt + 1;
+
+        if(++ch->pending == ch->decimation) {
+            ch->pending = 0;
+            _dsp_channelizer_frame(ch, out_rex + frames * ch->channels, out_imx + frames * ch->channels);
+            frames++;
+        }
+    }
+
+    DSP_INSTR_END(DSP_INSTR_CHANNELIZER_PROCESS, input_sig_len * sizeof(dsp_val_t));
+    return frames;
+}
+
+
+/**
+ * @brief Calculate one output frame from the current history
+ *
+ * Substitution l = m + p * M, r = n mod M:
+ *      u[m] = sum (h[m + p * M] * x[n - m - p * M]) | from p = 0 to p = P - 1
+ *      y_k[n] = sum (u[m] * exp(j * 2 * PI * k * (m - r) / M)) | from m = 0 to m = M - 1
+ *
+ * v[i] = u[(i + r) mod M] is real, so y_k[n] = conj(FFT(v)[k])
+ *
+ * @param ch channelizer
+ * @param out_rex frame output real part, M elements
+ * @param out_imx frame output imaginary part, M elements
+ */
+static void _dsp_channelizer_frame(dsp_channelizer_t *ch, dsp_val_t *out_rex, dsp_val_t *out_imx)
+{
+    dsp_size_t m, p, r;
+    dsp_size_t M = ch->channels;
+    dsp_val_t acc;
+
+    /*newest sample is the last element of the window*/
+    dsp_val_t *newest = ch->history + ch->hist_pos + ch->proto_len - 1;
+
+    r = (ch->sample_cnt + M - 1) % M;
+
+    /*polyphase branch sums, rotated by the sample index*/
+    for(m = 0; m < M; m++) {
+        for(p = 0, acc = 0.0; p < ch->taps_per_branch; p++) {
+            acc += *(ch->prototype + m + p * M) * *(newest - m - p * M);
+        }
+        *(ch->work_rex + (m + M - r) % M) = acc;
+        *(ch->work_imx + m) = 0.0;
+    }
+
+    dsp_fft(ch->plan, ch->work_rex, ch->work_imx);
+
+    for(m = 0; m < M; m++) {
+        *(out_rex + m) = *(ch->work_rex + m);
+        *(out_imx + m) = -*(ch->work_imx + m);
+    }
+}
@@ -8,7 +8,25 @@
  * @copyright Copyright (c) 2020
  * 
  */
+#include <stdlib.h>
+#include <string.h>
 #include "dsp_convolution.h"
+#include "dsp_instr.h"
+#include "dsp_kernels.h"
+
+
+/*Single precision functions*/
+#define DSP_PREC 32
+#include "dsp_prec.h"
+#include "dsp_convolution_tmpl.h"
+#undef DSP_PREC
+
+/*Double precision functions*/
+#define DSP_PREC 64
+#include "dsp_prec.h"
+#include "dsp_convolution_tmpl.h"
+#undef DSP_PREC
+
 
 /**
  * @brief DSP Convolution
@@ -22,17 +40,24 @@
 void dsp_convolution(dsp_val_t *dest_sig, dsp_val_t *input_sig, dsp_size_t input_sig_len, 
                 dsp_val_t *impulse_resp, dsp_size_t impulse_resp_len)
 {
-    dsp_size_t i, j;
-
-    // reset destination array
-    for(i = 0; i < (input_sig_len + impulse_resp_len); *(dest_sig + i) = 0.0, i++);
+    dsp_convolution_f64(dest_sig, input_sig, input_sig_len, impulse_resp, impulse_resp_len);
+}
 
-    // calc convolution sum
-    for(i = 0; i < input_sig_len; i++) {
-        for(j = 0; j < impulse_resp_len; j++) {
-            *(dest_sig + i + j) += *(input_sig + i) * *(impulse_resp + j); 
-        }
-    }
+/**
+ * @brief Convolution calculated in output blocks by the threads of an execution context
+ * Same result as dsp_convolution bit by bit.
+ *
+ * @param dest_sig destination output array, length: input_sig_len + impulse_resp_len
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @param impulse_resp impulse response signal array
+ * @param impulse_resp_len impulse response signal length
+ * @param ctx execution context, NULL: serial
+ */
+void dsp_convolution_exec(dsp_val_t *dest_sig, dsp_val_t *input_sig, dsp_size_t input_sig_len,
+                dsp_val_t *impulse_resp, dsp_size_t impulse_resp_len, dsp_exec_ctx_t *ctx)
+{
+    dsp_convolution_exec_f64(dest_sig, input_sig, input_sig_len, impulse_resp, impulse_resp_len, ctx);
 }
 
 /**
@@ -44,10 +69,5 @@ void dsp_convolution(dsp_val_t *dest_sig, dsp_val_t *input_sig, dsp_size_t input
  */
 void dsp_running_sum(dsp_val_t *dest_sig,  dsp_val_t *input_sig, dsp_size_t input_sig_len)
 {
-    dsp_size_t i;
-
-    /*init start point of dest array and start the iteration from first element*/
-    for(i = 1, *dest_sig = *input_sig; i < input_sig_len; i++) {
-        *(dest_sig + i) += *(dest_sig + i - 1) + *(input_sig + i);
-    }
-}
\ No newline at end of file
+    dsp_running_sum_f64(dest_sig, input_sig, input_sig_len);
+}
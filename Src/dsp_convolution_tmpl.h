@@ -0,0 +1,173 @@
+/**
+ * @file dsp_convolution_tmpl.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP Convolution, precision template (library internal)
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Included by dsp_convolution.c once per precision, see dsp_prec.h
+ */
+
+
+/**
+ * @brief DSP Convolution
+ * 
+ * @param dest_sig destination output array
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @param impulse_resp impulse response signal array
+ * @param impulse_resp_len impulse response signal length
+ */
+void DSP_FN(dsp_convolution)(DSP_T *dest_sig, DSP_T *input_sig, dsp_size_t input_sig_len, 
+                DSP_T *impulse_resp, dsp_size_t impulse_resp_len)
+{
+    dsp_size_t i;
+#if DSP_PREC != 64
+    dsp_size_t j;
+#endif
+    DSP_INSTR_BEGIN();
+
+    // reset destination array
+    for(i = 0; i < (input_sig_len + impulse_resp_len); *(dest_sig + i) = 0.0, i++);
+
+    // calc convolution sum
+#if DSP_PREC == 64
+    _dsp_kernels()->convolution(dest_sig, input_sig, input_sig_len, impulse_resp, impulse_resp_len);
+#else
+    for(i = 0; i < input_sig_len; i++) {
+        for(j = 0; j < impulse_resp_len; j++) {
+            *(dest_sig + i + j) += *(input_sig + i) * *(impulse_resp + j); 
+        }
+    }
+#endif
+    DSP_INSTR_END(DSP_INSTR_CONVOLUTION, (input_sig_len + impulse_resp_len) * sizeof(DSP_T));
+}
+
+
+/*
+Output block of the parallel convolution
+*/
+typedef struct {
+    DSP_T *dest_sig;
+    DSP_T *input_sig;
+    dsp_size_t input_sig_len;
+    DSP_T *impulse_resp;
+    dsp_size_t impulse_resp_len;
+    dsp_size_t block_len;
+} DSP_TN(_dsp_conv_job);
+
+
+/*
+Add the products of the inputs [i_first, i_last) to the outputs [o_first, o_last) only
+*/
+static void DSP_FN(_dsp_conv_acc_range)(DSP_T *dest_sig, DSP_T *input_sig, dsp_size_t i_first, dsp_size_t i_last,
+                DSP_T *impulse_resp, dsp_size_t impulse_resp_len, dsp_size_t o_first, dsp_size_t o_last)
+{
+    dsp_size_t i, j, j_first, j_last;
+
+    for(i = i_first; i < i_last; i++) {
+        j_first = (o_first > i) ? o_first - i : 0;
+        j_last = (o_last - i < impulse_resp_len) ? o_last - i : impulse_resp_len;
+        for(j = j_first; j < j_last; j++) {
+            *(dest_sig + i + j) += *(input_sig + i) * *(impulse_resp + j);
+        }
+    }
+}
+
+
+/**
+ * @brief Convolution of one output block: outputs [o_first, o_last) from the inputs
+ * [i_first, i_last), which reach them. The block is accumulated in place, the inputs
+ * reaching only this block are added by the convolution kernel, the inputs shared with
+ * the neighbour blocks are clipped. Every output sum is added in input order,
+ * so the result is identical to the serial convolution.
+ *
+ * @param arg job
+ * @param block output block index
+ */
+static void DSP_FN(_dsp_conv_task)(void *arg, dsp_size_t block)
+{
+    DSP_TN(_dsp_conv_job) *job = (DSP_TN(_dsp_conv_job) *)arg;
+    dsp_size_t i, o_first, o_last, i_first, i_last, inner_first, inner_last;
+    dsp_size_t out_len = job->input_sig_len + job->impulse_resp_len - 1;
+
+    o_first = block * job->block_len;
+    o_last = (o_first + job->block_len < out_len) ? o_first + job->block_len : out_len;
+    i_first = (o_first >= job->impulse_resp_len - 1) ? o_first - (job->impulse_resp_len - 1) : 0;
+    i_last = (o_last < job->input_sig_len) ? o_last : job->input_sig_len;
+
+    /*inputs with every output inside the block*/
+    inner_first = (o_first < i_last) ? o_first : i_last;
+    inner_last = (o_last - inner_first >= job->impulse_resp_len) ? o_last - job->impulse_resp_len + 1 : inner_first;
+    inner_last = (inner_last < i_last) ? inner_last : i_last;
+
+    for(i = o_first; i < o_last; *(job->dest_sig + i) = 0.0, i++);
+
+    DSP_FN(_dsp_conv_acc_range)(job->dest_sig, job->input_sig, i_first, inner_first,
+                                job->impulse_resp, job->impulse_resp_len, o_first, o_last);
+#if DSP_PREC == 64
+    _dsp_kernels()->convolution(job->dest_sig + inner_first, job->input_sig + inner_first, inner_last - inner_first,
+                                job->impulse_resp, job->impulse_resp_len);
+#else
+    DSP_FN(_dsp_conv_acc_range)(job->dest_sig, job->input_sig, inner_first, inner_last,
+                                job->impulse_resp, job->impulse_resp_len, o_first, o_last);
+#endif
+    DSP_FN(_dsp_conv_acc_range)(job->dest_sig, job->input_sig, inner_last, i_last,
+                                job->impulse_resp, job->impulse_resp_len, o_first, o_last);
+}
+
+
+/**
+ * @brief Convolution calculated in output blocks by the threads of an execution context
+ * Same result as dsp_convolution bit by bit.
+ *
+ * @param dest_sig destination output array, length: input_sig_len + impulse_resp_len
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @param impulse_resp impulse response signal array
+ * @param impulse_resp_len impulse response signal length
+ * @param ctx execution context, NULL: serial
+ */
+void DSP_FN(dsp_convolution_exec)(DSP_T *dest_sig, DSP_T *input_sig, dsp_size_t input_sig_len,
+                DSP_T *impulse_resp, dsp_size_t impulse_resp_len, dsp_exec_ctx_t *ctx)
+{
+    DSP_TN(_dsp_conv_job) job;
+    dsp_size_t out_len = input_sig_len + impulse_resp_len - 1;
+
+    if(dsp_exec_ctx_threads(ctx) <= 1 || input_sig_len == 0 || impulse_resp_len == 0) {
+        DSP_FN(dsp_convolution)(dest_sig, input_sig, input_sig_len, impulse_resp, impulse_resp_len);
+        return;
+    }
+
+    /*blocks much longer than the kernel, the overlapping inputs are a small overhead*/
+    job.dest_sig = dest_sig;
+    job.input_sig = input_sig;
+    job.input_sig_len = input_sig_len;
+    job.impulse_resp = impulse_resp;
+    job.impulse_resp_len = impulse_resp_len;
+    job.block_len = (DSP_CONV_EXEC_BLOCK_LEN > 4 * impulse_resp_len) ? DSP_CONV_EXEC_BLOCK_LEN : 4 * impulse_resp_len;
+
+    dsp_exec_parallel_for(ctx, (out_len + job.block_len - 1) / job.block_len, DSP_FN(_dsp_conv_task), &job);
+    *(dest_sig + out_len) = 0.0;
+}
+
+/**
+ * @brief Calculate running sum
+ * 
+ * @param dest_sig destination signal array
+ * @param input_sig input source signal array
+ * @param input_sig_len input signal length
+ */
+void DSP_FN(dsp_running_sum)(DSP_T *dest_sig,  DSP_T *input_sig, dsp_size_t input_sig_len)
+{
+    dsp_size_t i;
+    DSP_INSTR_BEGIN();
+
+    /*init start point of dest array and start the iteration from first element*/
+    for(i = 1, *dest_sig = *input_sig; i < input_sig_len; i++) {
+        *(dest_sig + i) += *(dest_sig + i - 1) + *(input_sig + i);
+    }
+    DSP_INSTR_END(DSP_INSTR_RUNNING_SUM, input_sig_len * sizeof(DSP_T));
+}
@@ -0,0 +1,387 @@
+/**
+ * @file dsp_correlation.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP auto- and cross-correlation, direct or FFT based
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <stdlib.h>
+#include "dsp_correlation.h"
+#include "dsp_instr.h"
+
+
+static dsp_size_t _dsp_corr_overlap(dsp_size_t x_len, dsp_size_t y_len, long lag);
+static dsp_size_t _dsp_xcorr_fft_len(dsp_size_t x_len, dsp_size_t y_len, long min_lag, long max_lag,
+                                     long *eff_min, long *eff_max);
+static void _dsp_xcorr_direct(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+                              long min_lag, long max_lag);
+static int _dsp_xcorr_fft(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+                          long min_lag, long max_lag, dsp_size_t fft_len, dsp_workspace_t *ws);
+
+
+/**
+ * @brief Cross-correlation for a limited lag range
+ * Only the requested lags are calculated:
+ *
+ * r[k] = sum (x[n + k] * y[n]) | for every n, where both indexes are valid, k = min_lag .. max_lag
+ *
+ * Cost:
+ * direct:  sum of the overlaps of the requested lags, MAC
+ * FFT:     3 * c * N * log2(N) + 6 * N, N >= max(x_len - min_lag, y_len + max_lag), power of two
+ * The FFT length depends on the lag range, so short lag ranges need smaller FFT.
+ *
+ * @param dest destination array, max_lag - min_lag + 1 elements
+ * @param x first signal
+ * @param x_len length of first signal
+ * @param y second signal
+ * @param y_len length of second signal
+ * @param min_lag first lag, can be negative
+ * @param max_lag last lag, not less than min_lag
+ * @param norm normalization
+ * @param path calculation path
+ */
+void dsp_xcorr_lags(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+                    long min_lag, long max_lag, dsp_corr_norm_t norm, dsp_corr_path_t path)
+{
+    dsp_xcorr_lags_ws(dest, x, x_len, y, y_len, min_lag, max_lag, norm, path, NULL);
+}
+
+
+/**
+ * @brief Cross-correlation for a limited lag range with scratch buffers from workspace
+ * Same as dsp_xcorr_lags. If the workspace is NULL the buffers are allocated,
+ * if it is too small the direct path is used.
+ *
+ * @param dest destination array, max_lag - min_lag + 1 elements
+ * @param x first signal
+ * @param x_len length of first signal
+ * @param y second signal
+ * @param y_len length of second signal
+ * @param min_lag first lag, can be negative
+ * @param max_lag last lag, not less than min_lag
+ * @param norm normalization
+ * @param path calculation path
+ * @param ws workspace, the used buffers are released before return
+ */
+void dsp_xcorr_lags_ws(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+                       long min_lag, long max_lag, dsp_corr_norm_t norm, dsp_corr_path_t path,
+                       dsp_workspace_t *ws)
+{
+    long k, eff_min, eff_max;
+    dsp_size_t i, fft_len, overlap;
+    dsp_val_t direct_cost = 0.0, fft_cost, scale, x_pow = 0.0, y_pow = 0.0;
+
+    if(max_lag < min_lag) {
+        return;
+    }
+    for(k = min_lag; k <= max_lag; *(dest + (k - min_lag)) = 0.0, k++);
+    if(x_len == 0 || y_len == 0) {
+        return;
+    }
+
+    /*lags with overlap, the others stay zero*/
+    fft_len = _dsp_xcorr_fft_len(x_len, y_len, min_lag, max_lag, &eff_min, &eff_max);
+    if(fft_len == 0) {
+        return;
+    }
+    DSP_INSTR_BEGIN();
+
+    if(path == DSP_CORR_PATH_AUTO) {
+        for(k = eff_min; k <= eff_max; direct_cost += _dsp_corr_overlap(x_len, y_len, k), k++);
+        fft_cost = 3.0 * DSP_CORR_FFT_COST_FACTOR * fft_len * log2((dsp_val_t)fft_len) + 6.0 * fft_len;
+        path = (fft_cost < direct_cost) ? DSP_CORR_PATH_FFT : DSP_CORR_PATH_DIRECT;
+    }
+
+    if(path != DSP_CORR_PATH_FFT ||
+       _dsp_xcorr_fft(dest + (eff_min - min_lag), x, x_len, y, y_len, eff_min, eff_max, fft_len, ws) != 0) {
+        _dsp_xcorr_direct(dest + (eff_min - min_lag), x, x_len, y, y_len, eff_min, eff_max);
+    }
+
+    /*normalization*/
+    switch(norm) {
+        case DSP_CORR_NORM_BIASED:
+            for(k = eff_min; k <= eff_max; *(dest + (k - min_lag)) /= (dsp_val_t)x_len, k++);
+            break;
+
+        case DSP_CORR_NORM_UNBIASED:
+            for(k = eff_min; k <= eff_max; k++) {
+                overlap = _dsp_corr_overlap(x_len, y_len, k);
+                *(dest + (k - min_lag)) /= (dsp_val_t)overlap;
+            }
+            break;
+
+        case DSP_CORR_NORM_COEFF:
+            for(i = 0; i < x_len; x_pow += *(x + i) * *(x + i), i++);
+            for(i = 0; i < y_len; y_pow += *(y + i) * *(y + i), i++);
+            scale = (x_pow > 0.0 && y_pow > 0.0) ? 1.0 / sqrt(x_pow * y_pow) : 0.0;
+            for(k = eff_min; k <= eff_max; *(dest + (k - min_lag)) *= scale, k++);
+            break;
+
+        default:
+            break;
+    }
+    DSP_INSTR_END(DSP_INSTR_XCORR, (x_len + y_len) * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Workspace bytes of dsp_xcorr_lags_ws (FFT path)
+ * dsp_xcorr full: min_lag = -(y_len - 1), max_lag = x_len - 1
+ * dsp_autocorr: y_len = x_len, min_lag = 0
+ *
+ * @param x_len length of first signal
+ * @param y_len length of second signal
+ * @param min_lag first lag
+ * @param max_lag last lag
+ * @return dsp_size_t workspace bytes, 0 if no lag overlaps the signals
+ */
+dsp_size_t dsp_xcorr_workspace_size(dsp_size_t x_len, dsp_size_t y_len, long min_lag, long max_lag)
+{
+    long eff_min, eff_max;
+    dsp_size_t fft_len;
+
+    if(max_lag < min_lag || x_len == 0 || y_len == 0) {
+        return 0;
+    }
+
+    fft_len = _dsp_xcorr_fft_len(x_len, y_len, min_lag, max_lag, &eff_min, &eff_max);
+    if(fft_len == 0) {
+        return 0;
+    }
+    return dsp_fft_plan_workspace_size(fft_len) + 4 * DSP_WORKSPACE_ROUND(fft_len * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Cross-correlation
+ * full: lags -(y_len - 1) .. x_len - 1
+ * same: x_len lags from -ceil((y_len - 1) / 2)
+ * A positive peak at lag k means y is delayed by k samples in x.
+ *
+ * @param dest destination array, x_len + y_len - 1 (full) or x_len (same) elements
+ * @param x first signal
+ * @param x_len length of first signal
+ * @param y second signal
+ * @param y_len length of second signal
+ * @param mode output lag range
+ * @param norm normalization
+ * @param path calculation path
+ */
+void dsp_xcorr(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+               dsp_corr_mode_t mode, dsp_corr_norm_t norm, dsp_corr_path_t path)
+{
+    long min_lag;
+
+    if(x_len == 0 || y_len == 0) {
+        return;
+    }
+
+    if(mode == DSP_CORR_SAME) {
+        min_lag = -(long)(y_len / 2);
+        dsp_xcorr_lags(dest, x, x_len, y, y_len, min_lag, min_lag + (long)x_len - 1, norm, path);
+    } else {
+        dsp_xcorr_lags(dest, x, x_len, y, y_len, -(long)(y_len - 1), (long)(x_len - 1), norm, path);
+    }
+}
+
+
+/**
+ * @brief Autocorrelation for lags 0 .. max_lag (the negative lags are symmetric)
+ *
+ * r[k] = sum (x[n + k] * x[n]) | from n = 0 to n = len - 1 - k
+ *
+ * @param dest destination array, max_lag + 1 elements
+ * @param x signal
+ * @param len length of signal
+ * @param max_lag last lag, less than len
+ * @param norm normalization, DSP_CORR_NORM_COEFF gives r[0] = 1
+ * @param path calculation path
+ */
+void dsp_autocorr(dsp_val_t *dest, dsp_val_t *x, dsp_size_t len, dsp_size_t max_lag,
+                  dsp_corr_norm_t norm, dsp_corr_path_t path)
+{
+    dsp_xcorr_lags(dest, x, len, x, len, 0, (long)max_lag, norm, path);
+}
+
+
+/**
+ * @brief Lags with overlap and FFT length without aliasing of them in the circular correlation
+ *
+ * @param x_len length of first signal, not 0
+ * @param y_len length of second signal, not 0
+ * @param min_lag first requested lag
+ * @param max_lag last requested lag
+ * @param eff_min first lag with overlap
+ * @param eff_max last lag with overlap
+ * @return dsp_size_t FFT length, 0 if no requested lag has overlap
+ */
+static dsp_size_t _dsp_xcorr_fft_len(dsp_size_t x_len, dsp_size_t y_len, long min_lag, long max_lag,
+                                     long *eff_min, long *eff_max)
+{
+    dsp_size_t n;
+
+    *eff_min = (min_lag > -(long)(y_len - 1)) ? min_lag : -(long)(y_len - 1);
+    *eff_max = (max_lag < (long)(x_len - 1)) ? max_lag : (long)(x_len - 1);
+    if(*eff_min > *eff_max) {
+        return 0;
+    }
+
+    n = (x_len - *eff_min > y_len + *eff_max) ? x_len - *eff_min : y_len + *eff_max;
+    n = (n > x_len) ? n : x_len;
+    n = (n > y_len) ? n : y_len;
+    return dsp_fft_next_pow2(n);
+}
+
+
+/**
+ * @brief Number of overlapping samples of x shifted by lag and y
+ *
+ * @param x_len length of first signal
+ * @param y_len length of second signal
+ * @param lag lag
+ * @return dsp_size_t number of products in the sum of the lag
+ */
+static dsp_size_t _dsp_corr_overlap(dsp_size_t x_len, dsp_size_t y_len, long lag)
+{
+    long first = (lag < 0) ? -lag : 0;
+    long last = ((long)x_len - lag < (long)y_len) ? (long)x_len - lag : (long)y_len;
+
+    return (last > first) ? (dsp_size_t)(last - first) : 0;
+}
+
+
+/**
+ * @brief Direct cross-correlation, dot product per lag with 4 independent accumulators
+ *
+ * @param dest destination array, max_lag - min_lag + 1 elements
+ * @param x first signal
+ * @param x_len length of first signal
+ * @param y second signal
+ * @param y_len length of second signal
+ * @param min_lag first lag
+ * @param max_lag last lag
+ */
+static void _dsp_xcorr_direct(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+                              long min_lag, long max_lag)
+{
+    long k;
+    dsp_size_t i, first, cnt;
+    dsp_val_t *xs, *ys, acc0, acc1, acc2, acc3;
+
+    for(k = min_lag; k <= max_lag; k++) {
+        first = (k < 0) ? (dsp_size_t)(-k) : 0;
+        cnt = _dsp_corr_overlap(x_len, y_len, k);
+        xs = x + first + k;
+        ys = y + first;
+
+        acc0 = acc1 = acc2 = acc3 = 0.0;
+        for(i = 0; i + 4 <= cnt; i += 4) {
+            acc0 += *(xs + i) * *(ys + i);
+            acc1 += *(xs + i + 1) * *(ys + i + 1);
+            acc2 += *(xs + i + 2) * *(ys + i + 2);
+            acc3 += *(xs + i + 3) * *(ys + i + 3);
+        }
+        for(; i < cnt; acc0 += *(xs + i) * *(ys + i), i++);
+
+        *(dest + (k - min_lag)) = (acc0 + acc1) + (acc2 + acc3);
+    }
+}
+
+
+/**
+ * @brief FFT based cross-correlation
+ * x and y are transformed together as real and imaginary part of one complex signal:
+ * X[k] = (Z[k] + conj(Z[N - k])) / 2
+ * Y[k] = (Z[k] - conj(Z[N - k])) / 2j
+ * r = IFFT(X * conj(Y)), the negative lags are at the end of the circular result.
+ *
+ * @param dest destination array, max_lag - min_lag + 1 elements
+ * @param x first signal
+ * @param x_len length of first signal
+ * @param y second signal
+ * @param y_len length of second signal
+ * @param min_lag first lag
+ * @param max_lag last lag
+ * @param fft_len FFT length without aliasing of the requested lags
+ * @param ws workspace of the buffers, NULL: allocated
+ * @return int 0 if succeeded, -1 if the allocation failed
+ */
+static int _dsp_xcorr_fft(dsp_val_t *dest, dsp_val_t *x, dsp_size_t x_len, dsp_val_t *y, dsp_size_t y_len,
+                          long min_lag, long max_lag, dsp_size_t fft_len, dsp_workspace_t *ws)
+{
+    long k;
+    dsp_size_t i, j, mark = dsp_workspace_mark(ws);
+    dsp_val_t zr, zi, br, bi, xr, xi, yr, yi;
+    dsp_fft_plan_t *plan;
+    dsp_val_t *rex, *imx, *sr, *si;
+
+    if(ws != NULL) {
+        plan = dsp_fft_plan_create_ws(fft_len, ws);
+        rex = (dsp_val_t *) dsp_workspace_alloc(ws, fft_len * sizeof(dsp_val_t));
+        imx = (dsp_val_t *) dsp_workspace_alloc(ws, fft_len * sizeof(dsp_val_t));
+        sr = (dsp_val_t *) dsp_workspace_alloc(ws, fft_len * sizeof(dsp_val_t));
+        si = (dsp_val_t *) dsp_workspace_alloc(ws, fft_len * sizeof(dsp_val_t));
+        if(plan == NULL || rex == NULL || imx == NULL || sr == NULL || si == NULL) {
+            dsp_workspace_release(ws, mark);
+            return -1;
+        }
+    } else {
+        plan = dsp_fft_plan_create(fft_len);
+        rex = (dsp_val_t *) malloc(fft_len * sizeof(dsp_val_t));
+        imx = (dsp_val_t *) malloc(fft_len * sizeof(dsp_val_t));
+        sr = (dsp_val_t *) malloc(fft_len * sizeof(dsp_val_t));
+        si = (dsp_val_t *) malloc(fft_len * sizeof(dsp_val_t));
+        if(plan == NULL || rex == NULL || imx == NULL || sr == NULL || si == NULL) {
+            dsp_fft_plan_destroy(plan);
+            free(rex);
+            free(imx);
+            free(sr);
+            free(si);
+            return -1;
+        }
+    }
+
+    for(i = 0; i < x_len; *(rex + i) = *(x + i), i++);
+    for(i = x_len; i < fft_len; *(rex + i) = 0.0, i++);
+    for(i = 0; i < y_len; *(imx + i) = *(y + i), i++);
+    for(i = y_len; i < fft_len; *(imx + i) = 0.0, i++);
+    dsp_fft(plan, rex, imx);
+
+    /*cross spectrum X * conj(Y)*/
+    for(i = 0; i < fft_len; i++) {
+        j = (fft_len - i) & (fft_len - 1);
+        zr = *(rex + i);
+        zi = *(imx + i);
+        br = *(rex + j);
+        bi = *(imx + j);
+
+        xr = 0.5 * (zr + br);
+        xi = 0.5 * (zi - bi);
+        yr = 0.5 * (zi + bi);
+        yi = -0.5 * (zr - br);
+
+        *(sr + i) = xr * yr + xi * yi;
+        *(si + i) = xi * yr - xr * yi;
+    }
+
+    dsp_ifft(plan, sr, si);
+
+    for(k = min_lag; k <= max_lag; k++) {
+        *(dest + (k - min_lag)) = *(sr + ((k < 0) ? (dsp_size_t)((long)fft_len + k) : (dsp_size_t)k));
+    }
+
+    if(ws != NULL) {
+        dsp_workspace_release(ws, mark);
+    } else {
+        dsp_fft_plan_destroy(plan);
+        free(rex);
+        free(imx);
+        free(sr);
+        free(si);
+    }
+    return 0;
+}
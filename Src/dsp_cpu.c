@@ -0,0 +1,185 @@
+/**
+ * @file dsp_cpu.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP runtime CPU feature detection and kernel variant selection
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_cpu.h"
+#include "dsp_kernels.h"
+
+#ifdef DSP_USE_PTHREAD
+    #include <pthread.h>
+#endif
+
+
+static dsp_kernels_t *dsp_cpu_kernels = NULL;
+static dsp_isa_t dsp_cpu_selected = DSP_ISA_GENERIC;
+
+#ifdef DSP_USE_PTHREAD
+/*the first kernel calls can run on more pool workers at the same time*/
+static pthread_once_t dsp_cpu_once = PTHREAD_ONCE_INIT;
+#endif
+
+static void _dsp_cpu_init_once(void);
+
+static char *dsp_cpu_isa_names[DSP_ISA_N] = {
+    "generic",
+    "sse2",
+    "avx2",
+    "avx512"
+};
+
+
+/**
+ * @brief Select the kernel variants: DSP_ISA environment variable if set and supported,
+ * best supported instruction set otherwise. Called by the first kernel call, explicit
+ * call is needed only to make the selection at a known point.
+ */
+void dsp_cpu_init(void)
+{
+    int i;
+    dsp_isa_t isa = dsp_cpu_best_isa();
+    char *env = getenv(DSP_CPU_ISA_ENV);
+
+    if(env != NULL) {
+        for(i = 0; i < DSP_ISA_N; i++) {
+            if(strcmp(env, dsp_cpu_isa_names[i]) == 0 && dsp_cpu_isa_supported((dsp_isa_t)i)) {
+                isa = (dsp_isa_t)i;
+                break;
+            }
+        }
+    }
+
+    dsp_cpu_set_isa(isa);
+}
+
+
+/**
+ * @brief Instruction set of the selected kernel variants
+ *
+ * @return dsp_isa_t selected instruction set
+ */
+dsp_isa_t dsp_cpu_isa(void)
+{
+    _dsp_kernels();
+    return dsp_cpu_selected;
+}
+
+
+/**
+ * @brief Best instruction set supported by the CPU (and the compiler)
+ *
+ * @return dsp_isa_t best instruction set
+ */
+dsp_isa_t dsp_cpu_best_isa(void)
+{
+    int i;
+
+    for(i = DSP_ISA_N - 1; i > DSP_ISA_GENERIC; i--) {
+        if(dsp_cpu_isa_supported((dsp_isa_t)i)) {
+            return (dsp_isa_t)i;
+        }
+    }
+    return DSP_ISA_GENERIC;
+}
+
+
+/**
+ * @brief Check if the instruction set is supported by the CPU
+ * cpuid and the OS support of the register state are checked by the compiler runtime.
+ *
+ * @param isa instruction set
+ * @return int 1 if supported, 0 otherwise
+ */
+int dsp_cpu_isa_supported(dsp_isa_t isa)
+{
+    if(isa < DSP_ISA_GENERIC || isa >= DSP_ISA_N || _dsp_kernels_tbl[isa] == NULL) {
+        return 0;
+    }
+
+#if DSP_KERNELS_X86
+    __builtin_cpu_init();
+
+    switch(isa) {
+    case DSP_ISA_SSE2:
+        return __builtin_cpu_supports("sse2") ? 1 : 0;
+    case DSP_ISA_AVX2:
+        return __builtin_cpu_supports("avx2") ? 1 : 0;
+    case DSP_ISA_AVX512:
+        return __builtin_cpu_supports("avx512f") ? 1 : 0;
+    default:
+        break;
+    }
+#endif
+
+    return isa == DSP_ISA_GENERIC;
+}
+
+
+/**
+ * @brief Force kernel variants, e.g. for testing or benchmarking
+ * Not thread safe, call it when no kernel is running.
+ *
+ * @param isa instruction set
+ * @return int 0 on success, -1 if the instruction set is not supported
+ */
+int dsp_cpu_set_isa(dsp_isa_t isa)
+{
+    if(!dsp_cpu_isa_supported(isa)) {
+        return -1;
+    }
+
+    dsp_cpu_selected = isa;
+    dsp_cpu_kernels = _dsp_kernels_tbl[isa];
+    return 0;
+}
+
+
+/**
+ * @brief Name of the instruction set
+ *
+ * @param isa instruction set
+ * @return char* name (generic, sse2, avx2, avx512), "unknown" if invalid
+ */
+char *dsp_cpu_isa_name(dsp_isa_t isa)
+{
+    if(isa < DSP_ISA_GENERIC || isa >= DSP_ISA_N) {
+        return "unknown";
+    }
+    return dsp_cpu_isa_names[isa];
+}
+
+
+/**
+ * @brief Kernel table of the selected instruction set, selects it on the first call
+ * The first call is synchronized with pthread_once if the library is built with DSP_USE_PTHREAD.
+ *
+ * @return dsp_kernels_t* kernel table
+ */
+dsp_kernels_t *_dsp_kernels(void)
+{
+#ifdef DSP_USE_PTHREAD
+    pthread_once(&dsp_cpu_once, _dsp_cpu_init_once);
+#else
+    _dsp_cpu_init_once();
+#endif
+    return dsp_cpu_kernels;
+}
+
+
+/*
+Default selection, unless dsp_cpu_set_isa was called before the first kernel call
+*/
+static void _dsp_cpu_init_once(void)
+{
+    if(dsp_cpu_kernels == NULL) {
+        dsp_cpu_init();
+    }
+}
@@ -10,6 +10,21 @@
  */
 
 #include "dsp_dft.h"
+#include "dsp_instr.h"
+#include "dsp_kernels.h"
+
+
+/*Single precision functions*/
+#define DSP_PREC 32
+#include "dsp_prec.h"
+#include "dsp_dft_tmpl.h"
+#undef DSP_PREC
+
+/*Double precision functions*/
+#define DSP_PREC 64
+#include "dsp_prec.h"
+#include "dsp_dft_tmpl.h"
+#undef DSP_PREC
 
 
 /**
@@ -36,15 +51,7 @@
  */
 void dsp_dft(dsp_val_t *input_sig, dsp_val_t *dest_rex,  dsp_val_t *dest_imx, dsp_size_t input_sig_len)
 {
-    dsp_size_t i, k;
-
-    // calc re and im arrays as result
-    for(k = 0; k < (input_sig_len / 2); k++) {
-        for(i = 0, *(dest_rex + k) = 0, *(dest_imx + k) = 0; i < input_sig_len; i++) {
-            *(dest_rex + k) += *(input_sig + i) * cos(2.0 * M_PI * k *i / input_sig_len);
-            *(dest_imx + k) -= *(input_sig + i) * sin(2.0 * M_PI * k *i / input_sig_len);
-        }
-    }
+    dsp_dft_f64(input_sig, dest_rex, dest_imx, input_sig_len);
 }
 
 /**
@@ -60,36 +67,9 @@ void dsp_dft(dsp_val_t *input_sig, dsp_val_t *dest_rex,  dsp_val_t *dest_imx, ds
  */
 void dsp_idft(dsp_val_t *dest_sig, dsp_val_t *input_rex,  dsp_val_t *input_imx, dsp_size_t idft_len)
 {
-    dsp_size_t i, k;
-    dsp_val_t div_rex, div_imx; // dividers
-    dsp_val_t rex, imx;
- 
-    // reset destination array
-    for(i = 0; i < idft_len; *(dest_sig + i) = 0.0, i++);
-
-    // calc output signal
-    for(k = 0, div_rex = ((dsp_val_t)idft_len / 2.0), div_imx = -1.0 * ((dsp_val_t)idft_len / 2.0); 
-        k < idft_len / 2; k++) {
-        
-        // prepare input rex and imx
-        rex = *(input_rex + k) / div_rex;
-        imx = *(input_imx + k) / div_imx;
-
-        // exception at zero index
-        if(!k) {
-            rex /= 2.0;
-            imx /= -2.0;
-        }
-
-        // Calculate output signal
-        for(i = 0; i < idft_len; i++) {
-            *(dest_sig + i) += rex * cos(2.0 * M_PI * k * i / idft_len);
-            *(dest_sig + i) += imx * sin(2.0 * M_PI * k * i / idft_len);
-        }
-    }
+    dsp_idft_f64(dest_sig, input_rex, input_imx, idft_len);
 }
 
-
 /**
  * @brief Calculate Discrete Fourier Transform magnitude signal from rex and imx
  * Absoulet value of complex number for each point.
@@ -101,11 +81,7 @@ void dsp_idft(dsp_val_t *dest_sig, dsp_val_t *input_rex,  dsp_val_t *input_imx,
  */
 void dsp_dft_magnitude(dsp_val_t *dest_mag, dsp_val_t *rex, dsp_val_t *imx, dsp_size_t rex_imx_len)
 {
-    dsp_size_t i;
-
-    for(i = 0; i < rex_imx_len; i++) {
-        *(dest_mag + i) = sqrt( pow(*(rex + i), 2) + pow(*(imx + i), 2) );
-    }
+    dsp_dft_magnitude_f64(dest_mag, rex, imx, rex_imx_len);
 }
 
 /**
@@ -131,32 +107,52 @@ void dsp_dft_magnitude(dsp_val_t *dest_mag, dsp_val_t *rex, dsp_val_t *imx, dsp_
  * @param imx_input ImX input signal arrau
  * @param sig_len Length of ReX and Imx
  */
-
-
 void dsp_rect2polar(dsp_val_t *mag_output, dsp_val_t *phase_output,
                     dsp_val_t *rex_input, dsp_val_t *imx_input, 
                     dsp_size_t sig_len)
 {
-    dsp_size_t k;
-    const dsp_val_t zero_for_calc = 10e-20;
-    for(k = 0; k < sig_len; k++) {
-        // magnitude
-        *(mag_output + k) = sqrt( pow(*(rex_input + k), 2) + pow(*(imx_input + k), 2) );
-        *(phase_output + k) = 0.0;
-        // phase rules
-        if(*(rex_input + k) == 0) {
-            // *(rex_input + k) = pow(10, -20);
-            *(phase_output +k) = atan(*(imx_input + k) / zero_for_calc);
-        } else {
-            *(phase_output +k) = atan(*(imx_input + k) / *(rex_input + k));
-        }
-        
-        if((*(rex_input + k) < 0) && (*(imx_input + k) < 0)) {
-            *(phase_output + k) -= M_PI;
-        }
+    dsp_rect2polar_f64(mag_output, phase_output, rex_input, imx_input, sig_len);
+}
+
+
+/**
+ * @brief Calculate Discrete Fourier transform with interleaved complex output
+ * Same as dsp_dft, bin k is (dest_iq[2 * k], dest_iq[2 * k + 1])
+ *
+ * @param input_sig input signal
+ * @param dest_iq interleaved destination array, 2 * (input_sig_len / 2) long
+ * @param input_sig_len input signal length
+ */
+void dsp_dft_iq(dsp_val_t *input_sig, dsp_val_t *dest_iq, dsp_size_t input_sig_len)
+{
+    dsp_dft_iq_f64(input_sig, dest_iq, input_sig_len);
+}
+
+
+/**
+ * @brief Calculate magnitude of interleaved complex signal
+ * Same as dsp_dft_magnitude on the interleaved layout, see dsp_iq.h
+ *
+ * @param dest_mag destination signal
+ * @param iq interleaved complex signal, 2 * mag_len long
+ * @param mag_len length of magnitude
+ */
+void dsp_dft_magnitude_iq(dsp_val_t *dest_mag, dsp_val_t *iq, dsp_size_t mag_len)
+{
+    dsp_dft_magnitude_iq_f64(dest_mag, iq, mag_len);
+}
+
 
-        if((*(rex_input + k) < 0) && (*(imx_input + k) >= 0)) {
-            *(phase_output + k) += M_PI;
-        }
-    }
-}
\ No newline at end of file
+/**
+ * @brief Convert interleaved complex signal to Polar notation
+ * Same rules as dsp_rect2polar on the interleaved layout, see dsp_iq.h
+ *
+ * @param mag_output magnitude output destination array
+ * @param phase_output phase output destination array
+ * @param iq_input interleaved complex input signal, 2 * sig_len long
+ * @param sig_len number of complex samples
+ */
+void dsp_rect2polar_iq(dsp_val_t *mag_output, dsp_val_t *phase_output, dsp_val_t *iq_input, dsp_size_t sig_len)
+{
+    dsp_rect2polar_iq_f64(mag_output, phase_output, iq_input, sig_len);
+}
@@ -0,0 +1,267 @@
+/**
+ * @file dsp_dft_tmpl.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP Discrete Fourier Transform, precision template (library internal)
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Included by dsp_dft.c once per precision, see dsp_prec.h
+ */
+
+
+/**
+ * @brief Calculate Discrete Fourier transform
+ * Decomposing singnal to sine and cosin waves
+ *                        
+ *                              Re X[]
+ *                        +---> N/2 + 1 cosine wave amplitudes
+ *                        |
+ * N point input -> DFT ->+ 
+ *                        |     Im X[]
+ *                        +---> N/2 + 1 sine wave amplitudes
+ * 
+ *    (Time domain)                    (Frequency domain)
+ * 
+ * A set of sine and cosine waves with unity amplitude
+ * 		ck[i] = cos((2 * PI * k *i) / N)
+ * 		sk[i] = sin((2 * PI * k *i) / N)
+ * 
+ * @param input_sig input signal source array
+ * @param dest_rex destination rex array
+ * @param dest_imx destination imx array
+ * @param input_sig_len length of input signal
+ */
+void DSP_FN(dsp_dft)(DSP_T *input_sig, DSP_T *dest_rex,  DSP_T *dest_imx, dsp_size_t input_sig_len)
+{
+    dsp_size_t i, k;
+    DSP_INSTR_BEGIN();
+
+    // calc re and im arrays as result, k * i is reduced modulo N in integer,
+    // so the phase error of the single precision variant does not grow with N
+    for(k = 0; k < (input_sig_len / 2); k++) {
+        for(i = 0, *(dest_rex + k) = 0, *(dest_imx + k) = 0; i < input_sig_len; i++) {
+            *(dest_rex + k) += *(input_sig + i) * DSP_COS((DSP_T)(2.0 * M_PI) * ((k * i) % input_sig_len) / input_sig_len);
+            *(dest_imx + k) -= *(input_sig + i) * DSP_SIN((DSP_T)(2.0 * M_PI) * ((k * i) % input_sig_len) / input_sig_len);
+        }
+    }
+    DSP_INSTR_END(DSP_INSTR_DFT, input_sig_len * sizeof(DSP_T));
+}
+
+/**
+ * @brief Calculate the Inverse Discrete Fourier Transform
+ * Synthesing sine and cosine waves to one signal
+ * 		Re negX[k] = Re X[k] / N / 2 Except k = 0 then Re X[k] / N
+ * 		Im negX[k] = Im X[k] / N / 2 Except k = 0 then Re X[k] / N
+ * 
+ * @param dest_sig destination output signal array
+ * @param input_rex input rex signal array 
+ * @param input_imx input imx signal array
+ * @param idft_len length of original time domain signal length
+ */
+void DSP_FN(dsp_idft)(DSP_T *dest_sig, DSP_T *input_rex,  DSP_T *input_imx, dsp_size_t idft_len)
+{
+    dsp_size_t i, k;
+    DSP_T div_rex, div_imx; // dividers
+    DSP_T rex, imx;
+    DSP_INSTR_BEGIN();
+ 
+    // reset destination array
+    for(i = 0; i < idft_len; *(dest_sig + i) = 0.0, i++);
+
+    // calc output signal
+    for(k = 0, div_rex = ((DSP_T)idft_len / (DSP_T)2.0), div_imx = (DSP_T)-1.0 * ((DSP_T)idft_len / (DSP_T)2.0); 
+        k < idft_len / 2; k++) {
+        
+        // prepare input rex and imx
+        rex = *(input_rex + k) / div_rex;
+        imx = *(input_imx + k) / div_imx;
+
+        // exception at zero index
+        if(!k) {
+            rex /= (DSP_T)2.0;
+            imx /= (DSP_T)-2.0;
+        }
+
+        // Calculate output signal
+        for(i = 0; i < idft_len; i++) {
+            *(dest_sig + i) += rex * DSP_COS((DSP_T)(2.0 * M_PI) * ((k * i) % idft_len) / idft_len);
+            *(dest_sig + i) += imx * DSP_SIN((DSP_T)(2.0 * M_PI) * ((k * i) % idft_len) / idft_len);
+        }
+    }
+    DSP_INSTR_END(DSP_INSTR_IDFT, idft_len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Calculate Discrete Fourier Transform magnitude signal from rex and imx
+ * Absoulet value of complex number for each point.
+ * 
+ * @param dest_mag destination signal
+ * @param rex real part array
+ * @param imx imaginary part array
+ * @param rex_imx_len length of magnitude, equal to rex and imx len
+ */
+void DSP_FN(dsp_dft_magnitude)(DSP_T *dest_mag, DSP_T *rex, DSP_T *imx, dsp_size_t rex_imx_len)
+{
+#if DSP_PREC == 64
+    DSP_INSTR_BEGIN();
+
+    /*selected kernel variant, see dsp_cpu.h*/
+    _dsp_kernels()->magnitude(dest_mag, rex, imx, rex_imx_len);
+#else
+    dsp_size_t i;
+    DSP_INSTR_BEGIN();
+
+    for(i = 0; i < rex_imx_len; i++) {
+        *(dest_mag + i) = DSP_SQRT( *(rex + i) * *(rex + i) + *(imx + i) * *(imx + i) );
+    }
+#endif
+    DSP_INSTR_END(DSP_INSTR_DFT_MAGNITUDE, 2 * rex_imx_len * sizeof(DSP_T));
+}
+
+/**
+ * @brief Convert Rectangle notation to Polar notation
+ * Rectengular notation:
+ * Re X[k] , Im X [k]
+ * 
+ * Polar Notation:
+ * Mag X[k], Phase X[k]
+ * M = sqrt( pow(A, 2), pow(B, 2) )
+ * Theta = arctan(B/A)
+ * 
+ * Rectengular to Polar conversion
+ * Mag[k] = sqrt( pow(ReX[k], 2), pow(ImX[k], 2) )
+ * Phase[k] = arctan(ImX[k] / ReX[k])
+ * 
+ * ReX[k] = MagX[k] * cos(PhaseX[k])
+ * ImX[k] = MagX[k] * sin(PhaseX[k])
+ * 
+ * @param mag_output magnitude output destination array
+ * @param phase_output phase output destination array
+ * @param rex_input ReX input signal array
+ * @param imx_input ImX input signal arrau
+ * @param sig_len Length of ReX and Imx
+ */
+void DSP_FN(dsp_rect2polar)(DSP_T *mag_output, DSP_T *phase_output,
+                    DSP_T *rex_input, DSP_T *imx_input, 
+                    dsp_size_t sig_len)
+{
+    dsp_size_t k;
+    const DSP_T zero_for_calc = (DSP_T)10e-20;
+    DSP_INSTR_BEGIN();
+    for(k = 0; k < sig_len; k++) {
+        // magnitude
+        *(mag_output + k) = DSP_SQRT( *(rex_input + k) * *(rex_input + k) + *(imx_input + k) * *(imx_input + k) );
+        *(phase_output + k) = 0.0;
+        // phase rules
+        if(*(rex_input + k) == 0) {
+            *(phase_output +k) = DSP_ATAN(*(imx_input + k) / zero_for_calc);
+        } else {
+            *(phase_output +k) = DSP_ATAN(*(imx_input + k) / *(rex_input + k));
+        }
+        
+        if((*(rex_input + k) < 0) && (*(imx_input + k) < 0)) {
+            *(phase_output + k) -= (DSP_T)M_PI;
+        }
+
+        if((*(rex_input + k) < 0) && (*(imx_input + k) >= 0)) {
+            *(phase_output + k) += (DSP_T)M_PI;
+        }
+    }
+    DSP_INSTR_END(DSP_INSTR_RECT2POLAR, 2 * sig_len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Calculate Discrete Fourier transform with interleaved complex output
+ * Same as dsp_dft, bin k is (dest_iq[2 * k], dest_iq[2 * k + 1])
+ *
+ * @param input_sig input signal
+ * @param dest_iq interleaved destination array, 2 * (input_sig_len / 2) long
+ * @param input_sig_len input signal length
+ */
+void DSP_FN(dsp_dft_iq)(DSP_T *input_sig, DSP_T *dest_iq, dsp_size_t input_sig_len)
+{
+    dsp_size_t i, k;
+    DSP_T *re, *im;
+    DSP_INSTR_BEGIN();
+
+    for(k = 0; k < (input_sig_len / 2); k++) {
+        re = dest_iq + 2 * k;
+        im = re + 1;
+        for(i = 0, *re = 0, *im = 0; i < input_sig_len; i++) {
+            *re += *(input_sig + i) * DSP_COS((DSP_T)(2.0 * M_PI) * ((k * i) % input_sig_len) / input_sig_len);
+            *im -= *(input_sig + i) * DSP_SIN((DSP_T)(2.0 * M_PI) * ((k * i) % input_sig_len) / input_sig_len);
+        }
+    }
+    DSP_INSTR_END(DSP_INSTR_DFT, input_sig_len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Calculate magnitude of interleaved complex signal
+ * Same as dsp_dft_magnitude on the interleaved layout, see dsp_iq.h
+ *
+ * @param dest_mag destination signal
+ * @param iq interleaved complex signal, 2 * mag_len long
+ * @param mag_len length of magnitude
+ */
+void DSP_FN(dsp_dft_magnitude_iq)(DSP_T *dest_mag, DSP_T *iq, dsp_size_t mag_len)
+{
+#if DSP_PREC == 64
+    DSP_INSTR_BEGIN();
+
+    /*selected kernel variant, see dsp_cpu.h*/
+    _dsp_kernels()->iq_magnitude(dest_mag, iq, mag_len);
+#else
+    dsp_size_t i;
+    DSP_INSTR_BEGIN();
+
+    for(i = 0; i < mag_len; i++) {
+        *(dest_mag + i) = DSP_SQRT( *(iq + 2 * i) * *(iq + 2 * i) + *(iq + 2 * i + 1) * *(iq + 2 * i + 1) );
+    }
+#endif
+    DSP_INSTR_END(DSP_INSTR_DFT_MAGNITUDE, 2 * mag_len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Convert interleaved complex signal to Polar notation
+ * Same rules as dsp_rect2polar on the interleaved layout, see dsp_iq.h
+ *
+ * @param mag_output magnitude output destination array
+ * @param phase_output phase output destination array
+ * @param iq_input interleaved complex input signal, 2 * sig_len long
+ * @param sig_len number of complex samples
+ */
+void DSP_FN(dsp_rect2polar_iq)(DSP_T *mag_output, DSP_T *phase_output, DSP_T *iq_input, dsp_size_t sig_len)
+{
+    dsp_size_t k;
+    DSP_T re, im;
+    const DSP_T zero_for_calc = (DSP_T)10e-20;
+    DSP_INSTR_BEGIN();
+    for(k = 0; k < sig_len; k++) {
+        re = *(iq_input + 2 * k);
+        im = *(iq_input + 2 * k + 1);
+
+        // magnitude
+        *(mag_output + k) = DSP_SQRT( re * re + im * im );
+        // phase rules
+        if(re == 0) {
+            *(phase_output + k) = DSP_ATAN(im / zero_for_calc);
+        } else {
+            *(phase_output + k) = DSP_ATAN(im / re);
+        }
+
+        if((re < 0) && (im < 0)) {
+            *(phase_output + k) -= (DSP_T)M_PI;
+        }
+
+        if((re < 0) && (im >= 0)) {
+            *(phase_output + k) += (DSP_T)M_PI;
+        }
+    }
+    DSP_INSTR_END(DSP_INSTR_RECT2POLAR, 2 * sig_len * sizeof(DSP_T));
+}
@@ -0,0 +1,421 @@
+/**
+ * @file dsp_exec.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP execution context: work-stealing thread pool of the parallel functions
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_exec.h"
+#include "dsp_instr.h"
+
+#ifdef DSP_USE_PTHREAD
+    #include <pthread.h>
+    #include <unistd.h>
+    #if defined(__linux__)
+        #include <sched.h>
+    #endif
+#endif
+
+
+#ifdef DSP_USE_PTHREAD
+/*
+Task range of one thread, the owner takes from the front, the thieves from the back
+*/
+typedef struct {
+    pthread_mutex_t lock;
+    dsp_size_t next;
+    dsp_size_t end;
+} _dsp_exec_queue_t;
+
+
+/*
+Worker thread argument
+*/
+typedef struct {
+    dsp_exec_ctx_t *ctx;
+    int id;
+} _dsp_exec_worker_t;
+#endif
+
+
+struct _dsp_exec_ctx {
+    int n_threads;
+#ifdef DSP_USE_PTHREAD
+    int *cpus;
+    int n_cpus;
+    pthread_t *thread;
+    _dsp_exec_worker_t *worker;
+    _dsp_exec_queue_t *queue;
+    int n_queues;                   // allocated task ranges, >= n_threads
+    pthread_mutex_t submit;         // one parallel_for at a time
+    pthread_mutex_t lock;           // job state below
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    unsigned long generation;       // incremented by every job
+    int active;                     // workers still running the job
+    int stop;
+    dsp_exec_task_fn_t fn;
+    void *arg;
+#ifdef DSP_INSTR
+    dsp_instr_snapshot_t instr;     // counters of the workers in the current job
+#endif
+#endif
+};
+
+
+#ifdef DSP_USE_PTHREAD
+/*Nonzero in a thread running a task, nested calls are serial*/
+static __thread int dsp_exec_in_task = 0;
+
+static void _dsp_exec_run(dsp_exec_ctx_t *ctx, int id);
+static int _dsp_exec_take(_dsp_exec_queue_t *q, dsp_size_t *task);
+static int _dsp_exec_steal(dsp_exec_ctx_t *ctx, int id, dsp_size_t *task);
+static void *_dsp_exec_worker(void *arg);
+#endif
+
+
+/**
+ * @brief Create execution context with worker threads
+ *
+ * @param n_threads number of threads including the caller, <= 0: number of online CPUs
+ * @param cpus CPU indices of the worker threads, worker t (1 ... n_threads - 1) is pinned to
+ *             cpus[(t - 1) % n_cpus], the caller thread (thread 0) is not pinned,
+ *             NULL: no affinity (pinning is supported on Linux only)
+ * @param n_cpus length of the cpus array
+ * @return dsp_exec_ctx_t* created context, NULL if the allocation failed
+ */
+dsp_exec_ctx_t *dsp_exec_ctx_create(int n_threads, int *cpus, int n_cpus)
+{
+    dsp_exec_ctx_t *ctx;
+
+    ctx = (dsp_exec_ctx_t *) calloc(1, sizeof(dsp_exec_ctx_t));
+    if(ctx == NULL) {
+        return NULL;
+    }
+    ctx->n_threads = 1;
+
+#ifdef DSP_USE_PTHREAD
+    {
+        int t;
+        long n_cpu_online;
+
+        if(n_threads <= 0) {
+            n_cpu_online = sysconf(_SC_NPROCESSORS_ONLN);
+            n_threads = (n_cpu_online > 0) ? (int)n_cpu_online : 1;
+        }
+
+        ctx->thread = (pthread_t *) calloc(n_threads, sizeof(pthread_t));
+        ctx->worker = (_dsp_exec_worker_t *) calloc(n_threads, sizeof(_dsp_exec_worker_t));
+        ctx->queue = (_dsp_exec_queue_t *) calloc(n_threads, sizeof(_dsp_exec_queue_t));
+        if(cpus != NULL && n_cpus > 0) {
+            ctx->cpus = (int *) malloc(n_cpus * sizeof(int));
+            if(ctx->cpus != NULL) {
+                memcpy(ctx->cpus, cpus, n_cpus * sizeof(int));
+                ctx->n_cpus = n_cpus;
+            }
+        }
+        if(ctx->thread == NULL || ctx->worker == NULL || ctx->queue == NULL ||
+           (cpus != NULL && n_cpus > 0 && ctx->cpus == NULL)) {
+            free(ctx->thread);
+            free(ctx->worker);
+            free(ctx->queue);
+            free(ctx->cpus);
+            free(ctx);
+            return NULL;
+        }
+
+        pthread_mutex_init(&ctx->submit, NULL);
+        pthread_mutex_init(&ctx->lock, NULL);
+        pthread_cond_init(&ctx->start_cond, NULL);
+        pthread_cond_init(&ctx->done_cond, NULL);
+        for(t = 0; t < n_threads; t++) {
+            pthread_mutex_init(&(ctx->queue + t)->lock, NULL);
+        }
+        ctx->n_queues = n_threads;
+
+        /*thread 0 is the caller, a failed start reduces the thread count*/
+        for(t = 1; t < n_threads; t++) {
+            pthread_attr_t attr;
+            int rc;
+
+            (ctx->worker + t)->ctx = ctx;
+            (ctx->worker + t)->id = t;
+            pthread_attr_init(&attr);
+#if defined(__linux__)
+            if(ctx->cpus != NULL) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(*(ctx->cpus + (t - 1) % ctx->n_cpus), &set);
+                pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &set);
+            }
+#endif
+            rc = pthread_create(ctx->thread + t, &attr, _dsp_exec_worker, ctx->worker + t);
+            pthread_attr_destroy(&attr);
+            if(rc != 0) {
+                break;
+            }
+            ctx->n_threads = t + 1;
+        }
+    }
+#else
+    (void)n_threads;
+    (void)cpus;
+    (void)n_cpus;
+#endif
+
+    return ctx;
+}
+
+
+/**
+ * @brief Stop the worker threads and destroy the context
+ *
+ * @param ctx context, can be NULL
+ */
+void dsp_exec_ctx_destroy(dsp_exec_ctx_t *ctx)
+{
+    if(ctx == NULL) {
+        return;
+    }
+
+#ifdef DSP_USE_PTHREAD
+    {
+        int t;
+
+        pthread_mutex_lock(&ctx->lock);
+        ctx->stop = 1;
+        pthread_cond_broadcast(&ctx->start_cond);
+        pthread_mutex_unlock(&ctx->lock);
+
+        for(t = 1; t < ctx->n_threads; t++) {
+            pthread_join(*(ctx->thread + t), NULL);
+        }
+
+        for(t = 0; t < ctx->n_queues; t++) {
+            pthread_mutex_destroy(&(ctx->queue + t)->lock);
+        }
+        pthread_mutex_destroy(&ctx->submit);
+        pthread_mutex_destroy(&ctx->lock);
+        pthread_cond_destroy(&ctx->start_cond);
+        pthread_cond_destroy(&ctx->done_cond);
+        free(ctx->thread);
+        free(ctx->worker);
+        free(ctx->queue);
+        free(ctx->cpus);
+    }
+#endif
+
+    free(ctx);
+}
+
+
+/**
+ * @brief Number of threads including the caller
+ *
+ * @param ctx context, NULL: 1
+ * @return int number of threads
+ */
+int dsp_exec_ctx_threads(dsp_exec_ctx_t *ctx)
+{
+    return (ctx == NULL) ? 1 : ctx->n_threads;
+}
+
+
+/**
+ * @brief Run fn(arg, task) for task = 0 ... n_tasks - 1, returns when every task is finished
+ * The order of the tasks is not defined, the tasks must write disjoint memory.
+ * Called from a task (nested parallelism) the tasks run serially in the calling task,
+ * concurrent calls from more threads wait for each other, so the pool is never oversubscribed.
+ *
+ * @param ctx context, NULL: serial in the caller thread
+ * @param n_tasks number of tasks
+ * @param fn task function
+ * @param arg argument of the task function
+ */
+void dsp_exec_parallel_for(dsp_exec_ctx_t *ctx, dsp_size_t n_tasks, dsp_exec_task_fn_t fn, void *arg)
+{
+    dsp_size_t task;
+
+#ifdef DSP_USE_PTHREAD
+    if(ctx != NULL && ctx->n_threads > 1 && n_tasks > 1 && !dsp_exec_in_task) {
+        int t;
+
+        pthread_mutex_lock(&ctx->submit);
+
+        /*contiguous ranges, equal share per thread*/
+        for(t = 0; t < ctx->n_threads; t++) {
+            (ctx->queue + t)->next = (dsp_size_t)t * n_tasks / ctx->n_threads;
+            (ctx->queue + t)->end = (dsp_size_t)(t + 1) * n_tasks / ctx->n_threads;
+        }
+
+        pthread_mutex_lock(&ctx->lock);
+        ctx->fn = fn;
+        ctx->arg = arg;
+        ctx->active = ctx->n_threads - 1;
+        ctx->generation++;
+        pthread_cond_broadcast(&ctx->start_cond);
+        pthread_mutex_unlock(&ctx->lock);
+
+        _dsp_exec_run(ctx, 0);
+
+        pthread_mutex_lock(&ctx->lock);
+        while(ctx->active > 0) {
+            pthread_cond_wait(&ctx->done_cond, &ctx->lock);
+        }
+#ifdef DSP_INSTR
+        /*work of the pool is counted in the caller thread*/
+        dsp_instr_add(&ctx->instr);
+        memset(&ctx->instr, 0, sizeof(ctx->instr));
+#endif
+        pthread_mutex_unlock(&ctx->lock);
+
+        pthread_mutex_unlock(&ctx->submit);
+        return;
+    }
+#else
+    (void)ctx;
+#endif
+
+    for(task = 0; task < n_tasks; task++) {
+        fn(arg, task);
+    }
+}
+
+
+#ifdef DSP_USE_PTHREAD
+/**
+ * @brief Run tasks of the own range, then steal until every range is empty
+ *
+ * @param ctx context
+ * @param id thread index
+ */
+static void _dsp_exec_run(dsp_exec_ctx_t *ctx, int id)
+{
+    dsp_size_t task;
+
+    dsp_exec_in_task = 1;
+    while(_dsp_exec_take(ctx->queue + id, &task) || _dsp_exec_steal(ctx, id, &task)) {
+        ctx->fn(ctx->arg, task);
+    }
+    dsp_exec_in_task = 0;
+}
+
+
+/**
+ * @brief Take the first task of the range
+ *
+ * @param q task range
+ * @param task output task index
+ * @return int 1 if a task was taken, 0 if the range is empty
+ */
+static int _dsp_exec_take(_dsp_exec_queue_t *q, dsp_size_t *task)
+{
+    int found = 0;
+
+    pthread_mutex_lock(&q->lock);
+    if(q->next < q->end) {
+        *task = q->next++;
+        found = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return found;
+}
+
+
+/**
+ * @brief Steal the back half of the range of another thread
+ * The first stolen task is returned, the rest becomes the own range.
+ *
+ * @param ctx context
+ * @param id thread index of the thief
+ * @param task output task index
+ * @return int 1 if a task was stolen, 0 if every range is empty
+ */
+static int _dsp_exec_steal(dsp_exec_ctx_t *ctx, int id, dsp_size_t *task)
+{
+    int i, victim;
+    dsp_size_t first = 0, end = 0;
+    _dsp_exec_queue_t *q;
+
+    for(i = 1; i < ctx->n_threads && first == end; i++) {
+        victim = (id + i) % ctx->n_threads;
+        q = ctx->queue + victim;
+
+        pthread_mutex_lock(&q->lock);
+        if(q->next < q->end) {
+            end = q->end;
+            first = q->end - (q->end - q->next + 1) / 2;
+            q->end = first;
+        }
+        pthread_mutex_unlock(&q->lock);
+    }
+
+    if(first == end) {
+        return 0;
+    }
+
+    q = ctx->queue + id;
+    pthread_mutex_lock(&q->lock);
+    q->next = first + 1;
+    q->end = end;
+    pthread_mutex_unlock(&q->lock);
+
+    *task = first;
+    return 1;
+}
+
+
+/**
+ * @brief Worker thread: waits for a job, runs it, reports the end
+ * and hands over its instrumentation counters (DSP_INSTR)
+ *
+ * @param arg worker argument
+ * @return void* NULL
+ */
+static void *_dsp_exec_worker(void *arg)
+{
+    _dsp_exec_worker_t *w = (_dsp_exec_worker_t *)arg;
+    dsp_exec_ctx_t *ctx = w->ctx;
+    unsigned long seen = 0;
+#ifdef DSP_INSTR
+    dsp_instr_snapshot_t instr;
+#endif
+
+    for(;;) {
+        pthread_mutex_lock(&ctx->lock);
+        while(!ctx->stop && ctx->generation == seen) {
+            pthread_cond_wait(&ctx->start_cond, &ctx->lock);
+        }
+        if(ctx->stop) {
+            pthread_mutex_unlock(&ctx->lock);
+            break;
+        }
+        seen = ctx->generation;
+        pthread_mutex_unlock(&ctx->lock);
+
+        _dsp_exec_run(ctx, w->id);
+#ifdef DSP_INSTR
+        dsp_instr_snapshot(&instr);
+        dsp_instr_reset();
+#endif
+
+        pthread_mutex_lock(&ctx->lock);
+#ifdef DSP_INSTR
+        dsp_instr_merge(&ctx->instr, &instr);
+#endif
+        if(--ctx->active == 0) {
+            pthread_cond_signal(&ctx->done_cond);
+        }
+        pthread_mutex_unlock(&ctx->lock);
+    }
+    return NULL;
+}
+#endif
@@ -0,0 +1,179 @@
+/**
+ * @file dsp_fft.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP Fast Fourier Transform
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <stdlib.h>
+#include "dsp_fft.h"
+#include "dsp_instr.h"
+#include "dsp_kernels.h"
+
+
+/*Single precision functions*/
+#define DSP_PREC 32
+#include "dsp_prec.h"
+#include "dsp_fft_tmpl.h"
+#undef DSP_PREC
+
+/*Double precision functions*/
+#define DSP_PREC 64
+#include "dsp_prec.h"
+#include "dsp_fft_tmpl.h"
+#undef DSP_PREC
+
+
+/**
+ * @brief Create FFT plan for given transform length
+ *
+ * @param fft_len transform length, must be power of two
+ * @return dsp_fft_plan_t* created plan, NULL if the length is invalid or the allocation failed
+ */
+dsp_fft_plan_t *dsp_fft_plan_create(dsp_size_t fft_len)
+{
+    return dsp_fft_plan_create_f64(fft_len);
+}
+
+
+/**
+ * @brief Destroy FFT plan
+ *
+ * @param plan plan created by dsp_fft_plan_create, can be NULL
+ */
+void dsp_fft_plan_destroy(dsp_fft_plan_t *plan)
+{
+    dsp_fft_plan_destroy_f64(plan);
+}
+
+
+/**
+ * @brief Workspace bytes of an FFT plan created by dsp_fft_plan_create_ws
+ *
+ * @param fft_len transform length, must be power of two
+ * @return dsp_size_t workspace bytes
+ */
+dsp_size_t dsp_fft_plan_workspace_size(dsp_size_t fft_len)
+{
+    return dsp_fft_plan_workspace_size_f64(fft_len);
+}
+
+
+/**
+ * @brief Create FFT plan in workspace
+ * The plan lives until the workspace is released, it must not be destroyed.
+ *
+ * @param fft_len transform length, must be power of two
+ * @param ws workspace
+ * @return dsp_fft_plan_t* created plan, NULL if the length is invalid or the workspace is full
+ */
+dsp_fft_plan_t *dsp_fft_plan_create_ws(dsp_size_t fft_len, dsp_workspace_t *ws)
+{
+    return dsp_fft_plan_create_ws_f64(fft_len, ws);
+}
+
+
+/**
+ * @brief Calculate in-place Fast Fourier Transform (radix-2, decimation in time)
+ * Same result as the complex DFT, without scaling:
+ *
+ * X[k] = sum (x[n] * exp(-j * 2 * k * PI * n / N)) | from n = 0 to n = N - 1
+ *
+ * @param plan FFT plan
+ * @param rex real part array, N elements, input and output
+ * @param imx imaginary part array, N elements, input and output
+ */
+void dsp_fft(dsp_fft_plan_t *plan, dsp_val_t *rex, dsp_val_t *imx)
+{
+    dsp_fft_f64(plan, rex, imx);
+}
+
+
+/**
+ * @brief Calculate in-place Inverse Fast Fourier Transform
+ * Scaled by 1/N, so dsp_ifft(dsp_fft(x)) == x
+ *
+ * x[n] = 1/N * sum (X[k] * exp(j * 2 * k * PI * n / N)) | from k = 0 to k = N - 1
+ *
+ * @param plan FFT plan
+ * @param rex real part array, N elements, input and output
+ * @param imx imaginary part array, N elements, input and output
+ */
+void dsp_ifft(dsp_fft_plan_t *plan, dsp_val_t *rex, dsp_val_t *imx)
+{
+    dsp_ifft_f64(plan, rex, imx);
+}
+
+
+/**
+ * @brief Calculate in-place Fast Fourier Transform of interleaved complex signal
+ * Same result as dsp_fft, the layout is interleaved, see dsp_iq.h
+ *
+ * @param plan FFT plan
+ * @param iq interleaved complex array, 2 * N elements, input and output
+ */
+void dsp_fft_iq(dsp_fft_plan_t *plan, dsp_val_t *iq)
+{
+    dsp_fft_iq_f64(plan, iq);
+}
+
+
+/**
+ * @brief Calculate in-place Inverse Fast Fourier Transform of interleaved complex signal
+ * Same result as dsp_ifft, the layout is interleaved, see dsp_iq.h
+ *
+ * @param plan FFT plan
+ * @param iq interleaved complex array, 2 * N elements, input and output
+ */
+void dsp_ifft_iq(dsp_fft_plan_t *plan, dsp_val_t *iq)
+{
+    dsp_ifft_iq_f64(plan, iq);
+}
+
+
+/**
+ * @brief Calculate batch of in-place FFTs with the same plan
+ *
+ * @param plan FFT plan, shared by the threads
+ * @param rex real part array, n_batch * N elements, input and output
+ * @param imx imaginary part array, n_batch * N elements, input and output
+ * @param n_batch number of transforms
+ * @param ctx execution context, NULL: serial
+ */
+void dsp_fft_batch(dsp_fft_plan_t *plan, dsp_val_t *rex, dsp_val_t *imx, dsp_size_t n_batch, dsp_exec_ctx_t *ctx)
+{
+    dsp_fft_batch_f64(plan, rex, imx, n_batch, ctx);
+}
+
+
+/**
+ * @brief Calculate batch of in-place IFFTs with the same plan
+ *
+ * @param plan FFT plan, shared by the threads
+ * @param rex real part array, n_batch * N elements, input and output
+ * @param imx imaginary part array, n_batch * N elements, input and output
+ * @param n_batch number of transforms
+ * @param ctx execution context, NULL: serial
+ */
+void dsp_ifft_batch(dsp_fft_plan_t *plan, dsp_val_t *rex, dsp_val_t *imx, dsp_size_t n_batch, dsp_exec_ctx_t *ctx)
+{
+    dsp_ifft_batch_f64(plan, rex, imx, n_batch, ctx);
+}
+
+
+/**
+ * @brief Get the smallest power of two, which is not less than the given length
+ *
+ * @param len length
+ * @return dsp_size_t power of two length
+ */
+dsp_size_t dsp_fft_next_pow2(dsp_size_t len)
+{
+    dsp_size_t n;
+    for(n = 1; n < len; n <<= 1);
+    return n;
+}
@@ -0,0 +1,415 @@
+/**
+ * @file dsp_fft_tmpl.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP Fast Fourier Transform, precision template (library internal)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * Included by dsp_fft.c once per precision, see dsp_prec.h
+ * The twiddle factors are calculated in double precision in both variants.
+ */
+
+
+static void DSP_FN(_dsp_fft_core)(DSP_TN(dsp_fft_plan) *plan, DSP_T *rex, DSP_T *imx, DSP_T sign);
+static void DSP_FN(_dsp_fft_core_iq)(DSP_TN(dsp_fft_plan) *plan, DSP_T *iq, DSP_T sign);
+static void DSP_FN(_dsp_fft_plan_tables)(DSP_TN(dsp_fft_plan) *plan, dsp_size_t fft_len);
+
+
+/**
+ * @brief Create FFT plan for given transform length
+ *
+ * @param fft_len transform length, must be power of two
+ * @return dsp_fft_plan_t* created plan, NULL if the length is invalid or the allocation failed
+ */
+DSP_TN(dsp_fft_plan) *DSP_FN(dsp_fft_plan_create)(dsp_size_t fft_len)
+{
+    DSP_TN(dsp_fft_plan) *plan;
+
+    /*only power of two lengths are supported*/
+    if(fft_len < 2 || (fft_len & (fft_len - 1)) != 0) {
+        return NULL;
+    }
+
+    plan = (DSP_TN(dsp_fft_plan) *) calloc(1, sizeof(DSP_TN(dsp_fft_plan)));
+    if(plan == NULL) {
+        return NULL;
+    }
+
+    plan->cos_tbl = (DSP_T *) malloc((fft_len / 2) * sizeof(DSP_T));
+    plan->sin_tbl = (DSP_T *) malloc((fft_len / 2) * sizeof(DSP_T));
+    plan->rev_tbl = (dsp_size_t *) malloc(fft_len * sizeof(dsp_size_t));
+
+    if(plan->cos_tbl == NULL || plan->sin_tbl == NULL || plan->rev_tbl == NULL) {
+        DSP_FN(dsp_fft_plan_destroy)(plan);
+        return NULL;
+    }
+
+    DSP_FN(_dsp_fft_plan_tables)(plan, fft_len);
+    return plan;
+}
+
+
+/**
+ * @brief Workspace bytes of an FFT plan created by dsp_fft_plan_create_ws
+ *
+ * @param fft_len transform length, must be power of two
+ * @return dsp_size_t workspace bytes
+ */
+dsp_size_t DSP_FN(dsp_fft_plan_workspace_size)(dsp_size_t fft_len)
+{
+    return DSP_WORKSPACE_ROUND(sizeof(DSP_TN(dsp_fft_plan))) +
+           2 * DSP_WORKSPACE_ROUND((fft_len / 2) * sizeof(DSP_T)) +
+           DSP_WORKSPACE_ROUND(fft_len * sizeof(dsp_size_t));
+}
+
+
+/**
+ * @brief Create FFT plan in workspace
+ * The plan lives until the workspace is released, it must not be destroyed.
+ *
+ * @param fft_len transform length, must be power of two
+ * @param ws workspace
+ * @return dsp_fft_plan_t* created plan, NULL if the length is invalid or the workspace is full
+ */
+DSP_TN(dsp_fft_plan) *DSP_FN(dsp_fft_plan_create_ws)(dsp_size_t fft_len, dsp_workspace_t *ws)
+{
+    DSP_TN(dsp_fft_plan) *plan;
+    dsp_size_t mark = dsp_workspace_mark(ws);
+
+    if(fft_len < 2 || (fft_len & (fft_len - 1)) != 0) {
+        return NULL;
+    }
+
+    plan = (DSP_TN(dsp_fft_plan) *) dsp_workspace_alloc(ws, sizeof(DSP_TN(dsp_fft_plan)));
+    if(plan == NULL) {
+        return NULL;
+    }
+
+    plan->cos_tbl = (DSP_T *) dsp_workspace_alloc(ws, (fft_len / 2) * sizeof(DSP_T));
+    plan->sin_tbl = (DSP_T *) dsp_workspace_alloc(ws, (fft_len / 2) * sizeof(DSP_T));
+    plan->rev_tbl = (dsp_size_t *) dsp_workspace_alloc(ws, fft_len * sizeof(dsp_size_t));
+
+    if(plan->cos_tbl == NULL || plan->sin_tbl == NULL || plan->rev_tbl == NULL) {
+        dsp_workspace_release(ws, mark);
+        return NULL;
+    }
+
+    DSP_FN(_dsp_fft_plan_tables)(plan, fft_len);
+    return plan;
+}
+
+
+/**
+ * @brief Destroy FFT plan
+ *
+ * @param plan plan created by dsp_fft_plan_create, can be NULL
+ */
+void DSP_FN(dsp_fft_plan_destroy)(DSP_TN(dsp_fft_plan) *plan)
+{
+    if(plan == NULL) {
+        return;
+    }
+
+    free(plan->cos_tbl);
+    free(plan->sin_tbl);
+    free(plan->rev_tbl);
+    free(plan);
+}
+
+
+/**
+ * @brief Calculate in-place Fast Fourier Transform (radix-2, decimation in time)
+ * Same result as the complex DFT, without scaling:
+ *
+ * X[k] = sum (x[n] * exp(-j * 2 * k * PI * n / N)) | from n = 0 to n = N - 1
+ *
+ * @param plan FFT plan
+ * @param rex real part array, N elements, input and output
+ * @param imx imaginary part array, N elements, input and output
+ */
+void DSP_FN(dsp_fft)(DSP_TN(dsp_fft_plan) *plan, DSP_T *rex, DSP_T *imx)
+{
+    DSP_INSTR_BEGIN();
+    DSP_FN(_dsp_fft_core)(plan, rex, imx, (DSP_T)-1.0);
+    DSP_INSTR_END(DSP_INSTR_FFT, 2 * plan->len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Calculate in-place Inverse Fast Fourier Transform
+ * Scaled by 1/N, so dsp_ifft(dsp_fft(x)) == x
+ *
+ * x[n] = 1/N * sum (X[k] * exp(j * 2 * k * PI * n / N)) | from k = 0 to k = N - 1
+ *
+ * @param plan FFT plan
+ * @param rex real part array, N elements, input and output
+ * @param imx imaginary part array, N elements, input and output
+ */
+void DSP_FN(dsp_ifft)(DSP_TN(dsp_fft_plan) *plan, DSP_T *rex, DSP_T *imx)
+{
+    dsp_size_t i;
+    DSP_T scale = (DSP_T)1.0 / (DSP_T)plan->len;
+    DSP_INSTR_BEGIN();
+
+    DSP_FN(_dsp_fft_core)(plan, rex, imx, (DSP_T)1.0);
+
+    for(i = 0; i < plan->len; i++) {
+        *(rex + i) *= scale;
+        *(imx + i) *= scale;
+    }
+    DSP_INSTR_END(DSP_INSTR_IFFT, 2 * plan->len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Calculate in-place Fast Fourier Transform of interleaved complex signal
+ * Same result as dsp_fft, the layout is interleaved, see dsp_iq.h
+ *
+ * @param plan FFT plan
+ * @param iq interleaved complex array, 2 * N elements, input and output
+ */
+void DSP_FN(dsp_fft_iq)(DSP_TN(dsp_fft_plan) *plan, DSP_T *iq)
+{
+    DSP_INSTR_BEGIN();
+    DSP_FN(_dsp_fft_core_iq)(plan, iq, (DSP_T)-1.0);
+    DSP_INSTR_END(DSP_INSTR_FFT, 2 * plan->len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Calculate in-place Inverse Fast Fourier Transform of interleaved complex signal
+ * Same result as dsp_ifft, the layout is interleaved, see dsp_iq.h
+ *
+ * @param plan FFT plan
+ * @param iq interleaved complex array, 2 * N elements, input and output
+ */
+void DSP_FN(dsp_ifft_iq)(DSP_TN(dsp_fft_plan) *plan, DSP_T *iq)
+{
+    dsp_size_t i;
+    DSP_T scale = (DSP_T)1.0 / (DSP_T)plan->len;
+    DSP_INSTR_BEGIN();
+
+    DSP_FN(_dsp_fft_core_iq)(plan, iq, (DSP_T)1.0);
+
+    for(i = 0; i < 2 * plan->len; i++) {
+        *(iq + i) *= scale;
+    }
+    DSP_INSTR_END(DSP_INSTR_IFFT, 2 * plan->len * sizeof(DSP_T));
+}
+
+
+/*
+Transforms of the batch, one task per transform
+*/
+typedef struct {
+    DSP_TN(dsp_fft_plan) *plan;
+    DSP_T *rex;
+    DSP_T *imx;
+    int inverse;
+} DSP_TN(_dsp_fft_batch_job);
+
+
+static void DSP_FN(_dsp_fft_batch_task)(void *arg, dsp_size_t t)
+{
+    DSP_TN(_dsp_fft_batch_job) *job = (DSP_TN(_dsp_fft_batch_job) *)arg;
+    dsp_size_t offset = t * job->plan->len;
+
+    if(job->inverse) {
+        DSP_FN(dsp_ifft)(job->plan, job->rex + offset, job->imx + offset);
+    } else {
+        DSP_FN(dsp_fft)(job->plan, job->rex + offset, job->imx + offset);
+    }
+}
+
+
+/**
+ * @brief Calculate batch of in-place FFTs with the same plan
+ * Transform t is in rex[t * N ... (t + 1) * N - 1] and imx[t * N ... (t + 1) * N - 1].
+ *
+ * @param plan FFT plan, shared by the threads
+ * @param rex real part array, n_batch * N elements, input and output
+ * @param imx imaginary part array, n_batch * N elements, input and output
+ * @param n_batch number of transforms
+ * @param ctx execution context, NULL: serial
+ */
+void DSP_FN(dsp_fft_batch)(DSP_TN(dsp_fft_plan) *plan, DSP_T *rex, DSP_T *imx, dsp_size_t n_batch, dsp_exec_ctx_t *ctx)
+{
+    DSP_TN(_dsp_fft_batch_job) job;
+
+    job.plan = plan;
+    job.rex = rex;
+    job.imx = imx;
+    job.inverse = 0;
+    dsp_exec_parallel_for(ctx, n_batch, DSP_FN(_dsp_fft_batch_task), &job);
+}
+
+
+/**
+ * @brief Calculate batch of in-place IFFTs with the same plan, layout as dsp_fft_batch
+ *
+ * @param plan FFT plan, shared by the threads
+ * @param rex real part array, n_batch * N elements, input and output
+ * @param imx imaginary part array, n_batch * N elements, input and output
+ * @param n_batch number of transforms
+ * @param ctx execution context, NULL: serial
+ */
+void DSP_FN(dsp_ifft_batch)(DSP_TN(dsp_fft_plan) *plan, DSP_T *rex, DSP_T *imx, dsp_size_t n_batch, dsp_exec_ctx_t *ctx)
+{
+    DSP_TN(_dsp_fft_batch_job) job;
+
+    job.plan = plan;
+    job.rex = rex;
+    job.imx = imx;
+    job.inverse = 1;
+    dsp_exec_parallel_for(ctx, n_batch, DSP_FN(_dsp_fft_batch_task), &job);
+}
+
+
+/**
+ * @brief Radix-2 butterfly network
+ * 1. reorder input with bit reversal
+ * 2. log2(N) butterfly stages, stage s combines 2^s point transforms
+ *
+ * Butterfly:
+ *      A' = A + W * B
+ *      B' = A - W * B
+ *      W = cos(2 * PI * k / size) + j * sign * sin(2 * PI * k / size)
+ *
+ * @param plan FFT plan
+ * @param rex real part array
+ * @param imx imaginary part array
+ * @param sign -1.0 for forward, 1.0 for inverse transform
+ */
+static void DSP_FN(_dsp_fft_core)(DSP_TN(dsp_fft_plan) *plan, DSP_T *rex, DSP_T *imx, DSP_T sign)
+{
+    dsp_size_t i, j, size;
+    DSP_T tmp;
+#if DSP_PREC != 64
+    dsp_size_t k, half, step, a, b;
+    DSP_T wr, wi, tr, ti;
+#endif
+    dsp_size_t n = plan->len;
+
+    /*bit reversal reordering*/
+    for(i = 0; i < n; i++) {
+        j = *(plan->rev_tbl + i);
+        if(j > i) {
+            tmp = *(rex + i); *(rex + i) = *(rex + j); *(rex + j) = tmp;
+            tmp = *(imx + i); *(imx + i) = *(imx + j); *(imx + j) = tmp;
+        }
+    }
+
+    /*butterfly stages*/
+#if DSP_PREC == 64
+    for(size = 2; size <= n; size <<= 1) {
+        _dsp_kernels()->fft_stage(rex, imx, n, size >> 1, n / size, plan->cos_tbl, plan->sin_tbl, sign);
+    }
+#else
+    for(size = 2; size <= n; size <<= 1) {
+        half = size >> 1;
+        step = n / size;
+
+        for(k = 0; k < half; k++) {
+            wr = *(plan->cos_tbl + k * step);
+            wi = sign * *(plan->sin_tbl + k * step);
+
+            for(a = k; a < n; a += size) {
+                b = a + half;
+                tr = *(rex + b) * wr - *(imx + b) * wi;
+                ti = *(rex + b) * wi + *(imx + b) * wr;
+                *(rex + b) = *(rex + a) - tr;
+                *(imx + b) = *(imx + a) - ti;
+                *(rex + a) += tr;
+                *(imx + a) += ti;
+            }
+        }
+    }
+#endif
+}
+
+
+/**
+ * @brief Radix-2 butterfly network on interleaved complex samples
+ * Same steps and operations as _dsp_fft_core, sample i is (iq[2 * i], iq[2 * i + 1])
+ *
+ * @param plan FFT plan
+ * @param iq interleaved complex array
+ * @param sign -1.0 for forward, 1.0 for inverse transform
+ */
+static void DSP_FN(_dsp_fft_core_iq)(DSP_TN(dsp_fft_plan) *plan, DSP_T *iq, DSP_T sign)
+{
+    dsp_size_t i, j, size;
+    DSP_T tmp;
+#if DSP_PREC != 64
+    dsp_size_t k, half, step, a, b;
+    DSP_T wr, wi, tr, ti;
+#endif
+    dsp_size_t n = plan->len;
+
+    /*bit reversal reordering of the complex samples*/
+    for(i = 0; i < n; i++) {
+        j = *(plan->rev_tbl + i);
+        if(j > i) {
+            tmp = *(iq + 2 * i); *(iq + 2 * i) = *(iq + 2 * j); *(iq + 2 * j) = tmp;
+            tmp = *(iq + 2 * i + 1); *(iq + 2 * i + 1) = *(iq + 2 * j + 1); *(iq + 2 * j + 1) = tmp;
+        }
+    }
+
+    /*butterfly stages*/
+#if DSP_PREC == 64
+    for(size = 2; size <= n; size <<= 1) {
+        _dsp_kernels()->fft_stage_iq(iq, n, size >> 1, n / size, plan->cos_tbl, plan->sin_tbl, sign);
+    }
+#else
+    for(size = 2; size <= n; size <<= 1) {
+        half = size >> 1;
+        step = n / size;
+
+        for(k = 0; k < half; k++) {
+            wr = *(plan->cos_tbl + k * step);
+            wi = sign * *(plan->sin_tbl + k * step);
+
+            for(a = 2 * k; a < 2 * n; a += 2 * size) {
+                b = a + 2 * half;
+                tr = *(iq + b) * wr - *(iq + b + 1) * wi;
+                ti = *(iq + b) * wi + *(iq + b + 1) * wr;
+                *(iq + b) = *(iq + a) - tr;
+                *(iq + b + 1) = *(iq + a + 1) - ti;
+                *(iq + a) += tr;
+                *(iq + a + 1) += ti;
+            }
+        }
+    }
+#endif
+}
+
+
+/**
+ * @brief Length, twiddle factor and bit reversal tables of the plan
+ *
+ * @param plan plan with allocated tables
+ * @param fft_len transform length, power of two
+ */
+static void DSP_FN(_dsp_fft_plan_tables)(DSP_TN(dsp_fft_plan) *plan, dsp_size_t fft_len)
+{
+    dsp_size_t i, j, bits;
+
+    plan->len = fft_len;
+    for(bits = 0; ((dsp_size_t)1 << bits) < fft_len; bits++);
+    plan->log2_len = bits;
+
+    /*twiddle factors*/
+    for(i = 0; i < fft_len / 2; i++) {
+        *(plan->cos_tbl + i) = (DSP_T)cos(2.0 * M_PI * i / fft_len);
+        *(plan->sin_tbl + i) = (DSP_T)sin(2.0 * M_PI * i / fft_len);
+    }
+
+    /*bit reversal table*/
+    for(i = 0; i < fft_len; i++) {
+        for(j = 0, *(plan->rev_tbl + i) = 0; j < bits; j++) {
+            *(plan->rev_tbl + i) |= ((i >> j) & 1) << (bits - 1 - j);
+        }
+    }
+}
@@ -10,90 +10,27 @@
  */
 
 #include "dsp_filter.h"
+#include "dsp_instr.h"
 
+static dsp_val_t _dsp_bessel_i0(dsp_val_t x);
+static dsp_val_t _dsp_kaiser_window_beta(int idx, dsp_size_t filter_len, dsp_val_t beta);
 
-static void _dsp_filter_kernel(dsp_val_t *output_filter, 
-                                dsp_val_t input_sample_freq_khz, 
-                                dsp_val_t cutoff_freq_khz,
-                                dsp_val_t (*window_calc)(int, dsp_size_t),
-                                void (*spectral_op)(dsp_val_t*, int, dsp_size_t), 
-                                dsp_size_t filter_len);
 
+/*Kaiser window shape parameter of dsp_kaiser_window, the filter design does not use it*/
+static dsp_val_t _dsp_kaiser_beta = 0.0;
 
 
-/**
- * @brief Filter kernel function to create common interface for different types
- * Cutoff frequency must be between 0.0 and 0.5
- * sinc function:
- *      h[i] = sin(2 * PI * fc * i) / (i * PI)
- * After applying sinc function, window calculation is also applied. if the function pointer is NULL,
- * Hamming window is the default
- * 
- * Example calculation of cutoff:
- * You have to know the sample frequency of the input signal what you have to filter, for example 48kHz
- * Nyquist frequency is 24kHz.
- * 24kHz => 0.5
- * expcted 10kHz:
- * 10 kHz => (10kHz/ 24kHz) * 0.5
- * 
- * Filter len calculation:
- * M ~= 4 / BW => 
- * BW: is the transition band width, transition band is the frequencies between passband and stopband 
- * M: length of filer kernel, approximation
- * 
- * Additional spectral operation support with function pointer
- * Args: filter array pointer, index of element, filter len
- * @param output_filter filter output result
- * @param input_sample_freq_khz known filterable signal sample frequency in kHz 
- * @param cutoff_freq_khz cutoff frequency in kHz
- * @param window_calc window calculation function for given index. int argument: index of filter, dsp_size_t argument: size of filter
- * @param spectral_op additional spectral operation function pointer
- * @param filter_len filter len
- */
-static void _dsp_filter_kernel(dsp_val_t *output_filter, 
-                                dsp_val_t input_sample_freq_khz, 
-                                dsp_val_t cutoff_freq_khz,
-                                dsp_val_t (*window_calc)(int, dsp_size_t),
-                                void (*spectral_op)(dsp_val_t*, int, dsp_size_t), 
-                                dsp_size_t filter_len)
-{
+/*Single precision functions*/
+#define DSP_PREC 32
+#include "dsp_prec.h"
+#include "dsp_filter_tmpl.h"
+#undef DSP_PREC
 
-    dsp_size_t i;
-    
-    /*calculate cutoff*/
-    dsp_val_t c = (cutoff_freq_khz / input_sample_freq_khz);
-    
-    /*calculate index, which can be negative*/
-    int offset;
-    for(i = 0; i < filter_len; i++) {
-
-        /*index ofset calculation*/
-        offset = (int)i - (filter_len / 2); 
-
-        /*special rules for center*/
-        if(offset == 0) {
-            *(output_filter + i)  = 2.0 * M_PI * c;
-        } else {
-            
-            /*Sinc calculation*/
-            *(output_filter + i) = sin(2.0 * M_PI * c * offset) / offset;
-            
-            /*Window calculation*/
-            if(window_calc == NULL) {
-                /*Default is the Hamming window*/
-                *(output_filter + i) *= dsp_hamming_window(i, filter_len);    
-            } else {
-                *(output_filter + i) *= window_calc(i, filter_len);
-            }
-             
-        }
-
-        /*do spectral inversion or other further operation, if function pointer is set*/
-        if (spectral_op != NULL) {
-            spectral_op(output_filter, i, filter_len);
-        }
-    }
-}
+/*Double precision functions*/
+#define DSP_PREC 64
+#include "dsp_prec.h"
+#include "dsp_filter_tmpl.h"
+#undef DSP_PREC
 
 
 /**
@@ -126,12 +63,9 @@ static void _dsp_filter_kernel(dsp_val_t *output_filter,
 void dsp_lp_win_sinc_filter(dsp_val_t *output_filter, dsp_val_t input_sample_freq_khz, dsp_val_t cutoff_freq_khz,
                             dsp_val_t (*window_calc)(int, dsp_size_t), dsp_size_t filter_len)
 {
-    /*create simple lowpass filter*/
-    _dsp_filter_kernel(output_filter, input_sample_freq_khz, 
-                        cutoff_freq_khz, window_calc, NULL, filter_len);
+    dsp_lp_win_sinc_filter_f64(output_filter, input_sample_freq_khz, cutoff_freq_khz, window_calc, filter_len);
 }
 
-
 /**
  * @brief Create high-pass windowed sinc filter
  * Cutoff frequency must be between 0.0 and 0.5
@@ -166,12 +100,9 @@ void dsp_lp_win_sinc_filter(dsp_val_t *output_filter, dsp_val_t input_sample_fre
 void dsp_hp_win_sinc_filter(dsp_val_t *output_filter, dsp_val_t input_sample_freq_khz, dsp_val_t cutoff_freq_khz,
                             dsp_val_t (*window_calc)(int, dsp_size_t), dsp_size_t filter_len)
 {
-    /*Create low-pass filter with spectral inversion*/
-    _dsp_filter_kernel(output_filter, input_sample_freq_khz, 
-                    cutoff_freq_khz, window_calc, dsp_specteral_inversion, filter_len);
+    dsp_hp_win_sinc_filter_f64(output_filter, input_sample_freq_khz, cutoff_freq_khz, window_calc, filter_len);
 }
 
-
 /**
  * @brief Create band-pass windowed sinc filter
  * Cutoff frequency must be between 0.0 and 0.5
@@ -211,67 +142,10 @@ void dsp_bp_win_sinc_filter(dsp_val_t *output_filter, dsp_val_t input_sample_fre
                             dsp_val_t lower_cutoff_freq_khz, dsp_val_t upper_cutoff_freq_khz,
                             dsp_val_t (*window_calc)(int, dsp_size_t), dsp_size_t filter_len)
 {
-
-    dsp_size_t i;
-    
-    /*filter values*/
-    dsp_val_t l_filter, u_filter;
-
-    /*calculate lower cutoff*/
-    dsp_val_t lc = (lower_cutoff_freq_khz / input_sample_freq_khz);
-    
-    /*calculate upper cutoff*/
-    dsp_val_t uc = (upper_cutoff_freq_khz / input_sample_freq_khz);
-    
-    /*calculate index, which can be negative*/
-    int offset;
-    for(i = 0; i < filter_len; i++) {
-
-        /*index ofset calculation*/
-        offset = (int)i - (filter_len / 2); 
-
-        /*special rules for center*/
-        if(offset == 0) {
-            l_filter = 2.0 * M_PI * lc;
-            u_filter = 2.0 * M_PI * uc;
-
-        } else {
-            
-            /*Sinc calculation*/
-            l_filter = sin(2.0 * M_PI * lc * offset) / offset;
-            u_filter = sin(2.0 * M_PI * uc * offset) / offset;
-
-
-            /*Window calculation*/
-            if(window_calc == NULL) {
-                /*Default is the Hamming window*/
-                l_filter *= dsp_hamming_window(i, filter_len);
-                u_filter *= dsp_hamming_window(i, filter_len);    
-            } else {
-                l_filter *= window_calc(i, filter_len);
-                u_filter *= window_calc(i, filter_len);
-            }
-             
-        }
-
-        /*change low pass filter to high pass filter using spectral inversion*/
-        u_filter *= -1.0;
-        if (i == filter_len / 2) {
-            u_filter += 1.0;
-        }
-
-        /*calculate output destination filter*/
-        *(output_filter + i) = l_filter + u_filter;
-
-        /*change band reject filter into bandpass filter using spectral inversion*/
-        *(output_filter + i) *= -1.0;
-        if (i == filter_len / 2) {
-            *(output_filter + i) += 1.0;
-        }
-    }
+    dsp_bp_win_sinc_filter_f64(output_filter, input_sample_freq_khz, lower_cutoff_freq_khz, upper_cutoff_freq_khz,
+                               window_calc, filter_len);
 }
 
-
 /**
  * @brief Calculate Hamming window
  * 
@@ -281,7 +155,7 @@ void dsp_bp_win_sinc_filter(dsp_val_t *output_filter, dsp_val_t input_sample_fre
  */
 dsp_val_t dsp_hamming_window(int idx, dsp_size_t filter_len)
 {
-    return (0.54 - 0.46 * cos(2.0 * M_PI * idx / filter_len));
+    return dsp_hamming_window_f64(idx, filter_len);
 }
 
 /**
@@ -293,8 +167,115 @@ dsp_val_t dsp_hamming_window(int idx, dsp_size_t filter_len)
  */
 dsp_val_t dsp_blackman_window(int idx, dsp_size_t filter_len)
 {
-    return (0.42 - 0.5 * cos((2.0 * M_PI * idx) / filter_len) + 
-            0.08 * cos((4.0 * M_PI * idx) / filter_len));
+    return dsp_blackman_window_f64(idx, filter_len);
+}
+
+/**
+ * @brief Calculate Kaiser window
+ * w[i] = I0(beta * sqrt(1 - pow((i - N/2) / (N/2), 2))) / I0(beta)
+ * I0: zeroth order modified Bessel function of the first kind
+ *
+ * The shape parameter is set by dsp_kaiser_set_beta, it is stored globally because the
+ * window_calc slot has no context argument. dsp_kaiser_win_sinc_filter does not use it,
+ * the filter design is safe to call from more threads.
+ *
+ * @param idx index of filter
+ * @param filter_len filter len
+ * @return dsp_val_t calculation result
+ */
+dsp_val_t dsp_kaiser_window(int idx, dsp_size_t filter_len)
+{
+    return dsp_kaiser_window_f64(idx, filter_len);
+}
+
+/**
+ * @brief Set the shape parameter of the Kaiser window
+ *
+ * @param beta shape parameter, 0.0 is the rectangle window
+ */
+void dsp_kaiser_set_beta(dsp_val_t beta)
+{
+    _dsp_kaiser_beta = beta;
+}
+
+/**
+ * @brief Calculate the minimal Kaiser windowed sinc filter length and shape parameter
+ * Kaiser formulas:
+ *      N = (A - 7.95) / (14.36 * df) + 1, df = |stop - pass| / sample_freq
+ *      beta = 0.1102 * (A - 8.7)                               A > 50
+ *      beta = 0.5842 * pow(A - 21, 0.4) + 0.07886 * (A - 21)   21 <= A <= 50
+ *      beta = 0                                                A < 21
+ * The length is rounded up to odd number, so the kernel is symmetric around filter_len / 2.
+ *
+ * @param input_sample_freq_khz known filterable signal sample frequency in kHz
+ * @param pass_freq_khz passband edge frequency in kHz
+ * @param stop_freq_khz stopband edge frequency in kHz
+ * @param atten_db stopband attenuation (and passband ripple) in dB, positive number
+ * @param beta calculated shape parameter output, can be NULL
+ * @return dsp_size_t minimal filter length, 0 if pass and stop frequencies are equal
+ */
+dsp_size_t dsp_kaiser_filter_len(dsp_val_t input_sample_freq_khz, dsp_val_t pass_freq_khz, dsp_val_t stop_freq_khz,
+                                 dsp_val_t atten_db, dsp_val_t *beta)
+{
+    dsp_size_t filter_len;
+
+    /*normalized transition band width*/
+    dsp_val_t df = fabs(stop_freq_khz - pass_freq_khz) / input_sample_freq_khz;
+
+    if(df == 0.0) {
+        return 0;
+    }
+
+    /*shape parameter*/
+    if(beta != NULL) {
+        if(atten_db > 50.0) {
+            *beta = 0.1102 * (atten_db - 8.7);
+        } else if(atten_db >= 21.0) {
+            *beta = 0.5842 * pow(atten_db - 21.0, 0.4) + 0.07886 * (atten_db - 21.0);
+        } else {
+            *beta = 0.0;
+        }
+    }
+
+    /*minimal length, rounded up to odd*/
+    filter_len = (dsp_size_t)ceil((atten_db - 7.95) / (14.36 * df)) + 1;
+    if(filter_len < 3) {
+        filter_len = 3;
+    }
+    if(!(filter_len & 1)) {
+        filter_len++;
+    }
+
+    return filter_len;
+}
+
+
+/**
+ * @brief Create Kaiser windowed sinc filter with minimal length
+ * Low-pass filter if pass_freq_khz < stop_freq_khz, high-pass filter otherwise.
+ * Cutoff frequency is the middle of the transition band, passband gain is 1.0.
+ *
+ * Steps:
+ * 1. calculate minimal length and beta (dsp_kaiser_filter_len)
+ * 2. create low-pass filter with dsp_lp_win_sinc_filter using rectangle window
+ * 3. apply Kaiser window of the calculated beta
+ * 4. normalize to unity DC gain
+ * 5. spectral inversion for high-pass filter
+ *
+ * @param output_filter filter output result
+ * @param max_filter_len size of output_filter array
+ * @param input_sample_freq_khz known filterable signal sample frequency in kHz
+ * @param pass_freq_khz passband edge frequency in kHz
+ * @param stop_freq_khz stopband edge frequency in kHz
+ * @param atten_db stopband attenuation (and passband ripple) in dB, positive number
+ * @return dsp_size_t created filter length, 0 if the filter does not fit into max_filter_len
+ */
+dsp_size_t dsp_kaiser_win_sinc_filter(dsp_val_t *output_filter, dsp_size_t max_filter_len,
+                                      dsp_val_t input_sample_freq_khz, dsp_val_t pass_freq_khz,
+                                      dsp_val_t stop_freq_khz, dsp_val_t atten_db)
+{
+    return dsp_kaiser_win_sinc_filter_f64(output_filter, max_filter_len, input_sample_freq_khz,
+                                          pass_freq_khz, stop_freq_khz, atten_db);
 }
 
 /**
@@ -306,8 +287,54 @@ dsp_val_t dsp_blackman_window(int idx, dsp_size_t filter_len)
  */
 void dsp_specteral_inversion(dsp_val_t *filter, int idx, dsp_size_t filter_len)
 {
-        *(filter + idx) *= -1.0;
-        if (idx == filter_len / 2) {
-            *(filter + idx) += 1.0;
+    dsp_specteral_inversion_f64(filter, idx, filter_len);
+}
+
+/**
+ * @brief Zeroth order modified Bessel function of the first kind
+ * I0(x) = sum (pow(pow(x / 2, k) / k!, 2)) | from k = 0
+ *
+ * @param x argument
+ * @return dsp_val_t I0(x)
+ */
+static dsp_val_t _dsp_bessel_i0(dsp_val_t x)
+{
+    dsp_val_t sum = 1.0, term = 1.0;
+    dsp_val_t half_x = x / 2.0;
+    int k;
+
+    for(k = 1; k < 100; k++) {
+        term *= half_x / k;
+        sum += term * term;
+        if(term * term < sum * 1e-16) {
+            break;
         }
-}
\ No newline at end of file
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Kaiser window with given shape parameter
+ *
+ * @param idx index of filter
+ * @param filter_len filter len
+ * @param beta shape parameter
+ * @return dsp_val_t calculation result
+ */
+static dsp_val_t _dsp_kaiser_window_beta(int idx, dsp_size_t filter_len, dsp_val_t beta)
+{
+    dsp_val_t half = (dsp_val_t)(filter_len / 2);
+    dsp_val_t t;
+
+    if(half == 0.0) {
+        return 1.0;
+    }
+
+    t = ((dsp_val_t)idx - half) / half;
+    if(t < -1.0 || t > 1.0) {
+        return 0.0;
+    }
+
+    return _dsp_bessel_i0(beta * sqrt(1.0 - t * t)) / _dsp_bessel_i0(beta);
+}
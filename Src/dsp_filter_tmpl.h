@@ -0,0 +1,401 @@
+/**
+ * @file dsp_filter_tmpl.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP filter function, precision template (library internal)
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Included by dsp_filter.c once per precision, see dsp_prec.h
+ * Requires _dsp_kaiser_beta and _dsp_kaiser_window_beta from dsp_filter.c
+ */
+
+
+/**
+ * @brief Filter kernel function to create common interface for different types
+ * Cutoff frequency must be between 0.0 and 0.5
+ * sinc function:
+ *      h[i] = sin(2 * PI * fc * i) / (i * PI)
+ * After applying sinc function, window calculation is also applied. if the function pointer is NULL,
+ * Hamming window is the default
+ * 
+ * Example calculation of cutoff:
+ * You have to know the sample frequency of the input signal what you have to filter, for example 48kHz
+ * Nyquist frequency is 24kHz.
+ * 24kHz => 0.5
+ * expcted 10kHz:
+ * 10 kHz => (10kHz/ 24kHz) * 0.5
+ * 
+ * Filter len calculation:
+ * M ~= 4 / BW => 
+ * BW: is the transition band width, transition band is the frequencies between passband and stopband 
+ * M: length of filer kernel, approximation
+ * 
+ * Additional spectral operation support with function pointer
+ * Args: filter array pointer, index of element, filter len
+ * @param output_filter filter output result
+ * @param input_sample_freq_khz known filterable signal sample frequency in kHz 
+ * @param cutoff_freq_khz cutoff frequency in kHz
+ * @param window_calc window calculation function for given index. int argument: index of filter, dsp_size_t argument: size of filter
+ * @param spectral_op additional spectral operation function pointer
+ * @param filter_len filter len
+ */
+static void DSP_FN(_dsp_filter_kernel)(DSP_T *output_filter, 
+                                DSP_T input_sample_freq_khz, 
+                                DSP_T cutoff_freq_khz,
+                                DSP_T (*window_calc)(int, dsp_size_t),
+                                void (*spectral_op)(DSP_T*, int, dsp_size_t), 
+                                dsp_size_t filter_len)
+{
+
+    dsp_size_t i;
+    
+    /*calculate cutoff*/
+    DSP_T c = (cutoff_freq_khz / input_sample_freq_khz);
+    
+    /*calculate index, which can be negative*/
+    int offset;
+    for(i = 0; i < filter_len; i++) {
+
+        /*index ofset calculation*/
+        offset = (int)i - (filter_len / 2); 
+
+        /*special rules for center*/
+        if(offset == 0) {
+            *(output_filter + i)  = (DSP_T)(2.0 * M_PI) * c;
+        } else {
+            
+            /*Sinc calculation*/
+            *(output_filter + i) = DSP_SIN((DSP_T)(2.0 * M_PI) * c * offset) / offset;
+            
+            /*Window calculation*/
+            if(window_calc == NULL) {
+                /*Default is the Hamming window*/
+                *(output_filter + i) *= DSP_FN(dsp_hamming_window)(i, filter_len);    
+            } else {
+                *(output_filter + i) *= window_calc(i, filter_len);
+            }
+             
+        }
+
+        /*do spectral inversion or other further operation, if function pointer is set*/
+        if (spectral_op != NULL) {
+            spectral_op(output_filter, i, filter_len);
+        }
+    }
+}
+
+
+/**
+ * @brief Create low-pass windowed sinc filter
+ * Cutoff frequency must be between 0.0 and 0.5
+ * sinc function:
+ *      h[i] = sin(2 * PI * fc * i) / (i * PI)
+ * After applying sinc function, window calculation is also applied. if the function pointer is NULL,
+ * Hamming window is the default
+ * 
+ * 
+ * Example calculation of cutoff:
+ * You have to know the sample frequency of the input signal what you have to filter, for example 48kHz
+ * Nyquist frequency is 24kHz.
+ * 24kHz => 0.5
+ * expcted 10kHz:
+ * 10 kHz => (10kHz/ 24kHz) * 0.5
+ * 
+ * Filter len calculation:
+ * M ~= 4 / BW => 
+ * BW: is the transition band width, transition band is the frequencies between passband and stopband 
+ * M: length of filer kernel, approximation
+ * 
+ * @param output_filter filter output result
+ * @param input_sample_freq_khz known filterable signal sample frequency in kHz 
+ * @param cutoff_freq_khz  cutoff frequency in kHz
+ * @param window_calc window calculation function for given index. int argument: index of filter, dsp_size_t argument: size of filter
+ * @param filter_len filter len
+ */
+void DSP_FN(dsp_lp_win_sinc_filter)(DSP_T *output_filter, DSP_T input_sample_freq_khz, DSP_T cutoff_freq_khz,
+                            DSP_T (*window_calc)(int, dsp_size_t), dsp_size_t filter_len)
+{
+    DSP_INSTR_BEGIN();
+
+    /*create simple lowpass filter*/
+    DSP_FN(_dsp_filter_kernel)(output_filter, input_sample_freq_khz, 
+                        cutoff_freq_khz, window_calc, NULL, filter_len);
+    DSP_INSTR_END(DSP_INSTR_LP_WIN_SINC_FILTER, filter_len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Create high-pass windowed sinc filter
+ * Cutoff frequency must be between 0.0 and 0.5
+ * sinc function:
+ *      h[i] = sin(2 * PI * fc * i) / (i * PI)
+ * After applying sinc function, window calculation is also applied. if the function pointer is NULL,
+ * Hamming window is the default
+ * 
+ * 
+ * Example calculation of cutoff:
+ * You have to know the sample frequency of the input signal what you have to filter, for example 48kHz
+ * Nyquist frequency is 24kHz.
+ * 24kHz => 0.5
+ * expcted 10kHz:
+ * 10 kHz => (10kHz/ 24kHz) * 0.5
+ * 
+ * Filter len calculation:
+ * M ~= 4 / BW => 
+ * BW: is the transition band width, transition band is the frequencies between passband and stopband 
+ * M: length of filer kernel, approximation
+ * 
+ * Steps:
+ * 1. create cutoff low pas filter
+ * 2. spectral inversion transforms to high pass filter
+ *  
+ * @param output_filter filter output result
+ * @param input_sample_freq_khz known filterable signal sample frequency in kHz 
+ * @param cutoff_freq_khz  cutoff frequency in kHz
+ * @param window_calc window calculation function for given index. int argument: index of filter, dsp_size_t argument: size of filter
+ * @param filter_len filter len
+ */
+void DSP_FN(dsp_hp_win_sinc_filter)(DSP_T *output_filter, DSP_T input_sample_freq_khz, DSP_T cutoff_freq_khz,
+                            DSP_T (*window_calc)(int, dsp_size_t), dsp_size_t filter_len)
+{
+    DSP_INSTR_BEGIN();
+
+    /*Create low-pass filter with spectral inversion*/
+    DSP_FN(_dsp_filter_kernel)(output_filter, input_sample_freq_khz, 
+                    cutoff_freq_khz, window_calc, DSP_FN(dsp_specteral_inversion), filter_len);
+    DSP_INSTR_END(DSP_INSTR_HP_WIN_SINC_FILTER, filter_len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Create band-pass windowed sinc filter
+ * Cutoff frequency must be between 0.0 and 0.5
+ * sinc function:
+ *      h[i] = sin(2 * PI * fc * i) / (i * PI)
+ * After applying sinc function, window calculation is also applied. if the function pointer is NULL,
+ * Hamming window is the default
+ * 
+ * 
+ * Example calculation of cutoff:
+ * You have to know the sample frequency of the input signal what you have to filter, for example 48kHz
+ * Nyquist frequency is 24kHz.
+ * 24kHz => 0.5
+ * expcted 10kHz:
+ * 10 kHz => (10kHz/ 24kHz) * 0.5
+ * 
+ * Filter len calculation:
+ * M ~= 4 / BW => 
+ * BW: is the transition band width, transition band is the frequencies between passband and stopband 
+ * M: length of filer kernel, approximation
+ * 
+ * Steps:
+ * 1. create lower cutoff filter
+ * 2. create upper cutoff filter
+ * 3. spectarl inversion of upper cutoff filter, transformed to high pass filter
+ * 4. output filter creation with sum of upper and lower cutoff filter
+ * 5. spectral inversion of ouput filter, transformed from band reject filter to band pass filter
+ * 
+ * @param output_filter filter output result
+ * @param input_sample_freq_khz known filterable signal sample frequency in kHz 
+ * @param lower_cutoff_freq_khz  lower_cutoff frequency in kHz
+ * @param upper_cutoff_freq_khz  upper_cutoff frequency in kHz
+ * @param window_calc window calculation function for given index. int argument: index of filter, dsp_size_t argument: size of filter
+ * @param filter_len filter len
+ */
+void DSP_FN(dsp_bp_win_sinc_filter)(DSP_T *output_filter, DSP_T input_sample_freq_khz, 
+                            DSP_T lower_cutoff_freq_khz, DSP_T upper_cutoff_freq_khz,
+                            DSP_T (*window_calc)(int, dsp_size_t), dsp_size_t filter_len)
+{
+
+    dsp_size_t i;
+    
+    /*filter values*/
+    DSP_T l_filter, u_filter;
+
+    /*calculate lower cutoff*/
+    DSP_T lc = (lower_cutoff_freq_khz / input_sample_freq_khz);
+    
+    /*calculate upper cutoff*/
+    DSP_T uc = (upper_cutoff_freq_khz / input_sample_freq_khz);
+    
+    /*calculate index, which can be negative*/
+    int offset;
+    DSP_INSTR_BEGIN();
+
+    for(i = 0; i < filter_len; i++) {
+
+        /*index ofset calculation*/
+        offset = (int)i - (filter_len / 2); 
+
+        /*special rules for center*/
+        if(offset == 0) {
+            l_filter = (DSP_T)(2.0 * M_PI) * lc;
+            u_filter = (DSP_T)(2.0 * M_PI) * uc;
+
+        } else {
+            
+            /*Sinc calculation*/
+            l_filter = DSP_SIN((DSP_T)(2.0 * M_PI) * lc * offset) / offset;
+            u_filter = DSP_SIN((DSP_T)(2.0 * M_PI) * uc * offset) / offset;
+
+
+            /*Window calculation*/
+            if(window_calc == NULL) {
+                /*Default is the Hamming window*/
+                l_filter *= DSP_FN(dsp_hamming_window)(i, filter_len);
+                u_filter *= DSP_FN(dsp_hamming_window)(i, filter_len);    
+            } else {
+                l_filter *= window_calc(i, filter_len);
+                u_filter *= window_calc(i, filter_len);
+            }
+             
+        }
+
+        /*change low pass filter to high pass filter using spectral inversion*/
+        u_filter *= -1.0;
+        if (i == filter_len / 2) {
+            u_filter += 1.0;
+        }
+
+        /*calculate output destination filter*/
+        *(output_filter + i) = l_filter + u_filter;
+
+        /*change band reject filter into bandpass filter using spectral inversion*/
+        *(output_filter + i) *= -1.0;
+        if (i == filter_len / 2) {
+            *(output_filter + i) += 1.0;
+        }
+    }
+    DSP_INSTR_END(DSP_INSTR_BP_WIN_SINC_FILTER, filter_len * sizeof(DSP_T));
+}
+
+
+/**
+ * @brief Calculate Hamming window
+ * 
+ * @param idx index of filter
+ * @param filter_len filter len
+ * @return DSP_T calculation result
+ */
+DSP_T DSP_FN(dsp_hamming_window)(int idx, dsp_size_t filter_len)
+{
+    return ((DSP_T)0.54 - (DSP_T)0.46 * DSP_COS((DSP_T)(2.0 * M_PI) * idx / filter_len));
+}
+
+/**
+ * @brief Calculate Blackman window
+ * 
+ * @param idx index of filter
+ * @param filter_len filter len
+ * @return DSP_T calculation result
+ */
+DSP_T DSP_FN(dsp_blackman_window)(int idx, dsp_size_t filter_len)
+{
+    return ((DSP_T)0.42 - (DSP_T)0.5 * DSP_COS(((DSP_T)(2.0 * M_PI) * idx) / filter_len) + 
+            (DSP_T)0.08 * DSP_COS(((DSP_T)(4.0 * M_PI) * idx) / filter_len));
+}
+
+/**
+ * @brief Calculate Kaiser window
+ * w[i] = I0(beta * sqrt(1 - pow((i - N/2) / (N/2), 2))) / I0(beta)
+ * I0: zeroth order modified Bessel function of the first kind
+ *
+ * The shape parameter is set by dsp_kaiser_set_beta, it is stored globally because the
+ * window_calc slot has no context argument. dsp_kaiser_win_sinc_filter does not use it,
+ * the filter design is safe to call from more threads.
+ *
+ * @param idx index of filter
+ * @param filter_len filter len
+ * @return DSP_T calculation result
+ */
+DSP_T DSP_FN(dsp_kaiser_window)(int idx, dsp_size_t filter_len)
+{
+    return (DSP_T)_dsp_kaiser_window_beta(idx, filter_len, _dsp_kaiser_beta);
+}
+
+
+/*
+Rectangle window, the Kaiser window of the filter design is applied afterwards
+*/
+static DSP_T DSP_FN(_dsp_rect_window)(int idx, dsp_size_t filter_len)
+{
+    (void)idx;
+    (void)filter_len;
+    return (DSP_T)1.0;
+}
+
+/**
+ * @brief Create Kaiser windowed sinc filter with minimal length
+ * Low-pass filter if pass_freq_khz < stop_freq_khz, high-pass filter otherwise.
+ * Cutoff frequency is the middle of the transition band, passband gain is 1.0.
+ *
+ * Steps:
+ * 1. calculate minimal length and beta (dsp_kaiser_filter_len)
+ * 2. create low-pass filter with dsp_lp_win_sinc_filter using rectangle window
+ * 3. apply Kaiser window of the calculated beta
+ * 4. normalize to unity DC gain
+ * 5. spectral inversion for high-pass filter
+ *
+ * @param output_filter filter output result
+ * @param max_filter_len size of output_filter array
+ * @param input_sample_freq_khz known filterable signal sample frequency in kHz
+ * @param pass_freq_khz passband edge frequency in kHz
+ * @param stop_freq_khz stopband edge frequency in kHz
+ * @param atten_db stopband attenuation (and passband ripple) in dB, positive number
+ * @return dsp_size_t created filter length, 0 if the filter does not fit into max_filter_len
+ */
+dsp_size_t DSP_FN(dsp_kaiser_win_sinc_filter)(DSP_T *output_filter, dsp_size_t max_filter_len,
+                                      DSP_T input_sample_freq_khz, DSP_T pass_freq_khz,
+                                      DSP_T stop_freq_khz, DSP_T atten_db)
+{
+    dsp_size_t i;
+    dsp_val_t beta;
+    DSP_T gain = 0.0;
+    DSP_T cutoff_freq_khz = (pass_freq_khz + stop_freq_khz) / (DSP_T)2.0;
+    dsp_size_t filter_len = dsp_kaiser_filter_len(input_sample_freq_khz, pass_freq_khz, 
+                                                  stop_freq_khz, atten_db, &beta);
+    DSP_INSTR_BEGIN();
+
+    if(filter_len == 0 || filter_len > max_filter_len) {
+        DSP_INSTR_END(DSP_INSTR_KAISER_WIN_SINC_FILTER, 0);
+        return 0;
+    }
+
+    /*low-pass filter with the local beta, the global one of dsp_kaiser_window is not touched*/
+    DSP_FN(dsp_lp_win_sinc_filter)(output_filter, input_sample_freq_khz, cutoff_freq_khz, 
+                                   DSP_FN(_dsp_rect_window), filter_len);
+    for(i = 0; i < filter_len; i++) {
+        *(output_filter + i) *= (DSP_T)_dsp_kaiser_window_beta(i, filter_len, beta);
+    }
+
+    /*normalized to unity DC gain, so the ripple is relative to 1.0*/
+    for(i = 0; i < filter_len; gain += *(output_filter + i), i++);
+    for(i = 0; i < filter_len; *(output_filter + i) /= gain, i++);
+
+    /*high-pass filter with spectral inversion*/
+    if(pass_freq_khz > stop_freq_khz) {
+        for(i = 0; i < filter_len; i++) {
+            DSP_FN(dsp_specteral_inversion)(output_filter, i, filter_len);
+        }
+    }
+
+    DSP_INSTR_END(DSP_INSTR_KAISER_WIN_SINC_FILTER, filter_len * sizeof(DSP_T));
+    return filter_len;
+}
+
+/**
+ * @brief Calculate spectral inversion for given index
+ * 
+ * @param filter filter memory storage
+ * @param idx index of expected element
+ * @param filter_len filter length
+ */
+void DSP_FN(dsp_specteral_inversion)(DSP_T *filter, int idx, dsp_size_t filter_len)
+{
+        *(filter + idx) *= -1.0;
+        if (idx == filter_len / 2) {
+            *(filter + idx) += 1.0;
+        }
+}
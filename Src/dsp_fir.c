@@ -0,0 +1,241 @@
+/**
+ * @file dsp_fir.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP prepared FIR filter, time or frequency domain application
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_fir.h"
+#include "dsp_convolution.h"
+#include "dsp_buf.h"
+#include "dsp_instr.h"
+
+
+static void _dsp_fir_spectrum_mul(dsp_val_t *rex, dsp_val_t *imx, dsp_val_t *h_rex, dsp_val_t *h_imx, dsp_size_t len);
+static dsp_val_t _dsp_fir_freq_cost(dsp_size_t fft_len, dsp_size_t block_len);
+
+
+/**
+ * @brief Create prepared FIR filter
+ * The filter kernel is usually created by dsp_lp_win_sinc_filter, dsp_hp_win_sinc_filter or dsp_bp_win_sinc_filter.
+ *
+ * Cost per output sample:
+ * time domain:         K MAC
+ * frequency domain:    (2 * c * N * log2(N) + 4 * N) / (2 * B) MAC
+ *                      two blocks are transformed together as real and imaginary part
+ * K: kernel length, B: block length, N: FFT length >= B + K - 1
+ *
+ * With DSP_FIR_PATH_AUTO the cheaper path and the cheapest FFT length are selected.
+ *
+ * @param kernel filter kernel array, it is copied
+ * @param kernel_len filter kernel length
+ * @param max_block_len expected maximal input length of one dsp_fir_apply call
+ * @param path application path
+ * @return dsp_fir_t* prepared filter, NULL if the allocation failed
+ */
+dsp_fir_t *dsp_fir_create(dsp_val_t *kernel, dsp_size_t kernel_len, dsp_size_t max_block_len, dsp_fir_path_t path)
+{
+    dsp_fir_t *fir;
+    dsp_size_t fft_len, max_fft_len, block_len, best_fft_len = 0, best_block_len = 0;
+    dsp_val_t cost, best_cost = 0.0;
+
+    if(kernel == NULL || kernel_len == 0 || max_block_len == 0) {
+        return NULL;
+    }
+
+    fir = (dsp_fir_t *) calloc(1, sizeof(dsp_fir_t));
+    if(fir == NULL) {
+        return NULL;
+    }
+
+    fir->kernel_len = kernel_len;
+    fir->kernel = (dsp_val_t *) malloc(kernel_len * sizeof(dsp_val_t));
+    if(fir->kernel == NULL) {
+        dsp_fir_destroy(fir);
+        return NULL;
+    }
+    memcpy(fir->kernel, kernel, kernel_len * sizeof(dsp_val_t));
+
+    /*search the cheapest FFT length, block must be at least one sample*/
+    max_fft_len = dsp_fft_next_pow2(max_block_len + kernel_len - 1);
+    for(fft_len = dsp_fft_next_pow2(kernel_len + 1); ; fft_len <<= 1) {
+        block_len = fft_len - kernel_len + 1;
+        if(block_len > max_block_len) {
+            block_len = max_block_len;
+        }
+
+        cost = _dsp_fir_freq_cost(fft_len, block_len);
+        if(best_fft_len == 0 || cost < best_cost) {
+            best_cost = cost;
+            best_fft_len = fft_len;
+            best_block_len = block_len;
+        }
+
+        if(fft_len >= max_fft_len) {
+            break;
+        }
+    }
+
+    /*select path from the measured crossover*/
+    if(path == DSP_FIR_PATH_AUTO) {
+        path = (best_cost < (dsp_val_t)kernel_len) ? DSP_FIR_PATH_FREQ : DSP_FIR_PATH_TIME;
+    }
+    fir->path = path;
+
+    if(path == DSP_FIR_PATH_TIME) {
+        return fir;
+    }
+
+    /*prepare kernel spectrum*/
+    fir->block_len = best_block_len;
+    fir->plan = dsp_fft_plan_create(best_fft_len);
+    fir->kernel_rex = dsp_buf_alloc(best_fft_len);
+    fir->kernel_imx = dsp_buf_alloc(best_fft_len);
+    fir->work_rex = dsp_buf_alloc(best_fft_len);
+    fir->work_imx = dsp_buf_alloc(best_fft_len);
+
+    if(fir->plan == NULL || fir->kernel_rex == NULL || fir->kernel_imx == NULL ||
+       fir->work_rex == NULL || fir->work_imx == NULL) {
+        dsp_fir_destroy(fir);
+        return NULL;
+    }
+
+    memcpy(fir->kernel_rex, kernel, kernel_len * sizeof(dsp_val_t));
+    dsp_fft(fir->plan, fir->kernel_rex, fir->kernel_imx);
+
+    return fir;
+}
+
+
+/**
+ * @brief Destroy prepared FIR filter
+ *
+ * @param fir filter created by dsp_fir_create, can be NULL
+ */
+void dsp_fir_destroy(dsp_fir_t *fir)
+{
+    if(fir == NULL) {
+        return;
+    }
+
+    dsp_fft_plan_destroy(fir->plan);
+    free(fir->kernel);
+    dsp_buf_free(fir->kernel_rex);
+    dsp_buf_free(fir->kernel_imx);
+    dsp_buf_free(fir->work_rex);
+    dsp_buf_free(fir->work_imx);
+    free(fir);
+}
+
+
+/**
+ * @brief Apply prepared FIR filter on the input signal
+ * Same result as dsp_convolution with the filter kernel, any input length is accepted.
+ *
+ * Frequency domain path is overlap-add. The kernel is real, so two consecutive blocks are
+ * transformed together: IFFT(H * FFT(x1 + j * x2)) = h * x1 + j * (h * x2)
+ *
+ * @param fir prepared filter
+ * @param dest_sig destination output array, length: input_sig_len + kernel_len
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ */
+void dsp_fir_apply(dsp_fir_t *fir, dsp_val_t *dest_sig, dsp_val_t *input_sig, dsp_size_t input_sig_len)
+{
+    dsp_size_t i, pos, len1, len2;
+    dsp_size_t fft_len, block_len = fir->block_len;
+    DSP_INSTR_BEGIN();
+
+    if(fir->path == DSP_FIR_PATH_TIME) {
+        dsp_convolution(dest_sig, input_sig, input_sig_len, fir->kernel, fir->kernel_len);
+        DSP_INSTR_END(DSP_INSTR_FIR_APPLY, input_sig_len * sizeof(dsp_val_t));
+        return;
+    }
+
+    fft_len = fir->plan->len;
+
+    // reset destination array
+    for(i = 0; i < (input_sig_len + fir->kernel_len); *(dest_sig + i) = 0.0, i++);
+
+    for(pos = 0; pos < input_sig_len; pos += 2 * block_len) {
+
+        /*first block to real part, second block to imaginary part*/
+        len1 = (input_sig_len - pos < block_len) ? (input_sig_len - pos) : block_len;
+        len2 = input_sig_len - pos - len1;
+        len2 = (len2 < block_len) ? len2 : block_len;
+
+        memset(fir->work_rex, 0, fft_len * sizeof(dsp_val_t));
+        memset(fir->work_imx, 0, fft_len * sizeof(dsp_val_t));
+        memcpy(fir->work_rex, input_sig + pos, len1 * sizeof(dsp_val_t));
+        memcpy(fir->work_imx, input_sig + pos + len1, len2 * sizeof(dsp_val_t));
+
+        dsp_fft(fir->plan, fir->work_rex, fir->work_imx);
+
+        /*multiply with the cached kernel spectrum*/
+        _dsp_fir_spectrum_mul(fir->work_rex, fir->work_imx, fir->kernel_rex, fir->kernel_imx, fft_len);
+
+        dsp_ifft(fir->plan, fir->work_rex, fir->work_imx);
+
+        /*overlap-add*/
+        for(i = 0; i < len1 + fir->kernel_len - 1; i++) {
+            *(dest_sig + pos + i) += *(fir->work_rex + i);
+        }
+
+        if(len2) {
+            for(i = 0; i < len2 + fir->kernel_len - 1; i++) {
+                *(dest_sig + pos + len1 + i) += *(fir->work_imx + i);
+            }
+        }
+    }
+    DSP_INSTR_END(DSP_INSTR_FIR_APPLY, input_sig_len * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Frequency domain cost of one output sample in MAC
+ *
+ * @param fft_len FFT length
+ * @param block_len input samples per block
+ * @return dsp_val_t cost
+ */
+static dsp_val_t _dsp_fir_freq_cost(dsp_size_t fft_len, dsp_size_t block_len)
+{
+    return (2.0 * DSP_FIR_FFT_COST_FACTOR * fft_len * log2((dsp_val_t)fft_len) + 4.0 * fft_len) /
+           (2.0 * block_len);
+}
+
+
+/**
+ * @brief Complex multiplication of the block spectrum with the kernel spectrum
+ * The buffers are aligned and padded (dsp_buf_alloc), so it runs on whole blocks.
+ *
+ * @param rex block spectrum real part, input and output
+ * @param imx block spectrum imaginary part, input and output
+ * @param h_rex kernel spectrum real part
+ * @param h_imx kernel spectrum imaginary part
+ * @param len FFT length
+ */
+static void _dsp_fir_spectrum_mul(dsp_val_t *rex, dsp_val_t *imx, dsp_val_t *h_rex, dsp_val_t *h_imx, dsp_size_t len)
+{
+    dsp_size_t i, j, block = DSP_BUF_BLOCK_LEN(sizeof(dsp_val_t));
+    dsp_val_t re, im;
+    dsp_val_t *xr = DSP_BUF_ASSUME_ALIGNED(rex), *xi = DSP_BUF_ASSUME_ALIGNED(imx);
+    dsp_val_t *hr = DSP_BUF_ASSUME_ALIGNED(h_rex), *hi = DSP_BUF_ASSUME_ALIGNED(h_imx);
+
+    /*padded to whole blocks, the padding is zero in every buffer*/
+    len = DSP_BUF_PADDED_LEN(len, sizeof(dsp_val_t));
+    for(i = 0; i < len; i += block) {
+        for(j = i; j < i + block; j++) {
+            re = *(xr + j) * *(hr + j) - *(xi + j) * *(hi + j);
+            im = *(xr + j) * *(hi + j) + *(xi + j) * *(hr + j);
+            *(xr + j) = re;
+            *(xi + j) = im;
+        }
+    }
+}
@@ -0,0 +1,505 @@
+/**
+ * @file dsp_fixed.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP fixed-point (Q15, Q31) calculations
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "dsp_fixed.h"
+#include "dsp_instr.h"
+
+
+static dsp_q15_t _dsp_sat_q15(int64_t val);
+static dsp_q31_t _dsp_sat_q31(int64_t val);
+static int64_t _dsp_round_shift(int64_t val, int shift);
+static int64_t _dsp_round_div(int64_t val, int64_t div);
+static uint64_t _dsp_isqrt(uint64_t val);
+static int _dsp_coef_shift(dsp_val_t *filter, dsp_size_t filter_len, dsp_val_t full_scale, int max_shift);
+
+
+/**
+ * @brief Convert floating point array to Q15 with rounding and saturation
+ *
+ * @param dest destination Q15 array
+ * @param src source array
+ * @param len length of arrays
+ */
+void dsp_quantize_q15(dsp_q15_t *dest, dsp_val_t *src, dsp_size_t len)
+{
+    dsp_size_t i;
+    dsp_val_t val;
+
+    for(i = 0; i < len; i++) {
+        val = floor(*(src + i) * 32768.0 + 0.5);
+        *(dest + i) = (val >= 32767.0) ? DSP_Q15_MAX : (val <= -32768.0) ? DSP_Q15_MIN : (dsp_q15_t)val;
+    }
+}
+
+/**
+ * @brief Convert floating point array to Q31 with rounding and saturation
+ *
+ * @param dest destination Q31 array
+ * @param src source array
+ * @param len length of arrays
+ */
+void dsp_quantize_q31(dsp_q31_t *dest, dsp_val_t *src, dsp_size_t len)
+{
+    dsp_size_t i;
+    dsp_val_t val;
+
+    for(i = 0; i < len; i++) {
+        val = floor(*(src + i) * 2147483648.0 + 0.5);
+        *(dest + i) = (val >= 2147483647.0) ? DSP_Q31_MAX : (val <= -2147483648.0) ? DSP_Q31_MIN : (dsp_q31_t)val;
+    }
+}
+
+/**
+ * @brief Convert Q15 array to floating point
+ *
+ * @param dest destination array
+ * @param src source Q15 array
+ * @param len length of arrays
+ */
+void dsp_dequantize_q15(dsp_val_t *dest, dsp_q15_t *src, dsp_size_t len)
+{
+    dsp_size_t i;
+
+    for(i = 0; i < len; i++) {
+        *(dest + i) = (dsp_val_t)*(src + i) / 32768.0;
+    }
+}
+
+/**
+ * @brief Convert Q31 array to floating point
+ *
+ * @param dest destination array
+ * @param src source Q31 array
+ * @param len length of arrays
+ */
+void dsp_dequantize_q31(dsp_val_t *dest, dsp_q31_t *src, dsp_size_t len)
+{
+    dsp_size_t i;
+
+    for(i = 0; i < len; i++) {
+        *(dest + i) = (dsp_val_t)*(src + i) / 2147483648.0;
+    }
+}
+
+
+/**
+ * @brief Quantize filter kernel to Q15 coefficients
+ * The windowed sinc designers can produce coefficients out of the Q15 range,
+ * so the kernel is scaled down by pow(2, coef_shift):
+ *      dest[i] = filter[i] / pow(2, coef_shift)
+ * coef_shift is the minimal shift, where all coefficients fit into Q15.
+ * The shift must be passed to dsp_convolution_q15.
+ *
+ * @param dest destination Q15 coefficient array
+ * @param filter filter kernel, e.g. output of dsp_lp_win_sinc_filter
+ * @param filter_len filter length
+ * @return int coef_shift, -1 if a coefficient is not finite or needs a shift above 15
+ *         (dest is not written)
+ */
+int dsp_filter_quantize_q15(dsp_q15_t *dest, dsp_val_t *filter, dsp_size_t filter_len)
+{
+    dsp_size_t i;
+    dsp_val_t val;
+    int shift = _dsp_coef_shift(filter, filter_len, 32768.0, 15);
+
+    if(shift < 0) {
+        return -1;
+    }
+
+    for(i = 0; i < filter_len; i++) {
+        val = floor(ldexp(*(filter + i), 15 - shift) + 0.5);
+        *(dest + i) = (val >= 32767.0) ? DSP_Q15_MAX : (dsp_q15_t)val;
+    }
+
+    return shift;
+}
+
+/**
+ * @brief Quantize filter kernel to Q31 coefficients
+ * Same as dsp_filter_quantize_q15 with Q31 coefficients.
+ *
+ * @param dest destination Q31 coefficient array
+ * @param filter filter kernel, e.g. output of dsp_lp_win_sinc_filter
+ * @param filter_len filter length
+ * @return int coef_shift, -1 if a coefficient is not finite or needs a shift above 31
+ *         (dest is not written)
+ */
+int dsp_filter_quantize_q31(dsp_q31_t *dest, dsp_val_t *filter, dsp_size_t filter_len)
+{
+    dsp_size_t i;
+    dsp_val_t val;
+    int shift = _dsp_coef_shift(filter, filter_len, 2147483648.0, 31);
+
+    if(shift < 0) {
+        return -1;
+    }
+
+    for(i = 0; i < filter_len; i++) {
+        val = floor(ldexp(*(filter + i), 31 - shift) + 0.5);
+        *(dest + i) = (val >= 2147483647.0) ? DSP_Q31_MAX : (dsp_q31_t)val;
+    }
+
+    return shift;
+}
+
+
+/**
+ * @brief Q15 Convolution
+ * y[n] = sum (x[n - j] * h[j]) * pow(2, coef_shift)
+ * One 64-bit accumulator per output sample, the output is rounded and saturated once.
+ *
+ * @param dest_sig destination output array, length: input_sig_len + impulse_resp_len
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @param impulse_resp impulse response signal array
+ * @param impulse_resp_len impulse response signal length
+ * @param coef_shift coefficient scale returned by dsp_filter_quantize_q15, 0 for plain Q15 impulse response
+ */
+void dsp_convolution_q15(dsp_q15_t *dest_sig, dsp_q15_t *input_sig, dsp_size_t input_sig_len,
+                         dsp_q15_t *impulse_resp, dsp_size_t impulse_resp_len, int coef_shift)
+{
+    dsp_size_t n, j, j_start, j_end;
+    int64_t acc;
+    DSP_INSTR_BEGIN();
+
+    /*empty signal or impulse response: zero output*/
+    if(input_sig_len == 0 || impulse_resp_len == 0) {
+        for(n = 0; n < input_sig_len + impulse_resp_len; *(dest_sig + n) = 0, n++);
+        DSP_INSTR_END(DSP_INSTR_CONVOLUTION_Q15, (input_sig_len + impulse_resp_len) * sizeof(dsp_q15_t));
+        return;
+    }
+
+    for(n = 0; n < input_sig_len + impulse_resp_len - 1; n++) {
+
+        /*valid range of impulse response index*/
+        j_start = (n >= input_sig_len) ? (n - input_sig_len + 1) : 0;
+        j_end = (n < impulse_resp_len) ? n : (impulse_resp_len - 1);
+
+        /*Q30 products, 64-bit accumulator*/
+        for(j = j_start, acc = 0; j <= j_end; j++) {
+            acc += (int32_t)*(input_sig + n - j) * (int32_t)*(impulse_resp + j);
+        }
+
+        *(dest_sig + n) = _dsp_sat_q15(_dsp_round_shift(acc, 15 - coef_shift));
+    }
+
+    *(dest_sig + input_sig_len + impulse_resp_len - 1) = 0;
+    DSP_INSTR_END(DSP_INSTR_CONVOLUTION_Q15, (input_sig_len + impulse_resp_len) * sizeof(dsp_q15_t));
+}
+
+/**
+ * @brief Q31 Convolution
+ * Same as dsp_convolution_q15 with Q31 values.
+ * The products are rounded to Q31 before accumulation, the sum is kept in 64 bit.
+ *
+ * @param dest_sig destination output array, length: input_sig_len + impulse_resp_len
+ * @param input_sig input signal array
+ * @param input_sig_len input signal length
+ * @param impulse_resp impulse response signal array
+ * @param impulse_resp_len impulse response signal length
+ * @param coef_shift coefficient scale returned by dsp_filter_quantize_q31, 0 for plain Q31 impulse response
+ */
+void dsp_convolution_q31(dsp_q31_t *dest_sig, dsp_q31_t *input_sig, dsp_size_t input_sig_len,
+                         dsp_q31_t *impulse_resp, dsp_size_t impulse_resp_len, int coef_shift)
+{
+    dsp_size_t n, j, j_start, j_end;
+    int64_t acc;
+    DSP_INSTR_BEGIN();
+
+    /*empty signal or impulse response: zero output*/
+    if(input_sig_len == 0 || impulse_resp_len == 0) {
+        for(n = 0; n < input_sig_len + impulse_resp_len; *(dest_sig + n) = 0, n++);
+        DSP_INSTR_END(DSP_INSTR_CONVOLUTION_Q31, (input_sig_len + impulse_resp_len) * sizeof(dsp_q31_t));
+        return;
+    }
+
+    for(n = 0; n < input_sig_len + impulse_resp_len - 1; n++) {
+
+        /*valid range of impulse response index*/
+        j_start = (n >= input_sig_len) ? (n - input_sig_len + 1) : 0;
+        j_end = (n < impulse_resp_len) ? n : (impulse_resp_len - 1);
+
+        /*Q62 products rounded to the output scale, 64-bit accumulator*/
+        for(j = j_start, acc = 0; j <= j_end; j++) {
+            acc += _dsp_round_shift((int64_t)*(input_sig + n - j) * (int64_t)*(impulse_resp + j), 31 - coef_shift);
+        }
+
+        *(dest_sig + n) = _dsp_sat_q31(acc);
+    }
+
+    *(dest_sig + input_sig_len + impulse_resp_len - 1) = 0;
+    DSP_INSTR_END(DSP_INSTR_CONVOLUTION_Q31, (input_sig_len + impulse_resp_len) * sizeof(dsp_q31_t));
+}
+
+
+/**
+ * @brief Q15 Discrete Fourier Transform magnitude
+ * mag[k] = sqrt(pow(rex[k], 2) + pow(imx[k], 2)), integer square root, saturated
+ *
+ * @param dest_mag destination signal
+ * @param rex real part array
+ * @param imx imaginary part array
+ * @param mag_len length of magnitude
+ */
+void dsp_dft_magnitude_q15(dsp_q15_t *dest_mag, dsp_q15_t *rex, dsp_q15_t *imx, dsp_size_t mag_len)
+{
+    dsp_size_t i;
+    uint64_t sum_sq;
+
+    for(i = 0; i < mag_len; i++) {
+        /*Q30 sum of squares, square root is Q15*/
+        sum_sq = (uint64_t)((int32_t)*(rex + i) * (int32_t)*(rex + i)) +
+                 (uint64_t)((int32_t)*(imx + i) * (int32_t)*(imx + i));
+        *(dest_mag + i) = _dsp_sat_q15((int64_t)_dsp_isqrt(sum_sq));
+    }
+}
+
+/**
+ * @brief Q31 Discrete Fourier Transform magnitude
+ * mag[k] = sqrt(pow(rex[k], 2) + pow(imx[k], 2)), integer square root, saturated
+ *
+ * @param dest_mag destination signal
+ * @param rex real part array
+ * @param imx imaginary part array
+ * @param mag_len length of magnitude
+ */
+void dsp_dft_magnitude_q31(dsp_q31_t *dest_mag, dsp_q31_t *rex, dsp_q31_t *imx, dsp_size_t mag_len)
+{
+    dsp_size_t i;
+    uint64_t sum_sq;
+
+    for(i = 0; i < mag_len; i++) {
+        /*Q62 sum of squares fits into 64 bit unsigned, square root is Q31*/
+        sum_sq = (uint64_t)((int64_t)*(rex + i) * (int64_t)*(rex + i)) +
+                 (uint64_t)((int64_t)*(imx + i) * (int64_t)*(imx + i));
+        *(dest_mag + i) = _dsp_sat_q31((int64_t)_dsp_isqrt(sum_sq));
+    }
+}
+
+
+/**
+ * @brief Q15 signal mean
+ * mu = 1/N * sum(xi), 64-bit sum
+ *
+ * @param sig signal array
+ * @param len length of array
+ * @return dsp_q15_t mean value, 0 for empty signal
+ */
+dsp_q15_t dsp_sig_mean_q15(dsp_q15_t *sig, dsp_size_t len)
+{
+    dsp_size_t i;
+    int64_t sum = 0;
+
+    for(i = 0; i < len; i++) {
+        sum += *(sig + i);
+    }
+
+    if(len == 0) {
+        return 0;
+    }
+
+    return (dsp_q15_t)_dsp_round_div(sum, (int64_t)len);
+}
+
+/**
+ * @brief Q31 signal mean
+ * mu = 1/N * sum(xi), 64-bit sum
+ *
+ * @param sig signal array
+ * @param len length of array
+ * @return dsp_q31_t mean value, 0 for empty signal
+ */
+dsp_q31_t dsp_sig_mean_q31(dsp_q31_t *sig, dsp_size_t len)
+{
+    dsp_size_t i;
+    int64_t sum = 0;
+
+    for(i = 0; i < len; i++) {
+        sum += *(sig + i);
+    }
+
+    if(len == 0) {
+        return 0;
+    }
+
+    return (dsp_q31_t)_dsp_round_div(sum, (int64_t)len);
+}
+
+/**
+ * @brief Variance of Q15 signal
+ * pow(sigma, 2) = (1/(N-1)) * sum(pow(xi-u, 2))
+ * The result is Q31, because the variance of a Q15 signal is too small for Q15 precision.
+ *
+ * @param sig signal array
+ * @param sig_mean signal mean value
+ * @param len length of signal
+ * @return dsp_q31_t variance value
+ */
+dsp_q31_t dsp_sig_variance_q15(dsp_q15_t *sig, dsp_q15_t sig_mean, dsp_size_t len)
+{
+    dsp_size_t i;
+    int64_t diff, sum = 0;
+
+    if(len < 2) {
+        return 0;
+    }
+
+    for(i = 0; i < len; i++) {
+        diff = (int64_t)*(sig + i) - sig_mean;
+        sum += diff * diff;
+    }
+
+    /*Q30 -> Q31*/
+    return _dsp_sat_q31(_dsp_round_div(sum, (int64_t)(len - 1)) * 2);
+}
+
+/**
+ * @brief Variance of Q31 signal
+ * pow(sigma, 2) = (1/(N-1)) * sum(pow(xi-u, 2))
+ * The squares are rounded to Q31 before accumulation.
+ *
+ * @param sig signal array
+ * @param sig_mean signal mean value
+ * @param len length of signal
+ * @return dsp_q31_t variance value
+ */
+dsp_q31_t dsp_sig_variance_q31(dsp_q31_t *sig, dsp_q31_t sig_mean, dsp_size_t len)
+{
+    dsp_size_t i;
+    int64_t sum = 0;
+    uint64_t diff;
+
+    if(len < 2) {
+        return 0;
+    }
+
+    for(i = 0; i < len; i++) {
+        /*difference can be 32 bit wide, its square is rounded from Q62 to Q31*/
+        diff = (*(sig + i) >= sig_mean) ? (uint64_t)((int64_t)*(sig + i) - sig_mean) :
+                                          (uint64_t)((int64_t)sig_mean - *(sig + i));
+        sum += (int64_t)((diff * diff + (1ULL << 30)) >> 31);
+    }
+
+    return _dsp_sat_q31(_dsp_round_div(sum, (int64_t)(len - 1)));
+}
+
+
+/**
+ * @brief Saturate to Q15 range
+ *
+ * @param val value
+ * @return dsp_q15_t saturated value
+ */
+static dsp_q15_t _dsp_sat_q15(int64_t val)
+{
+    return (val > DSP_Q15_MAX) ? DSP_Q15_MAX : (val < DSP_Q15_MIN) ? DSP_Q15_MIN : (dsp_q15_t)val;
+}
+
+/**
+ * @brief Saturate to Q31 range
+ *
+ * @param val value
+ * @return dsp_q31_t saturated value
+ */
+static dsp_q31_t _dsp_sat_q31(int64_t val)
+{
+    return (val > DSP_Q31_MAX) ? DSP_Q31_MAX : (val < DSP_Q31_MIN) ? DSP_Q31_MIN : (dsp_q31_t)val;
+}
+
+/**
+ * @brief Arithmetic shift right with rounding to nearest, negative shift is left shift
+ *
+ * @param val value
+ * @param shift shift count
+ * @return int64_t shifted value
+ */
+static int64_t _dsp_round_shift(int64_t val, int shift)
+{
+    if(shift <= 0) {
+        return val * ((int64_t)1 << -shift);
+    }
+    return (val + ((int64_t)1 << (shift - 1))) >> shift;
+}
+
+/**
+ * @brief Signed division with rounding to nearest
+ *
+ * @param val dividend
+ * @param div divisor, positive
+ * @return int64_t quotient
+ */
+static int64_t _dsp_round_div(int64_t val, int64_t div)
+{
+    return (val >= 0) ? (val + div / 2) / div : (val - div / 2) / div;
+}
+
+/**
+ * @brief Integer square root, floor(sqrt(val))
+ * Bitwise method, one result bit per iteration
+ *
+ * @param val value
+ * @return uint64_t square root
+ */
+static uint64_t _dsp_isqrt(uint64_t val)
+{
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while(bit > val) {
+        bit >>= 2;
+    }
+
+    while(bit != 0) {
+        if(val >= res + bit) {
+            val -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return res;
+}
+
+/**
+ * @brief Minimal coefficient shift, where the kernel fits into the fixed-point range
+ *
+ * @param filter filter kernel
+ * @param filter_len filter length
+ * @param full_scale fixed-point value of 1.0
+ * @param max_shift largest allowed shift
+ * @return int shift, -1 if a coefficient is not finite or the shift is larger than max_shift
+ */
+static int _dsp_coef_shift(dsp_val_t *filter, dsp_size_t filter_len, dsp_val_t full_scale, int max_shift)
+{
+    dsp_size_t i;
+    dsp_val_t max_abs = 0.0;
+    int shift = 0;
+
+    for(i = 0; i < filter_len; i++) {
+        if(!isfinite(*(filter + i))) {
+            return -1;
+        }
+        if(fabs(*(filter + i)) > max_abs) {
+            max_abs = fabs(*(filter + i));
+        }
+    }
+
+    /*negative full scale value is representable, positive is not*/
+    while(floor(ldexp(max_abs, -shift) * full_scale + 0.5) > full_scale - 1.0) {
+        if(++shift > max_shift) {
+            return -1;
+        }
+    }
+
+    return shift;
+}
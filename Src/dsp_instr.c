@@ -0,0 +1,181 @@
+/**
+ * @file dsp_instr.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP hot path instrumentation: call count, time and processed bytes per function
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <string.h>
+#include <time.h>
+#include "dsp_instr.h"
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define DSP_INSTR_RDTSC     1
+#else
+    #define DSP_INSTR_RDTSC     0
+#endif
+
+/*Thread local counters only in the instrumented build*/
+#ifdef DSP_INSTR
+    #define DSP_INSTR_TLS       __thread
+#else
+    #define DSP_INSTR_TLS
+#endif
+
+static DSP_INSTR_TLS dsp_instr_counter_t dsp_instr_counter[DSP_INSTR_N_FUNCTIONS];
+
+static char *dsp_instr_names[DSP_INSTR_N_FUNCTIONS] = {
+    "dsp_sig_mean",
+    "dsp_sig_variance",
+    "dsp_sig_stats",
+    "dsp_sig_stats_mt",
+    "dsp_sig_metrics",
+    "dsp_stat_acc_update",
+    "dsp_convolution",
+    "dsp_running_sum",
+    "dsp_dft",
+    "dsp_idft",
+    "dsp_dft_magnitude",
+    "dsp_rect2polar",
+    "dsp_cdft",
+    "dsp_fft",
+    "dsp_ifft",
+    "dsp_lp_win_sinc_filter",
+    "dsp_hp_win_sinc_filter",
+    "dsp_bp_win_sinc_filter",
+    "dsp_kaiser_win_sinc_filter",
+    "dsp_fir_apply",
+    "dsp_channelizer_process",
+    "dsp_convolution_q15",
+    "dsp_convolution_q31",
+    "dsp_xcorr",
+    "dsp_rolling_process",
+    "dsp_quantile_acc_update",
+    "dsp_hist_update",
+    "dsp_pipeline_process",
+    "dsp_stft",
+    "dsp_istft",
+    "dsp_welch_update"
+};
+
+
+/**
+ * @brief Current time stamp of the instrumentation clock
+ *
+ * @return uint64_t CPU cycles on x86 with GCC compatible compiler, ns otherwise
+ */
+uint64_t dsp_instr_ticks(void)
+{
+#if DSP_INSTR_RDTSC
+    uint32_t lo, hi;
+
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((uint64_t)hi << 32) | lo;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+
+/**
+ * @brief Record one call into the counters of the calling thread
+ *
+ * @param id instrumented function
+ * @param ticks time of the call
+ * @param bytes processed input bytes
+ */
+void dsp_instr_record(dsp_instr_id_t id, uint64_t ticks, uint64_t bytes)
+{
+    dsp_instr_counter_t *c;
+
+    if ((unsigned)id >= DSP_INSTR_N_FUNCTIONS) {
+        return;
+    }
+    c = &dsp_instr_counter[id];
+    c->calls++;
+    c->total_ticks += ticks;
+    c->max_ticks = (ticks > c->max_ticks) ? ticks : c->max_ticks;
+    c->bytes += bytes;
+}
+
+
+/**
+ * @brief Copy of the counters of the calling thread
+ *
+ * @param snapshot output
+ */
+void dsp_instr_snapshot(dsp_instr_snapshot_t *snapshot)
+{
+    snapshot->ticks_are_cycles = DSP_INSTR_RDTSC;
+    memcpy(snapshot->counter, dsp_instr_counter, sizeof(dsp_instr_counter));
+}
+
+
+/**
+ * @brief Add the counters of an other snapshot (e.g. of a worker thread)
+ *
+ * @param snapshot accumulated snapshot
+ * @param other added snapshot
+ */
+void dsp_instr_merge(dsp_instr_snapshot_t *snapshot, dsp_instr_snapshot_t *other)
+{
+    dsp_size_t i;
+
+    for (i = 0; i < DSP_INSTR_N_FUNCTIONS; i++) {
+        snapshot->counter[i].calls += other->counter[i].calls;
+        snapshot->counter[i].total_ticks += other->counter[i].total_ticks;
+        snapshot->counter[i].max_ticks = (other->counter[i].max_ticks > snapshot->counter[i].max_ticks) ?
+                                         other->counter[i].max_ticks : snapshot->counter[i].max_ticks;
+        snapshot->counter[i].bytes += other->counter[i].bytes;
+    }
+}
+
+
+/**
+ * @brief Add the counters of a snapshot (e.g. of a worker thread) to the calling thread
+ *
+ * @param other added snapshot
+ */
+void dsp_instr_add(dsp_instr_snapshot_t *other)
+{
+    dsp_size_t i;
+
+    for (i = 0; i < DSP_INSTR_N_FUNCTIONS; i++) {
+        dsp_instr_counter[i].calls += other->counter[i].calls;
+        dsp_instr_counter[i].total_ticks += other->counter[i].total_ticks;
+        dsp_instr_counter[i].max_ticks = (other->counter[i].max_ticks > dsp_instr_counter[i].max_ticks) ?
+                                         other->counter[i].max_ticks : dsp_instr_counter[i].max_ticks;
+        dsp_instr_counter[i].bytes += other->counter[i].bytes;
+    }
+}
+
+
+/**
+ * @brief Clear the counters of the calling thread
+ */
+void dsp_instr_reset(void)
+{
+    memset(dsp_instr_counter, 0, sizeof(dsp_instr_counter));
+}
+
+
+/**
+ * @brief Name of an instrumented function
+ *
+ * @param id instrumented function
+ * @return char* public function name, "unknown" for invalid id
+ */
+char *dsp_instr_name(dsp_instr_id_t id)
+{
+    return ((unsigned)id < DSP_INSTR_N_FUNCTIONS) ? dsp_instr_names[id] : "unknown";
+}
@@ -0,0 +1,54 @@
+/**
+ * @file dsp_iq.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP interleaved complex (I/Q) sample layout conversion
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include "dsp_iq.h"
+#include "dsp_kernels.h"
+
+
+/*Single precision functions*/
+#define DSP_PREC 32
+#include "dsp_prec.h"
+#include "dsp_iq_tmpl.h"
+#undef DSP_PREC
+
+/*Double precision functions*/
+#define DSP_PREC 64
+#include "dsp_prec.h"
+#include "dsp_iq_tmpl.h"
+#undef DSP_PREC
+
+
+/**
+ * @brief Split interleaved complex signal into real and imaginary part arrays
+ *
+ * @param dest_rex real part destination array, len long
+ * @param dest_imx imaginary part destination array, len long
+ * @param iq interleaved input signal, 2 * len long
+ * @param len number of complex samples
+ */
+void dsp_iq_deinterleave(dsp_val_t *dest_rex, dsp_val_t *dest_imx, dsp_val_t *iq, dsp_size_t len)
+{
+    dsp_iq_deinterleave_f64(dest_rex, dest_imx, iq, len);
+}
+
+
+/**
+ * @brief Merge real and imaginary part arrays into interleaved complex signal
+ *
+ * @param dest_iq interleaved destination array, 2 * len long
+ * @param rex real part array, len long
+ * @param imx imaginary part array, len long
+ * @param len number of complex samples
+ */
+void dsp_iq_interleave(dsp_val_t *dest_iq, dsp_val_t *rex, dsp_val_t *imx, dsp_size_t len)
+{
+    dsp_iq_interleave_f64(dest_iq, rex, imx, len);
+}
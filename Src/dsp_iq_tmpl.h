@@ -0,0 +1,59 @@
+/**
+ * @file dsp_iq_tmpl.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP interleaved complex (I/Q) sample layout conversion, precision template (library internal)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * Included by dsp_iq.c once per precision, see dsp_prec.h
+ */
+
+
+/**
+ * @brief Split interleaved complex signal into real and imaginary part arrays
+ *
+ * @param dest_rex real part destination array, len long
+ * @param dest_imx imaginary part destination array, len long
+ * @param iq interleaved input signal, 2 * len long
+ * @param len number of complex samples
+ */
+void DSP_FN(dsp_iq_deinterleave)(DSP_T *dest_rex, DSP_T *dest_imx, DSP_T *iq, dsp_size_t len)
+{
+#if DSP_PREC == 64
+    /*selected kernel variant, see dsp_cpu.h*/
+    _dsp_kernels()->iq_deinterleave(dest_rex, dest_imx, iq, len);
+#else
+    dsp_size_t i;
+
+    for(i = 0; i < len; i++) {
+        *(dest_rex + i) = *(iq + 2 * i);
+        *(dest_imx + i) = *(iq + 2 * i + 1);
+    }
+#endif
+}
+
+
+/**
+ * @brief Merge real and imaginary part arrays into interleaved complex signal
+ *
+ * @param dest_iq interleaved destination array, 2 * len long
+ * @param rex real part array, len long
+ * @param imx imaginary part array, len long
+ * @param len number of complex samples
+ */
+void DSP_FN(dsp_iq_interleave)(DSP_T *dest_iq, DSP_T *rex, DSP_T *imx, dsp_size_t len)
+{
+#if DSP_PREC == 64
+    /*selected kernel variant, see dsp_cpu.h*/
+    _dsp_kernels()->iq_interleave(dest_iq, rex, imx, len);
+#else
+    dsp_size_t i;
+
+    for(i = 0; i < len; i++) {
+        *(dest_iq + 2 * i) = *(rex + i);
+        *(dest_iq + 2 * i + 1) = *(imx + i);
+    }
+#endif
+}
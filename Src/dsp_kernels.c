@@ -0,0 +1,792 @@
+/**
+ * @file dsp_kernels.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP double precision hot kernel variants: generic C, SSE2, AVX2, AVX-512
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The x86 variants are compiled with target attributes, so the library is built without
+ * -m flags and runs on every CPU. Every variant does the same operations in the same
+ * order without fused multiply-add, the results are identical.
+ *
+ * Convolution: the vector variants update DSP_KERNEL_CONV_ROWS input samples in one pass
+ * over the outputs, every output is loaded and stored once per pass.
+ */
+
+#include <math.h>
+#include "dsp_kernels.h"
+
+#if DSP_KERNELS_X86
+    #include <immintrin.h>
+
+    /*clean upper register state before returning to SSE code (not inserted by the compiler without optimization)*/
+    #define DSP_KERNEL_ZEROUPPER()  _mm256_zeroupper()
+#endif
+
+
+/*
+Generic C kernels
+*/
+
+static void _dsp_convolution_generic(dsp_f64_t *dest, dsp_f64_t *x, dsp_size_t x_len, dsp_f64_t *h, dsp_size_t h_len)
+{
+    dsp_size_t i, j;
+
+    for(i = 0; i < x_len; i++) {
+        for(j = 0; j < h_len; j++) {
+            *(dest + i + j) += *(x + i) * *(h + j);
+        }
+    }
+}
+
+
+/*
+Convolution sum of rows consecutive input samples on the outputs [o_first, o_last),
+relative to the first sample, the samples are added in input order
+*/
+static void _dsp_convolution_rows(dsp_f64_t *dest, dsp_f64_t *x, dsp_size_t rows, dsp_f64_t *h, dsp_size_t h_len,
+                                  dsp_size_t o_first, dsp_size_t o_last)
+{
+    dsp_size_t o, k;
+
+    for(o = o_first; o < o_last; o++) {
+        for(k = 0; k < rows; k++) {
+            if(o >= k && o - k < h_len) {
+                *(dest + o) += *(x + k) * *(h + o - k);
+            }
+        }
+    }
+}
+
+
+static void _dsp_magnitude_generic(dsp_f64_t *dest, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len)
+{
+    dsp_size_t i;
+
+    for(i = 0; i < len; i++) {
+        *(dest + i) = sqrt( *(rex + i) * *(rex + i) + *(imx + i) * *(imx + i) );
+    }
+}
+
+
+static void _dsp_stat_lanes_generic(dsp_f64_t *sig, dsp_size_t blocks, dsp_f64_t *mean, dsp_f64_t *m2, dsp_f64_t *min, dsp_f64_t *max)
+{
+    dsp_size_t n, j;
+    dsp_f64_t x, delta, inv_n;
+
+    for(n = 0; n < blocks; n++) {
+        inv_n = 1.0 / (dsp_f64_t)(n + 1);
+        for(j = 0; j < DSP_KERNEL_STAT_LANES; j++) {
+            x = *(sig + n * DSP_KERNEL_STAT_LANES + j);
+            delta = x - mean[j];
+            mean[j] += delta * inv_n;
+            m2[j] += delta * (x - mean[j]);
+            min[j] = (x < min[j]) ? x : min[j];
+            max[j] = (x > max[j]) ? x : max[j];
+        }
+    }
+}
+
+
+static void _dsp_fft_stage_generic(dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                                   dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign)
+{
+    dsp_size_t k, a, b, size = half << 1;
+    dsp_f64_t wr, wi, tr, ti;
+
+    for(k = 0; k < half; k++) {
+        wr = *(cos_tbl + k * step);
+        wi = sign * *(sin_tbl + k * step);
+
+        for(a = k; a < n; a += size) {
+            b = a + half;
+            tr = *(rex + b) * wr - *(imx + b) * wi;
+            ti = *(rex + b) * wi + *(imx + b) * wr;
+            *(rex + b) = *(rex + a) - tr;
+            *(imx + b) = *(imx + a) - ti;
+            *(rex + a) += tr;
+            *(imx + a) += ti;
+        }
+    }
+}
+
+
+static void _dsp_iq_deinterleave_generic(dsp_f64_t *rex, dsp_f64_t *imx, dsp_f64_t *iq, dsp_size_t len)
+{
+    dsp_size_t i;
+
+    for(i = 0; i < len; i++) {
+        *(rex + i) = *(iq + 2 * i);
+        *(imx + i) = *(iq + 2 * i + 1);
+    }
+}
+
+
+static void _dsp_iq_interleave_generic(dsp_f64_t *iq, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len)
+{
+    dsp_size_t i;
+
+    for(i = 0; i < len; i++) {
+        *(iq + 2 * i) = *(rex + i);
+        *(iq + 2 * i + 1) = *(imx + i);
+    }
+}
+
+
+static void _dsp_iq_magnitude_generic(dsp_f64_t *dest, dsp_f64_t *iq, dsp_size_t len)
+{
+    dsp_size_t i;
+
+    for(i = 0; i < len; i++) {
+        *(dest + i) = sqrt( *(iq + 2 * i) * *(iq + 2 * i) + *(iq + 2 * i + 1) * *(iq + 2 * i + 1) );
+    }
+}
+
+
+static void _dsp_fft_stage_iq_generic(dsp_f64_t *iq, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                                      dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign)
+{
+    dsp_size_t k, a, b, size = half << 1;
+    dsp_f64_t wr, wi, tr, ti;
+
+    for(k = 0; k < half; k++) {
+        wr = *(cos_tbl + k * step);
+        wi = sign * *(sin_tbl + k * step);
+
+        for(a = 2 * k; a < 2 * n; a += 2 * size) {
+            b = a + 2 * half;
+            tr = *(iq + b) * wr - *(iq + b + 1) * wi;
+            ti = *(iq + b) * wi + *(iq + b + 1) * wr;
+            *(iq + b) = *(iq + a) - tr;
+            *(iq + b + 1) = *(iq + a + 1) - ti;
+            *(iq + a) += tr;
+            *(iq + a + 1) += ti;
+        }
+    }
+}
+
+
+static dsp_kernels_t _dsp_kernels_generic = {
+    _dsp_convolution_generic,
+    _dsp_magnitude_generic,
+    _dsp_stat_lanes_generic,
+    _dsp_fft_stage_generic,
+    _dsp_iq_deinterleave_generic,
+    _dsp_iq_interleave_generic,
+    _dsp_iq_magnitude_generic,
+    _dsp_fft_stage_iq_generic
+};
+
+
+#if DSP_KERNELS_X86
+
+/*
+SSE2 kernels, 2 doubles per register
+*/
+
+__attribute__((target("sse2")))
+static void _dsp_convolution_sse2(dsp_f64_t *dest, dsp_f64_t *x, dsp_size_t x_len, dsp_f64_t *h, dsp_size_t h_len)
+{
+    dsp_size_t i, o;
+    dsp_f64_t *d;
+    __m128d acc, x0, x1, x2, x3;
+
+    for(i = 0; i + DSP_KERNEL_CONV_ROWS <= x_len; i += DSP_KERNEL_CONV_ROWS) {
+        d = dest + i;
+        o = DSP_KERNEL_CONV_ROWS - 1;
+        _dsp_convolution_rows(d, x + i, DSP_KERNEL_CONV_ROWS, h, h_len, 0, o);
+
+        x0 = _mm_set1_pd(*(x + i));
+        x1 = _mm_set1_pd(*(x + i + 1));
+        x2 = _mm_set1_pd(*(x + i + 2));
+        x3 = _mm_set1_pd(*(x + i + 3));
+        for(; o + 2 <= h_len; o += 2) {
+            acc = _mm_loadu_pd(d + o);
+            acc = _mm_add_pd(acc, _mm_mul_pd(x0, _mm_loadu_pd(h + o)));
+            acc = _mm_add_pd(acc, _mm_mul_pd(x1, _mm_loadu_pd(h + o - 1)));
+            acc = _mm_add_pd(acc, _mm_mul_pd(x2, _mm_loadu_pd(h + o - 2)));
+            acc = _mm_add_pd(acc, _mm_mul_pd(x3, _mm_loadu_pd(h + o - 3)));
+            _mm_storeu_pd(d + o, acc);
+        }
+
+        _dsp_convolution_rows(d, x + i, DSP_KERNEL_CONV_ROWS, h, h_len, o, h_len + DSP_KERNEL_CONV_ROWS - 1);
+    }
+
+    if(i < x_len) {
+        _dsp_convolution_rows(dest + i, x + i, x_len - i, h, h_len, 0, h_len + x_len - i - 1);
+    }
+}
+
+
+__attribute__((target("sse2")))
+static void _dsp_magnitude_sse2(dsp_f64_t *dest, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len)
+{
+    dsp_size_t i;
+    __m128d re, im;
+
+    for(i = 0; i + 2 <= len; i += 2) {
+        re = _mm_loadu_pd(rex + i);
+        im = _mm_loadu_pd(imx + i);
+        _mm_storeu_pd(dest + i, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(re, re), _mm_mul_pd(im, im))));
+    }
+    for(; i < len; i++) {
+        *(dest + i) = sqrt( *(rex + i) * *(rex + i) + *(imx + i) * *(imx + i) );
+    }
+}
+
+
+__attribute__((target("sse2")))
+static void _dsp_stat_lanes_sse2(dsp_f64_t *sig, dsp_size_t blocks, dsp_f64_t *mean, dsp_f64_t *m2, dsp_f64_t *min, dsp_f64_t *max)
+{
+    dsp_size_t n;
+    __m128d x0, x1, d0, d1, inv_n;
+    __m128d mean0 = _mm_loadu_pd(mean), mean1 = _mm_loadu_pd(mean + 2);
+    __m128d m20 = _mm_loadu_pd(m2), m21 = _mm_loadu_pd(m2 + 2);
+    __m128d min0 = _mm_loadu_pd(min), min1 = _mm_loadu_pd(min + 2);
+    __m128d max0 = _mm_loadu_pd(max), max1 = _mm_loadu_pd(max + 2);
+
+    for(n = 0; n < blocks; n++) {
+        inv_n = _mm_set1_pd(1.0 / (dsp_f64_t)(n + 1));
+        x0 = _mm_loadu_pd(sig + n * DSP_KERNEL_STAT_LANES);
+        x1 = _mm_loadu_pd(sig + n * DSP_KERNEL_STAT_LANES + 2);
+        d0 = _mm_sub_pd(x0, mean0);
+        d1 = _mm_sub_pd(x1, mean1);
+        mean0 = _mm_add_pd(mean0, _mm_mul_pd(d0, inv_n));
+        mean1 = _mm_add_pd(mean1, _mm_mul_pd(d1, inv_n));
+        m20 = _mm_add_pd(m20, _mm_mul_pd(d0, _mm_sub_pd(x0, mean0)));
+        m21 = _mm_add_pd(m21, _mm_mul_pd(d1, _mm_sub_pd(x1, mean1)));
+        min0 = _mm_min_pd(x0, min0);
+        min1 = _mm_min_pd(x1, min1);
+        max0 = _mm_max_pd(x0, max0);
+        max1 = _mm_max_pd(x1, max1);
+    }
+
+    _mm_storeu_pd(mean, mean0); _mm_storeu_pd(mean + 2, mean1);
+    _mm_storeu_pd(m2, m20); _mm_storeu_pd(m2 + 2, m21);
+    _mm_storeu_pd(min, min0); _mm_storeu_pd(min + 2, min1);
+    _mm_storeu_pd(max, max0); _mm_storeu_pd(max + 2, max1);
+}
+
+
+/*
+Vector butterfly stages run the groups inside a block of twiddle factors,
+stages with less butterflies than vector lanes use the generic stage
+*/
+__attribute__((target("sse2")))
+static void _dsp_fft_stage_sse2(dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                                dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign)
+{
+    dsp_size_t k, a, b, size = half << 1;
+    __m128d wr, wi, ra, ia, rb, ib, tr, ti, vsign = _mm_set1_pd(sign);
+
+    if(half < 2) {
+        _dsp_fft_stage_generic(rex, imx, n, half, step, cos_tbl, sin_tbl, sign);
+        return;
+    }
+
+    for(k = 0; k < half; k += 2) {
+        wr = _mm_set_pd(*(cos_tbl + (k + 1) * step), *(cos_tbl + k * step));
+        wi = _mm_mul_pd(vsign, _mm_set_pd(*(sin_tbl + (k + 1) * step), *(sin_tbl + k * step)));
+
+        for(a = k; a < n; a += size) {
+            b = a + half;
+            rb = _mm_loadu_pd(rex + b);
+            ib = _mm_loadu_pd(imx + b);
+            ra = _mm_loadu_pd(rex + a);
+            ia = _mm_loadu_pd(imx + a);
+            tr = _mm_sub_pd(_mm_mul_pd(rb, wr), _mm_mul_pd(ib, wi));
+            ti = _mm_add_pd(_mm_mul_pd(rb, wi), _mm_mul_pd(ib, wr));
+            _mm_storeu_pd(rex + b, _mm_sub_pd(ra, tr));
+            _mm_storeu_pd(imx + b, _mm_sub_pd(ia, ti));
+            _mm_storeu_pd(rex + a, _mm_add_pd(ra, tr));
+            _mm_storeu_pd(imx + a, _mm_add_pd(ia, ti));
+        }
+    }
+}
+
+
+/*
+Interleaved samples: one complex sample per register
+*/
+__attribute__((target("sse2")))
+static void _dsp_iq_deinterleave_sse2(dsp_f64_t *rex, dsp_f64_t *imx, dsp_f64_t *iq, dsp_size_t len)
+{
+    dsp_size_t i;
+    __m128d s0, s1;
+
+    for(i = 0; i + 2 <= len; i += 2) {
+        s0 = _mm_loadu_pd(iq + 2 * i);
+        s1 = _mm_loadu_pd(iq + 2 * i + 2);
+        _mm_storeu_pd(rex + i, _mm_unpacklo_pd(s0, s1));
+        _mm_storeu_pd(imx + i, _mm_unpackhi_pd(s0, s1));
+    }
+    _dsp_iq_deinterleave_generic(rex + i, imx + i, iq + 2 * i, len - i);
+}
+
+
+__attribute__((target("sse2")))
+static void _dsp_iq_interleave_sse2(dsp_f64_t *iq, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len)
+{
+    dsp_size_t i;
+    __m128d re, im;
+
+    for(i = 0; i + 2 <= len; i += 2) {
+        re = _mm_loadu_pd(rex + i);
+        im = _mm_loadu_pd(imx + i);
+        _mm_storeu_pd(iq + 2 * i, _mm_unpacklo_pd(re, im));
+        _mm_storeu_pd(iq + 2 * i + 2, _mm_unpackhi_pd(re, im));
+    }
+    _dsp_iq_interleave_generic(iq + 2 * i, rex + i, imx + i, len - i);
+}
+
+
+__attribute__((target("sse2")))
+static void _dsp_iq_magnitude_sse2(dsp_f64_t *dest, dsp_f64_t *iq, dsp_size_t len)
+{
+    dsp_size_t i;
+    __m128d s0, s1;
+
+    for(i = 0; i + 2 <= len; i += 2) {
+        s0 = _mm_loadu_pd(iq + 2 * i);
+        s1 = _mm_loadu_pd(iq + 2 * i + 2);
+        s0 = _mm_mul_pd(s0, s0);
+        s1 = _mm_mul_pd(s1, s1);
+        _mm_storeu_pd(dest + i, _mm_sqrt_pd(_mm_add_pd(_mm_unpacklo_pd(s0, s1), _mm_unpackhi_pd(s0, s1))));
+    }
+    _dsp_iq_magnitude_generic(dest + i, iq + 2 * i, len - i);
+}
+
+
+/*
+t = b * w: (br * wr - bi * wi, br * wi + bi * wr), the swapped sample is multiplied
+by wi and its real lane is negated, same operations as the generic stage
+*/
+__attribute__((target("sse2")))
+static void _dsp_fft_stage_iq_sse2(dsp_f64_t *iq, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                                   dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign)
+{
+    dsp_size_t k, a, b, size = half << 1;
+    __m128d wr, wi, sa, sb, t, neg_re = _mm_set_pd(1.0, -1.0);
+
+    for(k = 0; k < half; k++) {
+        wr = _mm_set1_pd(*(cos_tbl + k * step));
+        wi = _mm_mul_pd(neg_re, _mm_set1_pd(sign * *(sin_tbl + k * step)));
+
+        for(a = 2 * k; a < 2 * n; a += 2 * size) {
+            b = a + 2 * half;
+            sa = _mm_loadu_pd(iq + a);
+            sb = _mm_loadu_pd(iq + b);
+            t = _mm_add_pd(_mm_mul_pd(sb, wr), _mm_mul_pd(_mm_shuffle_pd(sb, sb, 1), wi));
+            _mm_storeu_pd(iq + b, _mm_sub_pd(sa, t));
+            _mm_storeu_pd(iq + a, _mm_add_pd(sa, t));
+        }
+    }
+}
+
+
+static dsp_kernels_t _dsp_kernels_sse2 = {
+    _dsp_convolution_sse2,
+    _dsp_magnitude_sse2,
+    _dsp_stat_lanes_sse2,
+    _dsp_fft_stage_sse2,
+    _dsp_iq_deinterleave_sse2,
+    _dsp_iq_interleave_sse2,
+    _dsp_iq_magnitude_sse2,
+    _dsp_fft_stage_iq_sse2
+};
+
+
+/*
+AVX2 kernels, 4 doubles per register
+*/
+
+__attribute__((target("avx2")))
+static void _dsp_convolution_avx2(dsp_f64_t *dest, dsp_f64_t *x, dsp_size_t x_len, dsp_f64_t *h, dsp_size_t h_len)
+{
+    dsp_size_t i, o;
+    dsp_f64_t *d;
+    __m256d acc, x0, x1, x2, x3;
+
+    for(i = 0; i + DSP_KERNEL_CONV_ROWS <= x_len; i += DSP_KERNEL_CONV_ROWS) {
+        d = dest + i;
+        o = DSP_KERNEL_CONV_ROWS - 1;
+        _dsp_convolution_rows(d, x + i, DSP_KERNEL_CONV_ROWS, h, h_len, 0, o);
+
+        x0 = _mm256_set1_pd(*(x + i));
+        x1 = _mm256_set1_pd(*(x + i + 1));
+        x2 = _mm256_set1_pd(*(x + i + 2));
+        x3 = _mm256_set1_pd(*(x + i + 3));
+        for(; o + 4 <= h_len; o += 4) {
+            acc = _mm256_loadu_pd(d + o);
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(x0, _mm256_loadu_pd(h + o)));
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(x1, _mm256_loadu_pd(h + o - 1)));
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(x2, _mm256_loadu_pd(h + o - 2)));
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(x3, _mm256_loadu_pd(h + o - 3)));
+            _mm256_storeu_pd(d + o, acc);
+        }
+        DSP_KERNEL_ZEROUPPER();
+
+        _dsp_convolution_rows(d, x + i, DSP_KERNEL_CONV_ROWS, h, h_len, o, h_len + DSP_KERNEL_CONV_ROWS - 1);
+    }
+
+    if(i < x_len) {
+        _dsp_convolution_rows(dest + i, x + i, x_len - i, h, h_len, 0, h_len + x_len - i - 1);
+    }
+}
+
+
+__attribute__((target("avx2")))
+static void _dsp_magnitude_avx2(dsp_f64_t *dest, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len)
+{
+    dsp_size_t i;
+    __m256d re, im;
+
+    for(i = 0; i + 4 <= len; i += 4) {
+        re = _mm256_loadu_pd(rex + i);
+        im = _mm256_loadu_pd(imx + i);
+        _mm256_storeu_pd(dest + i, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(re, re), _mm256_mul_pd(im, im))));
+    }
+    for(; i < len; i++) {
+        *(dest + i) = sqrt( *(rex + i) * *(rex + i) + *(imx + i) * *(imx + i) );
+    }
+    DSP_KERNEL_ZEROUPPER();
+}
+
+
+__attribute__((target("avx2")))
+static void _dsp_stat_lanes_avx2(dsp_f64_t *sig, dsp_size_t blocks, dsp_f64_t *mean, dsp_f64_t *m2, dsp_f64_t *min, dsp_f64_t *max)
+{
+    dsp_size_t n;
+    __m256d x, delta, inv_n;
+    __m256d vmean = _mm256_loadu_pd(mean), vm2 = _mm256_loadu_pd(m2);
+    __m256d vmin = _mm256_loadu_pd(min), vmax = _mm256_loadu_pd(max);
+
+    for(n = 0; n < blocks; n++) {
+        inv_n = _mm256_set1_pd(1.0 / (dsp_f64_t)(n + 1));
+        x = _mm256_loadu_pd(sig + n * DSP_KERNEL_STAT_LANES);
+        delta = _mm256_sub_pd(x, vmean);
+        vmean = _mm256_add_pd(vmean, _mm256_mul_pd(delta, inv_n));
+        vm2 = _mm256_add_pd(vm2, _mm256_mul_pd(delta, _mm256_sub_pd(x, vmean)));
+        vmin = _mm256_min_pd(x, vmin);
+        vmax = _mm256_max_pd(x, vmax);
+    }
+
+    _mm256_storeu_pd(mean, vmean);
+    _mm256_storeu_pd(m2, vm2);
+    _mm256_storeu_pd(min, vmin);
+    _mm256_storeu_pd(max, vmax);
+    DSP_KERNEL_ZEROUPPER();
+}
+
+
+__attribute__((target("avx2")))
+static void _dsp_fft_stage_avx2(dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                                dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign)
+{
+    dsp_size_t k, a, b, size = half << 1;
+    __m256d wr, wi, ra, ia, rb, ib, tr, ti, vsign = _mm256_set1_pd(sign);
+
+    if(half < 4) {
+        _dsp_fft_stage_generic(rex, imx, n, half, step, cos_tbl, sin_tbl, sign);
+        return;
+    }
+
+    for(k = 0; k < half; k += 4) {
+        wr = _mm256_set_pd(*(cos_tbl + (k + 3) * step), *(cos_tbl + (k + 2) * step),
+                           *(cos_tbl + (k + 1) * step), *(cos_tbl + k * step));
+        wi = _mm256_mul_pd(vsign, _mm256_set_pd(*(sin_tbl + (k + 3) * step), *(sin_tbl + (k + 2) * step),
+                                                *(sin_tbl + (k + 1) * step), *(sin_tbl + k * step)));
+
+        for(a = k; a < n; a += size) {
+            b = a + half;
+            rb = _mm256_loadu_pd(rex + b);
+            ib = _mm256_loadu_pd(imx + b);
+            ra = _mm256_loadu_pd(rex + a);
+            ia = _mm256_loadu_pd(imx + a);
+            tr = _mm256_sub_pd(_mm256_mul_pd(rb, wr), _mm256_mul_pd(ib, wi));
+            ti = _mm256_add_pd(_mm256_mul_pd(rb, wi), _mm256_mul_pd(ib, wr));
+            _mm256_storeu_pd(rex + b, _mm256_sub_pd(ra, tr));
+            _mm256_storeu_pd(imx + b, _mm256_sub_pd(ia, ti));
+            _mm256_storeu_pd(rex + a, _mm256_add_pd(ra, tr));
+            _mm256_storeu_pd(imx + a, _mm256_add_pd(ia, ti));
+        }
+    }
+    DSP_KERNEL_ZEROUPPER();
+}
+
+
+/*
+Interleaved samples: two complex samples per register, the unpacked lanes are
+reordered by permute4x64 (0, 2, 1, 3)
+*/
+__attribute__((target("avx2")))
+static void _dsp_iq_deinterleave_avx2(dsp_f64_t *rex, dsp_f64_t *imx, dsp_f64_t *iq, dsp_size_t len)
+{
+    dsp_size_t i;
+    __m256d s0, s1;
+
+    for(i = 0; i + 4 <= len; i += 4) {
+        s0 = _mm256_loadu_pd(iq + 2 * i);
+        s1 = _mm256_loadu_pd(iq + 2 * i + 4);
+        _mm256_storeu_pd(rex + i, _mm256_permute4x64_pd(_mm256_unpacklo_pd(s0, s1), 0xD8));
+        _mm256_storeu_pd(imx + i, _mm256_permute4x64_pd(_mm256_unpackhi_pd(s0, s1), 0xD8));
+    }
+    DSP_KERNEL_ZEROUPPER();
+    _dsp_iq_deinterleave_generic(rex + i, imx + i, iq + 2 * i, len - i);
+}
+
+
+__attribute__((target("avx2")))
+static void _dsp_iq_interleave_avx2(dsp_f64_t *iq, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len)
+{
+    dsp_size_t i;
+    __m256d re, im;
+
+    for(i = 0; i + 4 <= len; i += 4) {
+        re = _mm256_permute4x64_pd(_mm256_loadu_pd(rex + i), 0xD8);
+        im = _mm256_permute4x64_pd(_mm256_loadu_pd(imx + i), 0xD8);
+        _mm256_storeu_pd(iq + 2 * i, _mm256_unpacklo_pd(re, im));
+        _mm256_storeu_pd(iq + 2 * i + 4, _mm256_unpackhi_pd(re, im));
+    }
+    DSP_KERNEL_ZEROUPPER();
+    _dsp_iq_interleave_generic(iq + 2 * i, rex + i, imx + i, len - i);
+}
+
+
+__attribute__((target("avx2")))
+static void _dsp_iq_magnitude_avx2(dsp_f64_t *dest, dsp_f64_t *iq, dsp_size_t len)
+{
+    dsp_size_t i;
+    __m256d s0, s1;
+
+    for(i = 0; i + 4 <= len; i += 4) {
+        s0 = _mm256_loadu_pd(iq + 2 * i);
+        s1 = _mm256_loadu_pd(iq + 2 * i + 4);
+        s0 = _mm256_mul_pd(s0, s0);
+        s1 = _mm256_mul_pd(s1, s1);
+        s0 = _mm256_sqrt_pd(_mm256_add_pd(_mm256_unpacklo_pd(s0, s1), _mm256_unpackhi_pd(s0, s1)));
+        _mm256_storeu_pd(dest + i, _mm256_permute4x64_pd(s0, 0xD8));
+    }
+    DSP_KERNEL_ZEROUPPER();
+    _dsp_iq_magnitude_generic(dest + i, iq + 2 * i, len - i);
+}
+
+
+/*
+Two butterflies of neighbour twiddle factors per register,
+addsub: (br * wr - bi * wi, bi * wr + br * wi)
+*/
+__attribute__((target("avx2")))
+static void _dsp_fft_stage_iq_avx2(dsp_f64_t *iq, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                                   dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign)
+{
+    dsp_size_t k, a, b, size = half << 1;
+    dsp_f64_t wr0, wr1, wi0, wi1;
+    __m256d wr, wi, sa, sb, t;
+
+    if(half < 2) {
+        _dsp_fft_stage_iq_generic(iq, n, half, step, cos_tbl, sin_tbl, sign);
+        return;
+    }
+
+    for(k = 0; k < half; k += 2) {
+        wr0 = *(cos_tbl + k * step);
+        wr1 = *(cos_tbl + (k + 1) * step);
+        wi0 = sign * *(sin_tbl + k * step);
+        wi1 = sign * *(sin_tbl + (k + 1) * step);
+        wr = _mm256_set_pd(wr1, wr1, wr0, wr0);
+        wi = _mm256_set_pd(wi1, wi1, wi0, wi0);
+
+        for(a = 2 * k; a < 2 * n; a += 2 * size) {
+            b = a + 2 * half;
+            sa = _mm256_loadu_pd(iq + a);
+            sb = _mm256_loadu_pd(iq + b);
+            t = _mm256_addsub_pd(_mm256_mul_pd(sb, wr), _mm256_mul_pd(_mm256_permute_pd(sb, 0x5), wi));
+            _mm256_storeu_pd(iq + b, _mm256_sub_pd(sa, t));
+            _mm256_storeu_pd(iq + a, _mm256_add_pd(sa, t));
+        }
+    }
+    DSP_KERNEL_ZEROUPPER();
+}
+
+
+static dsp_kernels_t _dsp_kernels_avx2 = {
+    _dsp_convolution_avx2,
+    _dsp_magnitude_avx2,
+    _dsp_stat_lanes_avx2,
+    _dsp_fft_stage_avx2,
+    _dsp_iq_deinterleave_avx2,
+    _dsp_iq_interleave_avx2,
+    _dsp_iq_magnitude_avx2,
+    _dsp_fft_stage_iq_avx2
+};
+
+
+/*
+AVX-512 kernels, 8 doubles per register, the statistic has 4 lanes: AVX2 kernel,
+the interleaved layout conversions are bound by the memory: AVX2 kernels
+*/
+
+__attribute__((target("avx512f")))
+static void _dsp_convolution_avx512(dsp_f64_t *dest, dsp_f64_t *x, dsp_size_t x_len, dsp_f64_t *h, dsp_size_t h_len)
+{
+    dsp_size_t i, o;
+    dsp_f64_t *d;
+    __m512d acc, x0, x1, x2, x3;
+
+    for(i = 0; i + DSP_KERNEL_CONV_ROWS <= x_len; i += DSP_KERNEL_CONV_ROWS) {
+        d = dest + i;
+        o = DSP_KERNEL_CONV_ROWS - 1;
+        _dsp_convolution_rows(d, x + i, DSP_KERNEL_CONV_ROWS, h, h_len, 0, o);
+
+        x0 = _mm512_set1_pd(*(x + i));
+        x1 = _mm512_set1_pd(*(x + i + 1));
+        x2 = _mm512_set1_pd(*(x + i + 2));
+        x3 = _mm512_set1_pd(*(x + i + 3));
+        for(; o + 8 <= h_len; o += 8) {
+            acc = _mm512_loadu_pd(d + o);
+            acc = _mm512_add_pd(acc, _mm512_mul_pd(x0, _mm512_loadu_pd(h + o)));
+            acc = _mm512_add_pd(acc, _mm512_mul_pd(x1, _mm512_loadu_pd(h + o - 1)));
+            acc = _mm512_add_pd(acc, _mm512_mul_pd(x2, _mm512_loadu_pd(h + o - 2)));
+            acc = _mm512_add_pd(acc, _mm512_mul_pd(x3, _mm512_loadu_pd(h + o - 3)));
+            _mm512_storeu_pd(d + o, acc);
+        }
+        DSP_KERNEL_ZEROUPPER();
+
+        _dsp_convolution_rows(d, x + i, DSP_KERNEL_CONV_ROWS, h, h_len, o, h_len + DSP_KERNEL_CONV_ROWS - 1);
+    }
+
+    if(i < x_len) {
+        _dsp_convolution_rows(dest + i, x + i, x_len - i, h, h_len, 0, h_len + x_len - i - 1);
+    }
+}
+
+
+__attribute__((target("avx512f")))
+static void _dsp_magnitude_avx512(dsp_f64_t *dest, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len)
+{
+    dsp_size_t i;
+    __m512d re, im;
+
+    for(i = 0; i + 8 <= len; i += 8) {
+        re = _mm512_loadu_pd(rex + i);
+        im = _mm512_loadu_pd(imx + i);
+        _mm512_storeu_pd(dest + i, _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(re, re), _mm512_mul_pd(im, im))));
+    }
+    for(; i < len; i++) {
+        *(dest + i) = sqrt( *(rex + i) * *(rex + i) + *(imx + i) * *(imx + i) );
+    }
+    DSP_KERNEL_ZEROUPPER();
+}
+
+
+__attribute__((target("avx512f")))
+static void _dsp_fft_stage_avx512(dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                                  dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign)
+{
+    dsp_size_t k, a, b, size = half << 1;
+    __m512d wr, wi, ra, ia, rb, ib, tr, ti, vsign = _mm512_set1_pd(sign);
+
+    if(half < 8) {
+        _dsp_fft_stage_avx2(rex, imx, n, half, step, cos_tbl, sin_tbl, sign);
+        return;
+    }
+
+    for(k = 0; k < half; k += 8) {
+        wr = _mm512_set_pd(*(cos_tbl + (k + 7) * step), *(cos_tbl + (k + 6) * step),
+                           *(cos_tbl + (k + 5) * step), *(cos_tbl + (k + 4) * step),
+                           *(cos_tbl + (k + 3) * step), *(cos_tbl + (k + 2) * step),
+                           *(cos_tbl + (k + 1) * step), *(cos_tbl + k * step));
+        wi = _mm512_mul_pd(vsign, _mm512_set_pd(*(sin_tbl + (k + 7) * step), *(sin_tbl + (k + 6) * step),
+                                                *(sin_tbl + (k + 5) * step), *(sin_tbl + (k + 4) * step),
+                                                *(sin_tbl + (k + 3) * step), *(sin_tbl + (k + 2) * step),
+                                                *(sin_tbl + (k + 1) * step), *(sin_tbl + k * step)));
+
+        for(a = k; a < n; a += size) {
+            b = a + half;
+            rb = _mm512_loadu_pd(rex + b);
+            ib = _mm512_loadu_pd(imx + b);
+            ra = _mm512_loadu_pd(rex + a);
+            ia = _mm512_loadu_pd(imx + a);
+            tr = _mm512_sub_pd(_mm512_mul_pd(rb, wr), _mm512_mul_pd(ib, wi));
+            ti = _mm512_add_pd(_mm512_mul_pd(rb, wi), _mm512_mul_pd(ib, wr));
+            _mm512_storeu_pd(rex + b, _mm512_sub_pd(ra, tr));
+            _mm512_storeu_pd(imx + b, _mm512_sub_pd(ia, ti));
+            _mm512_storeu_pd(rex + a, _mm512_add_pd(ra, tr));
+            _mm512_storeu_pd(imx + a, _mm512_add_pd(ia, ti));
+        }
+    }
+    DSP_KERNEL_ZEROUPPER();
+}
+
+
+/*
+Four butterflies of neighbour twiddle factors per register, no addsub in AVX-512:
+the imaginary twiddle is negated in the real lanes as in the SSE2 stage
+*/
+__attribute__((target("avx512f")))
+static void _dsp_fft_stage_iq_avx512(dsp_f64_t *iq, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                                     dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign)
+{
+    dsp_size_t k, a, b, size = half << 1;
+    dsp_f64_t wr0, wr1, wr2, wr3, wi0, wi1, wi2, wi3;
+    __m512d wr, wi, sa, sb, t;
+
+    if(half < 4) {
+        _dsp_fft_stage_iq_avx2(iq, n, half, step, cos_tbl, sin_tbl, sign);
+        return;
+    }
+
+    for(k = 0; k < half; k += 4) {
+        wr0 = *(cos_tbl + k * step);
+        wr1 = *(cos_tbl + (k + 1) * step);
+        wr2 = *(cos_tbl + (k + 2) * step);
+        wr3 = *(cos_tbl + (k + 3) * step);
+        wi0 = sign * *(sin_tbl + k * step);
+        wi1 = sign * *(sin_tbl + (k + 1) * step);
+        wi2 = sign * *(sin_tbl + (k + 2) * step);
+        wi3 = sign * *(sin_tbl + (k + 3) * step);
+        wr = _mm512_set_pd(wr3, wr3, wr2, wr2, wr1, wr1, wr0, wr0);
+        wi = _mm512_set_pd(wi3, -wi3, wi2, -wi2, wi1, -wi1, wi0, -wi0);
+
+        for(a = 2 * k; a < 2 * n; a += 2 * size) {
+            b = a + 2 * half;
+            sa = _mm512_loadu_pd(iq + a);
+            sb = _mm512_loadu_pd(iq + b);
+            t = _mm512_add_pd(_mm512_mul_pd(sb, wr), _mm512_mul_pd(_mm512_permute_pd(sb, 0x55), wi));
+            _mm512_storeu_pd(iq + b, _mm512_sub_pd(sa, t));
+            _mm512_storeu_pd(iq + a, _mm512_add_pd(sa, t));
+        }
+    }
+    DSP_KERNEL_ZEROUPPER();
+}
+
+
+static dsp_kernels_t _dsp_kernels_avx512 = {
+    _dsp_convolution_avx512,
+    _dsp_magnitude_avx512,
+    _dsp_stat_lanes_avx2,
+    _dsp_fft_stage_avx512,
+    _dsp_iq_deinterleave_avx2,
+    _dsp_iq_interleave_avx2,
+    _dsp_iq_magnitude_avx2,
+    _dsp_fft_stage_iq_avx512
+};
+
+#endif
+
+
+dsp_kernels_t *_dsp_kernels_tbl[DSP_ISA_N] = {
+    &_dsp_kernels_generic,
+#if DSP_KERNELS_X86
+    &_dsp_kernels_sse2,
+    &_dsp_kernels_avx2,
+    &_dsp_kernels_avx512
+#else
+    NULL,
+    NULL,
+    NULL
+#endif
+};
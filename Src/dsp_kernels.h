@@ -0,0 +1,72 @@
+/**
+ * @file dsp_kernels.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP double precision hot kernel variants (library internal)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * One table of kernels per instruction set, the selected table is returned by
+ * _dsp_kernels(), see dsp_cpu.h
+ */
+
+#ifndef __DSP_KERNELS_H__
+#define __DSP_KERNELS_H__
+
+#include "dsp_common.h"
+#include "dsp_cpu.h"
+
+
+/*Input samples of one convolution pass in the vector variants*/
+#define DSP_KERNEL_CONV_ROWS    4
+
+/*Lanes of the statistic kernel, the caller merges them*/
+#define DSP_KERNEL_STAT_LANES   4
+
+/*x86 variants are compiled with GCC compatible compilers only*/
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define DSP_KERNELS_X86     1
+#else
+    #define DSP_KERNELS_X86     0
+#endif
+
+
+/*
+Kernel table of one instruction set
+*/
+typedef struct {
+    /*dest[i + j] += x[i] * h[j], dest is cleared by the caller*/
+    void (*convolution)(dsp_f64_t *dest, dsp_f64_t *x, dsp_size_t x_len, dsp_f64_t *h, dsp_size_t h_len);
+    /*dest[i] = sqrt(rex[i]^2 + imx[i]^2)*/
+    void (*magnitude)(dsp_f64_t *dest, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len);
+    /*Welford update of DSP_KERNEL_STAT_LANES interleaved lanes, blocks samples per lane*/
+    void (*stat_lanes)(dsp_f64_t *sig, dsp_size_t blocks, dsp_f64_t *mean, dsp_f64_t *m2, dsp_f64_t *min, dsp_f64_t *max);
+    /*one radix-2 butterfly stage of the FFT, half: half butterfly size, step: twiddle stride*/
+    void (*fft_stage)(dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                      dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign);
+    /*rex[i] = iq[2 * i], imx[i] = iq[2 * i + 1]*/
+    void (*iq_deinterleave)(dsp_f64_t *rex, dsp_f64_t *imx, dsp_f64_t *iq, dsp_size_t len);
+    /*iq[2 * i] = rex[i], iq[2 * i + 1] = imx[i]*/
+    void (*iq_interleave)(dsp_f64_t *iq, dsp_f64_t *rex, dsp_f64_t *imx, dsp_size_t len);
+    /*dest[i] = sqrt(iq[2 * i]^2 + iq[2 * i + 1]^2)*/
+    void (*iq_magnitude)(dsp_f64_t *dest, dsp_f64_t *iq, dsp_size_t len);
+    /*fft_stage on interleaved complex samples*/
+    void (*fft_stage_iq)(dsp_f64_t *iq, dsp_size_t n, dsp_size_t half, dsp_size_t step,
+                         dsp_f64_t *cos_tbl, dsp_f64_t *sin_tbl, dsp_f64_t sign);
+} dsp_kernels_t;
+
+
+/*Kernel tables, index: dsp_isa_t, NULL if the variant is not compiled*/
+extern dsp_kernels_t *_dsp_kernels_tbl[DSP_ISA_N];
+
+
+/**
+ * @brief Kernel table of the selected instruction set, selects it on the first call
+ * The first call is synchronized with pthread_once if the library is built with DSP_USE_PTHREAD.
+ *
+ * @return dsp_kernels_t* kernel table
+ */
+dsp_kernels_t *_dsp_kernels(void);
+
+#endif
@@ -0,0 +1,685 @@
+/**
+ * @file dsp_pipeline.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP block processing pipeline: chain of stages with ping-pong buffers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_pipeline.h"
+#include "dsp_dft.h"
+#include "dsp_buf.h"
+#include "dsp_instr.h"
+
+
+/*
+Streaming FIR stage: convolution of the block plus the tail of the previous blocks
+*/
+typedef struct {
+    dsp_fir_t *fir;
+    dsp_size_t tail_len;        // kernel_len - 1
+    dsp_val_t *tail;            // output samples reached by the previous blocks
+    dsp_val_t *conv;            // convolution of one block, block + kernel_len long
+} _dsp_pipeline_fir_t;
+
+
+/*
+Decimation stage
+*/
+typedef struct {
+    dsp_size_t factor;
+    dsp_size_t skip;            // samples to drop before the next kept sample
+} _dsp_pipeline_decimate_t;
+
+
+/*
+DFT framing stage
+*/
+typedef struct {
+    dsp_size_t frame_len;
+    dsp_size_t fill;            // samples in the partial frame
+    dsp_val_t *frame;           // partial frame
+    dsp_fft_plan_t *plan;       // FFT plan for power of two frames, NULL otherwise
+    dsp_val_t *rex;             // FFT work arrays, frame_len long
+    dsp_val_t *imx;
+} _dsp_pipeline_dft_t;
+
+
+static int _dsp_pipeline_reserve(dsp_pipeline_t *pl, dsp_size_t len);
+
+static dsp_size_t _dsp_pipeline_fir_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len);
+static void _dsp_pipeline_fir_reset(void *state);
+static void _dsp_pipeline_fir_destroy(void *state);
+static dsp_size_t _dsp_pipeline_decimate_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len);
+static void _dsp_pipeline_decimate_reset(void *state);
+static dsp_size_t _dsp_pipeline_dft_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len);
+static void _dsp_pipeline_dft_reset(void *state);
+static void _dsp_pipeline_dft_destroy(void *state);
+static dsp_size_t _dsp_pipeline_magnitude_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len);
+static dsp_size_t _dsp_pipeline_stats_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len);
+
+
+/**
+ * @brief Create empty pipeline
+ *
+ * @param block_len maximal input length of one dsp_pipeline_process call
+ * @return dsp_pipeline_t* created pipeline, NULL if block length is 0 or the allocation failed
+ */
+dsp_pipeline_t *dsp_pipeline_create(dsp_size_t block_len)
+{
+    dsp_pipeline_t *pl;
+
+    if(block_len == 0) {
+        return NULL;
+    }
+
+    pl = (dsp_pipeline_t *) calloc(1, sizeof(dsp_pipeline_t));
+    if(pl == NULL) {
+        return NULL;
+    }
+
+    pl->stages = (dsp_pipeline_stage_t *) calloc(DSP_PIPELINE_INIT_STAGES, sizeof(dsp_pipeline_stage_t));
+    if(pl->stages == NULL) {
+        free(pl);
+        return NULL;
+    }
+    pl->stages_cap = DSP_PIPELINE_INIT_STAGES;
+    pl->block_len = block_len;
+    pl->max_len = block_len;
+
+    return pl;
+}
+
+
+/**
+ * @brief Destroy pipeline and the owned stage states
+ *
+ * @param pl pipeline created by dsp_pipeline_create, can be NULL
+ */
+void dsp_pipeline_destroy(dsp_pipeline_t *pl)
+{
+    dsp_size_t i;
+
+    if(pl == NULL) {
+        return;
+    }
+
+    for(i = 0; i < pl->n_stages; i++) {
+        if((pl->stages + i)->destroy != NULL) {
+            (pl->stages + i)->destroy((pl->stages + i)->state);
+        }
+    }
+
+    dsp_buf_free(pl->buf[0]);
+    dsp_buf_free(pl->buf[1]);
+    free(pl->stages);
+    free(pl);
+}
+
+
+/**
+ * @brief Reset the history of every stage (filter tail, decimation phase, partial frame)
+ *
+ * @param pl pipeline
+ */
+void dsp_pipeline_reset(dsp_pipeline_t *pl)
+{
+    dsp_size_t i;
+
+    for(i = 0; i < pl->n_stages; i++) {
+        if((pl->stages + i)->reset != NULL) {
+            (pl->stages + i)->reset((pl->stages + i)->state);
+        }
+    }
+}
+
+
+/**
+ * @brief Append user defined stage to the end of the chain
+ * The maximal input length of the stage is the maximal output length of the previous
+ * stage (or the block length), see dsp_pipeline_max_len.
+ *
+ * @param pl pipeline
+ * @param process process function
+ * @param reset reset function, can be NULL
+ * @param destroy destroy function called by dsp_pipeline_destroy, NULL: state is owned by the caller
+ * @param state stage state
+ * @param max_out_len maximal output length of one call
+ * @param in_place nonzero if the output can be written over the input
+ * @return int 0 on success, -1 if the allocation failed
+ */
+int dsp_pipeline_add(dsp_pipeline_t *pl, dsp_pipeline_process_fn_t process, dsp_pipeline_reset_fn_t reset,
+                     dsp_pipeline_destroy_fn_t destroy, void *state, dsp_size_t max_out_len, int in_place)
+{
+    dsp_pipeline_stage_t *stage;
+
+    if(pl->n_stages == pl->stages_cap) {
+        stage = (dsp_pipeline_stage_t *) realloc(pl->stages, 2 * pl->stages_cap * sizeof(dsp_pipeline_stage_t));
+        if(stage == NULL) {
+            return -1;
+        }
+        pl->stages = stage;
+        pl->stages_cap *= 2;
+    }
+
+    /*an in-place stage can get the caller's block, then it writes the buffer*/
+    if(_dsp_pipeline_reserve(pl, (max_out_len > pl->max_len) ? max_out_len : pl->max_len) != 0) {
+        return -1;
+    }
+
+    stage = pl->stages + pl->n_stages;
+    stage->process = process;
+    stage->reset = reset;
+    stage->destroy = destroy;
+    stage->state = state;
+    stage->max_in_len = pl->max_len;
+    stage->max_out_len = max_out_len;
+    stage->in_place = in_place;
+
+    pl->n_stages++;
+    pl->max_len = max_out_len;
+    return 0;
+}
+
+
+/**
+ * @brief Maximal output length of the last stage, maximal input length of the next stage
+ *
+ * @param pl pipeline
+ * @return dsp_size_t maximal length, block length for empty pipeline
+ */
+dsp_size_t dsp_pipeline_max_len(dsp_pipeline_t *pl)
+{
+    return pl->max_len;
+}
+
+
+/**
+ * @brief Append streaming FIR filter stage
+ * Output length is the input length, the convolution tail is carried to the next block,
+ * so the concatenated output is the first samples of dsp_convolution on the whole signal.
+ *
+ * @param pl pipeline
+ * @param kernel filter kernel, it is copied
+ * @param kernel_len filter kernel length
+ * @param path application path, see dsp_fir_create
+ * @return int 0 on success, -1 if the allocation failed
+ */
+int dsp_pipeline_add_fir(dsp_pipeline_t *pl, dsp_val_t *kernel, dsp_size_t kernel_len, dsp_fir_path_t path)
+{
+    _dsp_pipeline_fir_t *st;
+    dsp_size_t max_len = pl->max_len;
+
+    st = (_dsp_pipeline_fir_t *) calloc(1, sizeof(_dsp_pipeline_fir_t));
+    if(st == NULL) {
+        return -1;
+    }
+
+    st->tail_len = kernel_len - 1;
+    st->fir = dsp_fir_create(kernel, kernel_len, max_len, path);
+    st->tail = (dsp_val_t *) calloc(kernel_len, sizeof(dsp_val_t));
+    st->conv = dsp_buf_alloc(max_len + kernel_len);
+    if(st->fir == NULL || st->tail == NULL || st->conv == NULL ||
+       dsp_pipeline_add(pl, _dsp_pipeline_fir_process, _dsp_pipeline_fir_reset,
+                        _dsp_pipeline_fir_destroy, st, max_len, 0) != 0) {
+        _dsp_pipeline_fir_destroy(st);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Append decimation stage, every factor-th sample is kept (in-place)
+ * The phase is carried to the next block. No anti-aliasing filter, add a low-pass
+ * FIR stage before it.
+ *
+ * @param pl pipeline
+ * @param factor decimation factor, >= 1
+ * @return int 0 on success, -1 if factor is 0 or the allocation failed
+ */
+int dsp_pipeline_add_decimate(dsp_pipeline_t *pl, dsp_size_t factor)
+{
+    _dsp_pipeline_decimate_t *st;
+
+    if(factor == 0) {
+        return -1;
+    }
+
+    st = (_dsp_pipeline_decimate_t *) calloc(1, sizeof(_dsp_pipeline_decimate_t));
+    if(st == NULL) {
+        return -1;
+    }
+    st->factor = factor;
+
+    if(dsp_pipeline_add(pl, _dsp_pipeline_decimate_process, _dsp_pipeline_decimate_reset,
+                        free, st, (pl->max_len + factor - 1) / factor, 1) != 0) {
+        free(st);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Append DFT framing stage
+ * Input samples are collected into frames of frame_len samples, partial frame is carried
+ * to the next block. The output of every complete frame is frame_len / 2 real parts followed by
+ * frame_len / 2 imaginary parts, the same as dsp_dft. Power of two frames are transformed by FFT.
+ *
+ * @param pl pipeline
+ * @param frame_len frame length, >= 2
+ * @return int 0 on success, -1 if the frame length is too short or the allocation failed
+ */
+int dsp_pipeline_add_dft(dsp_pipeline_t *pl, dsp_size_t frame_len)
+{
+    _dsp_pipeline_dft_t *st;
+    dsp_size_t max_frames;
+
+    if(frame_len < 2) {
+        return -1;
+    }
+
+    st = (_dsp_pipeline_dft_t *) calloc(1, sizeof(_dsp_pipeline_dft_t));
+    if(st == NULL) {
+        return -1;
+    }
+
+    st->frame_len = frame_len;
+    st->frame = dsp_buf_alloc(frame_len);
+    if(st->frame == NULL) {
+        _dsp_pipeline_dft_destroy(st);
+        return -1;
+    }
+
+    if(dsp_fft_next_pow2(frame_len) == frame_len) {
+        st->plan = dsp_fft_plan_create(frame_len);
+        st->rex = dsp_buf_alloc(frame_len);
+        st->imx = dsp_buf_alloc(frame_len);
+        if(st->plan == NULL || st->rex == NULL || st->imx == NULL) {
+            _dsp_pipeline_dft_destroy(st);
+            return -1;
+        }
+    }
+
+    /*partial frame of the previous block + the new samples*/
+    max_frames = (frame_len - 1 + pl->max_len) / frame_len;
+    if(dsp_pipeline_add(pl, _dsp_pipeline_dft_process, _dsp_pipeline_dft_reset,
+                        _dsp_pipeline_dft_destroy, st, max_frames * 2 * (frame_len / 2), 0) != 0) {
+        _dsp_pipeline_dft_destroy(st);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Append magnitude stage after a DFT stage (in-place)
+ * Every bins * 2 input samples (real parts, imaginary parts) give bins magnitudes.
+ *
+ * @param pl pipeline
+ * @param bins number of frequency bins in one spectrum (frame_len / 2 of the DFT stage)
+ * @return int 0 on success, -1 if bins is 0 or the allocation failed
+ */
+int dsp_pipeline_add_magnitude(dsp_pipeline_t *pl, dsp_size_t bins)
+{
+    dsp_size_t *st;
+
+    if(bins == 0) {
+        return -1;
+    }
+
+    st = (dsp_size_t *) malloc(sizeof(dsp_size_t));
+    if(st == NULL) {
+        return -1;
+    }
+    *st = bins;
+
+    if(dsp_pipeline_add(pl, _dsp_pipeline_magnitude_process, NULL, free, st, pl->max_len / 2, 1) != 0) {
+        free(st);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Append statistic tap stage, the input is accumulated and passed through (in-place)
+ *
+ * @param pl pipeline
+ * @param acc accumulator initialized by dsp_stat_acc_init, owned by the caller
+ * @return int 0 on success, -1 if the allocation failed
+ */
+int dsp_pipeline_add_stats(dsp_pipeline_t *pl, dsp_stat_acc_t *acc)
+{
+    return dsp_pipeline_add(pl, _dsp_pipeline_stats_process, NULL, NULL, acc, pl->max_len, 1);
+}
+
+
+/**
+ * @brief Process one block through every stage
+ * The returned pointer is valid until the next call, it points to one of the ping-pong
+ * buffers (or to the input for empty pipeline).
+ *
+ * @param pl pipeline
+ * @param input_sig input block
+ * @param input_sig_len length of input block, <= block length
+ * @param out_len output length of the last stage
+ * @return dsp_val_t* output of the last stage, NULL if the block is too long
+ */
+dsp_val_t *dsp_pipeline_process(dsp_pipeline_t *pl, dsp_val_t *input_sig, dsp_size_t input_sig_len,
+                                dsp_size_t *out_len)
+{
+    dsp_size_t i, len = input_sig_len;
+    dsp_val_t *cur = input_sig, *out;
+    int cur_buf = -1;       // ping-pong buffer of the current data, -1: caller's block
+    dsp_pipeline_stage_t *stage;
+    DSP_INSTR_BEGIN();
+
+    if(input_sig_len > pl->block_len) {
+        *out_len = 0;
+        return NULL;
+    }
+
+    for(i = 0; i < pl->n_stages; i++) {
+        stage = pl->stages + i;
+
+        /*the caller's block is never written*/
+        if(stage->in_place && cur_buf >= 0) {
+            out = cur;
+        } else {
+            cur_buf = (cur_buf == 0) ? 1 : 0;
+            out = pl->buf[cur_buf];
+        }
+
+        len = stage->process(stage->state, out, cur, len);
+        cur = out;
+    }
+
+    *out_len = len;
+    DSP_INSTR_END(DSP_INSTR_PIPELINE_PROCESS, input_sig_len * sizeof(dsp_val_t));
+    return cur;
+}
+
+
+/**
+ * @brief Process the whole signal block by block
+ * The outputs of the blocks are concatenated into the destination array.
+ *
+ * @param pl pipeline
+ * @param dest_sig destination array, NULL if only the side effects are needed (e.g. statistic tap)
+ * @param dest_sig_len length of destination array, the rest of the output is dropped
+ * @param input_sig input signal
+ * @param input_sig_len length of input signal
+ * @return dsp_size_t total output length of the last stage
+ */
+dsp_size_t dsp_pipeline_run(dsp_pipeline_t *pl, dsp_val_t *dest_sig, dsp_size_t dest_sig_len,
+                            dsp_val_t *input_sig, dsp_size_t input_sig_len)
+{
+    dsp_size_t pos, len, out_len, copy_len, total = 0;
+    dsp_val_t *out;
+
+    for(pos = 0; pos < input_sig_len; pos += len) {
+        len = (input_sig_len - pos < pl->block_len) ? (input_sig_len - pos) : pl->block_len;
+        out = dsp_pipeline_process(pl, input_sig + pos, len, &out_len);
+
+        if(dest_sig != NULL && total < dest_sig_len) {
+            copy_len = (dest_sig_len - total < out_len) ? (dest_sig_len - total) : out_len;
+            memcpy(dest_sig + total, out, copy_len * sizeof(dsp_val_t));
+        }
+        total += out_len;
+    }
+
+    return total;
+}
+
+
+/**
+ * @brief Grow the ping-pong buffers, their content is not kept
+ *
+ * @param pl pipeline
+ * @param len required length
+ * @return int 0 on success, -1 if the allocation failed
+ */
+static int _dsp_pipeline_reserve(dsp_pipeline_t *pl, dsp_size_t len)
+{
+    int b;
+
+    if(len <= pl->buf_len) {
+        return 0;
+    }
+
+    for(b = 0; b < 2; b++) {
+        dsp_buf_free(pl->buf[b]);
+        pl->buf[b] = dsp_buf_alloc(len);
+        if(pl->buf[b] == NULL) {
+            dsp_buf_free(pl->buf[0]);
+            pl->buf[0] = NULL;
+            pl->buf_len = 0;
+            return -1;
+        }
+    }
+    pl->buf_len = len;
+    return 0;
+}
+
+
+/**
+ * @brief FIR stage: y = (x * h)[0 .. n - 1] + tail, new tail = rest of the convolution + old tail
+ *
+ * @param state FIR stage state
+ * @param out output, in_len long
+ * @param in input block
+ * @param in_len input length
+ * @return dsp_size_t in_len
+ */
+static dsp_size_t _dsp_pipeline_fir_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len)
+{
+    _dsp_pipeline_fir_t *st = (_dsp_pipeline_fir_t *)state;
+    dsp_size_t i;
+
+    if(in_len == 0) {
+        return 0;
+    }
+
+    dsp_fir_apply(st->fir, st->conv, in, in_len);
+
+    for(i = 0; i < in_len; i++) {
+        *(out + i) = *(st->conv + i) + ((i < st->tail_len) ? *(st->tail + i) : 0.0);
+    }
+
+    /*shift the old tail by the block length, forward copy is safe*/
+    for(i = 0; i < st->tail_len; i++) {
+        *(st->tail + i) = ((i + in_len < st->tail_len) ? *(st->tail + i + in_len) : 0.0) +
+                          *(st->conv + in_len + i);
+    }
+
+    return in_len;
+}
+
+
+/**
+ * @brief Clear the tail of the FIR stage
+ *
+ * @param state FIR stage state
+ */
+static void _dsp_pipeline_fir_reset(void *state)
+{
+    _dsp_pipeline_fir_t *st = (_dsp_pipeline_fir_t *)state;
+
+    memset(st->tail, 0, st->tail_len * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Free the FIR stage state
+ *
+ * @param state FIR stage state
+ */
+static void _dsp_pipeline_fir_destroy(void *state)
+{
+    _dsp_pipeline_fir_t *st = (_dsp_pipeline_fir_t *)state;
+
+    dsp_fir_destroy(st->fir);
+    free(st->tail);
+    dsp_buf_free(st->conv);
+    free(st);
+}
+
+
+/**
+ * @brief Decimation stage, out can be the same as in
+ *
+ * @param state decimation stage state
+ * @param out output
+ * @param in input block
+ * @param in_len input length
+ * @return dsp_size_t number of kept samples
+ */
+static dsp_size_t _dsp_pipeline_decimate_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len)
+{
+    _dsp_pipeline_decimate_t *st = (_dsp_pipeline_decimate_t *)state;
+    dsp_size_t i, n = 0;
+
+    for(i = st->skip; i < in_len; i += st->factor) {
+        *(out + n++) = *(in + i);
+    }
+    st->skip = i - in_len;
+
+    return n;
+}
+
+
+/**
+ * @brief Reset the phase of the decimation stage
+ *
+ * @param state decimation stage state
+ */
+static void _dsp_pipeline_decimate_reset(void *state)
+{
+    ((_dsp_pipeline_decimate_t *)state)->skip = 0;
+}
+
+
+/**
+ * @brief DFT framing stage, spectrum of every completed frame
+ *
+ * @param state DFT stage state
+ * @param out output, frame_len / 2 real and frame_len / 2 imaginary parts per frame
+ * @param in input block
+ * @param in_len input length
+ * @return dsp_size_t output length
+ */
+static dsp_size_t _dsp_pipeline_dft_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len)
+{
+    _dsp_pipeline_dft_t *st = (_dsp_pipeline_dft_t *)state;
+    dsp_size_t pos = 0, n, bins = st->frame_len / 2, out_len = 0;
+
+    while(pos < in_len) {
+        n = st->frame_len - st->fill;
+        n = (in_len - pos < n) ? (in_len - pos) : n;
+        memcpy(st->frame + st->fill, in + pos, n * sizeof(dsp_val_t));
+        st->fill += n;
+        pos += n;
+
+        if(st->fill < st->frame_len) {
+            break;
+        }
+
+        if(st->plan != NULL) {
+            memcpy(st->rex, st->frame, st->frame_len * sizeof(dsp_val_t));
+            memset(st->imx, 0, st->frame_len * sizeof(dsp_val_t));
+            dsp_fft(st->plan, st->rex, st->imx);
+            memcpy(out + out_len, st->rex, bins * sizeof(dsp_val_t));
+            memcpy(out + out_len + bins, st->imx, bins * sizeof(dsp_val_t));
+        } else {
+            dsp_dft(st->frame, out + out_len, out + out_len + bins, st->frame_len);
+        }
+
+        out_len += 2 * bins;
+        st->fill = 0;
+    }
+
+    return out_len;
+}
+
+
+/**
+ * @brief Drop the partial frame of the DFT stage
+ *
+ * @param state DFT stage state
+ */
+static void _dsp_pipeline_dft_reset(void *state)
+{
+    ((_dsp_pipeline_dft_t *)state)->fill = 0;
+}
+
+
+/**
+ * @brief Free the DFT stage state
+ *
+ * @param state DFT stage state
+ */
+static void _dsp_pipeline_dft_destroy(void *state)
+{
+    _dsp_pipeline_dft_t *st = (_dsp_pipeline_dft_t *)state;
+
+    dsp_fft_plan_destroy(st->plan);
+    dsp_buf_free(st->frame);
+    dsp_buf_free(st->rex);
+    dsp_buf_free(st->imx);
+    free(st);
+}
+
+
+/**
+ * @brief Magnitude stage, out can be the same as in
+ * Spectrum f is read from [2 * f * bins, 2 * (f + 1) * bins) and written to
+ * [f * bins, (f + 1) * bins), the output never overtakes the unread input.
+ *
+ * @param state number of bins
+ * @param out output
+ * @param in spectra from the DFT stage
+ * @param in_len input length, multiple of 2 * bins
+ * @return dsp_size_t output length
+ */
+static dsp_size_t _dsp_pipeline_magnitude_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len)
+{
+    dsp_size_t f, bins = *(dsp_size_t *)state, n_frames = in_len / (2 * bins);
+
+    for(f = 0; f < n_frames; f++) {
+        dsp_dft_magnitude(out + f * bins, in + 2 * f * bins, in + (2 * f + 1) * bins, bins);
+    }
+
+    return n_frames * bins;
+}
+
+
+/**
+ * @brief Statistic tap stage, accumulates the input and passes it through
+ *
+ * @param state statistic accumulator
+ * @param out output, copied only if it is not the input
+ * @param in input block
+ * @param in_len input length
+ * @return dsp_size_t in_len
+ */
+static dsp_size_t _dsp_pipeline_stats_process(void *state, dsp_val_t *out, dsp_val_t *in, dsp_size_t in_len)
+{
+    dsp_stat_acc_update((dsp_stat_acc_t *)state, in, in_len);
+
+    if(out != in) {
+        memcpy(out, in, in_len * sizeof(dsp_val_t));
+    }
+
+    return in_len;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file dsp_prec.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP precision template definitions (library internal)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * The single and double precision functions are generated from one source.
+ * Define DSP_PREC to 32 or 64, include this file, then include the *_tmpl.h source:
+ *
+ *      #define DSP_PREC 32
+ *      #include "dsp_prec.h"
+ *      #include "dsp_stat_tmpl.h"
+ *
+ * DSP_T:           value type
+ * DSP_FN(name):    precision suffixed function name, e.g. dsp_sig_mean_f32
+ * DSP_TN(name):    precision suffixed type name, e.g. dsp_fft_plan_f32_t
+ * DSP_SIN, ...:    math functions of the given precision
+ *
+ * No include guard, the file is included once per precision.
+ */
+
+#undef DSP_T
+#undef DSP_FN
+#undef DSP_TN
+#undef DSP_SQRT
+#undef DSP_SIN
+#undef DSP_COS
+#undef DSP_ATAN
+#undef DSP_FABS
+
+#if DSP_PREC == 32
+
+    #define DSP_T           dsp_f32_t
+    #define DSP_FN(name)    name##_f32
+    #define DSP_TN(name)    name##_f32_t
+    #define DSP_SQRT        sqrtf
+    #define DSP_SIN         sinf
+    #define DSP_COS         cosf
+    #define DSP_ATAN        atanf
+    #define DSP_FABS        fabsf
+
+#elif DSP_PREC == 64
+
+    #define DSP_T           dsp_f64_t
+    #define DSP_FN(name)    name##_f64
+    #define DSP_TN(name)    name##_f64_t
+    #define DSP_SQRT        sqrt
+    #define DSP_SIN         sin
+    #define DSP_COS         cos
+    #define DSP_ATAN        atan
+    #define DSP_FABS        fabs
+
+#else
+    #error "DSP_PREC must be 32 or 64"
+#endif
@@ -0,0 +1,327 @@
+/**
+ * @file dsp_psd.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP power spectral density estimation by Welch's method
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <string.h>
+#include "dsp_psd.h"
+#include "dsp_filter.h"
+#include "dsp_instr.h"
+
+
+static void _dsp_welch_add_segment(dsp_welch_t *welch, dsp_val_t *head, dsp_size_t head_len, dsp_val_t *tail);
+static void _dsp_welch_flush_batch(dsp_welch_t *welch);
+
+
+/**
+ * @brief Workspace bytes of a Welch estimator created by dsp_welch_create_ws
+ *
+ * @param seg_len samples per segment
+ * @return dsp_size_t workspace bytes
+ */
+dsp_size_t dsp_welch_workspace_size(dsp_size_t seg_len)
+{
+    dsp_size_t fft_len = dsp_fft_next_pow2(seg_len);
+
+    return DSP_WORKSPACE_ROUND(sizeof(dsp_welch_t)) + dsp_fft_plan_workspace_size(fft_len)
+           + 2 * DSP_WORKSPACE_ROUND(seg_len * sizeof(dsp_val_t))
+           + 2 * DSP_WORKSPACE_ROUND(DSP_WELCH_BATCH * fft_len * sizeof(dsp_val_t))
+           + DSP_WORKSPACE_ROUND((fft_len / 2 + 1) * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Create Welch estimator
+ *
+ * @param seg_len samples per segment, >= 2
+ * @param overlap overlapping samples of the neighbour segments, less than seg_len (typically seg_len / 2)
+ * @param window_calc window function (dsp_hamming_window, dsp_blackman_window, ...), NULL: Hamming
+ * @param sample_rate sample rate in Hz, <= 0: 1 (density per normalized frequency)
+ * @param ctx execution context of the batch transform, NULL: serial
+ * @return dsp_welch_t* created estimator, NULL if the parameters are invalid or the allocation failed
+ */
+dsp_welch_t *dsp_welch_create(dsp_size_t seg_len, dsp_size_t overlap, dsp_val_t (*window_calc)(int, dsp_size_t),
+                              dsp_val_t sample_rate, dsp_exec_ctx_t *ctx)
+{
+    dsp_workspace_t *ws;
+    dsp_welch_t *welch;
+
+    if(seg_len < 2 || overlap >= seg_len) {
+        return NULL;
+    }
+
+    ws = dsp_workspace_create(dsp_welch_workspace_size(seg_len));
+    if(ws == NULL) {
+        return NULL;
+    }
+
+    welch = dsp_welch_create_ws(seg_len, overlap, window_calc, sample_rate, ctx, ws);
+    if(welch == NULL) {
+        dsp_workspace_destroy(ws);
+        return NULL;
+    }
+    welch->own_ws = ws;
+    return welch;
+}
+
+
+/**
+ * @brief Create Welch estimator in workspace
+ * The estimator lives until the workspace is released, it must not be destroyed.
+ *
+ * @param seg_len samples per segment, >= 2
+ * @param overlap overlapping samples of the neighbour segments, less than seg_len
+ * @param window_calc window function, NULL: Hamming
+ * @param sample_rate sample rate in Hz, <= 0: 1
+ * @param ctx execution context of the batch transform, NULL: serial
+ * @param ws workspace, at least dsp_welch_workspace_size(seg_len) bytes free
+ * @return dsp_welch_t* created estimator, NULL if the parameters are invalid or the workspace is full
+ */
+dsp_welch_t *dsp_welch_create_ws(dsp_size_t seg_len, dsp_size_t overlap, dsp_val_t (*window_calc)(int, dsp_size_t),
+                                 dsp_val_t sample_rate, dsp_exec_ctx_t *ctx, dsp_workspace_t *ws)
+{
+    dsp_size_t i, mark;
+    dsp_val_t win_pow = 0.0;
+    dsp_welch_t *welch;
+
+    if(seg_len < 2 || overlap >= seg_len || ws == NULL) {
+        return NULL;
+    }
+
+    mark = dsp_workspace_mark(ws);
+    welch = (dsp_welch_t *) dsp_workspace_alloc(ws, sizeof(dsp_welch_t));
+    if(welch == NULL) {
+        return NULL;
+    }
+
+    welch->seg_len = seg_len;
+    welch->hop = seg_len - overlap;
+    welch->fft_len = dsp_fft_next_pow2(seg_len);
+    welch->bins = welch->fft_len / 2 + 1;
+    welch->sample_rate = (sample_rate > 0.0) ? sample_rate : 1.0;
+    welch->ctx = ctx;
+    welch->own_ws = NULL;
+
+    welch->plan = dsp_fft_plan_create_ws(welch->fft_len, ws);
+    welch->window = (dsp_val_t *) dsp_workspace_alloc(ws, seg_len * sizeof(dsp_val_t));
+    welch->hist = (dsp_val_t *) dsp_workspace_alloc(ws, seg_len * sizeof(dsp_val_t));
+    welch->batch_rex = (dsp_val_t *) dsp_workspace_alloc(ws, DSP_WELCH_BATCH * welch->fft_len * sizeof(dsp_val_t));
+    welch->batch_imx = (dsp_val_t *) dsp_workspace_alloc(ws, DSP_WELCH_BATCH * welch->fft_len * sizeof(dsp_val_t));
+    welch->acc = (dsp_val_t *) dsp_workspace_alloc(ws, welch->bins * sizeof(dsp_val_t));
+
+    if(welch->plan == NULL || welch->window == NULL || welch->hist == NULL ||
+       welch->batch_rex == NULL || welch->batch_imx == NULL || welch->acc == NULL) {
+        dsp_workspace_release(ws, mark);
+        return NULL;
+    }
+
+    for(i = 0; i < seg_len; i++) {
+        *(welch->window + i) = (window_calc == NULL) ? dsp_hamming_window(i, seg_len) : window_calc(i, seg_len);
+        win_pow += *(welch->window + i) * *(welch->window + i);
+    }
+    welch->scale = (win_pow > 0.0) ? 1.0 / (welch->sample_rate * win_pow) : 0.0;
+
+    dsp_welch_reset(welch);
+    return welch;
+}
+
+
+/**
+ * @brief Destroy Welch estimator created by dsp_welch_create
+ *
+ * @param welch estimator, can be NULL
+ */
+void dsp_welch_destroy(dsp_welch_t *welch)
+{
+    if(welch == NULL) {
+        return;
+    }
+
+    /*the estimator itself is in the workspace*/
+    dsp_workspace_destroy(welch->own_ws);
+}
+
+
+/**
+ * @brief Drop the accumulated segments and the stream state
+ *
+ * @param welch estimator
+ */
+void dsp_welch_reset(dsp_welch_t *welch)
+{
+    welch->batch_fill = 0;
+    welch->hist_fill = 0;
+    welch->n_segments = 0;
+    memset(welch->acc, 0, welch->bins * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Add the next block of the input stream
+ * The blocks can have any length, the segments are the same as in the concatenated signal.
+ *
+ * @param welch estimator
+ * @param input_sig input block
+ * @param input_sig_len input block length
+ */
+void dsp_welch_update(dsp_welch_t *welch, dsp_val_t *input_sig, dsp_size_t input_sig_len)
+{
+    dsp_size_t i = 0, fill = welch->hist_fill;
+    dsp_size_t seg_len = welch->seg_len, hop = welch->hop;
+
+    DSP_INSTR_BEGIN();
+
+    /*segments started in the previous blocks*/
+    while(fill > 0 && i + (seg_len - fill) <= input_sig_len) {
+        _dsp_welch_add_segment(welch, welch->hist, fill, input_sig + i);
+
+        if(hop < fill) {
+            fill -= hop;
+            memmove(welch->hist, welch->hist + hop, fill * sizeof(dsp_val_t));
+        } else {
+            i += hop - fill;
+            fill = 0;
+        }
+    }
+
+    if(fill == 0) {
+        /*segments inside the block*/
+        for(; i + seg_len <= input_sig_len; i += hop) {
+            _dsp_welch_add_segment(welch, input_sig + i, seg_len, NULL);
+        }
+    }
+
+    /*hop <= seg_len: the rest is shorter than a segment, i <= input_sig_len*/
+    memcpy(welch->hist + fill, input_sig + i, (input_sig_len - i) * sizeof(dsp_val_t));
+    welch->hist_fill = fill + (input_sig_len - i);
+
+    DSP_INSTR_END(DSP_INSTR_WELCH_UPDATE, input_sig_len * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Get the estimate of the segments so far
+ * The stream can be continued, the estimate is the running average of every segment.
+ *
+ * @param welch estimator
+ * @param dest_psd one-sided power spectral density, bins long, 0 if there is no complete segment
+ * @return dsp_size_t number of averaged segments
+ */
+dsp_size_t dsp_welch_get(dsp_welch_t *welch, dsp_val_t *dest_psd)
+{
+    dsp_size_t k, bins = welch->bins;
+    dsp_val_t scale;
+
+    _dsp_welch_flush_batch(welch);
+
+    if(welch->n_segments == 0) {
+        memset(dest_psd, 0, bins * sizeof(dsp_val_t));
+        return 0;
+    }
+
+    /*one-sided: the negative frequencies are added to the positive ones, DC and Nyquist are single*/
+    scale = welch->scale / welch->n_segments;
+    for(k = 0; k < bins; k++) {
+        *(dest_psd + k) = ((k == 0 || k == bins - 1) ? scale : 2.0 * scale) * *(welch->acc + k);
+    }
+    return welch->n_segments;
+}
+
+
+/**
+ * @brief Power spectral density of a whole signal by Welch's method
+ *
+ * @param dest_psd one-sided power spectral density, next_pow2(seg_len) / 2 + 1 long
+ * @param input_sig input signal
+ * @param input_sig_len input signal length
+ * @param seg_len samples per segment, >= 2
+ * @param overlap overlapping samples of the neighbour segments, less than seg_len
+ * @param window_calc window function, NULL: Hamming
+ * @param sample_rate sample rate in Hz, <= 0: 1
+ * @return dsp_size_t number of averaged segments, 0 if the parameters are invalid, the signal
+ * is shorter than a segment or the allocation failed
+ */
+dsp_size_t dsp_welch_psd(dsp_val_t *dest_psd, dsp_val_t *input_sig, dsp_size_t input_sig_len,
+                         dsp_size_t seg_len, dsp_size_t overlap, dsp_val_t (*window_calc)(int, dsp_size_t),
+                         dsp_val_t sample_rate)
+{
+    dsp_size_t n_segments;
+    dsp_welch_t *welch = dsp_welch_create(seg_len, overlap, window_calc, sample_rate, NULL);
+
+    if(welch == NULL) {
+        return 0;
+    }
+
+    dsp_welch_update(welch, input_sig, input_sig_len);
+    n_segments = dsp_welch_get(welch, dest_psd);
+    dsp_welch_destroy(welch);
+    return n_segments;
+}
+
+
+/*
+Window one segment into the batch: head_len samples from head, the rest from tail,
+zero padding to fft_len. Two segments share a row as real and imaginary part,
+the batch is transformed when it is full.
+*/
+static void _dsp_welch_add_segment(dsp_welch_t *welch, dsp_val_t *head, dsp_size_t head_len, dsp_val_t *tail)
+{
+    dsp_size_t n, fft_len = welch->fft_len, row = welch->batch_fill / 2;
+    dsp_val_t *rex = welch->batch_rex + row * fft_len;
+    dsp_val_t *imx = welch->batch_imx + row * fft_len;
+    dsp_val_t *dest = (welch->batch_fill % 2 == 0) ? rex : imx;
+    dsp_val_t *w = welch->window;
+
+    for(n = 0; n < head_len; n++) {
+        *(dest + n) = *(w + n) * *(head + n);
+    }
+    for(; n < welch->seg_len; n++) {
+        *(dest + n) = *(w + n) * *(tail + n - head_len);
+    }
+    memset(dest + welch->seg_len, 0, (fft_len - welch->seg_len) * sizeof(dsp_val_t));
+    if(dest == rex) {
+        /*no pair yet*/
+        memset(imx, 0, fft_len * sizeof(dsp_val_t));
+    }
+
+    welch->n_segments++;
+    if(++welch->batch_fill == 2 * DSP_WELCH_BATCH) {
+        _dsp_welch_flush_batch(welch);
+    }
+}
+
+
+/*
+Transform the rows of the batch and add the periodograms to the sum
+z = x1 + j * x2, X[N - k] = conj(X[k]) for real signals, so
+pow(|X1[k]|, 2) + pow(|X2[k]|, 2) = (pow(|Z[k]|, 2) + pow(|Z[N - k]|, 2)) / 2
+A row without pair has zero imaginary part, then the same gives pow(|X1[k]|, 2).
+*/
+static void _dsp_welch_flush_batch(dsp_welch_t *welch)
+{
+    dsp_size_t r, k, nk, fft_len = welch->fft_len, n_rows = (welch->batch_fill + 1) / 2;
+    dsp_val_t *rex, *imx;
+
+    if(welch->batch_fill == 0) {
+        return;
+    }
+
+    dsp_fft_batch(welch->plan, welch->batch_rex, welch->batch_imx, n_rows, welch->ctx);
+
+    for(r = 0; r < n_rows; r++) {
+        rex = welch->batch_rex + r * fft_len;
+        imx = welch->batch_imx + r * fft_len;
+        for(k = 0; k < welch->bins; k++) {
+            nk = (fft_len - k) & (fft_len - 1);
+            *(welch->acc + k) += 0.5 * (*(rex + k) * *(rex + k) + *(imx + k) * *(imx + k) +
+                                        *(rex + nk) * *(rex + nk) + *(imx + nk) * *(imx + nk));
+        }
+    }
+    welch->batch_fill = 0;
+}
@@ -0,0 +1,370 @@
+/**
+ * @file dsp_quantile.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP streaming quantile estimation (t-digest) and fixed-bin histogram
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_quantile.h"
+#include "dsp_instr.h"
+
+
+static void _dsp_quantile_compress(dsp_quantile_acc_t *acc);
+static void _dsp_quantile_append(dsp_quantile_acc_t *acc, dsp_val_t mean, dsp_val_t weight);
+static dsp_val_t _dsp_quantile_limit(dsp_val_t compression, dsp_val_t q);
+static int _dsp_centroid_cmp(const void *a, const void *b);
+
+
+/**
+ * @brief Initialize quantile accumulator
+ *
+ * @param acc accumulator
+ * @param compression accuracy parameter, larger is more accurate, 0: DSP_QUANTILE_DEF_COMPRESSION
+ *                    limited to DSP_QUANTILE_MAX_CENTROIDS / 2
+ */
+void dsp_quantile_acc_init(dsp_quantile_acc_t *acc, dsp_val_t compression)
+{
+    if(compression <= 0.0) {
+        compression = DSP_QUANTILE_DEF_COMPRESSION;
+    }
+    if(compression > (dsp_val_t)(DSP_QUANTILE_MAX_CENTROIDS / 2)) {
+        compression = (dsp_val_t)(DSP_QUANTILE_MAX_CENTROIDS / 2);
+    }
+
+    acc->compression = compression;
+    acc->n_centroids = 0;
+    acc->n_buf = 0;
+    acc->total_weight = 0.0;
+    acc->min = 0.0;
+    acc->max = 0.0;
+}
+
+
+/**
+ * @brief Update quantile accumulator with a block of samples
+ * The samples are buffered, the buffer is compressed into the centroids when it is full.
+ * Amortized cost per sample: O(log(DSP_QUANTILE_MAX_CENTROIDS + DSP_QUANTILE_BUF_LEN))
+ *
+ * @param acc accumulator
+ * @param sig signal block
+ * @param len length of block
+ */
+void dsp_quantile_acc_update(dsp_quantile_acc_t *acc, dsp_val_t *sig, dsp_size_t len)
+{
+    dsp_size_t i;
+    DSP_INSTR_BEGIN();
+
+    for(i = 0; i < len; i++) {
+        _dsp_quantile_append(acc, *(sig + i), 1.0);
+    }
+    DSP_INSTR_END(DSP_INSTR_QUANTILE_ACC_UPDATE, len * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Merge quantile accumulator of other samples into the accumulator
+ *
+ * @param acc accumulator, updated
+ * @param other accumulator to merge, not modified
+ */
+void dsp_quantile_acc_merge(dsp_quantile_acc_t *acc, dsp_quantile_acc_t *other)
+{
+    dsp_size_t i;
+    dsp_val_t min = other->min, max = other->max;
+
+    if(other->total_weight == 0.0) {
+        return;
+    }
+
+    for(i = 0; i < other->n_centroids + other->n_buf; i++) {
+        _dsp_quantile_append(acc, other->centroid[i].mean, other->centroid[i].weight);
+    }
+
+    /*the centroid means are inside the range, the exact limits come from the other*/
+    acc->min = (min < acc->min) ? min : acc->min;
+    acc->max = (max > acc->max) ? max : acc->max;
+}
+
+
+/**
+ * @brief Estimate quantiles of the accumulated samples
+ * Linear interpolation between the centroid means, min and max are exact.
+ * The buffer is compressed, the accumulator can be updated further.
+ *
+ * @param acc accumulator
+ * @param quantiles quantiles to estimate, in [0, 1], e.g. 0.5 for the median
+ * @param output estimated values, 0 if the accumulator is empty
+ * @param n number of quantiles
+ */
+void dsp_quantile_acc_finalize(dsp_quantile_acc_t *acc, dsp_val_t *quantiles, dsp_val_t *output, dsp_size_t n)
+{
+    dsp_size_t i, j;
+    dsp_val_t target, cum, center, next_center = 0.0;
+    dsp_centroid_t *c = acc->centroid;
+
+    _dsp_quantile_compress(acc);
+
+    for(i = 0; i < n; i++) {
+        target = *(quantiles + i) * acc->total_weight;
+
+        if(acc->n_centroids == 0) {
+            *(output + i) = 0.0;
+            continue;
+        }
+        if(target <= 0.0) {
+            *(output + i) = acc->min;
+            continue;
+        }
+        if(target >= acc->total_weight) {
+            *(output + i) = acc->max;
+            continue;
+        }
+
+        /*between min and the first centroid*/
+        center = c[0].weight / 2.0;
+        if(target < center) {
+            *(output + i) = acc->min + (c[0].mean - acc->min) * target / center;
+            continue;
+        }
+
+        /*between two centroid centers*/
+        cum = 0.0;
+        for(j = 0; j + 1 < acc->n_centroids; j++) {
+            center = cum + c[j].weight / 2.0;
+            next_center = cum + c[j].weight + c[j + 1].weight / 2.0;
+            if(target < next_center) {
+                break;
+            }
+            cum += c[j].weight;
+        }
+
+        if(j + 1 < acc->n_centroids) {
+            *(output + i) = c[j].mean + (c[j + 1].mean - c[j].mean) * (target - center) / (next_center - center);
+        } else {
+            /*between the last centroid and max*/
+            center = acc->total_weight - c[j].weight / 2.0;
+            *(output + i) = c[j].mean + (acc->max - c[j].mean) * (target - center) / (acc->total_weight - center);
+        }
+    }
+}
+
+
+/**
+ * @brief Initialize histogram
+ *
+ * @param hist histogram
+ * @param bins bin counter array, n_bins elements, it is zeroed
+ * @param n_bins number of bins
+ * @param lo lower limit of the first bin
+ * @param hi upper limit of the last bin, greater than lo
+ */
+void dsp_hist_init(dsp_hist_t *hist, dsp_size_t *bins, dsp_size_t n_bins, dsp_val_t lo, dsp_val_t hi)
+{
+    hist->lo = lo;
+    hist->hi = hi;
+    hist->width = (hi - lo) / (dsp_val_t)n_bins;
+    hist->n_bins = n_bins;
+    hist->bins = bins;
+    hist->underflow = 0;
+    hist->overflow = 0;
+    hist->count = 0;
+    memset(bins, 0, n_bins * sizeof(dsp_size_t));
+}
+
+
+/**
+ * @brief Update histogram with a block of samples
+ *
+ * @param hist histogram
+ * @param sig signal block
+ * @param len length of block
+ */
+void dsp_hist_update(dsp_hist_t *hist, dsp_val_t *sig, dsp_size_t len)
+{
+    dsp_size_t i, idx;
+    dsp_val_t x, inv_width = 1.0 / hist->width;
+    DSP_INSTR_BEGIN();
+
+    for(i = 0; i < len; i++) {
+        x = *(sig + i);
+        if(x < hist->lo) {
+            hist->underflow++;
+        } else if(x >= hist->hi) {
+            hist->overflow++;
+        } else {
+            idx = (dsp_size_t)((x - hist->lo) * inv_width);
+            idx = (idx >= hist->n_bins) ? hist->n_bins - 1 : idx;
+            (*(hist->bins + idx))++;
+        }
+    }
+    hist->count += len;
+    DSP_INSTR_END(DSP_INSTR_HIST_UPDATE, len * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Merge histogram of other samples into the histogram
+ * Both histograms must have the same limits and number of bins, otherwise nothing happens.
+ *
+ * @param hist histogram, updated
+ * @param other histogram to merge, not modified
+ */
+void dsp_hist_merge(dsp_hist_t *hist, dsp_hist_t *other)
+{
+    dsp_size_t i;
+
+    if(hist->n_bins != other->n_bins || hist->lo != other->lo || hist->hi != other->hi) {
+        return;
+    }
+
+    for(i = 0; i < hist->n_bins; i++) {
+        *(hist->bins + i) += *(other->bins + i);
+    }
+    hist->underflow += other->underflow;
+    hist->overflow += other->overflow;
+    hist->count += other->count;
+}
+
+
+/**
+ * @brief Estimate quantiles from the histogram
+ * Linear interpolation inside the bins, the samples out of range are
+ * counted at the limits. Error is at most one bin width inside the range.
+ *
+ * @param hist histogram
+ * @param quantiles quantiles to estimate, in [0, 1]
+ * @param output estimated values, 0 if the histogram is empty
+ * @param n number of quantiles
+ */
+void dsp_hist_finalize(dsp_hist_t *hist, dsp_val_t *quantiles, dsp_val_t *output, dsp_size_t n)
+{
+    dsp_size_t i, j;
+    dsp_val_t target, cum, bin;
+
+    for(i = 0; i < n; i++) {
+        target = *(quantiles + i) * (dsp_val_t)hist->count;
+
+        if(hist->count == 0) {
+            *(output + i) = 0.0;
+            continue;
+        }
+
+        *(output + i) = hist->hi;
+        cum = (dsp_val_t)hist->underflow;
+        if(target <= cum) {
+            *(output + i) = hist->lo;
+            continue;
+        }
+        for(j = 0; j < hist->n_bins; j++) {
+            bin = (dsp_val_t)*(hist->bins + j);
+            if(bin > 0.0 && cum + bin >= target) {
+                *(output + i) = hist->lo + ((dsp_val_t)j + (target - cum) / bin) * hist->width;
+                break;
+            }
+            cum += bin;
+        }
+    }
+}
+
+
+/**
+ * @brief Append weighted entry to the buffer, compress when the buffer is full
+ *
+ * @param acc accumulator
+ * @param mean value of the entry
+ * @param weight number of samples of the entry
+ */
+static void _dsp_quantile_append(dsp_quantile_acc_t *acc, dsp_val_t mean, dsp_val_t weight)
+{
+    if(acc->n_buf == DSP_QUANTILE_BUF_LEN) {
+        _dsp_quantile_compress(acc);
+    }
+
+    if(acc->total_weight == 0.0) {
+        acc->min = mean;
+        acc->max = mean;
+    } else {
+        acc->min = (mean < acc->min) ? mean : acc->min;
+        acc->max = (mean > acc->max) ? mean : acc->max;
+    }
+
+    acc->centroid[acc->n_centroids + acc->n_buf].mean = mean;
+    acc->centroid[acc->n_centroids + acc->n_buf].weight = weight;
+    acc->n_buf++;
+    acc->total_weight += weight;
+}
+
+
+/**
+ * @brief Sort the centroids and the buffer, then merge the neighbours while
+ * the merged centroid fits into one unit of the k1 scale function
+ *
+ * @param acc accumulator
+ */
+static void _dsp_quantile_compress(dsp_quantile_acc_t *acc)
+{
+    dsp_size_t i, n = acc->n_centroids + acc->n_buf, out = 0;
+    dsp_val_t w_before = 0.0, w_limit;
+    dsp_centroid_t cur;
+
+    if(acc->n_buf == 0) {
+        return;
+    }
+
+    qsort(acc->centroid, n, sizeof(dsp_centroid_t), _dsp_centroid_cmp);
+
+    cur = acc->centroid[0];
+    w_limit = acc->total_weight * _dsp_quantile_limit(acc->compression, 0.0);
+    for(i = 1; i < n; i++) {
+        if(w_before + cur.weight + acc->centroid[i].weight <= w_limit) {
+            cur.weight += acc->centroid[i].weight;
+            cur.mean += (acc->centroid[i].mean - cur.mean) * acc->centroid[i].weight / cur.weight;
+        } else {
+            w_before += cur.weight;
+            acc->centroid[out++] = cur;
+            w_limit = acc->total_weight * _dsp_quantile_limit(acc->compression, w_before / acc->total_weight);
+            cur = acc->centroid[i];
+        }
+    }
+    acc->centroid[out++] = cur;
+
+    acc->n_centroids = out;
+    acc->n_buf = 0;
+}
+
+
+/**
+ * @brief Upper quantile limit of a centroid, which starts at quantile q
+ * k(q) = delta / (2 * PI) * asin(2 * q - 1), limit = k^-1(k(q) + 1)
+ *
+ * @param compression compression parameter (delta)
+ * @param q start quantile of the centroid
+ * @return dsp_val_t quantile limit
+ */
+static dsp_val_t _dsp_quantile_limit(dsp_val_t compression, dsp_val_t q)
+{
+    dsp_val_t k;
+
+    q = (q > 1.0) ? 1.0 : q;
+    k = compression / (2.0 * M_PI) * asin(2.0 * q - 1.0) + 1.0;
+
+    if(k >= compression / 4.0) {
+        return 1.0;
+    }
+    return (sin(k * 2.0 * M_PI / compression) + 1.0) / 2.0;
+}
+
+
+static int _dsp_centroid_cmp(const void *a, const void *b)
+{
+    dsp_val_t ma = ((const dsp_centroid_t *)a)->mean;
+    dsp_val_t mb = ((const dsp_centroid_t *)b)->mean;
+
+    return (ma > mb) - (ma < mb);
+}
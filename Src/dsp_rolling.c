@@ -0,0 +1,243 @@
+/**
+ * @file dsp_rolling.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP rolling window statistic
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_rolling.h"
+#include "dsp_instr.h"
+
+
+static void _dsp_rolling_resync(dsp_rolling_t *rs);
+
+
+/**
+ * @brief Create rolling window statistic
+ *
+ * @param win_len window length
+ * @param resync_period samples between exact recalculation of the running sums, 0: window length
+ * @return dsp_rolling_t* created object, NULL if the window length is 0 or the allocation failed
+ */
+dsp_rolling_t *dsp_rolling_create(dsp_size_t win_len, dsp_size_t resync_period)
+{
+    dsp_rolling_t *rs;
+
+    if(win_len == 0) {
+        return NULL;
+    }
+
+    rs = (dsp_rolling_t *) calloc(1, sizeof(dsp_rolling_t));
+    if(rs == NULL) {
+        return NULL;
+    }
+
+    rs->win_len = win_len;
+    rs->resync_period = (resync_period == 0) ? win_len : resync_period;
+    rs->window = (dsp_val_t *) calloc(win_len, sizeof(dsp_val_t));
+    rs->min_deque = (dsp_size_t *) calloc(win_len, sizeof(dsp_size_t));
+    rs->max_deque = (dsp_size_t *) calloc(win_len, sizeof(dsp_size_t));
+
+    if(rs->window == NULL || rs->min_deque == NULL || rs->max_deque == NULL) {
+        dsp_rolling_destroy(rs);
+        return NULL;
+    }
+
+    return rs;
+}
+
+
+/**
+ * @brief Destroy rolling window statistic
+ *
+ * @param rs object created by dsp_rolling_create, can be NULL
+ */
+void dsp_rolling_destroy(dsp_rolling_t *rs)
+{
+    if(rs == NULL) {
+        return;
+    }
+
+    free(rs->window);
+    free(rs->min_deque);
+    free(rs->max_deque);
+    free(rs);
+}
+
+
+/**
+ * @brief Reset rolling window statistic, the window becomes empty
+ *
+ * @param rs rolling window statistic
+ */
+void dsp_rolling_reset(dsp_rolling_t *rs)
+{
+    rs->resync_cnt = 0;
+    rs->sample_cnt = 0;
+    rs->shift = 0.0;
+    rs->sum = 0.0;
+    rs->sum_sq = 0.0;
+    rs->min_head = 0;
+    rs->min_cnt = 0;
+    rs->max_head = 0;
+    rs->max_cnt = 0;
+}
+
+
+/**
+ * @brief Push new sample into the window, the oldest sample leaves if the window is full
+ *
+ * @param rs rolling window statistic
+ * @param sample new sample
+ */
+void dsp_rolling_push(dsp_rolling_t *rs, dsp_val_t sample)
+{
+    dsp_size_t idx = rs->sample_cnt;
+    dsp_size_t pos = idx % rs->win_len;
+    dsp_size_t back;
+    dsp_val_t diff;
+
+    if(idx == 0) {
+        rs->shift = sample;
+    }
+
+    /*oldest sample leaves the sums and the front of the deques*/
+    if(idx >= rs->win_len) {
+        diff = *(rs->window + pos) - rs->shift;
+        rs->sum -= diff;
+        rs->sum_sq -= diff * diff;
+
+        if(rs->min_cnt > 0 && *(rs->min_deque + rs->min_head) == idx - rs->win_len) {
+            rs->min_head = (rs->min_head + 1) % rs->win_len;
+            rs->min_cnt--;
+        }
+        if(rs->max_cnt > 0 && *(rs->max_deque + rs->max_head) == idx - rs->win_len) {
+            rs->max_head = (rs->max_head + 1) % rs->win_len;
+            rs->max_cnt--;
+        }
+    }
+
+    *(rs->window + pos) = sample;
+    diff = sample - rs->shift;
+    rs->sum += diff;
+    rs->sum_sq += diff * diff;
+
+    /*drop the dominated samples from the back of the deques*/
+    while(rs->min_cnt > 0) {
+        back = *(rs->min_deque + (rs->min_head + rs->min_cnt - 1) % rs->win_len);
+        if(*(rs->window + back % rs->win_len) < sample) {
+            break;
+        }
+        rs->min_cnt--;
+    }
+    *(rs->min_deque + (rs->min_head + rs->min_cnt) % rs->win_len) = idx;
+    rs->min_cnt++;
+
+    while(rs->max_cnt > 0) {
+        back = *(rs->max_deque + (rs->max_head + rs->max_cnt - 1) % rs->win_len);
+        if(*(rs->window + back % rs->win_len) > sample) {
+            break;
+        }
+        rs->max_cnt--;
+    }
+    *(rs->max_deque + (rs->max_head + rs->max_cnt) % rs->win_len) = idx;
+    rs->max_cnt++;
+
+    rs->sample_cnt++;
+    if(++rs->resync_cnt >= rs->resync_period) {
+        _dsp_rolling_resync(rs);
+    }
+}
+
+
+/**
+ * @brief Get statistic of the current window
+ * Until the window is full, the statistic of the pushed samples.
+ * mean = shift + S1 / N
+ * variance = (S2 - pow(S1, 2) / N) / (N - 1)
+ * skewness and kurtosis are not calculated (0).
+ *
+ * @param rs rolling window statistic
+ * @param stats output statistics, all zero if the window is empty
+ */
+void dsp_rolling_get(dsp_rolling_t *rs, dsp_sig_stats_t *stats)
+{
+    dsp_size_t n = (rs->sample_cnt < rs->win_len) ? rs->sample_cnt : rs->win_len;
+
+    memset(stats, 0, sizeof(dsp_sig_stats_t));
+    if(n == 0) {
+        return;
+    }
+
+    stats->mean = rs->shift + rs->sum / (dsp_val_t)n;
+    if(n > 1) {
+        stats->variance = (rs->sum_sq - rs->sum * rs->sum / (dsp_val_t)n) / (dsp_val_t)(n - 1);
+        stats->variance = (stats->variance < 0.0) ? 0.0 : stats->variance;
+    }
+    stats->std_dev = sqrt(stats->variance);
+    stats->rms = sqrt(stats->mean * stats->mean + stats->variance * (dsp_val_t)(n - 1) / (dsp_val_t)n);
+    stats->min = *(rs->window + *(rs->min_deque + rs->min_head) % rs->win_len);
+    stats->max = *(rs->window + *(rs->max_deque + rs->max_head) % rs->win_len);
+}
+
+
+/**
+ * @brief Push every input sample and store the statistic after each of them
+ * The output arrays are input_sig_len long, any of them can be NULL.
+ *
+ * @param rs rolling window statistic
+ * @param mean_out rolling mean output array
+ * @param variance_out rolling variance output array
+ * @param min_out rolling min output array
+ * @param max_out rolling max output array
+ * @param input_sig input signal
+ * @param input_sig_len length of input signal
+ */
+void dsp_rolling_process(dsp_rolling_t *rs, dsp_val_t *mean_out, dsp_val_t *variance_out,
+                         dsp_val_t *min_out, dsp_val_t *max_out,
+                         dsp_val_t *input_sig, dsp_size_t input_sig_len)
+{
+    dsp_size_t i;
+    dsp_sig_stats_t stats;
+    DSP_INSTR_BEGIN();
+
+    for(i = 0; i < input_sig_len; i++) {
+        dsp_rolling_push(rs, *(input_sig + i));
+        dsp_rolling_get(rs, &stats);
+
+        if(mean_out != NULL) *(mean_out + i) = stats.mean;
+        if(variance_out != NULL) *(variance_out + i) = stats.variance;
+        if(min_out != NULL) *(min_out + i) = stats.min;
+        if(max_out != NULL) *(max_out + i) = stats.max;
+    }
+    DSP_INSTR_END(DSP_INSTR_ROLLING_PROCESS, input_sig_len * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Recalculate the running sums from the window, shifted by the current mean
+ * O(window length), called once per resync period.
+ *
+ * @param rs rolling window statistic
+ */
+static void _dsp_rolling_resync(dsp_rolling_t *rs)
+{
+    dsp_size_t i, n = (rs->sample_cnt < rs->win_len) ? rs->sample_cnt : rs->win_len;
+    dsp_val_t diff;
+
+    rs->shift += rs->sum / (dsp_val_t)n;
+    rs->sum = 0.0;
+    rs->sum_sq = 0.0;
+    for(i = 0; i < n; i++) {
+        diff = *(rs->window + i) - rs->shift;
+        rs->sum += diff;
+        rs->sum_sq += diff * diff;
+    }
+    rs->resync_cnt = 0;
+}
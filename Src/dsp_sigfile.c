@@ -0,0 +1,427 @@
+/**
+ * @file dsp_sigfile.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP binary signal file: header + raw interleaved samples, memory mapped reader
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#define _GNU_SOURCE
+#define _FILE_OFFSET_BITS   64
+
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_sigfile.h"
+#include "dsp_buf.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define DSP_SIGFILE_MMAP    1
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#else
+    #define DSP_SIGFILE_MMAP    0
+#endif
+
+
+/*
+File header, DSP_SIGFILE_HEADER_SIZE bytes
+*/
+typedef struct {
+    char magic[4];
+    uint32_t bom;
+    uint16_t version;
+    uint16_t dtype;
+    uint32_t channels;
+    double sample_rate;
+    uint64_t len;
+    uint8_t reserved[32];
+} _dsp_sigfile_header_t;
+
+
+static int _dsp_sigfile_write_header(FILE *fd, dsp_sigfile_dtype_t dtype, dsp_size_t channels,
+                                     dsp_val_t sample_rate, dsp_size_t len);
+
+
+/**
+ * @brief Size of one sample of the type in bytes
+ *
+ * @param dtype sample type
+ * @return dsp_size_t sample size, 0 for invalid type
+ */
+dsp_size_t dsp_sigfile_dtype_size(dsp_sigfile_dtype_t dtype)
+{
+    switch(dtype) {
+    case DSP_SIGFILE_F32:
+        return sizeof(dsp_f32_t);
+    case DSP_SIGFILE_F64:
+        return sizeof(dsp_f64_t);
+    case DSP_SIGFILE_Q15:
+        return sizeof(dsp_q15_t);
+    case DSP_SIGFILE_Q31:
+        return sizeof(dsp_q31_t);
+    default:
+        return 0;
+    }
+}
+
+
+/**
+ * @brief Open and map signal file
+ *
+ * @param path file path
+ * @return dsp_sigfile_t* opened file, NULL if it can not be opened or the header is invalid
+ */
+dsp_sigfile_t *dsp_sigfile_open(char *path)
+{
+    dsp_sigfile_t *sf;
+    _dsp_sigfile_header_t hdr;
+    dsp_size_t sample_size, file_len;
+
+    sf = (dsp_sigfile_t *) calloc(1, sizeof(dsp_sigfile_t));
+    if(sf == NULL) {
+        return NULL;
+    }
+
+#if DSP_SIGFILE_MMAP
+    {
+        int fd;
+        struct stat st;
+
+        fd = open(path, O_RDONLY);
+        if(fd < 0) {
+            free(sf);
+            return NULL;
+        }
+        if(fstat(fd, &st) != 0 || (dsp_size_t)st.st_size < DSP_SIGFILE_HEADER_SIZE) {
+            close(fd);
+            free(sf);
+            return NULL;
+        }
+        file_len = (dsp_size_t)st.st_size;
+
+        /*the mapping stays valid after close*/
+        sf->map = mmap(NULL, file_len, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if(sf->map == MAP_FAILED) {
+            free(sf);
+            return NULL;
+        }
+    }
+#else
+    {
+        FILE *fd = fopen(path, "rb");
+        long end;
+
+        if(fd == NULL) {
+            free(sf);
+            return NULL;
+        }
+        fseek(fd, 0, SEEK_END);
+        end = ftell(fd);
+        fseek(fd, 0, SEEK_SET);
+        file_len = (end > 0) ? (dsp_size_t)end : 0;
+        /*aligned like the mapping, so the samples after the header are aligned as well*/
+        sf->map = (file_len >= DSP_SIGFILE_HEADER_SIZE) ? dsp_buf_alloc_elem(file_len, 1) : NULL;
+        if(sf->map == NULL || fread(sf->map, 1, file_len, fd) != file_len) {
+            fclose(fd);
+            dsp_buf_free(sf->map);
+            free(sf);
+            return NULL;
+        }
+        fclose(fd);
+    }
+#endif
+    sf->map_len = file_len;
+
+    memcpy(&hdr, sf->map, sizeof(hdr));
+    sample_size = dsp_sigfile_dtype_size((dsp_sigfile_dtype_t)hdr.dtype);
+    if(memcmp(hdr.magic, DSP_SIGFILE_MAGIC, 4) != 0 || hdr.bom != DSP_SIGFILE_BOM ||
+       hdr.version != DSP_SIGFILE_VERSION || sample_size == 0 || hdr.channels == 0 ||
+       hdr.len > (file_len - DSP_SIGFILE_HEADER_SIZE) / (sample_size * hdr.channels)) {
+        dsp_sigfile_close(sf);
+        return NULL;
+    }
+
+    sf->dtype = (dsp_sigfile_dtype_t)hdr.dtype;
+    sf->channels = hdr.channels;
+    sf->sample_rate = hdr.sample_rate;
+    sf->len = (dsp_size_t)hdr.len;
+    sf->data = (char *)sf->map + DSP_SIGFILE_HEADER_SIZE;
+
+    return sf;
+}
+
+
+/**
+ * @brief Unmap and close signal file
+ *
+ * @param sf file opened by dsp_sigfile_open, can be NULL
+ */
+void dsp_sigfile_close(dsp_sigfile_t *sf)
+{
+    if(sf == NULL) {
+        return;
+    }
+
+#if DSP_SIGFILE_MMAP
+    munmap(sf->map, sf->map_len);
+#else
+    dsp_buf_free(sf->map);
+#endif
+    free(sf);
+}
+
+
+/**
+ * @brief Zero-copy view of the samples of a DSP_SIGFILE_F64 file
+ * Channels are interleaved, sample i of channel c: view[i * channels + c]
+ *
+ * @param sf opened file
+ * @return dsp_val_t* samples, NULL if the sample type is not DSP_SIGFILE_F64
+ */
+dsp_val_t *dsp_sigfile_view(dsp_sigfile_t *sf)
+{
+    return (sf->dtype == DSP_SIGFILE_F64) ? (dsp_val_t *)sf->data : NULL;
+}
+
+
+/**
+ * @brief Zero-copy view of the samples of a DSP_SIGFILE_F32 file
+ *
+ * @param sf opened file
+ * @return dsp_f32_t* samples, NULL if the sample type is not DSP_SIGFILE_F32
+ */
+dsp_f32_t *dsp_sigfile_view_f32(dsp_sigfile_t *sf)
+{
+    return (sf->dtype == DSP_SIGFILE_F32) ? (dsp_f32_t *)sf->data : NULL;
+}
+
+
+/**
+ * @brief Copy samples of one channel converted to dsp_val_t
+ * Q15 and Q31 samples are converted to the [-1, 1) range.
+ *
+ * @param sf opened file
+ * @param dest destination array, len long
+ * @param channel channel index
+ * @param start first sample
+ * @param len number of samples
+ * @return dsp_size_t number of copied samples, less than len at the end of the file
+ */
+dsp_size_t dsp_sigfile_read(dsp_sigfile_t *sf, dsp_val_t *dest, dsp_size_t channel, dsp_size_t start, dsp_size_t len)
+{
+    dsp_size_t i, pos, step = sf->channels;
+
+    if(channel >= sf->channels || start >= sf->len) {
+        return 0;
+    }
+    len = (sf->len - start < len) ? (sf->len - start) : len;
+    pos = start * step + channel;
+
+    switch(sf->dtype) {
+    case DSP_SIGFILE_F64:
+        if(step == 1) {
+            memcpy(dest, (dsp_f64_t *)sf->data + pos, len * sizeof(dsp_val_t));
+        } else {
+            for(i = 0; i < len; *(dest + i) = *((dsp_f64_t *)sf->data + pos + i * step), i++);
+        }
+        break;
+    case DSP_SIGFILE_F32:
+        for(i = 0; i < len; *(dest + i) = *((dsp_f32_t *)sf->data + pos + i * step), i++);
+        break;
+    case DSP_SIGFILE_Q15:
+        for(i = 0; i < len; *(dest + i) = *((dsp_q15_t *)sf->data + pos + i * step) / 32768.0, i++);
+        break;
+    case DSP_SIGFILE_Q31:
+        for(i = 0; i < len; *(dest + i) = *((dsp_q31_t *)sf->data + pos + i * step) / 2147483648.0, i++);
+        break;
+    default:
+        return 0;
+    }
+
+    return len;
+}
+
+
+/**
+ * @brief Drop the loaded pages of a processed sample range from the memory
+ * Streaming readers call it after every chunk, so a large file does not stay resident.
+ * The range can be read again, the pages are reloaded from the file. No effect without mapping.
+ *
+ * @param sf opened file
+ * @param start first sample
+ * @param len number of samples
+ */
+void dsp_sigfile_release(dsp_sigfile_t *sf, dsp_size_t start, dsp_size_t len)
+{
+#if DSP_SIGFILE_MMAP
+    dsp_size_t sample_size = dsp_sigfile_dtype_size(sf->dtype) * sf->channels;
+    dsp_size_t page = (dsp_size_t)sysconf(_SC_PAGESIZE);
+    dsp_size_t first, last;
+
+    if(start >= sf->len) {
+        return;
+    }
+    len = (sf->len - start < len) ? (sf->len - start) : len;
+
+    /*only the pages completely inside the range*/
+    first = DSP_SIGFILE_HEADER_SIZE + start * sample_size;
+    last = first + len * sample_size;
+    first = (first + page - 1) / page * page;
+    last = last / page * page;
+    if(last > first) {
+        madvise((char *)sf->map + first, last - first, MADV_DONTNEED);
+    }
+#else
+    (void)sf;
+    (void)start;
+    (void)len;
+#endif
+}
+
+
+/**
+ * @brief Write whole signal into a DSP_SIGFILE_F64 file
+ *
+ * @param path file path
+ * @param sig interleaved samples, len * channels long
+ * @param len samples per channel
+ * @param channels number of channels
+ * @param sample_rate sample rate in Hz, 0 if unknown
+ * @return int 0 on success, -1 on error
+ */
+int dsp_sigfile_write(char *path, dsp_val_t *sig, dsp_size_t len, dsp_size_t channels, dsp_val_t sample_rate)
+{
+    dsp_sigfile_writer_t *wr;
+    int rc;
+
+    wr = dsp_sigfile_writer_open(path, DSP_SIGFILE_F64, channels, sample_rate);
+    if(wr == NULL) {
+        return -1;
+    }
+
+    rc = dsp_sigfile_writer_append(wr, sig, len);
+    return (dsp_sigfile_writer_close(wr) == 0 && rc == 0) ? 0 : -1;
+}
+
+
+/**
+ * @brief Create signal file for appending
+ *
+ * @param path file path
+ * @param dtype sample type
+ * @param channels number of channels
+ * @param sample_rate sample rate in Hz, 0 if unknown
+ * @return dsp_sigfile_writer_t* writer, NULL if the file can not be created or the parameters are invalid
+ */
+dsp_sigfile_writer_t *dsp_sigfile_writer_open(char *path, dsp_sigfile_dtype_t dtype, dsp_size_t channels,
+                                              dsp_val_t sample_rate)
+{
+    dsp_sigfile_writer_t *wr;
+
+    if(dsp_sigfile_dtype_size(dtype) == 0 || channels == 0) {
+        return NULL;
+    }
+
+    wr = (dsp_sigfile_writer_t *) calloc(1, sizeof(dsp_sigfile_writer_t));
+    if(wr == NULL) {
+        return NULL;
+    }
+
+    wr->fd = fopen(path, "wb");
+    if(wr->fd == NULL) {
+        free(wr);
+        return NULL;
+    }
+    wr->dtype = dtype;
+    wr->channels = channels;
+    wr->sample_rate = sample_rate;
+
+    /*length is not known yet, the header is rewritten at close*/
+    if(_dsp_sigfile_write_header(wr->fd, dtype, channels, sample_rate, 0) != 0) {
+        fclose(wr->fd);
+        free(wr);
+        return NULL;
+    }
+
+    return wr;
+}
+
+
+/**
+ * @brief Append interleaved samples
+ *
+ * @param wr writer
+ * @param samples samples of the writer type, len * channels long
+ * @param len samples per channel
+ * @return int 0 on success, -1 on write error
+ */
+int dsp_sigfile_writer_append(dsp_sigfile_writer_t *wr, void *samples, dsp_size_t len)
+{
+    dsp_size_t n = len * wr->channels;
+
+    if(fwrite(samples, dsp_sigfile_dtype_size(wr->dtype), n, wr->fd) != n) {
+        return -1;
+    }
+    wr->len += len;
+    return 0;
+}
+
+
+/**
+ * @brief Write the final header and close the file
+ *
+ * @param wr writer, can be NULL
+ * @return int 0 on success, -1 on write error
+ */
+int dsp_sigfile_writer_close(dsp_sigfile_writer_t *wr)
+{
+    int rc = 0;
+
+    if(wr == NULL) {
+        return 0;
+    }
+
+    if(fseek(wr->fd, 0, SEEK_SET) != 0 ||
+       _dsp_sigfile_write_header(wr->fd, wr->dtype, wr->channels, wr->sample_rate, wr->len) != 0) {
+        rc = -1;
+    }
+    if(fclose(wr->fd) != 0) {
+        rc = -1;
+    }
+    free(wr);
+    return rc;
+}
+
+
+/**
+ * @brief Write the file header at the current position
+ *
+ * @param fd output file
+ * @param dtype sample type
+ * @param channels number of channels
+ * @param sample_rate sample rate in Hz
+ * @param len samples per channel
+ * @return int 0 on success, -1 on write error
+ */
+static int _dsp_sigfile_write_header(FILE *fd, dsp_sigfile_dtype_t dtype, dsp_size_t channels,
+                                     dsp_val_t sample_rate, dsp_size_t len)
+{
+    _dsp_sigfile_header_t hdr;
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, DSP_SIGFILE_MAGIC, 4);
+    hdr.bom = DSP_SIGFILE_BOM;
+    hdr.version = DSP_SIGFILE_VERSION;
+    hdr.dtype = (uint16_t)dtype;
+    hdr.channels = (uint32_t)channels;
+    hdr.sample_rate = sample_rate;
+    hdr.len = len;
+
+    return (fwrite(&hdr, sizeof(hdr), 1, fd) == 1) ? 0 : -1;
+}
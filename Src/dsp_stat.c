@@ -9,24 +9,35 @@
  * 
  */
 
+#include <stdlib.h>
+#include <string.h>
 #include "dsp_stat.h"
+#include "dsp_instr.h"
+#include "dsp_kernels.h"
 
 
+/*Number of independent accumulators in the one pass statistic*/
+#define DSP_STAT_LANES		DSP_KERNEL_STAT_LANES
+
+/*Single precision functions*/
+#define DSP_PREC 32
+#include "dsp_prec.h"
+#include "dsp_stat_tmpl.h"
+#undef DSP_PREC
+
+/*Double precision functions*/
+#define DSP_PREC 64
+#include "dsp_prec.h"
+#include "dsp_stat_tmpl.h"
+#undef DSP_PREC
+
 
 /*
 Signal mean
 */
 dsp_val_t dsp_sig_mean(dsp_val_t *sig, dsp_size_t len)
 {
-	dsp_size_t i;
-	dsp_val_t mean = 0;
-	
-	for (i = 0; i < len; i++) {
-		mean += *(sig + i);
-	}
-	
-	mean /= (dsp_val_t)len;
-	return mean;
+	return dsp_sig_mean_f64(sig, len);
 }
 
 
@@ -35,15 +46,7 @@ Signal varriance
 */
 dsp_val_t dsp_sig_variance(dsp_val_t *sig, dsp_val_t sig_mean, dsp_size_t len)
 {
-	dsp_size_t i;
-	dsp_val_t variance = 0;
-	
-	for (i = 0; i < len; i++) {
-		variance += pow(*(sig + i) - sig_mean, 2);
-	}
-	
-	variance /= (dsp_val_t)(len - 1);
-	return variance;
+	return dsp_sig_variance_f64(sig, sig_mean, len);
 }
 
 
@@ -52,5 +55,98 @@ Signal standard deviation
 */
 dsp_val_t dsp_sig_std_dev(dsp_val_t sig_variance)
 {
-	return sqrt(sig_variance);
+	return dsp_sig_std_dev_f64(sig_variance);
+}
+
+
+/*
+Signal mean, variance and standard deviation in one pass
+*/
+void dsp_sig_stats(dsp_val_t *sig, dsp_size_t len, dsp_sig_stats_t *stats)
+{
+	dsp_sig_stats_f64(sig, len, stats);
+}
+
+
+/*
+Statistic accumulator initialization
+*/
+void dsp_stat_acc_init(dsp_stat_acc_t *acc, int moments)
+{
+	dsp_stat_acc_init_f64(acc, moments);
+}
+
+
+/*
+Statistic accumulator update with a block of samples
+*/
+void dsp_stat_acc_update(dsp_stat_acc_t *acc, dsp_val_t *sig, dsp_size_t len)
+{
+	dsp_stat_acc_update_f64(acc, sig, len);
+}
+
+
+/*
+Statistic accumulator merge
+*/
+void dsp_stat_acc_merge(dsp_stat_acc_t *acc, dsp_stat_acc_t *other)
+{
+	dsp_stat_acc_merge_f64(acc, other);
+}
+
+
+/*
+Statistic accumulator finalization
+*/
+void dsp_stat_acc_finalize(dsp_stat_acc_t *acc, dsp_sig_stats_t *stats)
+{
+	dsp_stat_acc_finalize_f64(acc, stats);
+}
+
+
+/*
+Signal statistic calculated by more threads
+*/
+void dsp_sig_stats_mt(dsp_val_t *sig, dsp_size_t len, dsp_sig_stats_t *stats, int n_threads)
+{
+	dsp_sig_stats_mt_f64(sig, len, stats, n_threads);
+}
+
+
+/*
+Signal statistic calculated by more threads, chunk accumulators from workspace
+*/
+void dsp_sig_stats_mt_ws(dsp_val_t *sig, dsp_size_t len, dsp_sig_stats_t *stats, int n_threads,
+                         dsp_workspace_t *ws)
+{
+	dsp_sig_stats_mt_ws_f64(sig, len, stats, n_threads, ws);
+}
+
+
+/*
+Signal statistic calculated by the tasks of an execution context
+*/
+void dsp_sig_stats_exec(dsp_val_t *sig, dsp_size_t len, dsp_sig_stats_t *stats, dsp_exec_ctx_t *ctx,
+                        dsp_workspace_t *ws)
+{
+	dsp_sig_stats_exec_f64(sig, len, stats, ctx, ws);
+}
+
+
+/*
+Workspace bytes of the multithreaded statistic
+*/
+dsp_size_t dsp_sig_stats_mt_workspace_size(dsp_size_t len)
+{
+	return dsp_sig_stats_mt_workspace_size_f64(len);
+}
+
+
+/*
+Signal metrics in one pass
+*/
+void dsp_sig_metrics(dsp_val_t *sig, dsp_size_t len, dsp_val_t *ref, dsp_val_t noise_power,
+                     dsp_sig_metrics_t *metrics)
+{
+	dsp_sig_metrics_f64(sig, len, ref, noise_power, metrics);
 }
@@ -0,0 +1,502 @@
+/**
+ * @file dsp_stat_tmpl.h
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP Signal statistic calculations, precision template (library internal)
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2020
+ * 
+ * Included by dsp_stat.c once per precision, see dsp_prec.h
+ */
+
+
+/*
+Signal mean
+*/
+DSP_T DSP_FN(dsp_sig_mean)(DSP_T *sig, dsp_size_t len)
+{
+	dsp_size_t i;
+	DSP_T mean = 0;
+	DSP_INSTR_BEGIN();
+	
+	for (i = 0; i < len; i++) {
+		mean += *(sig + i);
+	}
+	
+	mean /= (DSP_T)len;
+	DSP_INSTR_END(DSP_INSTR_SIG_MEAN, len * sizeof(DSP_T));
+	return mean;
+}
+
+
+/*
+Signal varriance
+*/
+DSP_T DSP_FN(dsp_sig_variance)(DSP_T *sig, DSP_T sig_mean, dsp_size_t len)
+{
+	dsp_size_t i;
+	DSP_T variance = 0, diff;
+	DSP_INSTR_BEGIN();
+	
+	for (i = 0; i < len; i++) {
+		diff = *(sig + i) - sig_mean;
+		variance += diff * diff;
+	}
+	
+	variance /= (DSP_T)(len - 1);
+	DSP_INSTR_END(DSP_INSTR_SIG_VARIANCE, len * sizeof(DSP_T));
+	return variance;
+}
+
+
+/*
+Signal standard deviation
+*/
+DSP_T DSP_FN(dsp_sig_std_dev)(DSP_T sig_variance)
+{
+	return DSP_SQRT(sig_variance);
+}
+
+
+static void DSP_FN(_dsp_stat_acc_block)(DSP_TN(dsp_stat_acc) *acc, DSP_T *sig, dsp_size_t len);
+static void DSP_FN(_dsp_stat_acc_sample)(DSP_TN(dsp_stat_acc) *acc, DSP_T x);
+static void DSP_FN(_dsp_stat_chunk)(DSP_T *sig, dsp_size_t len, dsp_size_t chunk, DSP_TN(dsp_stat_acc) *acc);
+#if DSP_PREC != 64
+static inline void DSP_FN(_dsp_stat_lanes)(DSP_T *sig, dsp_size_t blocks, DSP_T *mean, DSP_T *m2, DSP_T *min, DSP_T *max);
+#endif
+
+
+/*
+Chunk accumulators of the parallel statistic, one task per chunk
+*/
+typedef struct {
+	DSP_T *sig;
+	dsp_size_t len;
+	DSP_TN(dsp_stat_acc) *chunk_acc;
+} DSP_TN(_dsp_stat_job);
+
+
+static void DSP_FN(_dsp_stat_task)(void *arg, dsp_size_t chunk)
+{
+	DSP_TN(_dsp_stat_job) *job = (DSP_TN(_dsp_stat_job) *)arg;
+
+	DSP_FN(_dsp_stat_chunk)(job->sig, job->len, chunk, job->chunk_acc + chunk);
+}
+
+
+/*
+Signal mean, variance and standard deviation in one pass
+*/
+void DSP_FN(dsp_sig_stats)(DSP_T *sig, dsp_size_t len, DSP_TN(dsp_sig_stats) *stats)
+{
+	DSP_TN(dsp_stat_acc) acc;
+	DSP_INSTR_BEGIN();
+
+	DSP_FN(dsp_stat_acc_init)(&acc, 2);
+	DSP_FN(dsp_stat_acc_update)(&acc, sig, len);
+	DSP_FN(dsp_stat_acc_finalize)(&acc, stats);
+	DSP_INSTR_END(DSP_INSTR_SIG_STATS, len * sizeof(DSP_T));
+}
+
+
+/*
+Signal statistic in fixed chunks, calculated by more threads and merged in chunk order
+*/
+void DSP_FN(dsp_sig_stats_mt)(DSP_T *sig, dsp_size_t len, DSP_TN(dsp_sig_stats) *stats, int n_threads)
+{
+	DSP_FN(dsp_sig_stats_mt_ws)(sig, len, stats, n_threads, NULL);
+}
+
+
+/*
+Workspace bytes of the multithreaded statistic: one accumulator per chunk
+*/
+dsp_size_t DSP_FN(dsp_sig_stats_mt_workspace_size)(dsp_size_t len)
+{
+	return DSP_WORKSPACE_ROUND((len + DSP_STAT_CHUNK_LEN - 1) / DSP_STAT_CHUNK_LEN * sizeof(DSP_TN(dsp_stat_acc)));
+}
+
+
+/*
+Signal statistic in fixed chunks, calculated by a temporary thread pool
+*/
+void DSP_FN(dsp_sig_stats_mt_ws)(DSP_T *sig, dsp_size_t len, DSP_TN(dsp_sig_stats) *stats, int n_threads,
+                                 dsp_workspace_t *ws)
+{
+	dsp_size_t n_chunks = (len + DSP_STAT_CHUNK_LEN - 1) / DSP_STAT_CHUNK_LEN;
+	dsp_exec_ctx_t *ctx = NULL;
+
+	if (n_threads > 1 && n_chunks > 1) {
+		ctx = dsp_exec_ctx_create(((dsp_size_t)n_threads > n_chunks) ? (int)n_chunks : n_threads, NULL, 0);
+	}
+	DSP_FN(dsp_sig_stats_exec)(sig, len, stats, ctx, ws);
+	dsp_exec_ctx_destroy(ctx);
+}
+
+
+/*
+Signal statistic in fixed chunks, tasks of the execution context (NULL: serial),
+chunk accumulators from workspace (NULL: allocated)
+*/
+void DSP_FN(dsp_sig_stats_exec)(DSP_T *sig, dsp_size_t len, DSP_TN(dsp_sig_stats) *stats, dsp_exec_ctx_t *ctx,
+                                dsp_workspace_t *ws)
+{
+	dsp_size_t c, n_chunks = (len + DSP_STAT_CHUNK_LEN - 1) / DSP_STAT_CHUNK_LEN, mark = dsp_workspace_mark(ws);
+	DSP_TN(dsp_stat_acc) acc, *chunk_acc = NULL;
+	DSP_TN(_dsp_stat_job) job;
+	DSP_INSTR_BEGIN();
+
+	DSP_FN(dsp_stat_acc_init)(&acc, 2);
+	if (dsp_exec_ctx_threads(ctx) > 1 && n_chunks > 1) {
+		chunk_acc = (ws != NULL) ?
+			(DSP_TN(dsp_stat_acc) *) dsp_workspace_alloc(ws, n_chunks * sizeof(DSP_TN(dsp_stat_acc))) :
+			(DSP_TN(dsp_stat_acc) *) malloc(n_chunks * sizeof(DSP_TN(dsp_stat_acc)));
+	}
+
+	/*serial: the same chunks merged in the same order, the result is identical*/
+	if (chunk_acc == NULL) {
+		DSP_TN(dsp_stat_acc) chunk;
+		for (c = 0; c < n_chunks; c++) {
+			DSP_FN(_dsp_stat_chunk)(sig, len, c, &chunk);
+			DSP_FN(dsp_stat_acc_merge)(&acc, &chunk);
+		}
+		DSP_FN(dsp_stat_acc_finalize)(&acc, stats);
+		DSP_INSTR_END(DSP_INSTR_SIG_STATS_MT, len * sizeof(DSP_T));
+		return;
+	}
+
+	job.sig = sig;
+	job.len = len;
+	job.chunk_acc = chunk_acc;
+	dsp_exec_parallel_for(ctx, n_chunks, DSP_FN(_dsp_stat_task), &job);
+
+	for (c = 0; c < n_chunks; c++) {
+		DSP_FN(dsp_stat_acc_merge)(&acc, chunk_acc + c);
+	}
+	if (ws != NULL) {
+		dsp_workspace_release(ws, mark);
+	} else {
+		free(chunk_acc);
+	}
+	DSP_FN(dsp_stat_acc_finalize)(&acc, stats);
+	DSP_INSTR_END(DSP_INSTR_SIG_STATS_MT, len * sizeof(DSP_T));
+}
+
+
+/*
+Signal metrics in one pass: mean, variance, RMS, peak, crest factor, zero crossings, SNR
+*/
+void DSP_FN(dsp_sig_metrics)(DSP_T *sig, dsp_size_t len, DSP_T *ref, DSP_T noise_power,
+                             DSP_TN(dsp_sig_metrics) *metrics)
+{
+	dsp_size_t i, j, n, blocks = len / DSP_STAT_LANES, zc_cnt = 0;
+	DSP_T mean[DSP_STAT_LANES] = {0}, m2[DSP_STAT_LANES] = {0}, peak[DSP_STAT_LANES] = {0};
+	DSP_T ref_pow[DSP_STAT_LANES] = {0}, err_pow[DSP_STAT_LANES] = {0};
+	dsp_size_t zc[DSP_STAT_LANES] = {0};
+	DSP_T x, prev, delta, inv_n, cnt, lane_cnt, tot_mean, tot_m2, tot_peak, tot_ref, tot_err, ms;
+	DSP_INSTR_BEGIN();
+
+	memset(metrics, 0, sizeof(DSP_TN(dsp_sig_metrics)));
+	if (len == 0) {
+		DSP_INSTR_END(DSP_INSTR_SIG_METRICS, 0);
+		return;
+	}
+
+	/*full blocks, every lane has own accumulators*/
+	for (n = 0; n < blocks; n++) {
+		inv_n = (DSP_T)1.0 / (DSP_T)(n + 1);
+		for (j = 0; j < DSP_STAT_LANES; j++) {
+			i = n * DSP_STAT_LANES + j;
+			x = *(sig + i);
+			prev = (i > 0) ? *(sig + i - 1) : x;
+			delta = x - mean[j];
+			mean[j] += delta * inv_n;
+			m2[j] += delta * (x - mean[j]);
+			peak[j] = (DSP_FABS(x) > peak[j]) ? DSP_FABS(x) : peak[j];
+			zc[j] += ((x < (DSP_T)0.0) != (prev < (DSP_T)0.0));
+			if (ref != NULL) {
+				ref_pow[j] += *(ref + i) * *(ref + i);
+				err_pow[j] += (x - *(ref + i)) * (x - *(ref + i));
+			}
+		}
+	}
+
+	/*merge lanes (Chan), then the tail samples*/
+	tot_mean = mean[0];
+	tot_m2 = m2[0];
+	tot_peak = peak[0];
+	tot_ref = ref_pow[0];
+	tot_err = err_pow[0];
+	zc_cnt = zc[0];
+	cnt = (DSP_T)blocks;
+	lane_cnt = (DSP_T)blocks;
+	for (j = 1; j < DSP_STAT_LANES; j++) {
+		if (blocks > 0) {
+			delta = mean[j] - tot_mean;
+			tot_mean += delta * lane_cnt / (cnt + lane_cnt);
+			tot_m2 += m2[j] + delta * delta * cnt * lane_cnt / (cnt + lane_cnt);
+			cnt += lane_cnt;
+		}
+		tot_peak = (peak[j] > tot_peak) ? peak[j] : tot_peak;
+		tot_ref += ref_pow[j];
+		tot_err += err_pow[j];
+		zc_cnt += zc[j];
+	}
+
+	for (i = blocks * DSP_STAT_LANES; i < len; i++) {
+		x = *(sig + i);
+		prev = (i > 0) ? *(sig + i - 1) : x;
+		cnt += (DSP_T)1.0;
+		delta = x - tot_mean;
+		tot_mean += delta / cnt;
+		tot_m2 += delta * (x - tot_mean);
+		tot_peak = (DSP_FABS(x) > tot_peak) ? DSP_FABS(x) : tot_peak;
+		zc_cnt += ((x < (DSP_T)0.0) != (prev < (DSP_T)0.0));
+		if (ref != NULL) {
+			tot_ref += *(ref + i) * *(ref + i);
+			tot_err += (x - *(ref + i)) * (x - *(ref + i));
+		}
+	}
+
+	ms = tot_mean * tot_mean + tot_m2 / (DSP_T)len;
+	metrics->mean = tot_mean;
+	metrics->variance = (len > 1) ? tot_m2 / (DSP_T)(len - 1) : (DSP_T)0.0;
+	metrics->rms = DSP_SQRT(ms);
+	metrics->peak = tot_peak;
+	metrics->crest_factor = (metrics->rms > (DSP_T)0.0) ? tot_peak / metrics->rms : (DSP_T)0.0;
+	metrics->zero_crossings = zc_cnt;
+
+	if (ref != NULL) {
+		metrics->snr_db = (DSP_T)((tot_err > (DSP_T)0.0) ? 10.0 * log10((double)tot_ref / (double)tot_err) : INFINITY);
+	} else if (noise_power > (DSP_T)0.0) {
+		metrics->snr_db = (DSP_T)((ms > noise_power) ? 10.0 * log10((double)(ms - noise_power) / (double)noise_power) : -INFINITY);
+	}
+	DSP_INSTR_END(DSP_INSTR_SIG_METRICS, len * sizeof(DSP_T) * ((ref != NULL) ? 2 : 1));
+}
+
+
+/*
+Statistic accumulator initialization
+*/
+void DSP_FN(dsp_stat_acc_init)(DSP_TN(dsp_stat_acc) *acc, int moments)
+{
+	acc->count = 0;
+	acc->moments = (moments > 2) ? 4 : 2;
+	acc->mean = 0;
+	acc->m2 = 0;
+	acc->m3 = 0;
+	acc->m4 = 0;
+	acc->min = 0;
+	acc->max = 0;
+}
+
+
+/*
+Statistic accumulator update with a block of samples
+*/
+void DSP_FN(dsp_stat_acc_update)(DSP_TN(dsp_stat_acc) *acc, DSP_T *sig, dsp_size_t len)
+{
+	dsp_size_t i;
+	DSP_TN(dsp_stat_acc) block;
+	DSP_INSTR_BEGIN();
+
+	if (acc->moments == 4) {
+		for (i = 0; i < len; i++) {
+			DSP_FN(_dsp_stat_acc_sample)(acc, *(sig + i));
+		}
+	} else {
+		/*block statistic in lanes, merged in O(1)*/
+		DSP_FN(dsp_stat_acc_init)(&block, 2);
+		DSP_FN(_dsp_stat_acc_block)(&block, sig, len);
+		DSP_FN(dsp_stat_acc_merge)(acc, &block);
+	}
+	DSP_INSTR_END(DSP_INSTR_STAT_ACC_UPDATE, len * sizeof(DSP_T));
+}
+
+
+/*
+Statistic accumulator merge (Chan et al., Pebay for the higher moments)
+*/
+void DSP_FN(dsp_stat_acc_merge)(DSP_TN(dsp_stat_acc) *acc, DSP_TN(dsp_stat_acc) *other)
+{
+	DSP_T na, nb, n, delta, delta2, mean, m2, m3;
+
+	if (other->count == 0) {
+		return;
+	}
+	if (acc->count == 0) {
+		int moments = acc->moments;
+		*acc = *other;
+		acc->moments = (moments < other->moments) ? moments : other->moments;
+		return;
+	}
+
+	na = (DSP_T)acc->count;
+	nb = (DSP_T)other->count;
+	n = na + nb;
+	delta = other->mean - acc->mean;
+	delta2 = delta * delta;
+
+	mean = acc->mean + delta * nb / n;
+	m2 = acc->m2 + other->m2 + delta2 * na * nb / n;
+
+	if (acc->moments == 4 && other->moments == 4) {
+		m3 = acc->m3 + other->m3 + delta2 * delta * na * nb * (na - nb) / (n * n)
+			+ (DSP_T)3.0 * delta * (na * other->m2 - nb * acc->m2) / n;
+		acc->m4 = acc->m4 + other->m4
+			+ delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+			+ (DSP_T)6.0 * delta2 * (na * na * other->m2 + nb * nb * acc->m2) / (n * n)
+			+ (DSP_T)4.0 * delta * (na * other->m3 - nb * acc->m3) / n;
+		acc->m3 = m3;
+	} else {
+		acc->moments = 2;
+		acc->m3 = 0;
+		acc->m4 = 0;
+	}
+
+	acc->mean = mean;
+	acc->m2 = m2;
+	acc->count += other->count;
+	acc->min = (other->min < acc->min) ? other->min : acc->min;
+	acc->max = (other->max > acc->max) ? other->max : acc->max;
+}
+
+
+/*
+Statistic accumulator finalization
+*/
+void DSP_FN(dsp_stat_acc_finalize)(DSP_TN(dsp_stat_acc) *acc, DSP_TN(dsp_sig_stats) *stats)
+{
+	DSP_T n = (DSP_T)acc->count;
+
+	stats->mean = acc->mean;
+	stats->variance = (acc->count > 1) ? acc->m2 / (n - (DSP_T)1.0) : (DSP_T)0.0;
+	stats->std_dev = DSP_SQRT(stats->variance);
+	stats->rms = (acc->count > 0) ? DSP_SQRT(acc->mean * acc->mean + acc->m2 / n) : (DSP_T)0.0;
+	stats->min = acc->min;
+	stats->max = acc->max;
+	stats->skewness = 0;
+	stats->kurtosis = 0;
+
+	if (acc->moments == 4 && acc->m2 > (DSP_T)0.0) {
+		stats->skewness = DSP_SQRT(n) * acc->m3 / (acc->m2 * DSP_SQRT(acc->m2));
+		stats->kurtosis = n * acc->m4 / (acc->m2 * acc->m2) - (DSP_T)3.0;
+	}
+}
+
+
+/*
+Block statistic with lane-wise Welford update, into an empty accumulator
+*/
+static void DSP_FN(_dsp_stat_acc_block)(DSP_TN(dsp_stat_acc) *acc, DSP_T *sig, dsp_size_t len)
+{
+	dsp_size_t i, j, blocks = len / DSP_STAT_LANES;
+	DSP_T mean[DSP_STAT_LANES] = {0}, m2[DSP_STAT_LANES] = {0};
+	DSP_T min[DSP_STAT_LANES], max[DSP_STAT_LANES];
+	DSP_T delta, cnt, lane_cnt;
+
+	if (len == 0) {
+		return;
+	}
+	for (j = 0; j < DSP_STAT_LANES; j++) {
+		min[j] = *sig;
+		max[j] = *sig;
+	}
+
+	/*full blocks, every lane has the same sample count*/
+#if DSP_PREC == 64
+	_dsp_kernels()->stat_lanes(sig, blocks, mean, m2, min, max);
+#else
+	DSP_FN(_dsp_stat_lanes)(sig, blocks, mean, m2, min, max);
+#endif
+
+	/*merge lanes (Chan), then the tail samples (Welford), the count is exact in integer*/
+	acc->count = blocks * DSP_STAT_LANES;
+	acc->mean = mean[0];
+	acc->m2 = m2[0];
+	acc->min = min[0];
+	acc->max = max[0];
+	cnt = (DSP_T)blocks;
+	lane_cnt = (DSP_T)blocks;
+	for (j = 1; j < DSP_STAT_LANES && blocks > 0; j++) {
+		delta = mean[j] - acc->mean;
+		acc->mean += delta * lane_cnt / (cnt + lane_cnt);
+		acc->m2 += m2[j] + delta * delta * cnt * lane_cnt / (cnt + lane_cnt);
+		acc->min = (min[j] < acc->min) ? min[j] : acc->min;
+		acc->max = (max[j] > acc->max) ? max[j] : acc->max;
+		cnt += lane_cnt;
+	}
+
+	for (i = blocks * DSP_STAT_LANES; i < len; i++) {
+		DSP_FN(_dsp_stat_acc_sample)(acc, *(sig + i));
+	}
+}
+
+
+/*
+Single sample Welford update, with third and fourth moments if enabled
+*/
+static void DSP_FN(_dsp_stat_acc_sample)(DSP_TN(dsp_stat_acc) *acc, DSP_T x)
+{
+	DSP_T n1 = (DSP_T)acc->count;
+	DSP_T n = n1 + (DSP_T)1.0;
+	DSP_T delta = x - acc->mean;
+	DSP_T delta_n = delta / n;
+	DSP_T term1 = delta * delta_n * n1;
+
+	if (acc->count == 0) {
+		acc->min = x;
+		acc->max = x;
+	} else {
+		acc->min = (x < acc->min) ? x : acc->min;
+		acc->max = (x > acc->max) ? x : acc->max;
+	}
+
+	acc->mean += delta_n;
+	if (acc->moments == 4) {
+		acc->m4 += term1 * delta_n * delta_n * (n * n - (DSP_T)3.0 * n + (DSP_T)3.0)
+			+ (DSP_T)6.0 * delta_n * delta_n * acc->m2 - (DSP_T)4.0 * delta_n * acc->m3;
+		acc->m3 += term1 * delta_n * (n - (DSP_T)2.0) - (DSP_T)3.0 * delta_n * acc->m2;
+	}
+	acc->m2 += term1;
+	acc->count++;
+}
+
+
+/*
+Accumulator of one fixed chunk of the signal
+*/
+static void DSP_FN(_dsp_stat_chunk)(DSP_T *sig, dsp_size_t len, dsp_size_t chunk, DSP_TN(dsp_stat_acc) *acc)
+{
+	dsp_size_t start = chunk * DSP_STAT_CHUNK_LEN;
+	dsp_size_t chunk_len = (len - start < DSP_STAT_CHUNK_LEN) ? len - start : DSP_STAT_CHUNK_LEN;
+
+	DSP_FN(dsp_stat_acc_init)(acc, 2);
+	DSP_FN(_dsp_stat_acc_block)(acc, sig + start, chunk_len);
+}
+
+
+#if DSP_PREC != 64
+/*
+Lane-wise Welford update of full blocks.
+Double precision uses the selected kernel variant, see dsp_cpu.h
+*/
+static inline void DSP_FN(_dsp_stat_lanes)(DSP_T *sig, dsp_size_t blocks, DSP_T *mean, DSP_T *m2, DSP_T *min, DSP_T *max)
+{
+	dsp_size_t n, j;
+	DSP_T x, delta, inv_n;
+
+	for (n = 0; n < blocks; n++) {
+		inv_n = (DSP_T)1.0 / (DSP_T)(n + 1);
+		for (j = 0; j < DSP_STAT_LANES; j++) {
+			x = *(sig + n * DSP_STAT_LANES + j);
+			delta = x - mean[j];
+			mean[j] += delta * inv_n;
+			m2[j] += delta * (x - mean[j]);
+			min[j] = (x < min[j]) ? x : min[j];
+			max[j] = (x > max[j]) ? x : max[j];
+		}
+	}
+}
+#endif
@@ -0,0 +1,560 @@
+/**
+ * @file dsp_stft.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP short-time Fourier transform with overlapped windows, inverse by weighted overlap-add
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <string.h>
+#include "dsp_stft.h"
+#include "dsp_dft.h"
+#include "dsp_filter.h"
+#include "dsp_instr.h"
+
+
+static void _dsp_stft_pair(dsp_stft_t *stft, dsp_val_t *x1, dsp_val_t *x2,
+                           dsp_val_t *rex1, dsp_val_t *imx1, dsp_val_t *rex2, dsp_val_t *imx2);
+static void _dsp_stft_frames(dsp_stft_t *stft, dsp_val_t *dest_rex, dsp_val_t *dest_imx, dsp_val_t *dest_mag,
+                             dsp_val_t *input_sig, dsp_size_t n_frames);
+static void _dsp_istft_frame(dsp_stft_t *stft, dsp_val_t *dest_sig, dsp_size_t out_len,
+                             dsp_val_t *rex, dsp_val_t *imx);
+static dsp_val_t _dsp_istft_norm(dsp_stft_t *stft, dsp_size_t pos, dsp_size_t n_frames);
+
+
+/**
+ * @brief Workspace bytes of an STFT object created by dsp_stft_create_ws
+ *
+ * @param frame_len samples per frame
+ * @return dsp_size_t workspace bytes
+ */
+dsp_size_t dsp_stft_workspace_size(dsp_size_t frame_len)
+{
+    dsp_size_t fft_len = dsp_fft_next_pow2(frame_len);
+    dsp_size_t bins = fft_len / 2 + 1;
+
+    return DSP_WORKSPACE_ROUND(sizeof(dsp_stft_t)) + dsp_fft_plan_workspace_size(fft_len)
+           + 3 * DSP_WORKSPACE_ROUND(frame_len * sizeof(dsp_val_t))
+           + 2 * DSP_WORKSPACE_ROUND(fft_len * sizeof(dsp_val_t))
+           + DSP_WORKSPACE_ROUND(4 * bins * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Create STFT object
+ *
+ * @param frame_len samples per frame, >= 2
+ * @param hop samples between the frame starts, >= 1
+ * @param window_calc window function (dsp_hamming_window, dsp_blackman_window, ...), NULL: Hamming
+ * @return dsp_stft_t* created object, NULL if the parameters are invalid or the allocation failed
+ */
+dsp_stft_t *dsp_stft_create(dsp_size_t frame_len, dsp_size_t hop, dsp_val_t (*window_calc)(int, dsp_size_t))
+{
+    dsp_workspace_t *ws;
+    dsp_stft_t *stft;
+
+    if(frame_len < 2 || hop == 0) {
+        return NULL;
+    }
+
+    ws = dsp_workspace_create(dsp_stft_workspace_size(frame_len));
+    if(ws == NULL) {
+        return NULL;
+    }
+
+    stft = dsp_stft_create_ws(frame_len, hop, window_calc, ws);
+    if(stft == NULL) {
+        dsp_workspace_destroy(ws);
+        return NULL;
+    }
+    stft->own_ws = ws;
+    return stft;
+}
+
+
+/**
+ * @brief Create STFT object in workspace
+ * The object lives until the workspace is released, it must not be destroyed.
+ *
+ * @param frame_len samples per frame, >= 2
+ * @param hop samples between the frame starts, >= 1
+ * @param window_calc window function, NULL: Hamming
+ * @param ws workspace, at least dsp_stft_workspace_size(frame_len) bytes free
+ * @return dsp_stft_t* created object, NULL if the parameters are invalid or the workspace is full
+ */
+dsp_stft_t *dsp_stft_create_ws(dsp_size_t frame_len, dsp_size_t hop, dsp_val_t (*window_calc)(int, dsp_size_t),
+                               dsp_workspace_t *ws)
+{
+    dsp_size_t i, mark;
+    dsp_stft_t *stft;
+
+    if(frame_len < 2 || hop == 0 || ws == NULL) {
+        return NULL;
+    }
+
+    mark = dsp_workspace_mark(ws);
+    stft = (dsp_stft_t *) dsp_workspace_alloc(ws, sizeof(dsp_stft_t));
+    if(stft == NULL) {
+        return NULL;
+    }
+
+    stft->frame_len = frame_len;
+    stft->hop = hop;
+    stft->fft_len = dsp_fft_next_pow2(frame_len);
+    stft->bins = stft->fft_len / 2 + 1;
+    stft->own_ws = NULL;
+
+    stft->plan = dsp_fft_plan_create_ws(stft->fft_len, ws);
+    stft->window = (dsp_val_t *) dsp_workspace_alloc(ws, frame_len * sizeof(dsp_val_t));
+    stft->hist = (dsp_val_t *) dsp_workspace_alloc(ws, frame_len * sizeof(dsp_val_t));
+    stft->ola = (dsp_val_t *) dsp_workspace_alloc(ws, frame_len * sizeof(dsp_val_t));
+    stft->work_rex = (dsp_val_t *) dsp_workspace_alloc(ws, stft->fft_len * sizeof(dsp_val_t));
+    stft->work_imx = (dsp_val_t *) dsp_workspace_alloc(ws, stft->fft_len * sizeof(dsp_val_t));
+    stft->spec = (dsp_val_t *) dsp_workspace_alloc(ws, 4 * stft->bins * sizeof(dsp_val_t));
+
+    if(stft->plan == NULL || stft->window == NULL || stft->hist == NULL || stft->ola == NULL ||
+       stft->work_rex == NULL || stft->work_imx == NULL || stft->spec == NULL) {
+        dsp_workspace_release(ws, mark);
+        return NULL;
+    }
+
+    for(i = 0; i < frame_len; i++) {
+        *(stft->window + i) = (window_calc == NULL) ? dsp_hamming_window(i, frame_len) : window_calc(i, frame_len);
+    }
+
+    dsp_stft_reset(stft);
+    return stft;
+}
+
+
+/**
+ * @brief Destroy STFT object created by dsp_stft_create
+ *
+ * @param stft object, can be NULL
+ */
+void dsp_stft_destroy(dsp_stft_t *stft)
+{
+    if(stft == NULL) {
+        return;
+    }
+
+    /*the object itself is in the workspace*/
+    dsp_workspace_destroy(stft->own_ws);
+}
+
+
+/**
+ * @brief Clear the stream state of dsp_stft_push and dsp_istft_push
+ *
+ * @param stft STFT object
+ */
+void dsp_stft_reset(dsp_stft_t *stft)
+{
+    stft->hist_fill = 0;
+    stft->hist_skip = 0;
+    stft->ola_frames = 0;
+    memset(stft->ola, 0, stft->frame_len * sizeof(dsp_val_t));
+}
+
+
+/**
+ * @brief Number of complete frames in a signal
+ *
+ * @param stft STFT object
+ * @param sig_len signal length
+ * @return dsp_size_t (sig_len - frame_len) / hop + 1, 0 if the signal is shorter than a frame
+ */
+dsp_size_t dsp_stft_frames(dsp_stft_t *stft, dsp_size_t sig_len)
+{
+    if(sig_len < stft->frame_len) {
+        return 0;
+    }
+    return (sig_len - stft->frame_len) / stft->hop + 1;
+}
+
+
+/**
+ * @brief Short-time Fourier transform of the whole signal
+ * Two real frames are transformed together as real and imaginary part.
+ *
+ * @param stft STFT object
+ * @param dest_rex real part matrix, dsp_stft_frames(sig_len) * bins long
+ * @param dest_imx imaginary part matrix, dsp_stft_frames(sig_len) * bins long
+ * @param input_sig input signal
+ * @param input_sig_len input signal length
+ * @return dsp_size_t number of frames
+ */
+dsp_size_t dsp_stft(dsp_stft_t *stft, dsp_val_t *dest_rex, dsp_val_t *dest_imx,
+                    dsp_val_t *input_sig, dsp_size_t input_sig_len)
+{
+    dsp_size_t n_frames = dsp_stft_frames(stft, input_sig_len);
+
+    DSP_INSTR_BEGIN();
+    _dsp_stft_frames(stft, dest_rex, dest_imx, NULL, input_sig, n_frames);
+    DSP_INSTR_END(DSP_INSTR_STFT, input_sig_len * sizeof(dsp_val_t));
+    return n_frames;
+}
+
+
+/**
+ * @brief Magnitude spectrogram of the whole signal
+ *
+ * @param stft STFT object
+ * @param dest_mag magnitude matrix, dsp_stft_frames(sig_len) * bins long
+ * @param input_sig input signal
+ * @param input_sig_len input signal length
+ * @return dsp_size_t number of frames
+ */
+dsp_size_t dsp_spectrogram(dsp_stft_t *stft, dsp_val_t *dest_mag, dsp_val_t *input_sig, dsp_size_t input_sig_len)
+{
+    dsp_size_t n_frames = dsp_stft_frames(stft, input_sig_len);
+
+    DSP_INSTR_BEGIN();
+    _dsp_stft_frames(stft, NULL, NULL, dest_mag, input_sig, n_frames);
+    DSP_INSTR_END(DSP_INSTR_STFT, input_sig_len * sizeof(dsp_val_t));
+    return n_frames;
+}
+
+
+/**
+ * @brief Number of frames completed by the next dsp_stft_push call
+ *
+ * @param stft STFT object
+ * @param input_sig_len length of the next pushed block
+ * @return dsp_size_t number of frames
+ */
+dsp_size_t dsp_stft_push_frames(dsp_stft_t *stft, dsp_size_t input_sig_len)
+{
+    dsp_size_t i, fill = stft->hist_fill, n_frames = 0;
+
+    /*same steps as dsp_stft_push, without copying*/
+    i = (stft->hist_skip < input_sig_len) ? stft->hist_skip : input_sig_len;
+    while(fill > 0 && i + (stft->frame_len - fill) <= input_sig_len) {
+        n_frames++;
+        if(stft->hop < fill) {
+            fill -= stft->hop;
+        } else {
+            i += stft->hop - fill;
+            fill = 0;
+        }
+    }
+    if(fill > 0 || i >= input_sig_len) {
+        return n_frames;
+    }
+    return n_frames + dsp_stft_frames(stft, input_sig_len - i);
+}
+
+
+/**
+ * @brief Push the next block of a stream, the completed frames are transformed
+ * The concatenated output of the pushes matches dsp_stft of the concatenated blocks up to
+ * rounding: two frames share one complex FFT only within a push, so a frame can have another
+ * pair than in dsp_stft, the difference is a few ulps of the largest bin magnitude.
+ *
+ * @param stft STFT object
+ * @param dest_rex real part matrix, dsp_stft_push_frames(input_sig_len) * bins long
+ * @param dest_imx imaginary part matrix, dsp_stft_push_frames(input_sig_len) * bins long
+ * @param input_sig input block
+ * @param input_sig_len input block length
+ * @return dsp_size_t number of completed frames
+ */
+dsp_size_t dsp_stft_push(dsp_stft_t *stft, dsp_val_t *dest_rex, dsp_val_t *dest_imx,
+                         dsp_val_t *input_sig, dsp_size_t input_sig_len)
+{
+    dsp_size_t i, fill, need, n_frames = 0, n_direct;
+    dsp_size_t frame_len = stft->frame_len, hop = stft->hop, bins = stft->bins;
+
+    DSP_INSTR_BEGIN();
+
+    /*samples between two frames (hop > frame_len)*/
+    i = (stft->hist_skip < input_sig_len) ? stft->hist_skip : input_sig_len;
+    stft->hist_skip -= i;
+
+    /*frames started in the previous blocks: completed in the history buffer,
+    the input samples are only borrowed, they are part of the next frames too*/
+    fill = stft->hist_fill;
+    while(fill > 0 && i + (need = frame_len - fill) <= input_sig_len) {
+        memcpy(stft->hist + fill, input_sig + i, need * sizeof(dsp_val_t));
+        _dsp_stft_pair(stft, stft->hist, NULL, dest_rex + n_frames * bins, dest_imx + n_frames * bins, NULL, NULL);
+        n_frames++;
+
+        if(hop < fill) {
+            fill -= hop;
+            memmove(stft->hist, stft->hist + hop, fill * sizeof(dsp_val_t));
+        } else {
+            i += hop - fill;
+            fill = 0;
+        }
+    }
+
+    if(fill > 0) {
+        /*not enough input for the next frame*/
+        memcpy(stft->hist + fill, input_sig + i, (input_sig_len - i) * sizeof(dsp_val_t));
+        stft->hist_fill = fill + (input_sig_len - i);
+    } else if(i >= input_sig_len) {
+        stft->hist_fill = 0;
+        stft->hist_skip += i - input_sig_len;
+    } else {
+        /*frames inside the block: transformed in pairs without copying into the history*/
+        n_direct = dsp_stft_frames(stft, input_sig_len - i);
+        _dsp_stft_frames(stft, dest_rex + n_frames * bins, dest_imx + n_frames * bins, NULL, input_sig + i, n_direct);
+        n_frames += n_direct;
+        i += n_direct * hop;
+
+        if(i >= input_sig_len) {
+            stft->hist_fill = 0;
+            stft->hist_skip = i - input_sig_len;
+        } else {
+            memcpy(stft->hist, input_sig + i, (input_sig_len - i) * sizeof(dsp_val_t));
+            stft->hist_fill = input_sig_len - i;
+        }
+    }
+
+    DSP_INSTR_END(DSP_INSTR_STFT, input_sig_len * sizeof(dsp_val_t));
+    return n_frames;
+}
+
+
+/**
+ * @brief Length of the signal resynthesized from n_frames frames
+ *
+ * @param stft STFT object
+ * @param n_frames number of frames
+ * @return dsp_size_t (n_frames - 1) * hop + frame_len, 0 for no frame
+ */
+dsp_size_t dsp_istft_len(dsp_stft_t *stft, dsp_size_t n_frames)
+{
+    if(n_frames == 0) {
+        return 0;
+    }
+    return (n_frames - 1) * stft->hop + stft->frame_len;
+}
+
+
+/**
+ * @brief Inverse STFT by weighted overlap-add
+ * Every frame is inverse transformed, multiplied by the window and added at f * hop.
+ * Sample n is divided by sum(pow(w[n - f * hop], 2)) of the frames covering it,
+ * so the transform of dsp_stft is inverted exactly where the sum is not zero.
+ * Samples covered by no frame or only by window zeros are 0.
+ *
+ * @param stft STFT object, its inverse stream state is reset
+ * @param dest_sig output signal, dsp_istft_len(n_frames) long
+ * @param rex real part matrix
+ * @param imx imaginary part matrix
+ * @param n_frames number of frames
+ * @return dsp_size_t output length
+ */
+dsp_size_t dsp_istft(dsp_stft_t *stft, dsp_val_t *dest_sig, dsp_val_t *rex, dsp_val_t *imx, dsp_size_t n_frames)
+{
+    dsp_size_t f, out_len = dsp_istft_len(stft, n_frames);
+
+    if(n_frames == 0) {
+        return 0;
+    }
+    DSP_INSTR_BEGIN();
+
+    stft->ola_frames = 0;
+    memset(stft->ola, 0, stft->frame_len * sizeof(dsp_val_t));
+
+    for(f = 0; f < n_frames; f++) {
+        /*the last frame of a hop > frame_len transform has no hop long output*/
+        _dsp_istft_frame(stft, dest_sig + f * stft->hop, out_len - f * stft->hop,
+                         rex + f * stft->bins, imx + f * stft->bins);
+    }
+    dsp_istft_flush(stft, dest_sig + n_frames * stft->hop);
+
+    DSP_INSTR_END(DSP_INSTR_ISTFT, out_len * sizeof(dsp_val_t));
+    return out_len;
+}
+
+
+/**
+ * @brief Push the next frame of an inverse stream
+ * The hop samples before the start of the next frame are completed.
+ *
+ * @param stft STFT object
+ * @param dest_sig output, hop long
+ * @param rex real part of the frame, bins long
+ * @param imx imaginary part of the frame, bins long
+ * @return dsp_size_t hop
+ */
+dsp_size_t dsp_istft_push(dsp_stft_t *stft, dsp_val_t *dest_sig, dsp_val_t *rex, dsp_val_t *imx)
+{
+    DSP_INSTR_BEGIN();
+    _dsp_istft_frame(stft, dest_sig, stft->hop, rex, imx);
+    DSP_INSTR_END(DSP_INSTR_ISTFT, stft->hop * sizeof(dsp_val_t));
+    return stft->hop;
+}
+
+
+/**
+ * @brief Output the rest of the last frame of an inverse stream and reset the inverse state
+ *
+ * @param stft STFT object
+ * @param dest_sig output, frame_len - hop long
+ * @return dsp_size_t number of samples: frame_len - hop, 0 if hop >= frame_len or no frame was pushed
+ */
+dsp_size_t dsp_istft_flush(dsp_stft_t *stft, dsp_val_t *dest_sig)
+{
+    dsp_size_t j, out_len = 0;
+    dsp_val_t norm;
+
+    if(stft->ola_frames > 0 && stft->hop < stft->frame_len) {
+        out_len = stft->frame_len - stft->hop;
+        for(j = 0; j < out_len; j++) {
+            /*position in the last frame: j + hop*/
+            norm = _dsp_istft_norm(stft, j + stft->hop, stft->ola_frames);
+            *(dest_sig + j) = (norm < DSP_STFT_NORM_EPS) ? 0.0 : *(stft->ola + j) / norm;
+        }
+    }
+
+    stft->ola_frames = 0;
+    memset(stft->ola, 0, stft->frame_len * sizeof(dsp_val_t));
+    return out_len;
+}
+
+
+/*
+Transform one or two windowed frames with one complex FFT: z = x1 + j * x2
+Z[k] = X1[k] + j * X2[k], and X[N - k] = conj(X[k]) for real signals, so
+X1[k] = (Z[k] + conj(Z[N - k])) / 2, X2[k] = (Z[k] - conj(Z[N - k])) / (2 * j)
+x2 == NULL: single frame, rex2 and imx2 are not used
+*/
+static void _dsp_stft_pair(dsp_stft_t *stft, dsp_val_t *x1, dsp_val_t *x2,
+                           dsp_val_t *rex1, dsp_val_t *imx1, dsp_val_t *rex2, dsp_val_t *imx2)
+{
+    dsp_size_t n, k, nk;
+    dsp_size_t frame_len = stft->frame_len, fft_len = stft->fft_len;
+    dsp_val_t *zr = stft->work_rex, *zi = stft->work_imx, *w = stft->window;
+
+    for(n = 0; n < frame_len; n++) {
+        *(zr + n) = *(w + n) * *(x1 + n);
+        *(zi + n) = (x2 == NULL) ? 0.0 : *(w + n) * *(x2 + n);
+    }
+    for(; n < fft_len; n++) {
+        *(zr + n) = 0.0;
+        *(zi + n) = 0.0;
+    }
+
+    dsp_fft(stft->plan, zr, zi);
+
+    if(x2 == NULL) {
+        memcpy(rex1, zr, stft->bins * sizeof(dsp_val_t));
+        memcpy(imx1, zi, stft->bins * sizeof(dsp_val_t));
+        return;
+    }
+
+    for(k = 0; k < stft->bins; k++) {
+        nk = (fft_len - k) & (fft_len - 1);
+        *(rex1 + k) = 0.5 * (*(zr + k) + *(zr + nk));
+        *(imx1 + k) = 0.5 * (*(zi + k) - *(zi + nk));
+        *(rex2 + k) = 0.5 * (*(zi + k) + *(zi + nk));
+        *(imx2 + k) = 0.5 * (*(zr + nk) - *(zr + k));
+    }
+}
+
+
+/*
+Transform n_frames frames starting at input_sig, in pairs
+dest_mag != NULL: magnitudes from the spectrum scratch, dest_rex and dest_imx are not used
+*/
+static void _dsp_stft_frames(dsp_stft_t *stft, dsp_val_t *dest_rex, dsp_val_t *dest_imx, dsp_val_t *dest_mag,
+                             dsp_val_t *input_sig, dsp_size_t n_frames)
+{
+    dsp_size_t f, bins = stft->bins, hop = stft->hop;
+    dsp_val_t *rex1, *imx1, *rex2, *imx2;
+
+    for(f = 0; f < n_frames; f += 2) {
+        if(dest_mag != NULL) {
+            rex1 = stft->spec;
+            imx1 = stft->spec + bins;
+            rex2 = stft->spec + 2 * bins;
+            imx2 = stft->spec + 3 * bins;
+        } else {
+            rex1 = dest_rex + f * bins;
+            imx1 = dest_imx + f * bins;
+            rex2 = rex1 + bins;
+            imx2 = imx1 + bins;
+        }
+
+        if(f + 1 < n_frames) {
+            _dsp_stft_pair(stft, input_sig + f * hop, input_sig + (f + 1) * hop, rex1, imx1, rex2, imx2);
+        } else {
+            _dsp_stft_pair(stft, input_sig + f * hop, NULL, rex1, imx1, NULL, NULL);
+        }
+
+        if(dest_mag != NULL) {
+            dsp_dft_magnitude(dest_mag + f * bins, rex1, imx1, bins);
+            if(f + 1 < n_frames) {
+                dsp_dft_magnitude(dest_mag + (f + 1) * bins, rex2, imx2, bins);
+            }
+        }
+    }
+}
+
+
+/*
+Inverse transform one frame, add it to the overlap-add buffer, output min(hop, out_len) samples
+*/
+static void _dsp_istft_frame(dsp_stft_t *stft, dsp_val_t *dest_sig, dsp_size_t out_len,
+                             dsp_val_t *rex, dsp_val_t *imx)
+{
+    dsp_size_t j, k, frame_len = stft->frame_len, fft_len = stft->fft_len, hop = stft->hop;
+    dsp_val_t *zr = stft->work_rex, *zi = stft->work_imx, norm;
+
+    /*full spectrum of a real frame: X[N - k] = conj(X[k])*/
+    memcpy(zr, rex, stft->bins * sizeof(dsp_val_t));
+    memcpy(zi, imx, stft->bins * sizeof(dsp_val_t));
+    for(k = stft->bins; k < fft_len; k++) {
+        *(zr + k) = *(rex + fft_len - k);
+        *(zi + k) = -*(imx + fft_len - k);
+    }
+
+    dsp_ifft(stft->plan, zr, zi);
+
+    for(j = 0; j < frame_len; j++) {
+        *(stft->ola + j) += *(stft->window + j) * *(zr + j);
+    }
+    stft->ola_frames++;
+
+    if(out_len > hop) {
+        out_len = hop;
+    }
+    for(j = 0; j < out_len; j++) {
+        if(j >= frame_len) {
+            *(dest_sig + j) = 0.0;
+            continue;
+        }
+        norm = _dsp_istft_norm(stft, j, stft->ola_frames);
+        *(dest_sig + j) = (norm < DSP_STFT_NORM_EPS) ? 0.0 : *(stft->ola + j) / norm;
+    }
+
+    /*the buffer starts at the next frame*/
+    if(hop < frame_len) {
+        memmove(stft->ola, stft->ola + hop, (frame_len - hop) * sizeof(dsp_val_t));
+        memset(stft->ola + frame_len - hop, 0, hop * sizeof(dsp_val_t));
+    } else {
+        memset(stft->ola, 0, frame_len * sizeof(dsp_val_t));
+    }
+}
+
+
+/*
+Sum of the squared window values at position pos of the last frame,
+over the last frame and the previous ones covering it (at most n_frames frames)
+*/
+static dsp_val_t _dsp_istft_norm(dsp_stft_t *stft, dsp_size_t pos, dsp_size_t n_frames)
+{
+    dsp_size_t m;
+    dsp_val_t w, norm = 0.0;
+
+    for(m = 0; m < n_frames && pos < stft->frame_len; m++, pos += stft->hop) {
+        w = *(stft->window + pos);
+        norm += w * w;
+    }
+    return norm;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file dsp_workspace.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief DSP workspace: caller owned scratch memory with bump allocation
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "dsp_workspace.h"
+
+
+/**
+ * @brief Create workspace with own memory
+ *
+ * @param size usable bytes, e.g. sum of the *_workspace_size results
+ * @return dsp_workspace_t* created workspace, NULL if the allocation failed
+ */
+dsp_workspace_t *dsp_workspace_create(dsp_size_t size)
+{
+    dsp_workspace_t *ws = (dsp_workspace_t *) calloc(1, sizeof(dsp_workspace_t));
+    void *mem;
+
+    size = DSP_WORKSPACE_ROUND(size) + DSP_WORKSPACE_ALIGN;
+    mem = malloc(size);
+
+    if(ws == NULL || mem == NULL) {
+        free(ws);
+        free(mem);
+        return NULL;
+    }
+
+    dsp_workspace_init(ws, mem, size);
+    ws->own_mem = mem;
+    return ws;
+}
+
+
+/**
+ * @brief Destroy workspace created by dsp_workspace_create
+ *
+ * @param ws workspace, can be NULL
+ */
+void dsp_workspace_destroy(dsp_workspace_t *ws)
+{
+    if(ws == NULL) {
+        return;
+    }
+
+    free(ws->own_mem);
+    free(ws);
+}
+
+
+/**
+ * @brief Initialize workspace on caller memory (static array, stack, ...)
+ * The start of the memory is aligned, so up to DSP_WORKSPACE_ALIGN - 1 bytes are lost.
+ *
+ * @param ws workspace
+ * @param mem caller memory, must live as long as the workspace
+ * @param size bytes of mem
+ */
+void dsp_workspace_init(dsp_workspace_t *ws, void *mem, dsp_size_t size)
+{
+    dsp_size_t pad = (DSP_WORKSPACE_ALIGN - ((uintptr_t)mem & (DSP_WORKSPACE_ALIGN - 1))) & (DSP_WORKSPACE_ALIGN - 1);
+
+    ws->mem = (unsigned char *)mem + pad;
+    ws->size = (size > pad) ? (size - pad) & ~(DSP_WORKSPACE_ALIGN - 1) : 0;
+    ws->used = 0;
+    ws->peak = 0;
+    ws->own_mem = NULL;
+}
+
+
+/**
+ * @brief Allocate aligned buffer from the workspace
+ *
+ * @param ws workspace
+ * @param bytes size of the buffer
+ * @return void* buffer, NULL if the workspace is NULL or full
+ */
+void *dsp_workspace_alloc(dsp_workspace_t *ws, dsp_size_t bytes)
+{
+    void *buf;
+
+    bytes = DSP_WORKSPACE_ROUND(bytes);
+    if(ws == NULL || bytes > ws->size - ws->used) {
+        return NULL;
+    }
+
+    buf = ws->mem + ws->used;
+    ws->used += bytes;
+    ws->peak = (ws->used > ws->peak) ? ws->used : ws->peak;
+    return buf;
+}
+
+
+/**
+ * @brief Current allocation position, to release the later allocations with dsp_workspace_release
+ *
+ * @param ws workspace
+ * @return dsp_size_t allocation mark
+ */
+dsp_size_t dsp_workspace_mark(dsp_workspace_t *ws)
+{
+    return (ws != NULL) ? ws->used : 0;
+}
+
+
+/**
+ * @brief Release every allocation after the mark
+ *
+ * @param ws workspace
+ * @param mark result of dsp_workspace_mark
+ */
+void dsp_workspace_release(dsp_workspace_t *ws, dsp_size_t mark)
+{
+    if(ws != NULL && mark <= ws->used) {
+        ws->used = mark;
+    }
+}
+
+
+/**
+ * @brief Release every allocation
+ *
+ * @param ws workspace
+ */
+void dsp_workspace_reset(dsp_workspace_t *ws)
+{
+    if(ws != NULL) {
+        ws->used = 0;
+    }
+}
@@ -9,10 +9,10 @@ set size 1,1
 set multiplot
 set size 0.5,0.5
 set origin 0,0.5
-plot 'cdft_sig_input_rex.dat' with lines lc rgb 'red'
+plot 'cdft_sig_input_rex.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'red'
 set origin 0.5,0.5
-plot 'cdft_sig_input_imx.dat' with lines lc rgb 'red'
+plot 'cdft_sig_input_imx.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'red'
 set origin 0,0
-plot 'cdft_sig_output_rex.dat' with lines lc rgb 'green'
+plot 'cdft_sig_output_rex.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'green'
 set origin 0.5,0
-plot 'cdft_sig_output_imx.dat' with lines lc rgb 'green'
\ No newline at end of file
+plot 'cdft_sig_output_imx.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'green'
\ No newline at end of file
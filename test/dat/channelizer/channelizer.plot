@@ -0,0 +1,9 @@
+# Istvan Milak
+# Polyphase channelizer plot
+# $ gnuplot -p channelizer.plot
+
+reset
+set terminal canvas size 1024,768
+set output 'channelizer.html'
+set style fill solid
+plot 'channel_power.dsig' binary skip=64 format='%float64' using 1 with boxes lc rgb 'blue'
@@ -10,8 +10,8 @@ set size 1,1
 set multiplot
 set size 0.5,0.5
 set origin 0,0.5
-plot 'conv_input_signal.dat' with lines lc rgb 'black'
+plot 'conv_input_signal.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'black'
 set origin 0.5,0.5
-plot 'conv_impulse_response.dat' with lines lc rgb 'red'
+plot 'conv_impulse_response.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'red'
 set origin 0,0
-plot 'conv_output_signal.dat' with lines lc rgb 'blue'
\ No newline at end of file
+plot 'conv_output_signal.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'blue'
\ No newline at end of file
@@ -10,6 +10,6 @@ set size 1,1
 set multiplot
 set size 0.5,0.5
 set origin 0,0.5
-plot 'rsum_input_signal.dat' with lines lc rgb 'black'
+plot 'rsum_input_signal.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'black'
 set origin 0.5,0.5
-plot 'rsum_output_signal.dat' with lines lc rgb 'red'
\ No newline at end of file
+plot 'rsum_output_signal.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'red'
\ No newline at end of file
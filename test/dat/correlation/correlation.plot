@@ -0,0 +1,11 @@
+# Istvan Milak
+# Auto- and cross-correlation plot
+# $ gnuplot -p correlation.plot
+
+reset
+set terminal canvas size 1024,768
+set output 'correlation.html'
+set multiplot layout 2,1
+plot 'autocorr_output.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'blue' title 'ECG autocorrelation'
+plot 'xcorr_output.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'red' title 'noise cross-correlation with delayed segment'
+unset multiplot
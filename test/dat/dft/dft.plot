@@ -9,10 +9,10 @@ set size 1,1
 set multiplot
 set size 0.5,0.5
 set origin 0,0.5
-plot 'dft_input_signal.dat' with lines lc rgb 'black'
+plot 'dft_input_signal.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'black'
 set origin 0,0
-plot 'dft_output_rex.dat' with lines lc rgb 'green'
+plot 'dft_output_rex.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'green'
 set origin 0.5,0
-plot 'dft_output_imx.dat' with lines lc rgb 'green'
+plot 'dft_output_imx.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'green'
 set origin 0.5,0.5
-plot 'idft_output_signal.dat' with lines lc rgb 'red'
+plot 'idft_output_signal.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'red'
@@ -9,6 +9,6 @@ set size 1,1
 set multiplot
 set size 1.0,0.5
 set origin 0,0.5
-plot 'dft_input_signal.dat' with lines lc rgb 'black'
+plot 'dft_input_signal.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'black'
 set origin 0,0
-plot 'dft_output_mag.dat' with lines lc rgb 'green'
+plot 'dft_output_mag.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'green'
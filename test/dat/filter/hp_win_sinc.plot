@@ -9,8 +9,8 @@ set size 1,1
 set multiplot
 set size 0.5,0.5
 set origin 0,0.5
-plot 'hp_input_signal.dat' with lines lc rgb 'black'
+plot 'hp_input_signal.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'black'
 set origin 0.5,0.5
-plot 'hp_win_sinc_filter.dat' with lines lc rgb 'red'
+plot 'hp_win_sinc_filter.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'red'
 set origin 0,0
-plot 'hp_conv_output.dat' with lines lc rgb 'blue'
\ No newline at end of file
+plot 'hp_conv_output.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'blue'
\ No newline at end of file
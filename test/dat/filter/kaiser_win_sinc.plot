@@ -0,0 +1,16 @@
+# Istvan Milak
+# Kaiser windowed sinc filter plot
+# $ gnuplot -p kaiser_win_sinc.plot
+
+reset
+set terminal canvas size 1024,768
+set output 'kaiser_win_sinc.html'
+set size 1,1
+set multiplot
+set size 0.5,0.5
+set origin 0,0.5
+plot 'lp_input_signal.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'black'
+set origin 0.5,0.5
+plot 'kaiser_win_sinc_filter.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'red'
+set origin 0,0
+plot 'kaiser_conv_output.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'blue'
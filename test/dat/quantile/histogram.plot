@@ -0,0 +1,9 @@
+# Istvan Milak
+# Histogram plot
+# $ gnuplot -p histogram.plot
+
+reset
+set terminal canvas size 1024,768
+set output 'histogram.html'
+set style fill solid
+plot 'histogram.dsig' binary skip=64 format='%float64' using 1 with boxes lc rgb 'blue'
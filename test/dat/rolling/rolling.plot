@@ -0,0 +1,11 @@
+# Istvan Milak
+# Rolling window statistic plot
+# $ gnuplot -p rolling.plot
+
+reset
+set terminal canvas size 1024,768
+set output 'rolling.html'
+plot 'rolling_input.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'gray' title 'ECG', \
+     'rolling_mean.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'blue' title 'mean', \
+     'rolling_min.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'green' title 'min', \
+     'rolling_max.dsig' binary skip=64 format='%float64' using 1 with lines lc rgb 'red' title 'max'
@@ -14,5 +14,22 @@
 #define TEST_DFT                1
 #define TEST_CDFT               1
 #define TEST_FILTER             1
+#define TEST_FIR                1
+#define TEST_CHANNELIZER        1
+#define TEST_FIXED_POINT        1
+#define TEST_PRECISION          1
+#define TEST_ROLLING            1
+#define TEST_QUANTILE           1
+#define TEST_CORRELATION        1
+#define TEST_WORKSPACE          1
+#define TEST_ALIGNED_BUF        1
+#define TEST_CPU_DISPATCH       1
+#define TEST_EXEC               1
+#define TEST_PIPELINE           1
+#define TEST_SIGFILE            1
+#define TEST_STFT               1
+#define TEST_PSD                1
+#define TEST_IQ                 1
+#define TEST_INSTR              1
 
 #endif
\ No newline at end of file
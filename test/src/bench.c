@@ -0,0 +1,695 @@
+/**
+ * @file bench.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief Micro-benchmark of the DSP library functions, JSON output
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * Usage: dsp_bench [-r repetitions] [-w warmup] [-t min_rep_time_us] [-f name_filter] [-o output.json] [-q]
+ *                  [-b baseline.json] [-s slowdown_percent] [-a alpha]
+ *
+ * Every function is timed for a sweep of sizes. One repetition calls the function
+ * as many times as needed for the minimal repetition time, the time per call is stored.
+ * Reported: median, p95, min and mean time per call and samples/sec (size / median).
+ * The JSON is written to stdout (or to the -o file), the progress to stderr.
+ *
+ * Comparison mode (-b): the runs of every case are compared with the runs of the same
+ * case and size in a previous JSON output. A case is a regression, if its median is slower
+ * than the baseline by more than slowdown_percent (default 5) and the one sided Mann-Whitney
+ * U test says the runs are slower with p < alpha (default 0.01). So the noise of a single
+ * run is not a regression, a small but significant change is also not.
+ * Exit code: 0 ok, 1 error, 2 usage, 3 regression found.
+ *
+ * The selected kernel variant is reported in the "isa" field, DSP_ISA=generic|sse2|avx2|avx512
+ * environment variable forces a variant, see dsp_cpu.h
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dsp_common.h"
+#include "dsp_stat.h"
+#include "dsp_convolution.h"
+#include "dsp_dft.h"
+#include "dsp_cdft.h"
+#include "dsp_filter.h"
+#include "dsp_fft.h"
+#include "dsp_fir.h"
+#include "dsp_channelizer.h"
+#include "dsp_fixed.h"
+#include "dsp_rolling.h"
+#include "dsp_quantile.h"
+#include "dsp_correlation.h"
+#include "dsp_buf.h"
+#include "dsp_cpu.h"
+#include "dsp_exec.h"
+#include "dsp_pipeline.h"
+#include "dsp_iq.h"
+
+
+#define BENCH_MAX_SIZE          (1UL << 20)
+#define BENCH_MAX_SIZES         8
+#define BENCH_MAX_REPS          1000
+#define BENCH_KERNEL_LEN        64
+#define BENCH_EXEC_THREADS      4
+#define BENCH_BATCH_FFT_LEN     1024
+#define BENCH_PIPELINE_BLOCK    4096
+#define BENCH_PIPELINE_FRAME    256
+#define BENCH_MAX_NAME          64
+#define BENCH_EXIT_REGRESSION   3
+
+
+/**
+ * @brief Benchmark case: one function, sweep of sizes
+ * setup and teardown are optional, they are not timed.
+ */
+typedef struct {
+    const char *name;
+    void (*setup)(dsp_size_t size);
+    void (*run)(dsp_size_t size);
+    void (*teardown)(void);
+    dsp_size_t sizes[BENCH_MAX_SIZES];      // 0 terminated
+} bench_case_t;
+
+
+/**
+ * @brief Result of one case and size
+ */
+typedef struct {
+    dsp_size_t iterations;                  // calls per repetition
+    dsp_size_t reps;                        // number of repetitions
+    double run_ns[BENCH_MAX_REPS];          // time per call of the repetitions, sorted
+    double median_ns;
+    double p95_ns;
+    double min_ns;
+    double mean_ns;
+} bench_result_t;
+
+
+/**
+ * @brief Entry of the baseline JSON
+ */
+typedef struct {
+    char name[BENCH_MAX_NAME];
+    dsp_size_t size;
+    dsp_size_t reps;
+    double run_ns[BENCH_MAX_REPS];          // sorted
+    double median_ns;
+} bench_baseline_t;
+
+
+/*Shared buffers, BENCH_MAX_SIZE + kernel length elements*/
+static dsp_val_t *buf_a, *buf_b, *buf_c, *buf_d, *buf_kernel;
+static dsp_f32_t *buf_f32_a, *buf_f32_b, *buf_f32_kernel;
+static dsp_q15_t *buf_q15_a, *buf_q15_b, *buf_q15_kernel;
+static int q15_shift;
+static volatile dsp_val_t sink;
+
+/*Objects of the cases*/
+static dsp_fft_plan_t *fft_plan;
+static dsp_fft_plan_f32_t *fft_plan_f32;
+static dsp_f32_t *fft_f32_rex, *fft_f32_imx;
+static dsp_fir_t *fir;
+static dsp_channelizer_t *channelizer;
+static dsp_rolling_t *rolling;
+static dsp_quantile_acc_t quantile_acc;
+static dsp_hist_t hist;
+static dsp_size_t hist_bins[256];
+static dsp_exec_ctx_t *exec_ctx;
+static dsp_pipeline_t *pipeline;
+static dsp_stat_acc_t pipeline_acc;
+
+
+static double now_ns(void);
+static void bench_measure(bench_case_t *bc, dsp_size_t size, dsp_size_t reps, dsp_size_t warmup,
+                          double min_rep_ns, bench_result_t *res);
+static int compare_double(const void *a, const void *b);
+static bench_baseline_t *bench_load_baseline(const char *path, dsp_size_t *n_entries);
+static double bench_mann_whitney(double *cur, dsp_size_t n_cur, double *base, dsp_size_t n_base);
+
+
+//////////////////////////////////////////////////////////////////////////////
+/*Cases*/
+//////////////////////////////////////////////////////////////////////////////
+static void run_sig_mean(dsp_size_t n) { sink = dsp_sig_mean(buf_a, n); }
+static void run_sig_variance(dsp_size_t n) { sink = dsp_sig_variance(buf_a, 0.1, n); }
+static void run_sig_stats(dsp_size_t n) { dsp_sig_stats_t s; dsp_sig_stats(buf_a, n, &s); sink = s.variance; }
+static void run_sig_stats_f32(dsp_size_t n) { dsp_sig_stats_f32_t s; dsp_sig_stats_f32(buf_f32_a, n, &s); sink = s.variance; }
+static void run_sig_stats_mt(dsp_size_t n) { dsp_sig_stats_t s; dsp_sig_stats_mt(buf_a, n, &s, 4); sink = s.variance; }
+static void run_sig_metrics(dsp_size_t n) { dsp_sig_metrics_t m; dsp_sig_metrics(buf_a, n, NULL, 0.0, &m); sink = m.rms; }
+static void run_stat_acc(dsp_size_t n)
+{
+    dsp_stat_acc_t acc;
+    dsp_sig_stats_t s;
+    dsp_stat_acc_init(&acc, 4);
+    dsp_stat_acc_update(&acc, buf_a, n);
+    dsp_stat_acc_finalize(&acc, &s);
+    sink = s.kurtosis;
+}
+
+static void run_convolution(dsp_size_t n) { dsp_convolution(buf_b, buf_a, n, buf_kernel, BENCH_KERNEL_LEN); }
+static void run_convolution_f32(dsp_size_t n) { dsp_convolution_f32(buf_f32_b, buf_f32_a, n, buf_f32_kernel, BENCH_KERNEL_LEN); }
+static void run_convolution_q15(dsp_size_t n) { dsp_convolution_q15(buf_q15_b, buf_q15_a, n, buf_q15_kernel, BENCH_KERNEL_LEN, q15_shift); }
+static void run_running_sum(dsp_size_t n) { dsp_running_sum(buf_b, buf_a, n); }
+
+static void run_dft(dsp_size_t n) { dsp_dft(buf_a, buf_b, buf_c, n); }
+static void run_idft(dsp_size_t n) { dsp_idft(buf_d, buf_b, buf_c, n); }
+static void run_cdft(dsp_size_t n) { dsp_cdft(buf_a, buf_b, buf_c, buf_d, n); }
+static void run_dft_magnitude(dsp_size_t n) { dsp_dft_magnitude(buf_d, buf_b, buf_c, n); }
+static void run_rect2polar(dsp_size_t n) { dsp_rect2polar(buf_d, buf_b + n, buf_b, buf_c, n); }
+
+/*the f32 transform works on a private copy, the shared f32 input of the other cases is kept*/
+static void setup_fft(dsp_size_t n)
+{
+    fft_plan = dsp_fft_plan_create(n);
+    fft_plan_f32 = dsp_fft_plan_create_f32(n);
+    fft_f32_rex = dsp_buf_alloc_f32(n);
+    fft_f32_imx = dsp_buf_alloc_f32(n);
+    memcpy(fft_f32_rex, buf_f32_a, n * sizeof(dsp_f32_t));
+    memcpy(fft_f32_imx, buf_f32_b, n * sizeof(dsp_f32_t));
+}
+static void teardown_fft(void)
+{
+    dsp_fft_plan_destroy(fft_plan);
+    dsp_fft_plan_destroy_f32(fft_plan_f32);
+    dsp_buf_free(fft_f32_rex);
+    dsp_buf_free(fft_f32_imx);
+}
+/*forward and inverse pair, so the repeated transforms keep the signal level*/
+static void run_fft_ifft(dsp_size_t n) { (void)n; dsp_fft(fft_plan, buf_b, buf_c); dsp_ifft(fft_plan, buf_b, buf_c); }
+static void run_fft_ifft_f32(dsp_size_t n) { (void)n; dsp_fft_f32(fft_plan_f32, fft_f32_rex, fft_f32_imx); dsp_ifft_f32(fft_plan_f32, fft_f32_rex, fft_f32_imx); }
+/*interleaved I/Q block: in place, and the same transform with layout conversion*/
+static void run_fft_ifft_iq(dsp_size_t n) { (void)n; dsp_fft_iq(fft_plan, buf_d); dsp_ifft_iq(fft_plan, buf_d); }
+static void run_fft_ifft_iq_split(dsp_size_t n)
+{
+    dsp_iq_deinterleave(buf_b, buf_c, buf_d, n);
+    dsp_fft(fft_plan, buf_b, buf_c);
+    dsp_ifft(fft_plan, buf_b, buf_c);
+    dsp_iq_interleave(buf_d, buf_b, buf_c, n);
+}
+static void run_dft_magnitude_iq(dsp_size_t n) { dsp_dft_magnitude_iq(buf_b, buf_a, n); }
+static void run_iq_deinterleave(dsp_size_t n) { dsp_iq_deinterleave(buf_b, buf_c, buf_a, n); }
+
+static void run_lp_filter(dsp_size_t n) { dsp_lp_win_sinc_filter(buf_b, 48.0, 10.0, NULL, n); }
+static void run_hp_filter(dsp_size_t n) { dsp_hp_win_sinc_filter(buf_b, 48.0, 10.0, dsp_blackman_window, n); }
+static void run_bp_filter(dsp_size_t n) { dsp_bp_win_sinc_filter(buf_b, 48.0, 5.0, 10.0, NULL, n); }
+static void run_kaiser_filter(dsp_size_t n) { sink = dsp_kaiser_win_sinc_filter(buf_b, n, 48.0, 10.0, 10.0 + 480.0 / n, 60.0); }
+
+static void setup_fir(dsp_size_t n) { fir = dsp_fir_create(buf_kernel, BENCH_KERNEL_LEN, n, DSP_FIR_PATH_AUTO); }
+static void teardown_fir(void) { dsp_fir_destroy(fir); }
+static void setup_exec(dsp_size_t n) { (void)n; exec_ctx = dsp_exec_ctx_create(BENCH_EXEC_THREADS, NULL, 0); fft_plan = dsp_fft_plan_create(BENCH_BATCH_FFT_LEN); }
+static void teardown_exec(void) { dsp_exec_ctx_destroy(exec_ctx); dsp_fft_plan_destroy(fft_plan); }
+static void run_sig_stats_exec(dsp_size_t n) { dsp_sig_stats_t s; dsp_sig_stats_exec(buf_a, n, &s, exec_ctx, NULL); sink = s.variance; }
+static void run_convolution_exec(dsp_size_t n) { dsp_convolution_exec(buf_b, buf_a, n, buf_kernel, BENCH_KERNEL_LEN, exec_ctx); }
+/*n samples: n / BENCH_BATCH_FFT_LEN transforms*/
+static void run_fft_batch(dsp_size_t n)
+{
+    dsp_fft_batch(fft_plan, buf_b, buf_c, n / BENCH_BATCH_FFT_LEN, exec_ctx);
+    dsp_ifft_batch(fft_plan, buf_b, buf_c, n / BENCH_BATCH_FFT_LEN, exec_ctx);
+}
+
+static void run_fir_apply(dsp_size_t n) { dsp_fir_apply(fir, buf_b, buf_a, n); }
+
+/*win-sinc FIR -> decimation by 2 -> FFT frames -> magnitude -> statistic*/
+static void setup_pipeline(dsp_size_t n)
+{
+    (void)n;
+    pipeline = dsp_pipeline_create(BENCH_PIPELINE_BLOCK);
+    dsp_pipeline_add_fir(pipeline, buf_kernel, BENCH_KERNEL_LEN, DSP_FIR_PATH_AUTO);
+    dsp_pipeline_add_decimate(pipeline, 2);
+    dsp_pipeline_add_dft(pipeline, BENCH_PIPELINE_FRAME);
+    dsp_pipeline_add_magnitude(pipeline, BENCH_PIPELINE_FRAME / 2);
+    dsp_pipeline_add_stats(pipeline, &pipeline_acc);
+}
+static void teardown_pipeline(void) { dsp_pipeline_destroy(pipeline); }
+static void run_pipeline(dsp_size_t n)
+{
+    dsp_stat_acc_init(&pipeline_acc, 2);
+    dsp_pipeline_run(pipeline, NULL, 0, buf_a, n);
+    sink = pipeline_acc.mean;
+}
+
+/*the same chain with full length intermediate arrays*/
+static void setup_pipeline_arrays(dsp_size_t n)
+{
+    fir = dsp_fir_create(buf_kernel, BENCH_KERNEL_LEN, n, DSP_FIR_PATH_AUTO);
+    fft_plan = dsp_fft_plan_create(BENCH_PIPELINE_FRAME);
+}
+static void teardown_pipeline_arrays(void) { dsp_fir_destroy(fir); dsp_fft_plan_destroy(fft_plan); }
+static void run_pipeline_arrays(dsp_size_t n)
+{
+    dsp_size_t i, bins = BENCH_PIPELINE_FRAME / 2, n_frames = n / 2 / BENCH_PIPELINE_FRAME;
+    dsp_sig_stats_t s;
+
+    dsp_fir_apply(fir, buf_b, buf_a, n);
+    for(i = 0; i < n / 2; *(buf_b + i) = *(buf_b + 2 * i), i++);
+    for(i = 0; i < n_frames; i++) {
+        memcpy(buf_c, buf_b + i * BENCH_PIPELINE_FRAME, BENCH_PIPELINE_FRAME * sizeof(dsp_val_t));
+        memset(buf_d, 0, BENCH_PIPELINE_FRAME * sizeof(dsp_val_t));
+        dsp_fft(fft_plan, buf_c, buf_d);
+        dsp_dft_magnitude(buf_b + i * bins, buf_c, buf_d, bins);
+    }
+    dsp_sig_stats(buf_b, n_frames * bins, &s);
+    sink = s.mean;
+}
+
+static void setup_channelizer(dsp_size_t n) { (void)n; channelizer = dsp_channelizer_create(16, 8, 8, NULL); }
+static void teardown_channelizer(void) { dsp_channelizer_destroy(channelizer); }
+static void run_channelizer(dsp_size_t n) { sink = dsp_channelizer_process(channelizer, buf_b, buf_c, buf_a, n); }
+
+static void run_xcorr(dsp_size_t n) { dsp_xcorr(buf_b, buf_a, n, buf_kernel, BENCH_KERNEL_LEN, DSP_CORR_FULL, DSP_CORR_NORM_NONE, DSP_CORR_PATH_AUTO); }
+static void run_autocorr(dsp_size_t n) { dsp_autocorr(buf_b, buf_a, n, n / 4, DSP_CORR_NORM_COEFF, DSP_CORR_PATH_AUTO); }
+
+static void setup_rolling(dsp_size_t n) { (void)n; rolling = dsp_rolling_create(256, 0); }
+static void teardown_rolling(void) { dsp_rolling_destroy(rolling); }
+static void run_rolling(dsp_size_t n) { dsp_rolling_process(rolling, buf_b, buf_c, buf_d, buf_b + n, buf_a, n); }
+
+static void run_quantile(dsp_size_t n)
+{
+    dsp_val_t q = 0.99;
+    dsp_quantile_acc_init(&quantile_acc, 0.0);
+    dsp_quantile_acc_update(&quantile_acc, buf_a, n);
+    dsp_quantile_acc_finalize(&quantile_acc, &q, buf_b, 1);
+}
+static void run_hist(dsp_size_t n)
+{
+    dsp_hist_init(&hist, hist_bins, 256, -1.0, 1.0);
+    dsp_hist_update(&hist, buf_a, n);
+}
+
+
+static bench_case_t bench_cases[] = {
+    {"dsp_sig_mean",            NULL, run_sig_mean,         NULL, {1024, 16384, 262144, 1048576}},
+    {"dsp_sig_variance",        NULL, run_sig_variance,     NULL, {1024, 16384, 262144, 1048576}},
+    {"dsp_sig_stats",           NULL, run_sig_stats,        NULL, {1024, 16384, 262144, 1048576}},
+    {"dsp_sig_stats_f32",       NULL, run_sig_stats_f32,    NULL, {1024, 16384, 262144, 1048576}},
+    {"dsp_sig_stats_mt",        NULL, run_sig_stats_mt,     NULL, {262144, 1048576}},
+    {"dsp_sig_metrics",         NULL, run_sig_metrics,      NULL, {1024, 16384, 262144, 1048576}},
+    {"dsp_stat_acc",            NULL, run_stat_acc,         NULL, {1024, 16384, 262144}},
+    {"dsp_convolution",         NULL, run_convolution,      NULL, {1024, 16384, 262144}},
+    {"dsp_convolution_f32",     NULL, run_convolution_f32,  NULL, {1024, 16384, 262144}},
+    {"dsp_convolution_q15",     NULL, run_convolution_q15,  NULL, {1024, 16384, 262144}},
+    {"dsp_running_sum",         NULL, run_running_sum,      NULL, {1024, 16384, 262144}},
+    {"dsp_dft",                 NULL, run_dft,              NULL, {64, 256, 1024, 2048}},
+    {"dsp_idft",                NULL, run_idft,             NULL, {64, 256, 1024, 2048}},
+    {"dsp_cdft",                NULL, run_cdft,             NULL, {64, 256, 1024, 2048}},
+    {"dsp_dft_magnitude",       NULL, run_dft_magnitude,    NULL, {1024, 16384, 262144}},
+    {"dsp_rect2polar",          NULL, run_rect2polar,       NULL, {1024, 16384, 262144}},
+    {"dsp_fft+dsp_ifft",        setup_fft, run_fft_ifft,    teardown_fft, {64, 1024, 16384, 262144}},
+    {"dsp_fft+dsp_ifft_f32",    setup_fft, run_fft_ifft_f32, teardown_fft, {64, 1024, 16384, 262144}},
+    {"dsp_fft_iq+dsp_ifft_iq",  setup_fft, run_fft_ifft_iq, teardown_fft, {64, 1024, 16384, 262144}},
+    {"iq_split+dsp_fft+dsp_ifft", setup_fft, run_fft_ifft_iq_split, teardown_fft, {64, 1024, 16384, 262144}},
+    {"dsp_dft_magnitude_iq",    NULL, run_dft_magnitude_iq, NULL, {1024, 16384, 262144}},
+    {"dsp_iq_deinterleave",     NULL, run_iq_deinterleave,  NULL, {1024, 16384, 262144}},
+    {"dsp_lp_win_sinc_filter",  NULL, run_lp_filter,        NULL, {31, 101, 1001}},
+    {"dsp_hp_win_sinc_filter",  NULL, run_hp_filter,        NULL, {31, 101, 1001}},
+    {"dsp_bp_win_sinc_filter",  NULL, run_bp_filter,        NULL, {31, 101, 1001}},
+    {"dsp_kaiser_win_sinc_filter", NULL, run_kaiser_filter, NULL, {101, 1001}},
+    {"dsp_fir_apply",           setup_fir, run_fir_apply,   teardown_fir, {1024, 16384, 262144}},
+    {"dsp_channelizer_process", setup_channelizer, run_channelizer, teardown_channelizer, {1024, 16384, 262144}},
+    {"dsp_xcorr",               NULL, run_xcorr,            NULL, {1024, 16384, 262144}},
+    {"dsp_autocorr",            NULL, run_autocorr,         NULL, {1024, 4096, 16384}},
+    {"dsp_sig_stats_exec",      setup_exec, run_sig_stats_exec, teardown_exec, {262144, 1048576}},
+    {"dsp_convolution_exec",    setup_exec, run_convolution_exec, teardown_exec, {16384, 262144}},
+    {"dsp_fft_batch+ifft_batch", setup_exec, run_fft_batch, teardown_exec, {16384, 262144}},
+    {"dsp_pipeline_run",        setup_pipeline, run_pipeline, teardown_pipeline, {16384, 262144, 1048576}},
+    {"pipeline_arrays",         setup_pipeline_arrays, run_pipeline_arrays, teardown_pipeline_arrays, {16384, 262144, 1048576}},
+    {"dsp_rolling_process",     setup_rolling, run_rolling, teardown_rolling, {1024, 16384, 262144}},
+    {"dsp_quantile_acc",        NULL, run_quantile,         NULL, {1024, 16384, 262144}},
+    {"dsp_hist",                NULL, run_hist,             NULL, {1024, 16384, 262144}},
+};
+
+
+int main(int argc, char **argv)
+{
+    dsp_size_t reps = 15, warmup = 3, i, j, n_cases = sizeof(bench_cases) / sizeof(bench_cases[0]);
+    double min_rep_ns = 2e6;
+    double slowdown = 0.05, alpha = 0.01;
+    const char *filter = NULL, *out_path = NULL, *baseline_path = NULL;
+    FILE *out = stdout;
+    int first = 1;
+    bench_baseline_t *baseline = NULL;
+    dsp_size_t n_baseline = 0, n_compared = 0, n_regressions = 0;
+    static bench_result_t res;
+
+    for(i = 1; i < (dsp_size_t)argc; i++) {
+        if(strcmp(argv[i], "-r") == 0 && i + 1 < (dsp_size_t)argc) {
+            reps = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-w") == 0 && i + 1 < (dsp_size_t)argc) {
+            warmup = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-t") == 0 && i + 1 < (dsp_size_t)argc) {
+            min_rep_ns = 1e3 * strtod(argv[++i], NULL);
+        } else if(strcmp(argv[i], "-f") == 0 && i + 1 < (dsp_size_t)argc) {
+            filter = argv[++i];
+        } else if(strcmp(argv[i], "-o") == 0 && i + 1 < (dsp_size_t)argc) {
+            out_path = argv[++i];
+        } else if(strcmp(argv[i], "-b") == 0 && i + 1 < (dsp_size_t)argc) {
+            baseline_path = argv[++i];
+        } else if(strcmp(argv[i], "-s") == 0 && i + 1 < (dsp_size_t)argc) {
+            slowdown = 0.01 * strtod(argv[++i], NULL);
+        } else if(strcmp(argv[i], "-a") == 0 && i + 1 < (dsp_size_t)argc) {
+            alpha = strtod(argv[++i], NULL);
+        } else if(strcmp(argv[i], "-q") == 0) {
+            reps = 5;
+            warmup = 1;
+            min_rep_ns = 2e5;
+        } else {
+            fprintf(stderr, "usage: %s [-r repetitions] [-w warmup] [-t min_rep_time_us] "
+                            "[-f name_filter] [-o output.json] [-q] "
+                            "[-b baseline.json] [-s slowdown_percent] [-a alpha]\n", argv[0]);
+            return 2;
+        }
+    }
+    reps = (reps < 1) ? 1 : (reps > BENCH_MAX_REPS) ? BENCH_MAX_REPS : reps;
+
+    if(baseline_path != NULL) {
+        baseline = bench_load_baseline(baseline_path, &n_baseline);
+        if(baseline == NULL) {
+            fprintf(stderr, "Cannot load baseline %s\n", baseline_path);
+            return 1;
+        }
+    }
+
+    /*buffers, random signal in [-1, 1)*/
+    /*aligned buffers, the kernels take their aligned paths*/
+    buf_a = dsp_buf_alloc(BENCH_MAX_SIZE + BENCH_KERNEL_LEN);
+    buf_b = dsp_buf_alloc(2 * (BENCH_MAX_SIZE + BENCH_KERNEL_LEN));
+    buf_c = dsp_buf_alloc(BENCH_MAX_SIZE + BENCH_KERNEL_LEN);
+    buf_d = dsp_buf_alloc(BENCH_MAX_SIZE + BENCH_KERNEL_LEN);
+    buf_kernel = dsp_buf_alloc(BENCH_KERNEL_LEN);
+    buf_f32_a = dsp_buf_alloc_f32(BENCH_MAX_SIZE + BENCH_KERNEL_LEN);
+    buf_f32_b = dsp_buf_alloc_f32(BENCH_MAX_SIZE + BENCH_KERNEL_LEN);
+    buf_f32_kernel = dsp_buf_alloc_f32(BENCH_KERNEL_LEN);
+    buf_q15_a = (dsp_q15_t *) calloc(BENCH_MAX_SIZE + BENCH_KERNEL_LEN, sizeof(dsp_q15_t));
+    buf_q15_b = (dsp_q15_t *) calloc(BENCH_MAX_SIZE + BENCH_KERNEL_LEN, sizeof(dsp_q15_t));
+    buf_q15_kernel = (dsp_q15_t *) calloc(BENCH_KERNEL_LEN, sizeof(dsp_q15_t));
+    if(buf_a == NULL || buf_b == NULL || buf_c == NULL || buf_d == NULL || buf_kernel == NULL ||
+       buf_f32_a == NULL || buf_f32_b == NULL || buf_f32_kernel == NULL || buf_q15_a == NULL || buf_q15_b == NULL || buf_q15_kernel == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1;
+    }
+
+    srand(1);
+    for(i = 0; i < BENCH_MAX_SIZE; i++) {
+        *(buf_a + i) = 2.0 * rand() / ((double)RAND_MAX + 1.0) - 1.0;
+        *(buf_b + i) = *(buf_a + i);
+        *(buf_c + i) = 0.0;
+        *(buf_f32_a + i) = (dsp_f32_t)*(buf_a + i);
+    }
+    dsp_lp_win_sinc_filter(buf_kernel, 48.0, 10.0, NULL, BENCH_KERNEL_LEN);
+    for(i = 0; i < BENCH_KERNEL_LEN; *(buf_f32_kernel + i) = (dsp_f32_t)*(buf_kernel + i), i++);
+    dsp_quantize_q15(buf_q15_a, buf_a, BENCH_MAX_SIZE);
+    q15_shift = dsp_filter_quantize_q15(buf_q15_kernel, buf_kernel, BENCH_KERNEL_LEN);
+
+    if(out_path != NULL) {
+        out = fopen(out_path, "w");
+        if(out == NULL) {
+            fprintf(stderr, "Cannot open %s\n", out_path);
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\n  \"benchmark\": \"dsp_bench\",\n  \"version\": 1,\n");
+    fprintf(out, "  \"isa\": \"%s\",\n", dsp_cpu_isa_name(dsp_cpu_isa()));
+    fprintf(stderr, "kernel variant: %s\n", dsp_cpu_isa_name(dsp_cpu_isa()));
+    fprintf(out, "  \"repetitions\": %lu,\n  \"warmup\": %lu,\n  \"min_rep_time_ns\": %.0f,\n",
+            reps, warmup, min_rep_ns);
+    fprintf(out, "  \"results\": [");
+
+    for(i = 0; i < n_cases; i++) {
+        bench_case_t *bc = &bench_cases[i];
+        if(filter != NULL && strstr(bc->name, filter) == NULL) {
+            continue;
+        }
+
+        for(j = 0; j < BENCH_MAX_SIZES && bc->sizes[j] != 0; j++) {
+            dsp_size_t k, size = bc->sizes[j];
+
+            bench_measure(bc, size, reps, warmup, min_rep_ns, &res);
+            fprintf(stderr, "%-28s %8lu  median %12.1f ns  p95 %12.1f ns  %10.3f Msamples/s\n",
+                    bc->name, size, res.median_ns, res.p95_ns, size / res.median_ns * 1e3);
+
+            fprintf(out, "%s\n    {\"name\": \"%s\", \"size\": %lu, \"iterations\": %lu, ",
+                    first ? "" : ",", bc->name, size, res.iterations);
+            fprintf(out, "\"median_ns\": %.3f, \"p95_ns\": %.3f, \"min_ns\": %.3f, \"mean_ns\": %.3f, ",
+                    res.median_ns, res.p95_ns, res.min_ns, res.mean_ns);
+            fprintf(out, "\"samples_per_sec\": %.1f,\n     \"runs_ns\": [", size / res.median_ns * 1e9);
+            for(k = 0; k < res.reps; k++) {
+                fprintf(out, "%s%.3f", (k == 0) ? "" : ", ", res.run_ns[k]);
+            }
+            fprintf(out, "]");
+
+            /*comparison with the same case and size of the baseline*/
+            for(k = 0; k < n_baseline; k++) {
+                if(baseline[k].size == size && strcmp(baseline[k].name, bc->name) == 0) {
+                    break;
+                }
+            }
+            if(k < n_baseline) {
+                double ratio = res.median_ns / baseline[k].median_ns;
+                double p = bench_mann_whitney(res.run_ns, res.reps, baseline[k].run_ns, baseline[k].reps);
+                int regression = (ratio > 1.0 + slowdown && p < alpha);
+
+                n_compared++;
+                n_regressions += regression;
+                fprintf(stderr, "%-28s %8lu  baseline %10.1f ns  ratio %6.3f  p %.4f%s\n",
+                        "", size, baseline[k].median_ns, ratio, p, regression ? "  REGRESSION" : "");
+                fprintf(out, ",\n     \"baseline_median_ns\": %.3f, \"ratio\": %.4f, \"p_value\": %.6f, \"regression\": %s",
+                        baseline[k].median_ns, ratio, p, regression ? "true" : "false");
+            }
+            fprintf(out, "}");
+            first = 0;
+        }
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if(out != stdout) {
+        fclose(out);
+    }
+
+    if(baseline != NULL) {
+        free(baseline);
+        fprintf(stderr, "%lu of %lu compared cases regressed (slowdown > %.1f %%, p < %g)\n",
+                n_regressions, n_compared, 100.0 * slowdown, alpha);
+        if(n_regressions > 0) {
+            return BENCH_EXIT_REGRESSION;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Time of one case and size
+ * The number of calls per repetition is calibrated, so one repetition takes at least min_rep_ns.
+ *
+ * @param bc benchmark case
+ * @param size size parameter of the function
+ * @param reps number of measured repetitions
+ * @param warmup number of not measured repetitions
+ * @param min_rep_ns minimal time of one repetition
+ * @param res result
+ */
+static void bench_measure(bench_case_t *bc, dsp_size_t size, dsp_size_t reps, dsp_size_t warmup,
+                          double min_rep_ns, bench_result_t *res)
+{
+    dsp_size_t r, it, iterations = 1;
+    double t0, elapsed, sum = 0.0;
+
+    if(bc->setup != NULL) {
+        bc->setup(size);
+    }
+
+    /*calibration, doubles the calls until the repetition is long enough*/
+    for(;;) {
+        t0 = now_ns();
+        for(it = 0; it < iterations; bc->run(size), it++);
+        elapsed = now_ns() - t0;
+        if(elapsed >= min_rep_ns || iterations >= (1UL << 30)) {
+            break;
+        }
+        iterations = (elapsed > 0.0 && min_rep_ns / elapsed < 2.0) ?
+                     (dsp_size_t)(iterations * min_rep_ns / elapsed) + 1 : 2 * iterations;
+    }
+
+    for(r = 0; r < warmup; r++) {
+        for(it = 0; it < iterations; bc->run(size), it++);
+    }
+
+    for(r = 0; r < reps; r++) {
+        t0 = now_ns();
+        for(it = 0; it < iterations; bc->run(size), it++);
+        res->run_ns[r] = (now_ns() - t0) / (double)iterations;
+        sum += res->run_ns[r];
+    }
+
+    if(bc->teardown != NULL) {
+        bc->teardown();
+    }
+
+    qsort(res->run_ns, reps, sizeof(double), compare_double);
+    res->iterations = iterations;
+    res->reps = reps;
+    res->median_ns = (reps % 2) ? res->run_ns[reps / 2] : 0.5 * (res->run_ns[reps / 2 - 1] + res->run_ns[reps / 2]);
+    res->p95_ns = res->run_ns[(dsp_size_t)ceil(0.95 * reps) - 1];
+    res->min_ns = res->run_ns[0];
+    res->mean_ns = sum / (double)reps;
+}
+
+
+/**
+ * @brief Monotonic time
+ *
+ * @return double time in ns
+ */
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+
+static int compare_double(const void *a, const void *b)
+{
+    double va = *(const double *)a;
+    double vb = *(const double *)b;
+
+    return (va > vb) - (va < vb);
+}
+
+
+/**
+ * @brief Loads the results of a previous dsp_bench JSON output
+ * Only the own output format is parsed: name, size and runs_ns of every result.
+ *
+ * @param path JSON file
+ * @param n_entries number of the loaded entries
+ * @return bench_baseline_t* array of the entries (free by the caller), NULL if failed
+ */
+static bench_baseline_t *bench_load_baseline(const char *path, dsp_size_t *n_entries)
+{
+    FILE *fp;
+    char *text, *p, *end;
+    long text_len;
+    dsp_size_t n = 0, cap = 0, k;
+    bench_baseline_t *entries = NULL, *tmp;
+
+    fp = fopen(path, "r");
+    if(fp == NULL) {
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    text_len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    text = (char *) malloc(text_len + 1);
+    if(text == NULL || text_len < 0 || fread(text, 1, text_len, fp) != (size_t)text_len) {
+        free(text);
+        fclose(fp);
+        return NULL;
+    }
+    *(text + text_len) = '\0';
+    fclose(fp);
+
+    for(p = strstr(text, "\"name\""); p != NULL; p = strstr(p, "\"name\"")) {
+        if(n == cap) {
+            cap = (cap == 0) ? 64 : 2 * cap;
+            tmp = (bench_baseline_t *) realloc(entries, cap * sizeof(bench_baseline_t));
+            if(tmp == NULL) {
+                break;
+            }
+            entries = tmp;
+        }
+
+        /*name*/
+        p = strchr(p + 6, '"');
+        if(p == NULL) {
+            break;
+        }
+        p++;
+        for(k = 0; *p != '"' && *p != '\0' && k < BENCH_MAX_NAME - 1; entries[n].name[k++] = *p++);
+        entries[n].name[k] = '\0';
+
+        /*size*/
+        p = strstr(p, "\"size\"");
+        if(p == NULL) {
+            break;
+        }
+        entries[n].size = strtoul(strchr(p, ':') + 1, NULL, 10);
+
+        /*runs*/
+        p = strstr(p, "\"runs_ns\"");
+        if(p == NULL || (p = strchr(p, '[')) == NULL) {
+            break;
+        }
+        p++;
+        for(k = 0; k < BENCH_MAX_REPS; k++) {
+            double v = strtod(p, &end);
+            if(end == p) {
+                break;
+            }
+            entries[n].run_ns[k] = v;
+            for(p = end; *p == ' ' || *p == ',' || *p == '\n'; p++);
+        }
+        if(k == 0) {
+            continue;
+        }
+        entries[n].reps = k;
+        qsort(entries[n].run_ns, k, sizeof(double), compare_double);
+        entries[n].median_ns = (k % 2) ? entries[n].run_ns[k / 2] :
+                               0.5 * (entries[n].run_ns[k / 2 - 1] + entries[n].run_ns[k / 2]);
+        n++;
+    }
+    free(text);
+
+    if(entries == NULL) {
+        entries = (bench_baseline_t *) malloc(sizeof(bench_baseline_t));
+    }
+    *n_entries = n;
+    return entries;
+}
+
+
+/**
+ * @brief One sided Mann-Whitney U test: are the current runs slower than the baseline runs?
+ * Normal approximation with tie and continuity correction. Both arrays must be sorted.
+ *
+ * @param cur current run times, sorted
+ * @param n_cur number of the current runs
+ * @param base baseline run times, sorted
+ * @param n_base number of the baseline runs
+ * @return double p value
+ */
+static double bench_mann_whitney(double *cur, dsp_size_t n_cur, double *base, dsp_size_t n_base)
+{
+    dsp_size_t i = 0, j = 0, t_cur, t_base, t;
+    double rank = 1.0, rank_sum = 0.0, tie_sum = 0.0, n = (double)(n_cur + n_base);
+    double u, mean, var, z;
+
+    /*merge of the sorted arrays, the equal values get the average rank*/
+    while(i < n_cur || j < n_base) {
+        double v = (j >= n_base || (i < n_cur && cur[i] <= base[j])) ? cur[i] : base[j];
+
+        for(t_cur = 0; i < n_cur && cur[i] == v; i++, t_cur++);
+        for(t_base = 0; j < n_base && base[j] == v; j++, t_base++);
+        t = t_cur + t_base;
+        rank_sum += t_cur * (rank + 0.5 * (t - 1));
+        tie_sum += (double)t * t * t - t;
+        rank += t;
+    }
+
+    u = rank_sum - 0.5 * n_cur * (n_cur + 1);
+    mean = 0.5 * n_cur * n_base;
+    var = n_cur * n_base / 12.0 * ((n + 1.0) - tie_sum / (n * (n - 1.0)));
+    if(var <= 0.0) {
+        return 1.0;
+    }
+    z = (u - mean - 0.5) / sqrt(var);
+    return 0.5 * erfc(z / sqrt(2.0));
+}
@@ -22,6 +22,23 @@
 #include "dsp_dft.h"
 #include "dsp_cdft.h"
 #include "dsp_filter.h"
+#include "dsp_fft.h"
+#include "dsp_fir.h"
+#include "dsp_channelizer.h"
+#include "dsp_fixed.h"
+#include "dsp_rolling.h"
+#include "dsp_quantile.h"
+#include "dsp_correlation.h"
+#include "dsp_instr.h"
+#include "dsp_workspace.h"
+#include "dsp_buf.h"
+#include "dsp_cpu.h"
+#include "dsp_exec.h"
+#include "dsp_pipeline.h"
+#include "dsp_sigfile.h"
+#include "dsp_stft.h"
+#include "dsp_psd.h"
+#include "dsp_iq.h"
 #include "waveforms.h"
 
 
@@ -29,8 +46,11 @@
 
 
 static inline void check_mem_alloc(void *mem);
-void create_dat_file(const char *test_path, const char *rel_path, const dsp_val_t *data_array, const dsp_size_t size);
+void create_sig_file(const char *test_path, const char *rel_path, const dsp_val_t *data_array, const dsp_size_t size);
 char *prepare_path(const char *test_path, const char *rel_path);
+dsp_val_t max_abs_error(const dsp_val_t *sig, const dsp_val_t *ref_sig, const dsp_size_t size);
+int compare_val(const void *a, const void *b);
+void exec_test_task(void *arg, dsp_size_t task);
 
 int main(void)
 {
@@ -77,6 +97,10 @@ int main(void)
  * 1. Calculating the mean value
  * 2. Calculating the variance
  * 3. Calculating the standard deviation
+ * 4. One pass statistic, compared to the two pass results
+ * 5. Accumulators of uneven chunks merged, compared to the direct moments
+ * 6. Multithreaded statistic of a large signal, same result with every thread count
+ * 7. One pass signal metrics, compared to separate loops, SNR of noisy signal
  */
 
     dsp_val_t mean = dsp_sig_mean((dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
@@ -87,7 +111,91 @@ int main(void)
     printf("-----------------------------------------------------------\n");
     printf("mean:          %lf\n", mean);
     printf("variance:      %lf\n", variance);
-    printf("standard dev:  %lf\n\n", std_dev);
+    printf("standard dev:  %lf\n", std_dev);
+
+    dsp_sig_stats_t stats;
+    dsp_sig_stats((dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE, &stats);
+    printf("one pass mean error:      %e\n", fabs(stats.mean - mean));
+    printf("one pass variance error:  %e\n", fabs(stats.variance - variance));
+    printf("one pass std dev error:   %e\n", fabs(stats.std_dev - std_dev));
+
+    /*short signals, tail only and single sample*/
+    dsp_sig_stats((dsp_val_t *)InputSignal_f32_1kHz_15kHz, 3, &stats);
+    printf("one pass 3 samples error: %e\n", fabs(stats.variance - dsp_sig_variance((dsp_val_t *)InputSignal_f32_1kHz_15kHz,
+            dsp_sig_mean((dsp_val_t *)InputSignal_f32_1kHz_15kHz, 3), 3)));
+    dsp_sig_stats((dsp_val_t *)InputSignal_f32_1kHz_15kHz, 1, &stats);
+    printf("one pass 1 sample:        mean %lf, variance %lf\n", stats.mean, stats.variance);
+
+    dsp_stat_acc_t acc_chunk[3], acc_all;
+    dsp_size_t chunk_pos[4] = {0, 7, 200, INP_SIG_F32_1K_15K_SIZE};
+    dsp_val_t m3_ref = 0.0, m4_ref = 0.0, diff_ref;
+    dsp_size_t si;
+    for(si = 0; si < 3; si++) {
+        dsp_stat_acc_init(&acc_chunk[si], 4);
+        dsp_stat_acc_update(&acc_chunk[si], (dsp_val_t *)InputSignal_f32_1kHz_15kHz + chunk_pos[si],
+                            chunk_pos[si + 1] - chunk_pos[si]);
+    }
+    dsp_stat_acc_init(&acc_all, 4);
+    for(si = 0; si < 3; dsp_stat_acc_merge(&acc_all, &acc_chunk[si]), si++);
+    dsp_stat_acc_finalize(&acc_all, &stats);
+
+    for(si = 0; si < INP_SIG_F32_1K_15K_SIZE; si++) {
+        diff_ref = InputSignal_f32_1kHz_15kHz[si] - mean;
+        m3_ref += diff_ref * diff_ref * diff_ref;
+        m4_ref += diff_ref * diff_ref * diff_ref * diff_ref;
+    }
+    dsp_val_t m2_ref = variance * (INP_SIG_F32_1K_15K_SIZE - 1);
+    dsp_val_t skew_ref = sqrt((dsp_val_t)INP_SIG_F32_1K_15K_SIZE) * m3_ref / pow(m2_ref, 1.5);
+    dsp_val_t kurt_ref = INP_SIG_F32_1K_15K_SIZE * m4_ref / (m2_ref * m2_ref) - 3.0;
+
+    printf("merged min, max:          %lf, %lf\n", stats.min, stats.max);
+    printf("merged variance error:    %e\n", fabs(stats.variance - variance));
+    printf("merged skewness:          %lf (error %e)\n", stats.skewness, fabs(stats.skewness - skew_ref));
+    printf("merged kurtosis:          %lf (error %e)\n", stats.kurtosis, fabs(stats.kurtosis - kurt_ref));
+
+    dsp_size_t mt_len = 40 * DSP_STAT_CHUNK_LEN + 123;
+    dsp_val_t *mt_sig = (dsp_val_t *) malloc(mt_len * sizeof(dsp_val_t));
+    check_mem_alloc(mt_sig);
+    for(si = 0; si < mt_len; si++) {
+        *(mt_sig + si) = 1000.0 + InputSignal_f32_1kHz_15kHz[si % INP_SIG_F32_1K_15K_SIZE];
+    }
+
+    dsp_sig_stats_t mt_ref, mt_stats;
+    int mt_threads, mt_same = 1;
+    dsp_sig_stats_mt(mt_sig, mt_len, &mt_ref, 1);
+    for(mt_threads = 2; mt_threads <= 8; mt_threads++) {
+        dsp_sig_stats_mt(mt_sig, mt_len, &mt_stats, mt_threads);
+        mt_same &= (memcmp(&mt_stats, &mt_ref, sizeof(dsp_sig_stats_t)) == 0);
+    }
+    dsp_sig_stats(mt_sig, mt_len, &stats);
+    printf("multithreaded same result:%s\n", mt_same ? " OK" : " FAILED");
+    printf("multithreaded mean error: %e\n", fabs(mt_ref.mean - stats.mean));
+    printf("multithreaded var error:  %e\n", fabs(mt_ref.variance - stats.variance));
+    printf("multithreaded rms:        %lf\n", mt_ref.rms);
+    free(mt_sig);
+
+    dsp_sig_metrics_t metrics;
+    dsp_val_t noisy[INP_SIG_F32_1K_15K_SIZE], peak_ref = 0.0, noise_pow = 0.0, sig_pow = 0.0;
+    dsp_size_t zc_ref = 0;
+    unsigned long noise_seed = 1;
+    for(si = 0; si < INP_SIG_F32_1K_15K_SIZE; si++) {
+        noise_seed = noise_seed * 1103515245UL + 12345UL;
+        noisy[si] = InputSignal_f32_1kHz_15kHz[si] + 0.05 * ((dsp_val_t)((noise_seed >> 16) & 0x7FFF) / 16384.0 - 1.0);
+        noise_pow += (noisy[si] - InputSignal_f32_1kHz_15kHz[si]) * (noisy[si] - InputSignal_f32_1kHz_15kHz[si]);
+        sig_pow += InputSignal_f32_1kHz_15kHz[si] * InputSignal_f32_1kHz_15kHz[si];
+        peak_ref = fmax(peak_ref, fabs(InputSignal_f32_1kHz_15kHz[si]));
+        zc_ref += (si > 0) && ((InputSignal_f32_1kHz_15kHz[si] < 0.0) != (InputSignal_f32_1kHz_15kHz[si - 1] < 0.0));
+    }
+
+    dsp_sig_metrics((dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE, NULL, 0.0, &metrics);
+    printf("metrics mean/var error:   %e, %e\n", fabs(metrics.mean - mean), fabs(metrics.variance - variance));
+    printf("metrics rms, peak, crest: %lf, %lf, %lf\n", metrics.rms, metrics.peak, metrics.crest_factor);
+    printf("metrics peak, zero cross: %s\n", (metrics.peak == peak_ref && metrics.zero_crossings == zc_ref) ? "OK" : "FAILED");
+
+    dsp_sig_metrics(noisy, INP_SIG_F32_1K_15K_SIZE, (dsp_val_t *)InputSignal_f32_1kHz_15kHz, 0.0, &metrics);
+    printf("SNR with reference:       %lf dB (expected %lf dB)\n", metrics.snr_db, 10.0 * log10(sig_pow / noise_pow));
+    dsp_sig_metrics(noisy, INP_SIG_F32_1K_15K_SIZE, NULL, noise_pow / INP_SIG_F32_1K_15K_SIZE, &metrics);
+    printf("SNR with noise power:     %lf dB\n\n", metrics.snr_db);
 
 #endif
 
@@ -109,17 +217,17 @@ int main(void)
 
     
     /*Create convolution input signal dat file*/
-    create_dat_file(test_abs_path, "dat/convolution/conv_input_signal.dat", 
+    create_sig_file(test_abs_path, "dat/convolution/conv_input_signal.dsig", 
                     (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
 
 
     /*Create convolution impulse response dat file*/
-    create_dat_file(test_abs_path, "dat/convolution/conv_impulse_response.dat", 
+    create_sig_file(test_abs_path, "dat/convolution/conv_impulse_response.dsig", 
                     (dsp_val_t *)Impulse_response, IMPULSE_RESP_SIZE);
 
 
     /*Create convolution output signal */
-    create_dat_file(test_abs_path, "dat/convolution/conv_output_signal.dat", 
+    create_sig_file(test_abs_path, "dat/convolution/conv_output_signal.dsig", 
                     conv_output_signal, IMPULSE_RESP_SIZE + INP_SIG_F32_1K_15K_SIZE);
 
     /*Running su*/
@@ -131,12 +239,12 @@ int main(void)
     dsp_running_sum(running_sum_ouptut_signal, (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
 
     /*Cerate runing sum input signal*/
-    create_dat_file(test_abs_path, "dat/convolution/rsum_input_signal.dat", 
+    create_sig_file(test_abs_path, "dat/convolution/rsum_input_signal.dsig", 
                     (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
 
 
     /*Create running sum output signal*/
-    create_dat_file(test_abs_path, "dat/convolution/rsum_output_signal.dat", 
+    create_sig_file(test_abs_path, "dat/convolution/rsum_output_signal.dsig", 
                     (dsp_val_t *)running_sum_ouptut_signal, INP_SIG_F32_1K_15K_SIZE);
 
     free(running_sum_ouptut_signal);
@@ -178,15 +286,15 @@ int main(void)
 
 
     /*Cerate  DFT input signal*/
-    create_dat_file(test_abs_path, "dat/dft/dft_input_signal.dat", 
+    create_sig_file(test_abs_path, "dat/dft/dft_input_signal.dsig", 
                     (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
 
     /*Cerate  DFT output rex signal*/
-    create_dat_file(test_abs_path, "dat/dft/dft_output_rex.dat", 
+    create_sig_file(test_abs_path, "dat/dft/dft_output_rex.dsig", 
                     dft_output_rex, INP_SIG_F32_1K_15K_SIZE / 2);
 
     /*Cerate  DFT output imx signal*/
-    create_dat_file(test_abs_path, "dat/dft/dft_output_imx.dat", 
+    create_sig_file(test_abs_path, "dat/dft/dft_output_imx.dsig", 
                     dft_output_imx, INP_SIG_F32_1K_15K_SIZE / 2);
 
     
@@ -195,14 +303,14 @@ int main(void)
     dsp_idft(idft_output_signal, dft_output_rex, dft_output_imx, INP_SIG_F32_1K_15K_SIZE);
 
     /*Cerate  DFT input signal*/
-    create_dat_file(test_abs_path, "/dat/dft/idft_output_signal.dat", 
+    create_sig_file(test_abs_path, "/dat/dft/idft_output_signal.dsig", 
                     idft_output_signal, INP_SIG_F32_1K_15K_SIZE);
 
 
     
 
     /*Cerate  DFT output magniute signal*/
-    create_dat_file(test_abs_path, "dat/dft/dft_output_mag.dat", 
+    create_sig_file(test_abs_path, "dat/dft/dft_output_mag.dsig", 
                     dft_output_mag, INP_SIG_F32_1K_15K_SIZE / 2);
 
     printf("\n");
@@ -226,22 +334,22 @@ int main(void)
     
 
     /*Cerate  DFT input signal*/
-    create_dat_file(test_abs_path, "dat/dft/dft_ecg_input_signal.dat", 
+    create_sig_file(test_abs_path, "dat/dft/dft_ecg_input_signal.dsig", 
                     (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE);
 
     /*Cerate  DFT output rex signal*/
-    create_dat_file(test_abs_path, "dat/dft/dft_ecg_output_rex.dat", 
+    create_sig_file(test_abs_path, "dat/dft/dft_ecg_output_rex.dsig", 
                     dft_ecg_output_rex, ECG_SIGNAL_SIZE / 2);
 
     /*Cerate  DFT output imx signal*/
-    create_dat_file(test_abs_path, "dat/dft/dft_ecg_output_imx.dat", 
+    create_sig_file(test_abs_path, "dat/dft/dft_ecg_output_imx.dsig", 
                     dft_ecg_output_imx, ECG_SIGNAL_SIZE / 2);
 
     /*Regenerate the original signal with IDFT*/
     dsp_idft(idft_ecg_output_signal, dft_ecg_output_rex, dft_ecg_output_imx, ECG_SIGNAL_SIZE);
 
     /*Cerate  DFT input signal*/
-    create_dat_file(test_abs_path, "dat/dft/idft_ecg_output_signal.dat", 
+    create_sig_file(test_abs_path, "dat/dft/idft_ecg_output_signal.dsig", 
                     idft_ecg_output_signal, ECG_SIGNAL_SIZE);
 
 
@@ -256,11 +364,11 @@ int main(void)
     dsp_rect2polar(dft_ecg_output_mag, dft_ecg_output_phase, dft_ecg_output_rex, dft_ecg_output_imx, ECG_SIGNAL_SIZE / 2);
 
     /*Create magnitude dat file*/
-    create_dat_file(test_abs_path, "dat/dft/dft_ecg_output_mag.dat", 
+    create_sig_file(test_abs_path, "dat/dft/dft_ecg_output_mag.dsig", 
                     dft_ecg_output_mag, ECG_SIGNAL_SIZE / 2);
 
     /*Create magnitude dat file*/
-    create_dat_file(test_abs_path, "dat/dft/dft_ecg_output_phase.dat", 
+    create_sig_file(test_abs_path, "dat/dft/dft_ecg_output_phase.dsig", 
                     dft_ecg_output_phase, ECG_SIGNAL_SIZE / 2);
 
     printf("\n");
@@ -296,19 +404,19 @@ int main(void)
             cdft_sig_output_rex, cdft_sig_output_imx, SIG_20HZ_REX_SIZE);
     
     /*Create cdft input rex dat file*/
-    create_dat_file(test_abs_path, "dat/cdft/cdft_sig_input_rex.dat", 
+    create_sig_file(test_abs_path, "dat/cdft/cdft_sig_input_rex.dsig", 
                     sig_20Hz_rex, SIG_20HZ_REX_SIZE);
 
     /*create cdft input imx dat file*/
-    create_dat_file(test_abs_path, "dat/cdft/cdft_sig_input_imx.dat", 
+    create_sig_file(test_abs_path, "dat/cdft/cdft_sig_input_imx.dsig", 
                     sig_20Hz_imx, SIG_20HZ_IMX_SIZE);
 
     /*create cdft output rex file*/
-    create_dat_file(test_abs_path, "dat/cdft/cdft_sig_output_rex.dat", 
+    create_sig_file(test_abs_path, "dat/cdft/cdft_sig_output_rex.dsig", 
                     cdft_sig_output_rex, SIG_20HZ_REX_SIZE);
 
     /*create cdft output imx file*/
-    create_dat_file(test_abs_path, "dat/cdft/cdft_sig_output_imx.dat", 
+    create_sig_file(test_abs_path, "dat/cdft/cdft_sig_output_imx.dsig", 
                     cdft_sig_output_imx, SIG_20HZ_IMX_SIZE);
 
     printf("\n");
@@ -342,17 +450,17 @@ int main(void)
 
 
     /*Create convolution input signal dat file*/
-    create_dat_file(test_abs_path, "dat/filter/lp_input_signal.dat", 
+    create_sig_file(test_abs_path, "dat/filter/lp_input_signal.dsig", 
                     (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
 
 
     /*Create low pass filter dat file*/
-    create_dat_file(test_abs_path, "dat/filter/lp_win_sinc_filter.dat", 
+    create_sig_file(test_abs_path, "dat/filter/lp_win_sinc_filter.dsig", 
                     lp_filter, IMPULSE_RESP_SIZE);
 
 
     /*Create convolution output signal */
-    create_dat_file(test_abs_path, "dat/filter/lp_conv_output.dat", 
+    create_sig_file(test_abs_path, "dat/filter/lp_conv_output.dsig", 
                     filter_conv_output, IMPULSE_RESP_SIZE + INP_SIG_F32_1K_15K_SIZE);
 
     /////////////////////////////////////
@@ -372,17 +480,17 @@ int main(void)
 
 
     /*Create convolution input signal dat file*/
-    create_dat_file(test_abs_path, "dat/filter/hp_input_signal.dat", 
+    create_sig_file(test_abs_path, "dat/filter/hp_input_signal.dsig", 
                     (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
 
 
     /*Create high pass filter dat file*/
-    create_dat_file(test_abs_path, "dat/filter/hp_win_sinc_filter.dat", 
+    create_sig_file(test_abs_path, "dat/filter/hp_win_sinc_filter.dsig", 
                     hp_filter, IMPULSE_RESP_SIZE);
 
 
     /*Create convolution output signal */
-    create_dat_file(test_abs_path, "dat/filter/hp_conv_output.dat", 
+    create_sig_file(test_abs_path, "dat/filter/hp_conv_output.dsig", 
                     filter_conv_output, IMPULSE_RESP_SIZE + INP_SIG_F32_1K_15K_SIZE);
 
     /////////////////////////////////////
@@ -401,20 +509,51 @@ int main(void)
                     bp_filter, IMPULSE_RESP_SIZE);
 
     /*Create convolution input signal dat file*/
-    create_dat_file(test_abs_path, "dat/filter/bp_input_signal.dat", 
+    create_sig_file(test_abs_path, "dat/filter/bp_input_signal.dsig", 
                     (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
 
 
     /*Create band pass filter dat file*/
-    create_dat_file(test_abs_path, "dat/filter/bp_win_sinc_filter.dat", 
+    create_sig_file(test_abs_path, "dat/filter/bp_win_sinc_filter.dsig", 
                     bp_filter, IMPULSE_RESP_SIZE);
 
 
     /*Create convolution output signal */
-    create_dat_file(test_abs_path, "dat/filter/bp_conv_output.dat", 
+    create_sig_file(test_abs_path, "dat/filter/bp_conv_output.dsig", 
                     filter_conv_output, IMPULSE_RESP_SIZE + INP_SIG_F32_1K_15K_SIZE);
 
 
+    /////////////////////////////////////
+    printf("\n");
+    printf("Kaiser low-pass filter test:\n");
+    /*Length and beta for 1 kHz passband, 10 kHz stopband edge with 60 dB attenuation*/
+    dsp_val_t kaiser_beta;
+    dsp_size_t kaiser_len = dsp_kaiser_filter_len(48.0, 1.0, 10.0, 60.0, &kaiser_beta);
+    printf("filter len:    %lu\n", kaiser_len);
+    printf("beta:          %lf\n", kaiser_beta);
+
+    /*Allocate Kaiser filter memory*/
+    dsp_val_t *kaiser_filter = (dsp_val_t *) calloc(kaiser_len, sizeof(dsp_val_t));
+    check_mem_alloc(kaiser_filter);
+
+    /*Create Kaiser low-pass filter*/
+    dsp_kaiser_win_sinc_filter(kaiser_filter, kaiser_len, 48.0, 1.0, 10.0, 60.0);
+
+    /*Create convolution with Kaiser filter*/
+    dsp_convolution(filter_conv_output, 
+                    (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE, 
+                    kaiser_filter, kaiser_len);
+
+    /*Create Kaiser filter dat file*/
+    create_sig_file(test_abs_path, "dat/filter/kaiser_win_sinc_filter.dsig", 
+                    kaiser_filter, kaiser_len);
+
+    /*Create convolution output signal */
+    create_sig_file(test_abs_path, "dat/filter/kaiser_conv_output.dsig", 
+                    filter_conv_output, kaiser_len + INP_SIG_F32_1K_15K_SIZE);
+
+    free(kaiser_filter);
+
     /*Free memories*/
     free(lp_filter);
     free(hp_filter);
@@ -423,41 +562,1483 @@ int main(void)
     printf("\n");
 #endif
 
+
+//////////////////////////////////////////////////////////////////////////////
+#if TEST_FIR
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing prepared FIR filter
+ * test signal: InputSignal_f32_1kHz_15kHz
+ * 1. Create low-pass filter kernel
+ * 2. Apply it with direct convolution (reference)
+ * 3. Apply it with prepared filter in frequency domain, compare with the reference
+ */
+    printf("Prepared FIR filter test\n");
+    printf("------------------------\n");
+
+    dsp_val_t *fir_kernel = (dsp_val_t *) calloc(IMPULSE_RESP_SIZE, sizeof(dsp_val_t));
+    check_mem_alloc(fir_kernel);
+
+    dsp_val_t *fir_ref_output = (dsp_val_t *) calloc(IMPULSE_RESP_SIZE + INP_SIG_F32_1K_15K_SIZE, sizeof(dsp_val_t));
+    check_mem_alloc(fir_ref_output);
+
+    dsp_val_t *fir_output = (dsp_val_t *) calloc(IMPULSE_RESP_SIZE + INP_SIG_F32_1K_15K_SIZE, sizeof(dsp_val_t));
+    check_mem_alloc(fir_output);
+
+    dsp_lp_win_sinc_filter(fir_kernel, 48.0, 10.0, NULL, IMPULSE_RESP_SIZE);
+
+    /*Reference*/
+    dsp_convolution(fir_ref_output, (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE, 
+                    fir_kernel, IMPULSE_RESP_SIZE);
+
+    /*Frequency domain application*/
+    dsp_fir_t *fir = dsp_fir_create(fir_kernel, IMPULSE_RESP_SIZE, 64, DSP_FIR_PATH_FREQ);
+    check_mem_alloc(fir);
+
+    dsp_fir_apply(fir, fir_output, (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
+
+    dsp_val_t fir_max_err = 0.0;
+    dsp_size_t fir_i;
+    for(fir_i = 0; fir_i < IMPULSE_RESP_SIZE + INP_SIG_F32_1K_15K_SIZE; fir_i++) {
+        if(fabs(*(fir_output + fir_i) - *(fir_ref_output + fir_i)) > fir_max_err) {
+            fir_max_err = fabs(*(fir_output + fir_i) - *(fir_ref_output + fir_i));
+        }
+    }
+
+    printf("FFT length:    %lu\n", fir->plan->len);
+    printf("block length:  %lu\n", fir->block_len);
+    printf("max error:     %e\n", fir_max_err);
+    dsp_fir_destroy(fir);
+
+    /*Automatic path selection*/
+    fir = dsp_fir_create(fir_kernel, IMPULSE_RESP_SIZE, INP_SIG_F32_1K_15K_SIZE, DSP_FIR_PATH_AUTO);
+    check_mem_alloc(fir);
+    printf("auto path:     %s\n", (fir->path == DSP_FIR_PATH_FREQ) ? "frequency domain" : "time domain");
+    dsp_fir_destroy(fir);
+
+    /*Create prepared filter output signal*/
+    create_sig_file(test_abs_path, "dat/filter/fir_output.dsig", 
+                    fir_output, IMPULSE_RESP_SIZE + INP_SIG_F32_1K_15K_SIZE);
+
+    free(fir_kernel);
+    free(fir_ref_output);
+    free(fir_output);
+    printf("\n");
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////////
+#if TEST_CHANNELIZER
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing polyphase channelizer
+ * test signal: InputSignal_f32_1kHz_15kHz, sample frequency 48 kHz
+ * 16 channels, 3 kHz channel spacing:
+ * 1 kHz component is in channel 0, 15 kHz component is in channel 5
+ * Channel power is averaged over all output frames
+ */
+    printf("Polyphase channelizer test\n");
+    printf("--------------------------\n");
+
+#define CHANNELIZER_CHANNELS    (16UL)
+#define CHANNELIZER_DECIMATION  (8UL)
+
+    dsp_channelizer_t *ch = dsp_channelizer_create(CHANNELIZER_CHANNELS, CHANNELIZER_DECIMATION, 8, NULL);
+    check_mem_alloc(ch);
+
+    dsp_size_t ch_max_frames = INP_SIG_F32_1K_15K_SIZE / CHANNELIZER_DECIMATION + 1;
+
+    dsp_val_t *ch_output_rex = (dsp_val_t *) calloc(ch_max_frames * CHANNELIZER_CHANNELS, sizeof(dsp_val_t));
+    check_mem_alloc(ch_output_rex);
+
+    dsp_val_t *ch_output_imx = (dsp_val_t *) calloc(ch_max_frames * CHANNELIZER_CHANNELS, sizeof(dsp_val_t));
+    check_mem_alloc(ch_output_imx);
+
+    dsp_val_t *ch_power = (dsp_val_t *) calloc(CHANNELIZER_CHANNELS, sizeof(dsp_val_t));
+    check_mem_alloc(ch_power);
+
+    dsp_size_t ch_frames = dsp_channelizer_process(ch, ch_output_rex, ch_output_imx, 
+                                                   (dsp_val_t *)InputSignal_f32_1kHz_15kHz, INP_SIG_F32_1K_15K_SIZE);
+
+    dsp_size_t ch_f, ch_k;
+    for(ch_f = 0; ch_f < ch_frames; ch_f++) {
+        for(ch_k = 0; ch_k < CHANNELIZER_CHANNELS; ch_k++) {
+            *(ch_power + ch_k) += pow(*(ch_output_rex + ch_f * CHANNELIZER_CHANNELS + ch_k), 2) + 
+                                  pow(*(ch_output_imx + ch_f * CHANNELIZER_CHANNELS + ch_k), 2);
+        }
+    }
+
+    printf("output frames: %lu\n", ch_frames);
+    for(ch_k = 0; ch_k < CHANNELIZER_CHANNELS; ch_k++) {
+        *(ch_power + ch_k) /= (dsp_val_t)ch_frames;
+        printf("channel %2lu:    %lf\n", ch_k, *(ch_power + ch_k));
+    }
+
+    /*Create channel power dat file*/
+    create_sig_file(test_abs_path, "dat/channelizer/channel_power.dsig", 
+                    ch_power, CHANNELIZER_CHANNELS);
+
+    dsp_channelizer_destroy(ch);
+    free(ch_output_rex);
+    free(ch_output_imx);
+    free(ch_power);
+    printf("\n");
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////////
+#if TEST_FIXED_POINT
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing fixed-point calculations against the double reference
+ * test signal: InputSignal_f32_1kHz_15kHz scaled by 0.5 into the Q15/Q31 range
+ * 1. Low-pass filter convolution, Q15 and Q31
+ * 2. DFT magnitude, Q15 and Q31
+ * 3. Mean and variance, Q15 and Q31
+ * Error bounds are in LSB of the output format, scaled by the coefficient shift for the convolution
+ */
+    printf("Fixed-point test\n");
+    printf("----------------\n");
+
+    dsp_size_t fx_i, fx_len = INP_SIG_F32_1K_15K_SIZE;
+    dsp_size_t fx_conv_len = INP_SIG_F32_1K_15K_SIZE + IMPULSE_RESP_SIZE;
+    dsp_val_t fx_err, fx_bound;
+    int fx_shift;
+
+    dsp_val_t *fx_sig = (dsp_val_t *) calloc(fx_conv_len, sizeof(dsp_val_t));
+    dsp_val_t *fx_kernel = (dsp_val_t *) calloc(IMPULSE_RESP_SIZE, sizeof(dsp_val_t));
+    dsp_val_t *fx_ref = (dsp_val_t *) calloc(fx_conv_len, sizeof(dsp_val_t));
+    dsp_val_t *fx_out = (dsp_val_t *) calloc(fx_conv_len, sizeof(dsp_val_t));
+    dsp_q15_t *q15_sig = (dsp_q15_t *) calloc(fx_conv_len, sizeof(dsp_q15_t));
+    dsp_q15_t *q15_kernel = (dsp_q15_t *) calloc(IMPULSE_RESP_SIZE, sizeof(dsp_q15_t));
+    dsp_q15_t *q15_out = (dsp_q15_t *) calloc(fx_conv_len, sizeof(dsp_q15_t));
+    dsp_q31_t *q31_sig = (dsp_q31_t *) calloc(fx_conv_len, sizeof(dsp_q31_t));
+    dsp_q31_t *q31_kernel = (dsp_q31_t *) calloc(IMPULSE_RESP_SIZE, sizeof(dsp_q31_t));
+    dsp_q31_t *q31_out = (dsp_q31_t *) calloc(fx_conv_len, sizeof(dsp_q31_t));
+    check_mem_alloc(fx_sig);
+    check_mem_alloc(fx_kernel);
+    check_mem_alloc(fx_ref);
+    check_mem_alloc(fx_out);
+    check_mem_alloc(q15_sig);
+    check_mem_alloc(q15_kernel);
+    check_mem_alloc(q15_out);
+    check_mem_alloc(q31_sig);
+    check_mem_alloc(q31_kernel);
+    check_mem_alloc(q31_out);
+
+    /*scaled input signal and normalized low-pass kernel*/
+    for(fx_i = 0; fx_i < fx_len; fx_i++) {
+        *(fx_sig + fx_i) = 0.5 * InputSignal_f32_1kHz_15kHz[fx_i];
+    }
+    dsp_lp_win_sinc_filter(fx_kernel, 48.0, 10.0, NULL, IMPULSE_RESP_SIZE);
+    dsp_val_t fx_gain = 0.0;
+    for(fx_i = 0; fx_i < IMPULSE_RESP_SIZE; fx_gain += *(fx_kernel + fx_i), fx_i++);
+    for(fx_i = 0; fx_i < IMPULSE_RESP_SIZE; *(fx_kernel + fx_i) /= fx_gain, fx_i++);
+
+    dsp_convolution(fx_ref, fx_sig, fx_len, fx_kernel, IMPULSE_RESP_SIZE);
+
+    /*Q15 convolution, bound: rounding of input, coefficients and output*/
+    dsp_quantize_q15(q15_sig, fx_sig, fx_len);
+    fx_shift = dsp_filter_quantize_q15(q15_kernel, fx_kernel, IMPULSE_RESP_SIZE);
+    dsp_convolution_q15(q15_out, q15_sig, fx_len, q15_kernel, IMPULSE_RESP_SIZE, fx_shift);
+    dsp_dequantize_q15(fx_out, q15_out, fx_conv_len);
+    fx_err = max_abs_error(fx_out, fx_ref, fx_conv_len);
+    fx_bound = (IMPULSE_RESP_SIZE * (1 << fx_shift) + 2.0) / 32768.0;
+    printf("Q15 convolution max error:  %e (bound %e) %s\n", fx_err, fx_bound, (fx_err <= fx_bound) ? "OK" : "FAILED");
+
+    /*Q31 convolution*/
+    dsp_quantize_q31(q31_sig, fx_sig, fx_len);
+    fx_shift = dsp_filter_quantize_q31(q31_kernel, fx_kernel, IMPULSE_RESP_SIZE);
+    dsp_convolution_q31(q31_out, q31_sig, fx_len, q31_kernel, IMPULSE_RESP_SIZE, fx_shift);
+    dsp_dequantize_q31(fx_out, q31_out, fx_conv_len);
+    fx_err = max_abs_error(fx_out, fx_ref, fx_conv_len);
+    fx_bound = (IMPULSE_RESP_SIZE * (2 << fx_shift) + 2.0) / 2147483648.0;
+    printf("Q31 convolution max error:  %e (bound %e) %s\n", fx_err, fx_bound, (fx_err <= fx_bound) ? "OK" : "FAILED");
+
+    /*Q15 and Q31 magnitude, input and output rounding*/
+    dsp_val_t *fx_imx = fx_sig + fx_len / 2;
+    dsp_dft_magnitude(fx_ref, fx_sig, fx_imx, fx_len / 2);
+
+    dsp_dft_magnitude_q15(q15_out, q15_sig, q15_sig + fx_len / 2, fx_len / 2);
+    dsp_dequantize_q15(fx_out, q15_out, fx_len / 2);
+    fx_err = max_abs_error(fx_out, fx_ref, fx_len / 2);
+    fx_bound = 2.0 / 32768.0;
+    printf("Q15 magnitude max error:    %e (bound %e) %s\n", fx_err, fx_bound, (fx_err <= fx_bound) ? "OK" : "FAILED");
+
+    dsp_dft_magnitude_q31(q31_out, q31_sig, q31_sig + fx_len / 2, fx_len / 2);
+    dsp_dequantize_q31(fx_out, q31_out, fx_len / 2);
+    fx_err = max_abs_error(fx_out, fx_ref, fx_len / 2);
+    fx_bound = 2.0 / 2147483648.0;
+    printf("Q31 magnitude max error:    %e (bound %e) %s\n", fx_err, fx_bound, (fx_err <= fx_bound) ? "OK" : "FAILED");
+
+    /*Mean and variance*/
+    dsp_val_t fx_mean = dsp_sig_mean(fx_sig, fx_len);
+    dsp_val_t fx_variance = dsp_sig_variance(fx_sig, fx_mean, fx_len);
+
+    dsp_q15_t q15_mean = dsp_sig_mean_q15(q15_sig, fx_len);
+    dsp_q31_t q15_variance = dsp_sig_variance_q15(q15_sig, q15_mean, fx_len);
+    printf("Q15 mean error:             %e\n", fabs(q15_mean / 32768.0 - fx_mean));
+    printf("Q15 variance error:         %e\n", fabs(q15_variance / 2147483648.0 - fx_variance));
+
+    dsp_q31_t q31_mean = dsp_sig_mean_q31(q31_sig, fx_len);
+    dsp_q31_t q31_variance = dsp_sig_variance_q31(q31_sig, q31_mean, fx_len);
+    printf("Q31 mean error:             %e\n", fabs(q31_mean / 2147483648.0 - fx_mean));
+    printf("Q31 variance error:         %e\n", fabs(q31_variance / 2147483648.0 - fx_variance));
+
+    /*Empty inputs: zero output, no access out of the arrays*/
+    q15_out[0] = q15_out[1] = 1;
+    q31_out[0] = q31_out[1] = 1;
+    dsp_convolution_q15(q15_out, q15_sig, 2, q15_kernel, 0, 0);
+    dsp_convolution_q31(q31_out, q31_sig, 0, q31_kernel, 0, 0);
+    dsp_convolution_q31(q31_out, q31_sig, 0, q31_kernel, 2, 0);
+    printf("empty inputs:               %s\n",
+           (q15_out[0] == 0 && q15_out[1] == 0 && q31_out[0] == 0 && q31_out[1] == 0 &&
+            dsp_sig_mean_q15(q15_sig, 0) == 0 && dsp_sig_mean_q31(q31_sig, 0) == 0) ? "OK" : "FAILED");
+
+    /*Non-finite coefficients are rejected*/
+    fx_kernel[1] = INFINITY;
+    fx_shift = dsp_filter_quantize_q15(q15_kernel, fx_kernel, IMPULSE_RESP_SIZE);
+    fx_kernel[1] = NAN;
+    printf("non-finite coefficients:    %s\n",
+           (fx_shift == -1 && dsp_filter_quantize_q31(q31_kernel, fx_kernel, IMPULSE_RESP_SIZE) == -1) ? "rejected" : "FAILED");
+
+    free(fx_sig);
+    free(fx_kernel);
+    free(fx_ref);
+    free(fx_out);
+    free(q15_sig);
+    free(q15_kernel);
+    free(q15_out);
+    free(q31_sig);
+    free(q31_kernel);
+    free(q31_out);
+    printf("\n");
+#endif
+
+
+#if TEST_PRECISION
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing single precision functions against the double precision variants
+ * test signal: InputSignal_f32_1kHz_15kHz
+ * 1. Mean and variance
+ * 2. Low-pass filter convolution
+ * 3. DFT magnitude and FFT
+ * Error bound: relative to the output peak, a few float epsilon times the log2 of the summation length
+ */
+    printf("Precision test\n");
+    printf("--------------\n");
+
+    dsp_size_t pr_i, pr_len = INP_SIG_F32_1K_15K_SIZE;
+    dsp_size_t pr_conv_len = INP_SIG_F32_1K_15K_SIZE + IMPULSE_RESP_SIZE;
+    dsp_size_t pr_fft_len = dsp_fft_next_pow2(pr_len);
+    dsp_size_t pr_buf_len = pr_fft_len + IMPULSE_RESP_SIZE;
+    dsp_val_t pr_err, pr_peak;
+
+    dsp_f64_t *pr_sig64 = (dsp_f64_t *) calloc(pr_buf_len, sizeof(dsp_f64_t));
+    dsp_f64_t *pr_kernel64 = (dsp_f64_t *) calloc(IMPULSE_RESP_SIZE, sizeof(dsp_f64_t));
+    dsp_f64_t *pr_out64 = (dsp_f64_t *) calloc(pr_buf_len, sizeof(dsp_f64_t));
+    dsp_f64_t *pr_imx64 = (dsp_f64_t *) calloc(pr_buf_len, sizeof(dsp_f64_t));
+    dsp_f32_t *pr_sig32 = (dsp_f32_t *) calloc(pr_buf_len, sizeof(dsp_f32_t));
+    dsp_f32_t *pr_kernel32 = (dsp_f32_t *) calloc(IMPULSE_RESP_SIZE, sizeof(dsp_f32_t));
+    dsp_f32_t *pr_out32 = (dsp_f32_t *) calloc(pr_buf_len, sizeof(dsp_f32_t));
+    dsp_f32_t *pr_imx32 = (dsp_f32_t *) calloc(pr_buf_len, sizeof(dsp_f32_t));
+    dsp_val_t *pr_cmp = (dsp_val_t *) calloc(pr_buf_len, sizeof(dsp_val_t));
+    dsp_val_t *pr_zero = (dsp_val_t *) calloc(pr_buf_len, sizeof(dsp_val_t));
+    check_mem_alloc(pr_sig64);
+    check_mem_alloc(pr_kernel64);
+    check_mem_alloc(pr_out64);
+    check_mem_alloc(pr_imx64);
+    check_mem_alloc(pr_sig32);
+    check_mem_alloc(pr_kernel32);
+    check_mem_alloc(pr_out32);
+    check_mem_alloc(pr_imx32);
+    check_mem_alloc(pr_cmp);
+    check_mem_alloc(pr_zero);
+
+    for(pr_i = 0; pr_i < pr_len; pr_i++) {
+        *(pr_sig64 + pr_i) = InputSignal_f32_1kHz_15kHz[pr_i];
+        *(pr_sig32 + pr_i) = (dsp_f32_t)InputSignal_f32_1kHz_15kHz[pr_i];
+    }
+
+    /*Mean and variance*/
+    dsp_f64_t pr_mean64 = dsp_sig_mean_f64(pr_sig64, pr_len);
+    dsp_f32_t pr_mean32 = dsp_sig_mean_f32(pr_sig32, pr_len);
+    dsp_f64_t pr_var64 = dsp_sig_variance_f64(pr_sig64, pr_mean64, pr_len);
+    dsp_f32_t pr_var32 = dsp_sig_variance_f32(pr_sig32, pr_mean32, pr_len);
+    printf("f32 mean error:              %e\n", fabs(pr_mean32 - pr_mean64));
+    printf("f32 variance error:          %e\n", fabs(pr_var32 - pr_var64));
+
+    /*Convolution*/
+    dsp_lp_win_sinc_filter_f64(pr_kernel64, 48.0, 10.0, NULL, IMPULSE_RESP_SIZE);
+    dsp_lp_win_sinc_filter_f32(pr_kernel32, 48.0f, 10.0f, NULL, IMPULSE_RESP_SIZE);
+    dsp_convolution_f64(pr_out64, pr_sig64, pr_len, pr_kernel64, IMPULSE_RESP_SIZE);
+    dsp_convolution_f32(pr_out32, pr_sig32, pr_len, pr_kernel32, IMPULSE_RESP_SIZE);
+    for(pr_i = 0; pr_i < pr_conv_len; *(pr_cmp + pr_i) = *(pr_out32 + pr_i), pr_i++);
+    pr_err = max_abs_error(pr_cmp, pr_out64, pr_conv_len);
+    pr_peak = max_abs_error(pr_out64, pr_zero, pr_conv_len);
+    printf("f32 convolution rel error:   %e %s\n", pr_err / pr_peak, (pr_err / pr_peak < 1e-5) ? "OK" : "FAILED");
+
+    /*DFT magnitude*/
+    dsp_dft_f64(pr_sig64, pr_out64, pr_imx64, pr_len);
+    dsp_dft_magnitude_f64(pr_out64, pr_out64, pr_imx64, pr_len / 2);
+    dsp_dft_f32(pr_sig32, pr_out32, pr_imx32, pr_len);
+    dsp_dft_magnitude_f32(pr_out32, pr_out32, pr_imx32, pr_len / 2);
+    for(pr_i = 0; pr_i < pr_len / 2; *(pr_cmp + pr_i) = *(pr_out32 + pr_i), pr_i++);
+    pr_err = max_abs_error(pr_cmp, pr_out64, pr_len / 2);
+    pr_peak = max_abs_error(pr_out64, pr_zero, pr_len / 2);
+    printf("f32 DFT magnitude rel error: %e %s\n", pr_err / pr_peak, (pr_err / pr_peak < 1e-5) ? "OK" : "FAILED");
+
+    /*Large DFT, the twiddle phase is reduced in integer, so the error does not grow with the phase*/
+    dsp_size_t pr_big = 4096;
+    dsp_f64_t *pr_big64 = (dsp_f64_t *) calloc(4 * pr_big, sizeof(dsp_f64_t));
+    dsp_f32_t *pr_big32 = (dsp_f32_t *) calloc(4 * pr_big, sizeof(dsp_f32_t));
+    dsp_val_t *pr_big_cmp = (dsp_val_t *) calloc(2 * pr_big, sizeof(dsp_val_t));
+    check_mem_alloc(pr_big64);
+    check_mem_alloc(pr_big32);
+    check_mem_alloc(pr_big_cmp);
+    for(pr_i = 0; pr_i < 2 * pr_big; pr_i++) {
+        *(pr_big64 + pr_i) = sin(2.0 * M_PI * 37.3 * pr_i / pr_big) + 0.5 * cos(2.0 * M_PI * 1500.7 * pr_i / pr_big);
+        *(pr_big32 + pr_i) = (dsp_f32_t)*(pr_big64 + pr_i);
+    }
+    dsp_dft_f64(pr_big64, pr_big64 + 2 * pr_big, pr_big64 + 3 * pr_big, pr_big);
+    dsp_dft_f32(pr_big32, pr_big32 + 2 * pr_big, pr_big32 + 3 * pr_big, pr_big);
+    for(pr_i = 0; pr_i < pr_big / 2; pr_i++) {
+        *(pr_big_cmp + pr_i) = *(pr_big32 + 2 * pr_big + pr_i);
+        *(pr_big_cmp + pr_big / 2 + pr_i) = *(pr_big32 + 3 * pr_big + pr_i);
+    }
+    memcpy(pr_big64 + 2 * pr_big + pr_big / 2, pr_big64 + 3 * pr_big, pr_big / 2 * sizeof(dsp_f64_t));
+    pr_err = max_abs_error(pr_big_cmp, pr_big64 + 2 * pr_big, pr_big);
+    printf("f32 DFT N=%lu max error:   %e %s\n", pr_big, pr_err, (pr_err < 1e-2) ? "OK" : "FAILED");
+
+    dsp_cdft_f64(pr_big64, pr_big64 + pr_big, pr_big64 + 2 * pr_big, pr_big64 + 3 * pr_big, pr_big);
+    dsp_cdft_f32(pr_big32, pr_big32 + pr_big, pr_big32 + 2 * pr_big, pr_big32 + 3 * pr_big, pr_big);
+    for(pr_i = 0; pr_i < 2 * pr_big; *(pr_big_cmp + pr_i) = *(pr_big32 + 2 * pr_big + pr_i), pr_i++);
+    pr_err = max_abs_error(pr_big_cmp, pr_big64 + 2 * pr_big, 2 * pr_big);
+    printf("f32 CDFT N=%lu max error:  %e %s\n", pr_big, pr_err, (pr_err < 1e-2) ? "OK" : "FAILED");
+    free(pr_big64);
+    free(pr_big32);
+    free(pr_big_cmp);
+
+    /*FFT, real part*/
+    dsp_fft_plan_f64_t *pr_plan64 = dsp_fft_plan_create_f64(pr_fft_len);
+    dsp_fft_plan_f32_t *pr_plan32 = dsp_fft_plan_create_f32(pr_fft_len);
+    check_mem_alloc(pr_plan64);
+    check_mem_alloc(pr_plan32);
+    memset(pr_imx64, 0, pr_fft_len * sizeof(dsp_f64_t));
+    memset(pr_imx32, 0, pr_fft_len * sizeof(dsp_f32_t));
+    dsp_fft_f64(pr_plan64, pr_sig64, pr_imx64);
+    dsp_fft_f32(pr_plan32, pr_sig32, pr_imx32);
+    for(pr_i = 0; pr_i < pr_fft_len; *(pr_cmp + pr_i) = *(pr_sig32 + pr_i), pr_i++);
+    pr_err = max_abs_error(pr_cmp, pr_sig64, pr_fft_len);
+    pr_peak = max_abs_error(pr_sig64, pr_zero, pr_fft_len);
+    printf("f32 FFT rel error:           %e %s\n", pr_err / pr_peak, (pr_err / pr_peak < 1e-5) ? "OK" : "FAILED");
+
+    dsp_fft_plan_destroy_f64(pr_plan64);
+    dsp_fft_plan_destroy_f32(pr_plan32);
+    free(pr_sig64);
+    free(pr_kernel64);
+    free(pr_out64);
+    free(pr_imx64);
+    free(pr_sig32);
+    free(pr_kernel32);
+    free(pr_out32);
+    free(pr_imx32);
+    free(pr_cmp);
+    free(pr_zero);
+    printf("\n");
+#endif
+
+
+#if TEST_ROLLING
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing rolling window statistic
+ * test signal: ECG_signal
+ * 1. Rolling mean, variance, min and max with 50 samples window
+ * 2. Compare every sample with the statistic of the window (dsp_sig_stats)
+ */
+    printf("Rolling statistic test\n");
+    printf("----------------------\n");
+
+    dsp_size_t rl_i, rl_n, rl_win = 50;
+    dsp_val_t rl_err_mean = 0.0, rl_err_var = 0.0, rl_err_minmax = 0.0;
+    dsp_sig_stats_t rl_ref;
+
+    dsp_val_t *rl_mean = (dsp_val_t *) calloc(ECG_SIGNAL_SIZE, sizeof(dsp_val_t));
+    dsp_val_t *rl_var = (dsp_val_t *) calloc(ECG_SIGNAL_SIZE, sizeof(dsp_val_t));
+    dsp_val_t *rl_min = (dsp_val_t *) calloc(ECG_SIGNAL_SIZE, sizeof(dsp_val_t));
+    dsp_val_t *rl_max = (dsp_val_t *) calloc(ECG_SIGNAL_SIZE, sizeof(dsp_val_t));
+    check_mem_alloc(rl_mean);
+    check_mem_alloc(rl_var);
+    check_mem_alloc(rl_min);
+    check_mem_alloc(rl_max);
+
+    dsp_rolling_t *rolling = dsp_rolling_create(rl_win, 0);
+    check_mem_alloc(rolling);
+
+    dsp_rolling_process(rolling, rl_mean, rl_var, rl_min, rl_max, (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE);
+
+    for(rl_i = 0; rl_i < ECG_SIGNAL_SIZE; rl_i++) {
+        rl_n = (rl_i + 1 < rl_win) ? rl_i + 1 : rl_win;
+        dsp_sig_stats((dsp_val_t *)ECG_signal + rl_i + 1 - rl_n, rl_n, &rl_ref);
+        rl_err_mean = fmax(rl_err_mean, fabs(*(rl_mean + rl_i) - rl_ref.mean));
+        rl_err_var = fmax(rl_err_var, fabs(*(rl_var + rl_i) - rl_ref.variance));
+        rl_err_minmax = fmax(rl_err_minmax, fabs(*(rl_min + rl_i) - rl_ref.min));
+        rl_err_minmax = fmax(rl_err_minmax, fabs(*(rl_max + rl_i) - rl_ref.max));
+    }
+
+    printf("window length:      %lu\n", rl_win);
+    printf("mean max error:     %e\n", rl_err_mean);
+    printf("variance max error: %e\n", rl_err_var);
+    printf("min/max max error:  %e\n", rl_err_minmax);
+    dsp_rolling_destroy(rolling);
+
+    create_sig_file(test_abs_path, "dat/rolling/rolling_input.dsig", (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE);
+    create_sig_file(test_abs_path, "dat/rolling/rolling_mean.dsig", rl_mean, ECG_SIGNAL_SIZE);
+    create_sig_file(test_abs_path, "dat/rolling/rolling_min.dsig", rl_min, ECG_SIGNAL_SIZE);
+    create_sig_file(test_abs_path, "dat/rolling/rolling_max.dsig", rl_max, ECG_SIGNAL_SIZE);
+
+    free(rl_mean);
+    free(rl_var);
+    free(rl_min);
+    free(rl_max);
+    printf("\n");
+#endif
+
+
+#if TEST_QUANTILE
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing streaming quantile estimation and histogram
+ * test signal: ECG_signal repeated with pseudo random noise, 200000 samples
+ * 1. t-digest of 4 blocks, merged
+ * 2. Histogram with 200 bins, 4 blocks merged
+ * 3. Compare p1, p50 and p99 with the quantiles of the sorted signal
+ * Error bound: 1% of the signal range
+ */
+    printf("Quantile test\n");
+    printf("-------------\n");
+
+    dsp_size_t qt_i, qt_len = 200000, qt_blk = qt_len / 4, qt_bins[4][200];
+    unsigned long qt_seed = 12345;
+    dsp_val_t qt_q[3] = {0.01, 0.5, 0.99}, qt_exact[3], qt_td[3], qt_hs[3];
+
+    dsp_val_t *qt_sig = (dsp_val_t *) malloc(qt_len * sizeof(dsp_val_t));
+    dsp_val_t *qt_sorted = (dsp_val_t *) malloc(qt_len * sizeof(dsp_val_t));
+    dsp_quantile_acc_t *qt_acc = (dsp_quantile_acc_t *) malloc(4 * sizeof(dsp_quantile_acc_t));
+    dsp_hist_t qt_hist[4];
+    check_mem_alloc(qt_sig);
+    check_mem_alloc(qt_sorted);
+    check_mem_alloc(qt_acc);
+
+    for(qt_i = 0; qt_i < qt_len; qt_i++) {
+        qt_seed = qt_seed * 1103515245UL + 12345UL;
+        *(qt_sig + qt_i) = ECG_signal[qt_i % ECG_SIGNAL_SIZE] + 0.2 * ((dsp_val_t)((qt_seed >> 16) & 0x7FFF) / 32768.0 - 0.5);
+    }
+    memcpy(qt_sorted, qt_sig, qt_len * sizeof(dsp_val_t));
+    qsort(qt_sorted, qt_len, sizeof(dsp_val_t), compare_val);
+    dsp_val_t qt_range = *(qt_sorted + qt_len - 1) - *qt_sorted;
+
+    /*every block has own accumulator and histogram, like parallel workers*/
+    for(qt_i = 0; qt_i < 4; qt_i++) {
+        dsp_quantile_acc_init(qt_acc + qt_i, 0.0);
+        dsp_quantile_acc_update(qt_acc + qt_i, qt_sig + qt_i * qt_blk, qt_blk);
+        dsp_hist_init(qt_hist + qt_i, qt_bins[qt_i], 200, *qt_sorted, *(qt_sorted + qt_len - 1) + 1e-9);
+        dsp_hist_update(qt_hist + qt_i, qt_sig + qt_i * qt_blk, qt_blk);
+    }
+    for(qt_i = 1; qt_i < 4; qt_i++) {
+        dsp_quantile_acc_merge(qt_acc, qt_acc + qt_i);
+        dsp_hist_merge(qt_hist, qt_hist + qt_i);
+    }
+    dsp_quantile_acc_finalize(qt_acc, qt_q, qt_td, 3);
+    dsp_hist_finalize(qt_hist, qt_q, qt_hs, 3);
+
+    printf("centroids:     %lu\n", qt_acc->n_centroids);
+    for(qt_i = 0; qt_i < 3; qt_i++) {
+        qt_exact[qt_i] = *(qt_sorted + (dsp_size_t)(qt_q[qt_i] * (qt_len - 1)));
+        printf("p%-3.0lf exact: %lf, t-digest: %lf %s, histogram: %lf %s\n", 100.0 * qt_q[qt_i], qt_exact[qt_i],
+               qt_td[qt_i], (fabs(qt_td[qt_i] - qt_exact[qt_i]) <= 0.01 * qt_range) ? "OK" : "FAILED",
+               qt_hs[qt_i], (fabs(qt_hs[qt_i] - qt_exact[qt_i]) <= 0.01 * qt_range) ? "OK" : "FAILED");
+    }
+
+    /*Create histogram output*/
+    for(qt_i = 0; qt_i < 200; qt_i++) {
+        *(qt_sorted + qt_i) = (dsp_val_t)qt_bins[0][qt_i];
+    }
+    create_sig_file(test_abs_path, "dat/quantile/histogram.dsig", qt_sorted, 200);
+
+    free(qt_sig);
+    free(qt_sorted);
+    free(qt_acc);
+    printf("\n");
+#endif
+
+
+#if TEST_CORRELATION
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing auto- and cross-correlation
+ * test signal: ECG_signal, pseudo random noise
+ * 1. Full cross-correlation of the noise and its delayed segment, direct and FFT path
+ * 2. Lag-limited cross-correlation, compared to the full result
+ * 3. Normalized autocorrelation (heart period), direct and FFT path
+ */
+    printf("Correlation test\n");
+    printf("----------------\n");
+
+    dsp_size_t cr_i, cr_seg_len = 200, cr_delay = 137, cr_full_len = ECG_SIGNAL_SIZE + cr_seg_len - 1;
+    dsp_size_t cr_max_lag = 400, cr_peak_idx = 0;
+    dsp_val_t cr_err;
+
+    dsp_val_t *cr_direct = (dsp_val_t *) calloc(cr_full_len, sizeof(dsp_val_t));
+    dsp_val_t *cr_fft = (dsp_val_t *) calloc(cr_full_len, sizeof(dsp_val_t));
+    dsp_val_t *cr_lags = (dsp_val_t *) calloc(cr_full_len, sizeof(dsp_val_t));
+    check_mem_alloc(cr_direct);
+    check_mem_alloc(cr_fft);
+    check_mem_alloc(cr_lags);
+
+    /*white noise, the segment starts at cr_delay*/
+    dsp_val_t cr_noise[ECG_SIGNAL_SIZE];
+    unsigned long cr_seed = 7;
+    for(cr_i = 0; cr_i < ECG_SIGNAL_SIZE; cr_i++) {
+        cr_seed = cr_seed * 1103515245UL + 12345UL;
+        cr_noise[cr_i] = (dsp_val_t)((cr_seed >> 16) & 0x7FFF) / 16384.0 - 1.0;
+    }
+    dsp_val_t *cr_seg = cr_noise + cr_delay;
+
+    dsp_xcorr(cr_direct, cr_noise, ECG_SIGNAL_SIZE, cr_seg, cr_seg_len,
+              DSP_CORR_FULL, DSP_CORR_NORM_NONE, DSP_CORR_PATH_DIRECT);
+    dsp_xcorr(cr_fft, cr_noise, ECG_SIGNAL_SIZE, cr_seg, cr_seg_len,
+              DSP_CORR_FULL, DSP_CORR_NORM_NONE, DSP_CORR_PATH_FFT);
+    cr_err = max_abs_error(cr_fft, cr_direct, cr_full_len);
+    printf("full FFT vs direct max error:  %e\n", cr_err);
+
+    /*lags -10 .. 300 are elements 189 .. 499 of the full output*/
+    dsp_xcorr_lags(cr_lags, cr_noise, ECG_SIGNAL_SIZE, cr_seg, cr_seg_len,
+                   -10, 300, DSP_CORR_NORM_NONE, DSP_CORR_PATH_FFT);
+    cr_err = max_abs_error(cr_lags, cr_direct + cr_seg_len - 1 - 10, 311);
+    printf("lag-limited max error:         %e\n", cr_err);
+
+    for(cr_i = 0; cr_i < 311; cr_i++) {
+        cr_peak_idx = (*(cr_lags + cr_i) > *(cr_lags + cr_peak_idx)) ? cr_i : cr_peak_idx;
+    }
+    printf("estimated delay:               %ld (expected %lu)\n", (long)cr_peak_idx - 10, cr_delay);
+
+    /*Autocorrelation*/
+    dsp_autocorr(cr_direct, (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE, cr_max_lag, DSP_CORR_NORM_COEFF, DSP_CORR_PATH_DIRECT);
+    dsp_autocorr(cr_fft, (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE, cr_max_lag, DSP_CORR_NORM_COEFF, DSP_CORR_PATH_FFT);
+    cr_err = max_abs_error(cr_fft, cr_direct, cr_max_lag + 1);
+    printf("autocorr FFT vs direct error:  %e\n", cr_err);
+    printf("autocorr lag 0:                %lf\n", *cr_direct);
+
+    dsp_xcorr(cr_lags, cr_noise, ECG_SIGNAL_SIZE, cr_seg, cr_seg_len,
+              DSP_CORR_FULL, DSP_CORR_NORM_COEFF, DSP_CORR_PATH_AUTO);
+    create_sig_file(test_abs_path, "dat/correlation/autocorr_output.dsig", cr_direct, cr_max_lag + 1);
+    create_sig_file(test_abs_path, "dat/correlation/xcorr_output.dsig", cr_lags, cr_full_len);
+
+    free(cr_direct);
+    free(cr_fft);
+    free(cr_lags);
+    printf("\n");
+#endif
+
+
+#if TEST_WORKSPACE
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing workspace
+ * test signal: ECG_signal, pseudo random noise
+ * 1. Workspace sized by the size queries, created once
+ * 2. Frame loop: DFT buffers of the frame and correlation scratch from workspace, reset per frame
+ * 3. Multithreaded statistic with workspace, compared to the allocating variant
+ */
+    printf("Workspace test\n");
+    printf("--------------\n");
+
+    dsp_size_t ws_i, ws_frame, ws_lags = 100, ws_big_len = 4 * DSP_STAT_CHUNK_LEN;
+    dsp_val_t ws_err = 0.0;
+    dsp_val_t ws_ref[101];
+    dsp_sig_stats_t ws_stats, ws_stats_ref;
+
+    dsp_val_t *ws_big = (dsp_val_t *) malloc(ws_big_len * sizeof(dsp_val_t));
+    check_mem_alloc(ws_big);
+    unsigned long ws_seed = 11;
+    for(ws_i = 0; ws_i < ws_big_len; ws_i++) {
+        ws_seed = ws_seed * 1103515245UL + 12345UL;
+        *(ws_big + ws_i) = (dsp_val_t)((ws_seed >> 16) & 0x7FFF) / 16384.0 - 1.0;
+    }
+
+    /*frame buffers + largest scratch*/
+    dsp_size_t ws_frame_bytes = 3 * DSP_WORKSPACE_ROUND(ECG_SIGNAL_SIZE / 2 * sizeof(dsp_val_t)) +
+                                DSP_WORKSPACE_ROUND((ws_lags + 1) * sizeof(dsp_val_t));
+    dsp_size_t ws_scratch = dsp_xcorr_workspace_size(ECG_SIGNAL_SIZE, ECG_SIGNAL_SIZE, 0, ws_lags);
+    ws_scratch = (ws_scratch > dsp_sig_stats_mt_workspace_size(ws_big_len)) ? ws_scratch : dsp_sig_stats_mt_workspace_size(ws_big_len);
+    dsp_workspace_t *ws = dsp_workspace_create(ws_frame_bytes + ws_scratch);
+    check_mem_alloc(ws);
+
+    dsp_autocorr(ws_ref, (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE, ws_lags, DSP_CORR_NORM_COEFF, DSP_CORR_PATH_FFT);
+    for(ws_frame = 0; ws_frame < 10; ws_frame++) {
+        dsp_workspace_reset(ws);
+        dsp_val_t *ws_rex = (dsp_val_t *) dsp_workspace_alloc(ws, ECG_SIGNAL_SIZE / 2 * sizeof(dsp_val_t));
+        dsp_val_t *ws_imx = (dsp_val_t *) dsp_workspace_alloc(ws, ECG_SIGNAL_SIZE / 2 * sizeof(dsp_val_t));
+        dsp_val_t *ws_mag = (dsp_val_t *) dsp_workspace_alloc(ws, ECG_SIGNAL_SIZE / 2 * sizeof(dsp_val_t));
+        dsp_val_t *ws_corr = (dsp_val_t *) dsp_workspace_alloc(ws, (ws_lags + 1) * sizeof(dsp_val_t));
+
+        dsp_dft((dsp_val_t *)ECG_signal, ws_rex, ws_imx, ECG_SIGNAL_SIZE);
+        dsp_dft_magnitude(ws_mag, ws_rex, ws_imx, ECG_SIGNAL_SIZE / 2);
+        dsp_xcorr_lags_ws(ws_corr, (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE, (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE,
+                          0, ws_lags, DSP_CORR_NORM_COEFF, DSP_CORR_PATH_FFT, ws);
+        ws_err = fmax(ws_err, max_abs_error(ws_corr, ws_ref, ws_lags + 1));
+    }
+    printf("aligned buffers:               %s\n", ((unsigned long)ws->mem % DSP_WORKSPACE_ALIGN) ? "no" : "yes");
+    printf("workspace size, peak:          %lu, %lu bytes\n", ws->size, ws->peak);
+    printf("autocorr workspace error:      %e\n", ws_err);
+
+    dsp_workspace_reset(ws);
+    dsp_sig_stats_mt(ws_big, ws_big_len, &ws_stats_ref, 4);
+    dsp_sig_stats_mt_ws(ws_big, ws_big_len, &ws_stats, 4, ws);
+    printf("stats_mt workspace variance:   %s\n", (ws_stats.variance == ws_stats_ref.variance) ? "identical" : "DIFFERENT");
+    printf("used after the calls:          %lu bytes\n", ws->used);
+
+    dsp_workspace_destroy(ws);
+    free(ws_big);
+    printf("\n");
+#endif
+
+
+#if TEST_ALIGNED_BUF
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing aligned buffers
+ * test signal: ECG_signal
+ * 1. Alignment and zero padding of the allocated buffers
+ * 2. DFT magnitude and statistic: results do not depend on the alignment of the pointers
+ */
+    printf("Aligned buffer test\n");
+    printf("-------------------\n");
+
+    dsp_size_t ab_i, ab_len = ECG_SIGNAL_SIZE / 2, ab_pad_len = DSP_BUF_PADDED_LEN(ECG_SIGNAL_SIZE + 3, sizeof(dsp_val_t));
+    int ab_pad_zero = 1;
+    dsp_sig_stats_t ab_stats, ab_stats_ref;
+
+    dsp_val_t *ab_sig = dsp_buf_alloc(ECG_SIGNAL_SIZE + 3);
+    dsp_val_t *ab_rex = dsp_buf_alloc(ab_len);
+    dsp_val_t *ab_imx = dsp_buf_alloc(ab_len);
+    dsp_val_t *ab_mag = dsp_buf_alloc(ab_len);
+    dsp_f32_t *ab_f32 = dsp_buf_alloc_f32(5);
+    dsp_val_t *ab_unaligned = (dsp_val_t *) calloc(3 * ab_len + 4, sizeof(dsp_val_t));
+    check_mem_alloc(ab_sig);
+    check_mem_alloc(ab_rex);
+    check_mem_alloc(ab_imx);
+    check_mem_alloc(ab_mag);
+    check_mem_alloc(ab_f32);
+    check_mem_alloc(ab_unaligned);
+
+    for(ab_i = ECG_SIGNAL_SIZE; ab_i < ab_pad_len; ab_pad_zero &= (*(ab_sig + ab_i) == 0.0), ab_i++);
+    printf("aligned:                       %s\n", (DSP_BUF_IS_ALIGNED(ab_sig) && DSP_BUF_IS_ALIGNED(ab_rex) &&
+                                                  DSP_BUF_IS_ALIGNED(ab_f32)) ? "yes" : "no");
+    printf("padded length, zero padding:   %lu, %s\n", ab_pad_len, ab_pad_zero ? "yes" : "no");
+
+    /*magnitude: aligned pointers vs. odd addresses*/
+    memcpy(ab_sig, ECG_signal, ECG_SIGNAL_SIZE * sizeof(dsp_val_t));
+    dsp_dft(ab_sig, ab_rex, ab_imx, ECG_SIGNAL_SIZE);
+    dsp_val_t *ab_un_rex = ab_unaligned + 1, *ab_un_imx = ab_un_rex + ab_len, *ab_un_mag = ab_un_imx + ab_len;
+    memcpy(ab_un_rex, ab_rex, ab_len * sizeof(dsp_val_t));
+    memcpy(ab_un_imx, ab_imx, ab_len * sizeof(dsp_val_t));
+    dsp_dft_magnitude(ab_mag, ab_rex, ab_imx, ab_len);
+    dsp_dft_magnitude(ab_un_mag, ab_un_rex, ab_un_imx, ab_len);
+    printf("magnitude aligned/unaligned:   %e\n", max_abs_error(ab_mag, ab_un_mag, ab_len));
+
+    /*statistic: aligned and unaligned pointer to the same values*/
+    memcpy(ab_unaligned + 1, ECG_signal, ECG_SIGNAL_SIZE * sizeof(dsp_val_t));
+    dsp_sig_stats(ab_sig, ECG_SIGNAL_SIZE, &ab_stats);
+    dsp_sig_stats(ab_unaligned + 1, ECG_SIGNAL_SIZE, &ab_stats_ref);
+    printf("stats aligned vs unaligned:    %s\n", (ab_stats.variance == ab_stats_ref.variance &&
+                                                  ab_stats.mean == ab_stats_ref.mean) ? "identical" : "DIFFERENT");
+
+    dsp_buf_free(ab_sig);
+    dsp_buf_free(ab_rex);
+    dsp_buf_free(ab_imx);
+    dsp_buf_free(ab_mag);
+    dsp_buf_free(ab_f32);
+    free(ab_unaligned);
+    printf("\n");
+#endif
+
+
+#if TEST_CPU_DISPATCH
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing runtime kernel variant selection
+ * test signal: ECG_signal, Impulse_response
+ * Every supported variant is forced, convolution, FFT, magnitude and statistic
+ * results are compared to the generic variant, they must be identical.
+ * DSP_ISA environment variable forces the variant of the other tests.
+ */
+    printf("CPU dispatch test\n");
+    printf("-----------------\n");
+
+    int cd_isa, cd_ok;
+    dsp_isa_t cd_selected = dsp_cpu_isa();
+    dsp_size_t cd_fft_len = 512, cd_conv_len = ECG_SIGNAL_SIZE + IMPULSE_RESP_SIZE;
+    dsp_sig_stats_t cd_stats, cd_stats_ref;
+    dsp_fft_plan_t *cd_plan = dsp_fft_plan_create(cd_fft_len);
+    dsp_val_t *cd_conv = (dsp_val_t *) malloc(cd_conv_len * sizeof(dsp_val_t));
+    dsp_val_t *cd_conv_ref = (dsp_val_t *) malloc(cd_conv_len * sizeof(dsp_val_t));
+    dsp_val_t *cd_rex = (dsp_val_t *) malloc(cd_fft_len * sizeof(dsp_val_t));
+    dsp_val_t *cd_imx = (dsp_val_t *) malloc(cd_fft_len * sizeof(dsp_val_t));
+    dsp_val_t *cd_rex_ref = (dsp_val_t *) malloc(cd_fft_len * sizeof(dsp_val_t));
+    dsp_val_t *cd_imx_ref = (dsp_val_t *) malloc(cd_fft_len * sizeof(dsp_val_t));
+    dsp_val_t *cd_mag = (dsp_val_t *) malloc((cd_fft_len - 1) * sizeof(dsp_val_t));
+    dsp_val_t *cd_mag_ref = (dsp_val_t *) malloc((cd_fft_len - 1) * sizeof(dsp_val_t));
+    check_mem_alloc(cd_plan);
+    check_mem_alloc(cd_conv);
+    check_mem_alloc(cd_conv_ref);
+    check_mem_alloc(cd_rex);
+    check_mem_alloc(cd_imx);
+    check_mem_alloc(cd_rex_ref);
+    check_mem_alloc(cd_imx_ref);
+    check_mem_alloc(cd_mag);
+    check_mem_alloc(cd_mag_ref);
+
+    printf("selected: %s, best: %s\n", dsp_cpu_isa_name(cd_selected), dsp_cpu_isa_name(dsp_cpu_best_isa()));
+
+    for(cd_isa = DSP_ISA_GENERIC; cd_isa < DSP_ISA_N; cd_isa++) {
+        if(dsp_cpu_set_isa((dsp_isa_t)cd_isa) != 0) {
+            printf("%-8s not supported\n", dsp_cpu_isa_name((dsp_isa_t)cd_isa));
+            continue;
+        }
+
+        dsp_convolution(cd_conv, (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE, (dsp_val_t *)Impulse_response, IMPULSE_RESP_SIZE);
+        memcpy(cd_rex, ECG_signal, cd_fft_len * sizeof(dsp_val_t));
+        memset(cd_imx, 0, cd_fft_len * sizeof(dsp_val_t));
+        dsp_fft(cd_plan, cd_rex, cd_imx);
+        /*odd length: vector body and scalar tail*/
+        dsp_dft_magnitude(cd_mag, cd_rex, cd_imx, cd_fft_len - 1);
+        dsp_sig_stats((dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE - 1, &cd_stats);
+
+        if(cd_isa == DSP_ISA_GENERIC) {
+            memcpy(cd_conv_ref, cd_conv, cd_conv_len * sizeof(dsp_val_t));
+            memcpy(cd_rex_ref, cd_rex, cd_fft_len * sizeof(dsp_val_t));
+            memcpy(cd_imx_ref, cd_imx, cd_fft_len * sizeof(dsp_val_t));
+            memcpy(cd_mag_ref, cd_mag, (cd_fft_len - 1) * sizeof(dsp_val_t));
+            cd_stats_ref = cd_stats;
+        }
+
+        cd_ok = memcmp(cd_conv, cd_conv_ref, cd_conv_len * sizeof(dsp_val_t)) == 0 &&
+                memcmp(cd_rex, cd_rex_ref, cd_fft_len * sizeof(dsp_val_t)) == 0 &&
+                memcmp(cd_imx, cd_imx_ref, cd_fft_len * sizeof(dsp_val_t)) == 0 &&
+                memcmp(cd_mag, cd_mag_ref, (cd_fft_len - 1) * sizeof(dsp_val_t)) == 0 &&
+                cd_stats.mean == cd_stats_ref.mean && cd_stats.variance == cd_stats_ref.variance;
+        printf("%-8s conv, fft, magnitude, stats: %s\n", dsp_cpu_isa_name((dsp_isa_t)cd_isa),
+               cd_ok ? "identical" : "DIFFERENT");
+    }
+    dsp_cpu_set_isa(cd_selected);
+
+    dsp_fft_plan_destroy(cd_plan);
+    free(cd_conv);
+    free(cd_conv_ref);
+    free(cd_rex);
+    free(cd_imx);
+    free(cd_rex_ref);
+    free(cd_imx_ref);
+    free(cd_mag);
+    free(cd_mag_ref);
+    printf("\n");
+#endif
+
+
+#if TEST_EXEC
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing execution context (thread pool)
+ * test signal: ECG_signal repeated
+ * 1. Every task of dsp_exec_parallel_for runs once
+ * 2. Convolution, statistic and FFT batch with the context: identical to the serial result
+ * 3. Context with CPU affinity
+ */
+    printf("Execution context test\n");
+    printf("----------------------\n");
+
+    int ex_cpus[1] = {0}, ex_once = 1;
+    dsp_size_t ex_i, ex_len = 200 * ECG_SIGNAL_SIZE, ex_fft_len = 512, ex_batch = 16, ex_tasks = 1000;
+    dsp_sig_stats_t ex_stats, ex_stats_ref;
+    dsp_exec_ctx_t *ex_ctx = dsp_exec_ctx_create(4, NULL, 0);
+    dsp_exec_ctx_t *ex_ctx_pin = dsp_exec_ctx_create(2, ex_cpus, 1);
+    dsp_fft_plan_t *ex_plan = dsp_fft_plan_create(ex_fft_len);
+    dsp_val_t *ex_sig = (dsp_val_t *) malloc(ex_len * sizeof(dsp_val_t));
+    dsp_val_t *ex_conv = (dsp_val_t *) malloc((ex_len + IMPULSE_RESP_SIZE) * sizeof(dsp_val_t));
+    dsp_val_t *ex_conv_ref = (dsp_val_t *) malloc((ex_len + IMPULSE_RESP_SIZE) * sizeof(dsp_val_t));
+    dsp_val_t *ex_rex = (dsp_val_t *) malloc(ex_batch * ex_fft_len * sizeof(dsp_val_t));
+    dsp_val_t *ex_imx = (dsp_val_t *) calloc(ex_batch * ex_fft_len, sizeof(dsp_val_t));
+    dsp_val_t *ex_rex_ref = (dsp_val_t *) malloc(ex_batch * ex_fft_len * sizeof(dsp_val_t));
+    dsp_val_t *ex_imx_ref = (dsp_val_t *) calloc(ex_batch * ex_fft_len, sizeof(dsp_val_t));
+    int *ex_hits = (int *) calloc(ex_tasks, sizeof(int));
+    check_mem_alloc(ex_ctx);
+    check_mem_alloc(ex_ctx_pin);
+    check_mem_alloc(ex_plan);
+    check_mem_alloc(ex_sig);
+    check_mem_alloc(ex_conv);
+    check_mem_alloc(ex_conv_ref);
+    check_mem_alloc(ex_rex);
+    check_mem_alloc(ex_imx);
+    check_mem_alloc(ex_rex_ref);
+    check_mem_alloc(ex_imx_ref);
+    check_mem_alloc(ex_hits);
+
+    for(ex_i = 0; ex_i < ex_len; *(ex_sig + ex_i) = ECG_signal[ex_i % ECG_SIGNAL_SIZE], ex_i++);
+    printf("threads:                       %d (pinned: %d)\n", dsp_exec_ctx_threads(ex_ctx), dsp_exec_ctx_threads(ex_ctx_pin));
+
+    dsp_exec_parallel_for(ex_ctx, ex_tasks, exec_test_task, ex_hits);
+    for(ex_i = 0; ex_i < ex_tasks; ex_once &= (*(ex_hits + ex_i) == 1), ex_i++);
+    printf("every task once:               %s\n", ex_once ? "yes" : "NO");
+
+    dsp_convolution(ex_conv_ref, ex_sig, ex_len, (dsp_val_t *)Impulse_response, IMPULSE_RESP_SIZE);
+    dsp_convolution_exec(ex_conv, ex_sig, ex_len, (dsp_val_t *)Impulse_response, IMPULSE_RESP_SIZE, ex_ctx);
+    printf("convolution exec vs serial:    %s\n",
+           memcmp(ex_conv, ex_conv_ref, (ex_len + IMPULSE_RESP_SIZE) * sizeof(dsp_val_t)) == 0 ? "identical" : "DIFFERENT");
+
+    dsp_sig_stats_mt(ex_sig, ex_len, &ex_stats_ref, 1);
+    dsp_sig_stats_exec(ex_sig, ex_len, &ex_stats, ex_ctx_pin, NULL);
+    printf("stats exec vs serial:          %s\n", (ex_stats.mean == ex_stats_ref.mean &&
+                                                  ex_stats.variance == ex_stats_ref.variance) ? "identical" : "DIFFERENT");
+
+    memcpy(ex_rex, ex_sig, ex_batch * ex_fft_len * sizeof(dsp_val_t));
+    memcpy(ex_rex_ref, ex_sig, ex_batch * ex_fft_len * sizeof(dsp_val_t));
+    dsp_fft_batch(ex_plan, ex_rex, ex_imx, ex_batch, ex_ctx);
+    for(ex_i = 0; ex_i < ex_batch; ex_i++) {
+        dsp_fft(ex_plan, ex_rex_ref + ex_i * ex_fft_len, ex_imx_ref + ex_i * ex_fft_len);
+    }
+    printf("fft batch vs serial:           %s\n",
+           (memcmp(ex_rex, ex_rex_ref, ex_batch * ex_fft_len * sizeof(dsp_val_t)) == 0 &&
+            memcmp(ex_imx, ex_imx_ref, ex_batch * ex_fft_len * sizeof(dsp_val_t)) == 0) ? "identical" : "DIFFERENT");
+
+    dsp_exec_ctx_destroy(ex_ctx);
+    dsp_exec_ctx_destroy(ex_ctx_pin);
+    dsp_fft_plan_destroy(ex_plan);
+    free(ex_sig);
+    free(ex_conv);
+    free(ex_conv_ref);
+    free(ex_rex);
+    free(ex_imx);
+    free(ex_rex_ref);
+    free(ex_imx_ref);
+    free(ex_hits);
+    printf("\n");
+#endif
+
+
+#if TEST_PIPELINE
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing block processing pipeline
+ * test signal: ECG_signal repeated
+ * chain: low-pass win-sinc FIR -> decimation by 2 -> DFT frames -> magnitude -> statistic
+ * reference: the same chain on full length intermediate arrays
+ */
+    printf("Pipeline test\n");
+    printf("-------------\n");
+
+    dsp_size_t pl_i, pl_len = 20 * ECG_SIGNAL_SIZE, pl_block = 300, pl_frame = 64, pl_bins = pl_frame / 2;
+    dsp_size_t pl_dec_len = pl_len / 2, pl_frames = pl_dec_len / pl_frame, pl_out_len;
+    dsp_val_t pl_err = 0.0;
+    dsp_stat_acc_t pl_acc;
+    dsp_sig_stats_t pl_stats, pl_stats_ref;
+    dsp_pipeline_t *pl = dsp_pipeline_create(pl_block);
+    dsp_val_t *pl_kernel = (dsp_val_t *) malloc(IMPULSE_RESP_SIZE * sizeof(dsp_val_t));
+    dsp_val_t *pl_sig = (dsp_val_t *) malloc(pl_len * sizeof(dsp_val_t));
+    dsp_val_t *pl_filt = (dsp_val_t *) malloc((pl_len + IMPULSE_RESP_SIZE) * sizeof(dsp_val_t));
+    dsp_val_t *pl_rex = (dsp_val_t *) malloc(pl_bins * sizeof(dsp_val_t));
+    dsp_val_t *pl_imx = (dsp_val_t *) malloc(pl_bins * sizeof(dsp_val_t));
+    dsp_val_t *pl_mag_ref = (dsp_val_t *) malloc(pl_frames * pl_bins * sizeof(dsp_val_t));
+    dsp_val_t *pl_mag = (dsp_val_t *) malloc(pl_frames * pl_bins * sizeof(dsp_val_t));
+    check_mem_alloc(pl);
+    check_mem_alloc(pl_kernel);
+    check_mem_alloc(pl_sig);
+    check_mem_alloc(pl_filt);
+    check_mem_alloc(pl_rex);
+    check_mem_alloc(pl_imx);
+    check_mem_alloc(pl_mag_ref);
+    check_mem_alloc(pl_mag);
+
+    for(pl_i = 0; pl_i < pl_len; *(pl_sig + pl_i) = ECG_signal[pl_i % ECG_SIGNAL_SIZE], pl_i++);
+    dsp_lp_win_sinc_filter(pl_kernel, 48.0, 10.0, NULL, IMPULSE_RESP_SIZE);
+
+    /*reference chain, decimation in place*/
+    dsp_convolution(pl_filt, pl_sig, pl_len, pl_kernel, IMPULSE_RESP_SIZE);
+    for(pl_i = 0; pl_i < pl_dec_len; *(pl_filt + pl_i) = *(pl_filt + 2 * pl_i), pl_i++);
+    for(pl_i = 0; pl_i < pl_frames; pl_i++) {
+        dsp_dft(pl_filt + pl_i * pl_frame, pl_rex, pl_imx, pl_frame);
+        dsp_dft_magnitude(pl_mag_ref + pl_i * pl_bins, pl_rex, pl_imx, pl_bins);
+    }
+    dsp_stat_acc_init(&pl_acc, 2);
+    dsp_stat_acc_update(&pl_acc, pl_mag_ref, pl_frames * pl_bins);
+    dsp_stat_acc_finalize(&pl_acc, &pl_stats_ref);
+
+    dsp_stat_acc_init(&pl_acc, 2);
+    if(dsp_pipeline_add_fir(pl, pl_kernel, IMPULSE_RESP_SIZE, DSP_FIR_PATH_AUTO) != 0 ||
+       dsp_pipeline_add_decimate(pl, 2) != 0 ||
+       dsp_pipeline_add_dft(pl, pl_frame) != 0 ||
+       dsp_pipeline_add_magnitude(pl, pl_bins) != 0 ||
+       dsp_pipeline_add_stats(pl, &pl_acc) != 0) {
+        printf("Stage allocation failed\n");
+        exit(1);
+    }
+    printf("stages:                 %lu, buffer length: %lu\n", (unsigned long)pl->n_stages, (unsigned long)pl->buf_len);
+
+    pl_out_len = dsp_pipeline_run(pl, pl_mag, pl_frames * pl_bins, pl_sig, pl_len);
+    dsp_stat_acc_finalize(&pl_acc, &pl_stats);
+    pl_err = max_abs_error(pl_mag, pl_mag_ref, pl_frames * pl_bins);
+    printf("output length:          %lu (expected %lu)\n", (unsigned long)pl_out_len, (unsigned long)(pl_frames * pl_bins));
+    printf("magnitude max error:    %e\n", pl_err);
+    printf("mean error:             %e\n", fabs(pl_stats.mean - pl_stats_ref.mean));
+    printf("variance error:         %e\n", fabs(pl_stats.variance - pl_stats_ref.variance));
+
+    /*uneven blocks after reset give the same output*/
+    dsp_pipeline_reset(pl);
+    dsp_stat_acc_init(&pl_acc, 2);
+    pl_out_len = 0;
+    for(pl_i = 0; pl_i < pl_len; ) {
+        dsp_size_t pl_n = (pl_i % 7 == 0) ? 1 : 97 + pl_i % pl_block;
+        dsp_size_t pl_blk_out;
+        dsp_val_t *pl_out;
+
+        pl_n = (pl_n > pl_block) ? pl_block : pl_n;
+        pl_n = (pl_len - pl_i < pl_n) ? (pl_len - pl_i) : pl_n;
+        pl_out = dsp_pipeline_process(pl, pl_sig + pl_i, pl_n, &pl_blk_out);
+        memcpy(pl_mag + pl_out_len, pl_out, pl_blk_out * sizeof(dsp_val_t));
+        pl_out_len += pl_blk_out;
+        pl_i += pl_n;
+    }
+    pl_err = max_abs_error(pl_mag, pl_mag_ref, pl_frames * pl_bins);
+    printf("uneven blocks max error: %e (output length %lu)\n", pl_err, (unsigned long)pl_out_len);
+    printf("too long block rejected: %s\n", dsp_pipeline_process(pl, pl_sig, pl_block + 1, &pl_out_len) == NULL ? "yes" : "NO");
+
+    dsp_pipeline_destroy(pl);
+    free(pl_kernel);
+    free(pl_sig);
+    free(pl_filt);
+    free(pl_rex);
+    free(pl_imx);
+    free(pl_mag_ref);
+    free(pl_mag);
+    printf("\n");
+#endif
+
+
+#if TEST_SIGFILE
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing binary signal file
+ * test signal: ECG_signal, 2 channels (ECG, negated ECG)
+ * 1. Write with the appending writer, mapped view is identical and aligned
+ * 2. Channel read, single precision file
+ * 3. Invalid file is rejected
+ */
+    printf("Signal file test\n");
+    printf("----------------\n");
+
+    dsp_size_t sf_i;
+    dsp_sigfile_t *sf;
+    dsp_sigfile_writer_t *sf_wr;
+    char *sf_path = prepare_path(test_abs_path, "dat/sigfile_test.dsig");
+    dsp_val_t *sf_sig = (dsp_val_t *) malloc(2 * ECG_SIGNAL_SIZE * sizeof(dsp_val_t));
+    dsp_val_t *sf_ch = (dsp_val_t *) malloc(ECG_SIGNAL_SIZE * sizeof(dsp_val_t));
+    dsp_f32_t *sf_f32 = (dsp_f32_t *) malloc(ECG_SIGNAL_SIZE * sizeof(dsp_f32_t));
+    check_mem_alloc(sf_path);
+    check_mem_alloc(sf_sig);
+    check_mem_alloc(sf_ch);
+    check_mem_alloc(sf_f32);
+
+    for(sf_i = 0; sf_i < ECG_SIGNAL_SIZE; sf_i++) {
+        *(sf_sig + 2 * sf_i) = ECG_signal[sf_i];
+        *(sf_sig + 2 * sf_i + 1) = -ECG_signal[sf_i];
+        *(sf_f32 + sf_i) = (dsp_f32_t)ECG_signal[sf_i];
+    }
+
+    /*two appends*/
+    sf_wr = dsp_sigfile_writer_open(sf_path, DSP_SIGFILE_F64, 2, 500.0);
+    check_mem_alloc(sf_wr);
+    dsp_sigfile_writer_append(sf_wr, sf_sig, 100);
+    dsp_sigfile_writer_append(sf_wr, sf_sig + 200, ECG_SIGNAL_SIZE - 100);
+    printf("writer close:           %s\n", dsp_sigfile_writer_close(sf_wr) == 0 ? "OK" : "FAILED");
+
+    sf = dsp_sigfile_open(sf_path);
+    check_mem_alloc(sf);
+    printf("header:                 %lu channels, %lu samples, %.1f Hz\n",
+           (unsigned long)sf->channels, (unsigned long)sf->len, sf->sample_rate);
+    printf("view vs written:        %s\n",
+           memcmp(dsp_sigfile_view(sf), sf_sig, 2 * ECG_SIGNAL_SIZE * sizeof(dsp_val_t)) == 0 ? "identical" : "DIFFERENT");
+    printf("view aligned:           %s\n", DSP_BUF_IS_ALIGNED(dsp_sigfile_view(sf)) ? "yes" : "no");
+    dsp_sigfile_read(sf, sf_ch, 1, 0, ECG_SIGNAL_SIZE);
+    for(sf_i = 0; sf_i < ECG_SIGNAL_SIZE && *(sf_ch + sf_i) == -ECG_signal[sf_i]; sf_i++);
+    printf("channel 1 read:         %s\n", sf_i == ECG_SIGNAL_SIZE ? "identical" : "DIFFERENT");
+    printf("read at the end:        %lu samples\n", (unsigned long)dsp_sigfile_read(sf, sf_ch, 0, ECG_SIGNAL_SIZE - 10, 100));
+    dsp_sigfile_close(sf);
+
+    /*single precision*/
+    sf_wr = dsp_sigfile_writer_open(sf_path, DSP_SIGFILE_F32, 1, 0.0);
+    check_mem_alloc(sf_wr);
+    dsp_sigfile_writer_append(sf_wr, sf_f32, ECG_SIGNAL_SIZE);
+    dsp_sigfile_writer_close(sf_wr);
+    sf = dsp_sigfile_open(sf_path);
+    check_mem_alloc(sf);
+    dsp_sigfile_read(sf, sf_ch, 0, 0, ECG_SIGNAL_SIZE);
+    printf("f32 view:               %s, f64 view: %s\n", dsp_sigfile_view_f32(sf) != NULL ? "yes" : "no",
+           dsp_sigfile_view(sf) != NULL ? "yes" : "no");
+    printf("f32 read max error:     %e\n", max_abs_error(sf_ch, (dsp_val_t *)ECG_signal, ECG_SIGNAL_SIZE));
+    dsp_sigfile_close(sf);
+
+    /*header length is larger than the data*/
+    sf_wr = dsp_sigfile_writer_open(sf_path, DSP_SIGFILE_F64, 1, 0.0);
+    check_mem_alloc(sf_wr);
+    dsp_sigfile_writer_append(sf_wr, sf_sig, ECG_SIGNAL_SIZE);
+    dsp_sigfile_writer_close(sf_wr);
+    {
+        FILE *sf_fd = fopen(sf_path, "r+b");
+        uint64_t sf_len = 2 * ECG_SIGNAL_SIZE;
+        check_mem_alloc(sf_fd);
+        fseek(sf_fd, 24, SEEK_SET);     // length field
+        fwrite(&sf_len, sizeof(sf_len), 1, sf_fd);
+        fclose(sf_fd);
+    }
+    printf("too long header length rejected: %s\n", dsp_sigfile_open(sf_path) == NULL ? "yes" : "NO");
+    printf("missing file rejected:  %s\n", dsp_sigfile_open("/nonexistent.dsig") == NULL ? "yes" : "NO");
+
+    remove(sf_path);
+    free(sf_path);
+    free(sf_sig);
+    free(sf_ch);
+    free(sf_f32);
+    printf("\n");
+#endif
+
+
+#if TEST_STFT
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing short-time Fourier transform
+ * test signal: ECG_signal repeated
+ * 1. Frames against windowed, zero padded single FFTs, spectrogram against their magnitude
+ * 2. Stream push with uneven blocks against the whole signal transform
+ * 3. Inverse transform reconstructs the signal
+ * 4. Hop longer than the frame (gaps between the frames)
+ */
+    printf("STFT test\n");
+    printf("---------\n");
+
+    dsp_size_t st_i, st_f, st_n, st_len = 4 * ECG_SIGNAL_SIZE, st_frames, st_out_len;
+    dsp_val_t st_err = 0.0;
+    dsp_stft_t *st = dsp_stft_create(100, 25, NULL);
+    dsp_stft_t *st_gap = dsp_stft_create(64, 80, dsp_blackman_window);
+    check_mem_alloc(st);
+    check_mem_alloc(st_gap);
+
+    dsp_size_t st_bins = st->bins, st_max_frames = dsp_stft_frames(st, st_len);
+    dsp_fft_plan_t *st_plan = dsp_fft_plan_create(st->fft_len);
+    dsp_val_t *st_sig = (dsp_val_t *) malloc(st_len * sizeof(dsp_val_t));
+    dsp_val_t *st_out = (dsp_val_t *) malloc(st_len * sizeof(dsp_val_t));
+    dsp_val_t *st_work_rex = (dsp_val_t *) malloc(st->fft_len * sizeof(dsp_val_t));
+    dsp_val_t *st_work_imx = (dsp_val_t *) malloc(st->fft_len * sizeof(dsp_val_t));
+    dsp_val_t *st_rex = (dsp_val_t *) malloc(st_max_frames * st_bins * sizeof(dsp_val_t));
+    dsp_val_t *st_imx = (dsp_val_t *) malloc(st_max_frames * st_bins * sizeof(dsp_val_t));
+    dsp_val_t *st_rex2 = (dsp_val_t *) malloc(st_max_frames * st_bins * sizeof(dsp_val_t));
+    dsp_val_t *st_imx2 = (dsp_val_t *) malloc(st_max_frames * st_bins * sizeof(dsp_val_t));
+    dsp_val_t *st_mag = (dsp_val_t *) malloc(st_max_frames * st_bins * sizeof(dsp_val_t));
+    check_mem_alloc(st_plan);
+    check_mem_alloc(st_sig);
+    check_mem_alloc(st_out);
+    check_mem_alloc(st_work_rex);
+    check_mem_alloc(st_work_imx);
+    check_mem_alloc(st_rex);
+    check_mem_alloc(st_imx);
+    check_mem_alloc(st_rex2);
+    check_mem_alloc(st_imx2);
+    check_mem_alloc(st_mag);
+
+    for(st_i = 0; st_i < st_len; *(st_sig + st_i) = ECG_signal[st_i % ECG_SIGNAL_SIZE], st_i++);
+
+    /*frames in pairs against single reference transforms*/
+    st_frames = dsp_stft(st, st_rex, st_imx, st_sig, st_len);
+    dsp_spectrogram(st, st_mag, st_sig, st_len);
+    printf("frames:                 %lu, bins: %lu, FFT length: %lu\n",
+           (unsigned long)st_frames, (unsigned long)st_bins, (unsigned long)st->fft_len);
+    for(st_f = 0; st_f < st_frames; st_f++) {
+        for(st_i = 0; st_i < st->fft_len; st_i++) {
+            *(st_work_rex + st_i) = (st_i < st->frame_len) ?
+                dsp_hamming_window(st_i, st->frame_len) * *(st_sig + st_f * st->hop + st_i) : 0.0;
+            *(st_work_imx + st_i) = 0.0;
+        }
+        dsp_fft(st_plan, st_work_rex, st_work_imx);
+        st_err = fmax(st_err, max_abs_error(st_rex + st_f * st_bins, st_work_rex, st_bins));
+        st_err = fmax(st_err, max_abs_error(st_imx + st_f * st_bins, st_work_imx, st_bins));
+        dsp_dft_magnitude(st_work_rex, st_work_rex, st_work_imx, st_bins);
+        st_err = fmax(st_err, max_abs_error(st_mag + st_f * st_bins, st_work_rex, st_bins));
+    }
+    printf("frame max error:        %e\n", st_err);
+
+    /*uneven pushes*/
+    dsp_stft_reset(st);
+    for(st_i = 0, st_f = 0; st_i < st_len; st_i += st_n) {
+        st_n = (st_i % 3 == 0) ? 7 : 13 + st_i % 211;
+        st_n = (st_len - st_i < st_n) ? (st_len - st_i) : st_n;
+        st_out_len = dsp_stft_push_frames(st, st_n);
+        if(dsp_stft_push(st, st_rex2 + st_f * st_bins, st_imx2 + st_f * st_bins, st_sig + st_i, st_n) != st_out_len) {
+            printf("push frame count mismatch\n");
+        }
+        st_f += st_out_len;
+    }
+    st_err = fmax(max_abs_error(st_rex2, st_rex, st_frames * st_bins), max_abs_error(st_imx2, st_imx, st_frames * st_bins));
+    printf("push frames:            %lu, max error: %e\n", (unsigned long)st_f, st_err);
+
+    /*resynthesis*/
+    st_out_len = dsp_istft(st, st_out, st_rex, st_imx, st_frames);
+    printf("inverse length:         %lu (expected %lu)\n", (unsigned long)st_out_len,
+           (unsigned long)((st_frames - 1) * st->hop + st->frame_len));
+    printf("inverse max error:      %e\n", max_abs_error(st_out, st_sig, st_out_len));
+
+    /*gaps between the frames*/
+    st_frames = dsp_stft(st_gap, st_rex, st_imx, st_sig, st_len);
+    for(st_i = 0, st_f = 0; st_i < st_len; st_i += st_n) {
+        st_n = 1 + (st_i * 7) % 150;
+        st_n = (st_len - st_i < st_n) ? (st_len - st_i) : st_n;
+        st_f += dsp_stft_push(st_gap, st_rex2 + st_f * st_gap->bins, st_imx2 + st_f * st_gap->bins, st_sig + st_i, st_n);
+    }
+    st_err = fmax(max_abs_error(st_rex2, st_rex, st_frames * st_gap->bins),
+                  max_abs_error(st_imx2, st_imx, st_frames * st_gap->bins));
+    printf("hop > frame push:       %lu/%lu frames, max error: %e\n", (unsigned long)st_f, (unsigned long)st_frames, st_err);
+    st_out_len = dsp_istft(st_gap, st_out, st_rex, st_imx, st_frames);
+    for(st_i = 0, st_err = 0.0; st_i < st_out_len; st_i++) {
+        /*Blackman window is zero at the frame start*/
+        if(st_i % st_gap->hop != 0 && st_i % st_gap->hop < st_gap->frame_len) {
+            st_err = fmax(st_err, fabs(*(st_out + st_i) - *(st_sig + st_i)));
+        }
+    }
+    printf("hop > frame inverse:    max error in the frames: %e\n", st_err);
+
+    dsp_stft_destroy(st);
+    dsp_stft_destroy(st_gap);
+    dsp_fft_plan_destroy(st_plan);
+    free(st_sig);
+    free(st_out);
+    free(st_work_rex);
+    free(st_work_imx);
+    free(st_rex);
+    free(st_imx);
+    free(st_rex2);
+    free(st_imx2);
+    free(st_mag);
+    printf("\n");
+#endif
+
+
+#if TEST_PSD
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing Welch power spectral density
+ * test signal: ECG_signal repeated + sine at bin 32 (125 Hz, fs = 1000 Hz)
+ * 1. Estimate against averaged single FFT periodograms
+ * 2. Stream update with uneven blocks against the one-shot estimate
+ * 3. Parseval: integral of the PSD equals the windowed mean square of the segments
+ */
+    printf("Welch PSD test\n");
+    printf("--------------\n");
+
+    dsp_size_t ps_i, ps_k, ps_n, ps_seg, ps_len = 4 * ECG_SIGNAL_SIZE, ps_seg_len = 200, ps_overlap = 100;
+    dsp_size_t ps_fft_len = dsp_fft_next_pow2(ps_seg_len), ps_bins = ps_fft_len / 2 + 1, ps_peak = 0;
+    dsp_val_t ps_fs = 1000.0, ps_err = 0.0, ps_win_pow = 0.0, ps_ms = 0.0, ps_int = 0.0;
+    dsp_welch_t *ps_welch = dsp_welch_create(ps_seg_len, ps_overlap, NULL, ps_fs, NULL);
+    dsp_fft_plan_t *ps_plan = dsp_fft_plan_create(ps_fft_len);
+    dsp_val_t *ps_sig = (dsp_val_t *) malloc(ps_len * sizeof(dsp_val_t));
+    dsp_val_t *ps_rex = (dsp_val_t *) malloc(ps_fft_len * sizeof(dsp_val_t));
+    dsp_val_t *ps_imx = (dsp_val_t *) malloc(ps_fft_len * sizeof(dsp_val_t));
+    dsp_val_t *ps_ref = (dsp_val_t *) calloc(ps_bins, sizeof(dsp_val_t));
+    dsp_val_t *ps_psd = (dsp_val_t *) malloc(ps_bins * sizeof(dsp_val_t));
+    check_mem_alloc(ps_welch);
+    check_mem_alloc(ps_plan);
+    check_mem_alloc(ps_sig);
+    check_mem_alloc(ps_rex);
+    check_mem_alloc(ps_imx);
+    check_mem_alloc(ps_ref);
+    check_mem_alloc(ps_psd);
+
+    for(ps_i = 0; ps_i < ps_len; ps_i++) {
+        *(ps_sig + ps_i) = ECG_signal[ps_i % ECG_SIGNAL_SIZE] + sin(2.0 * M_PI * 125.0 * ps_i / ps_fs);
+    }
+    for(ps_i = 0; ps_i < ps_seg_len; ps_i++) {
+        ps_win_pow += pow(dsp_hamming_window(ps_i, ps_seg_len), 2);
+    }
+
+    /*reference: one FFT per segment*/
+    for(ps_seg = 0; (ps_seg * (ps_seg_len - ps_overlap)) + ps_seg_len <= ps_len; ps_seg++) {
+        for(ps_i = 0; ps_i < ps_fft_len; ps_i++) {
+            *(ps_rex + ps_i) = (ps_i < ps_seg_len) ?
+                dsp_hamming_window(ps_i, ps_seg_len) * *(ps_sig + ps_seg * (ps_seg_len - ps_overlap) + ps_i) : 0.0;
+            *(ps_imx + ps_i) = 0.0;
+            ps_ms += *(ps_rex + ps_i) * *(ps_rex + ps_i);
+        }
+        dsp_fft(ps_plan, ps_rex, ps_imx);
+        for(ps_k = 0; ps_k < ps_bins; ps_k++) {
+            *(ps_ref + ps_k) += *(ps_rex + ps_k) * *(ps_rex + ps_k) + *(ps_imx + ps_k) * *(ps_imx + ps_k);
+        }
+    }
+    for(ps_k = 0; ps_k < ps_bins; ps_k++) {
+        *(ps_ref + ps_k) *= ((ps_k == 0 || ps_k == ps_bins - 1) ? 1.0 : 2.0) / (ps_fs * ps_win_pow * ps_seg);
+    }
+    ps_ms /= ps_seg * ps_win_pow;
+
+    ps_n = dsp_welch_psd(ps_psd, ps_sig, ps_len, ps_seg_len, ps_overlap, NULL, ps_fs);
+    for(ps_k = 0; ps_k < ps_bins; ps_k++) {
+        ps_err = fmax(ps_err, fabs(*(ps_psd + ps_k) - *(ps_ref + ps_k)) / *(ps_ref + ps_k));
+        ps_peak = (ps_k > 0 && *(ps_psd + ps_k) > *(ps_psd + ps_peak)) ? ps_k : ps_peak;
+        ps_int += *(ps_psd + ps_k) * ps_fs / ps_fft_len;
+    }
+    printf("segments:               %lu (expected %lu), bins: %lu\n", (unsigned long)ps_n, (unsigned long)ps_seg, (unsigned long)ps_bins);
+    printf("max relative error:     %e\n", ps_err);
+    printf("peak:                   %.1f Hz (bin %lu)\n", ps_peak * ps_fs / ps_fft_len, (unsigned long)ps_peak);
+    printf("Parseval error:         %e\n", fabs(ps_int - ps_ms) / ps_ms);
+
+    /*stream with uneven blocks, estimate in the middle of the stream*/
+    for(ps_i = 0; ps_i < ps_len; ps_i += ps_n) {
+        ps_n = 1 + (ps_i * 13) % 317;
+        ps_n = (ps_len - ps_i < ps_n) ? (ps_len - ps_i) : ps_n;
+        dsp_welch_update(ps_welch, ps_sig + ps_i, ps_n);
+        if(ps_i < ps_len / 2 && ps_i + ps_n >= ps_len / 2) {
+            printf("running estimate:       %lu segments\n", (unsigned long)dsp_welch_get(ps_welch, ps_psd));
+        }
+    }
+    ps_n = dsp_welch_get(ps_welch, ps_psd);
+    for(ps_k = 0, ps_err = 0.0; ps_k < ps_bins; ps_k++) {
+        ps_err = fmax(ps_err, fabs(*(ps_psd + ps_k) - *(ps_ref + ps_k)) / *(ps_ref + ps_k));
+    }
+    printf("stream segments:        %lu, max relative error: %e\n", (unsigned long)ps_n, ps_err);
+    printf("overlap >= segment rejected: %s\n", dsp_welch_create(64, 64, NULL, ps_fs, NULL) == NULL ? "yes" : "NO");
+
+    dsp_welch_destroy(ps_welch);
+    dsp_fft_plan_destroy(ps_plan);
+    free(ps_sig);
+    free(ps_rex);
+    free(ps_imx);
+    free(ps_ref);
+    free(ps_psd);
+    printf("\n");
+#endif
+
+
+#if TEST_IQ
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Testing interleaved complex (I/Q) layout
+ * test signal: I = ECG_signal, Q = ECG_signal delayed by 7 samples
+ * 1. Interleave and deinterleave round trip (odd length: vector body and scalar tail)
+ * 2. Every supported kernel variant: FFT, magnitude and deinterleave are identical to the split layout
+ * 3. Complex DFT, real DFT and polar conversion against the split layout
+ */
+    printf("Interleaved I/Q test\n");
+    printf("--------------------\n");
+
+    int iq_isa, iq_ok;
+    dsp_isa_t iq_selected = dsp_cpu_isa();
+    dsp_size_t iq_i, iq_len = 256, iq_odd = 255;
+    dsp_fft_plan_t *iq_plan = dsp_fft_plan_create(iq_len);
+    dsp_fft_plan_f32_t *iq_plan_f32 = dsp_fft_plan_create_f32(iq_len);
+    dsp_val_t *iq_sig = (dsp_val_t *) malloc(2 * iq_len * sizeof(dsp_val_t));
+    dsp_val_t *iq_buf = (dsp_val_t *) malloc(2 * iq_len * sizeof(dsp_val_t));
+    dsp_val_t *iq_rex = (dsp_val_t *) malloc(iq_len * sizeof(dsp_val_t));
+    dsp_val_t *iq_imx = (dsp_val_t *) malloc(iq_len * sizeof(dsp_val_t));
+    dsp_val_t *iq_rex2 = (dsp_val_t *) malloc(iq_len * sizeof(dsp_val_t));
+    dsp_val_t *iq_imx2 = (dsp_val_t *) malloc(iq_len * sizeof(dsp_val_t));
+    dsp_val_t *iq_mag = (dsp_val_t *) malloc(iq_len * sizeof(dsp_val_t));
+    dsp_val_t *iq_mag2 = (dsp_val_t *) malloc(iq_len * sizeof(dsp_val_t));
+    dsp_val_t *iq_phase = (dsp_val_t *) malloc(iq_len * sizeof(dsp_val_t));
+    dsp_val_t *iq_phase2 = (dsp_val_t *) malloc(iq_len * sizeof(dsp_val_t));
+    dsp_f32_t *iq_f32 = (dsp_f32_t *) malloc(2 * iq_len * sizeof(dsp_f32_t));
+    dsp_f32_t *iq_rex_f32 = (dsp_f32_t *) malloc(iq_len * sizeof(dsp_f32_t));
+    dsp_f32_t *iq_imx_f32 = (dsp_f32_t *) malloc(iq_len * sizeof(dsp_f32_t));
+    check_mem_alloc(iq_plan);
+    check_mem_alloc(iq_plan_f32);
+    check_mem_alloc(iq_sig);
+    check_mem_alloc(iq_buf);
+    check_mem_alloc(iq_rex);
+    check_mem_alloc(iq_imx);
+    check_mem_alloc(iq_rex2);
+    check_mem_alloc(iq_imx2);
+    check_mem_alloc(iq_mag);
+    check_mem_alloc(iq_mag2);
+    check_mem_alloc(iq_phase);
+    check_mem_alloc(iq_phase2);
+    check_mem_alloc(iq_f32);
+    check_mem_alloc(iq_rex_f32);
+    check_mem_alloc(iq_imx_f32);
+
+    for(iq_i = 0; iq_i < iq_len; iq_i++) {
+        *(iq_sig + 2 * iq_i) = ECG_signal[iq_i];
+        *(iq_sig + 2 * iq_i + 1) = ECG_signal[iq_i + 7];
+    }
+
+    for(iq_isa = DSP_ISA_GENERIC; iq_isa < DSP_ISA_N; iq_isa++) {
+        if(dsp_cpu_set_isa((dsp_isa_t)iq_isa) != 0) {
+            printf("%-8s not supported\n", dsp_cpu_isa_name((dsp_isa_t)iq_isa));
+            continue;
+        }
+
+        /*round trip, odd length*/
+        memset(iq_buf, 0, 2 * iq_len * sizeof(dsp_val_t));
+        dsp_iq_deinterleave(iq_rex, iq_imx, iq_sig, iq_odd);
+        dsp_iq_interleave(iq_buf, iq_rex, iq_imx, iq_odd);
+        iq_ok = memcmp(iq_buf, iq_sig, 2 * iq_odd * sizeof(dsp_val_t)) == 0 && *(iq_buf + 2 * iq_odd) == 0.0;
+
+        /*split layout reference*/
+        dsp_iq_deinterleave(iq_rex, iq_imx, iq_sig, iq_len);
+        for(iq_i = 0; iq_i < iq_len && *(iq_rex + iq_i) == *(iq_sig + 2 * iq_i) &&
+                                       *(iq_imx + iq_i) == *(iq_sig + 2 * iq_i + 1); iq_i++);
+        iq_ok = iq_ok && iq_i == iq_len;
+        dsp_fft(iq_plan, iq_rex, iq_imx);
+        dsp_dft_magnitude(iq_mag, iq_rex, iq_imx, iq_odd);
+
+        memcpy(iq_buf, iq_sig, 2 * iq_len * sizeof(dsp_val_t));
+        dsp_fft_iq(iq_plan, iq_buf);
+        dsp_dft_magnitude_iq(iq_mag2, iq_buf, iq_odd);
+        dsp_iq_deinterleave(iq_rex2, iq_imx2, iq_buf, iq_len);
+
+        iq_ok = iq_ok && memcmp(iq_rex2, iq_rex, iq_len * sizeof(dsp_val_t)) == 0 &&
+                memcmp(iq_imx2, iq_imx, iq_len * sizeof(dsp_val_t)) == 0 &&
+                memcmp(iq_mag2, iq_mag, iq_odd * sizeof(dsp_val_t)) == 0;
+
+        dsp_ifft_iq(iq_plan, iq_buf);
+        printf("%-8s interleave, fft, magnitude: %s, inverse max error: %e\n", dsp_cpu_isa_name((dsp_isa_t)iq_isa),
+               iq_ok ? "identical" : "DIFFERENT", max_abs_error(iq_buf, iq_sig, 2 * iq_len));
+    }
+    dsp_cpu_set_isa(iq_selected);
+
+    /*single precision FFT*/
+    for(iq_i = 0; iq_i < 2 * iq_len; *(iq_f32 + iq_i) = (dsp_f32_t)*(iq_sig + iq_i), iq_i++);
+    dsp_iq_deinterleave_f32(iq_rex_f32, iq_imx_f32, iq_f32, iq_len);
+    dsp_fft_f32(iq_plan_f32, iq_rex_f32, iq_imx_f32);
+    dsp_fft_iq_f32(iq_plan_f32, iq_f32);
+    for(iq_i = 0; iq_i < iq_len && *(iq_rex_f32 + iq_i) == *(iq_f32 + 2 * iq_i) &&
+                                   *(iq_imx_f32 + iq_i) == *(iq_f32 + 2 * iq_i + 1); iq_i++);
+    printf("f32 fft:                %s\n", iq_i == iq_len ? "identical" : "DIFFERENT");
+
+    /*complex DFT against FFT*/
+    dsp_cdft_iq(iq_sig, iq_buf, iq_len);
+    dsp_iq_deinterleave(iq_rex2, iq_imx2, iq_buf, iq_len);
+    printf("cdft max error:         %e\n", fmax(max_abs_error(iq_rex2, iq_rex, iq_len), max_abs_error(iq_imx2, iq_imx, iq_len)));
+
+    /*real DFT, polar conversion*/
+    dsp_dft((dsp_val_t *)ECG_signal, iq_rex2, iq_imx2, iq_len);
+    dsp_dft_iq((dsp_val_t *)ECG_signal, iq_buf, iq_len);
+    dsp_iq_deinterleave(iq_rex, iq_imx, iq_buf, iq_len / 2);
+    iq_ok = memcmp(iq_rex, iq_rex2, (iq_len / 2) * sizeof(dsp_val_t)) == 0 &&
+            memcmp(iq_imx, iq_imx2, (iq_len / 2) * sizeof(dsp_val_t)) == 0;
+    dsp_rect2polar(iq_mag, iq_phase, iq_rex, iq_imx, iq_len / 2);
+    dsp_rect2polar_iq(iq_mag2, iq_phase2, iq_buf, iq_len / 2);
+    iq_ok = iq_ok && memcmp(iq_mag, iq_mag2, (iq_len / 2) * sizeof(dsp_val_t)) == 0 &&
+            memcmp(iq_phase, iq_phase2, (iq_len / 2) * sizeof(dsp_val_t)) == 0;
+    printf("dft, rect2polar:        %s\n", iq_ok ? "identical" : "DIFFERENT");
+
+    dsp_fft_plan_destroy(iq_plan);
+    dsp_fft_plan_destroy_f32(iq_plan_f32);
+    free(iq_sig);
+    free(iq_buf);
+    free(iq_rex);
+    free(iq_imx);
+    free(iq_rex2);
+    free(iq_imx2);
+    free(iq_mag);
+    free(iq_mag2);
+    free(iq_phase);
+    free(iq_phase2);
+    free(iq_f32);
+    free(iq_rex_f32);
+    free(iq_imx_f32);
+    printf("\n");
+#endif
+
+
+#if TEST_INSTR
+//////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Instrumentation counters of the previous tests
+ * Counters are collected only in instrumented build: make INSTR=1
+ */
+    printf("Instrumentation test\n");
+    printf("--------------------\n");
+
+#ifdef DSP_INSTR
+    dsp_size_t in_i;
+    dsp_instr_snapshot_t in_snap;
+
+    dsp_instr_snapshot(&in_snap);
+    printf("%-28s %10s %16s %14s %14s\n", "function", "calls",
+           in_snap.ticks_are_cycles ? "total cycles" : "total ns",
+           in_snap.ticks_are_cycles ? "max cycles" : "max ns", "bytes");
+    for(in_i = 0; in_i < DSP_INSTR_N_FUNCTIONS; in_i++) {
+        dsp_instr_counter_t *in_c = &in_snap.counter[in_i];
+        if(in_c->calls) {
+            printf("%-28s %10llu %16llu %14llu %14llu\n", dsp_instr_name(in_i),
+                   (unsigned long long)in_c->calls, (unsigned long long)in_c->total_ticks,
+                   (unsigned long long)in_c->max_ticks, (unsigned long long)in_c->bytes);
+        }
+    }
+
+    dsp_instr_reset();
+    dsp_instr_snapshot(&in_snap);
+    printf("calls after reset:            %llu\n", (unsigned long long)in_snap.counter[DSP_INSTR_DFT].calls);
+
+    /*FFTs of the pool workers are counted in the caller thread*/
+    dsp_size_t in_fft_len = 256, in_batch = 16;
+    dsp_exec_ctx_t *in_ctx = dsp_exec_ctx_create(4, NULL, 0);
+    dsp_fft_plan_t *in_plan = dsp_fft_plan_create(in_fft_len);
+    dsp_val_t *in_rex = (dsp_val_t *) calloc(in_batch * in_fft_len, sizeof(dsp_val_t));
+    dsp_val_t *in_imx = (dsp_val_t *) calloc(in_batch * in_fft_len, sizeof(dsp_val_t));
+    check_mem_alloc(in_ctx);
+    check_mem_alloc(in_plan);
+    check_mem_alloc(in_rex);
+    check_mem_alloc(in_imx);
+
+    dsp_fft_batch(in_plan, in_rex, in_imx, in_batch, in_ctx);
+    dsp_instr_snapshot(&in_snap);
+    printf("batch FFT calls (%d threads):  %llu of %lu\n", dsp_exec_ctx_threads(in_ctx),
+           (unsigned long long)in_snap.counter[DSP_INSTR_FFT].calls, in_batch);
+
+    dsp_exec_ctx_destroy(in_ctx);
+    dsp_fft_plan_destroy(in_plan);
+    free(in_rex);
+    free(in_imx);
+#else
+    printf("instrumentation is not compiled in, build with make INSTR=1\n");
+#endif
+    printf("\n");
+#endif
+
     return 0;
 }
 
 
 /**
- * @brief Create a dat file from array to test with GNU Plot
+ * @brief Create a binary signal file (dsp_sigfile.h) from array to test with GNU Plot
  * 
  * @param test_path test absoulute path
  * @param rel_path relative path in test directory
  * @param data_array data array
  * @param size size of data array
  */
-void create_dat_file(const char *test_path, const char *rel_path, const dsp_val_t *data_array, const dsp_size_t size)
+void create_sig_file(const char *test_path, const char *rel_path, const dsp_val_t *data_array, const dsp_size_t size)
 {
-    FILE *fd;
-    
     char *path = prepare_path(test_path, rel_path);
-    
 
     check_mem_alloc(path);
 
-    fd = fopen(path, "w+");
-
-    /*Error during opening the file*/
-    if (fd == NULL) {
+    /*Error during writing the file*/
+    if (dsp_sigfile_write(path, (dsp_val_t *)data_array, size, 1, 0.0) != 0) {
         fprintf(stderr, "An error occured in file creation: %s\n", path);
         exit(EXIT_FAILURE);
     }
-        
-    dsp_size_t i;
-    for (i = 0; i < size; fprintf(fd, "\n%f", *(data_array + i)), i++);
 
-    fprintf(stdout, "%s created. (%d elements)\n", path, size);
+    fprintf(stdout, "%s created. (%lu elements)\n", path, (unsigned long)size);
     
-    fclose(fd);
     free(path);
 }
 
@@ -483,4 +2064,55 @@ char *prepare_path(const char *test_path, const char *rel_path)
     strcpy(path + len_test_path + 1, rel_path);
     
     return path;
-}
\ No newline at end of file
+}
+
+
+/**
+ * @brief Calculate maximal absolute difference of two signals
+ * 
+ * @param sig signal array
+ * @param ref_sig reference signal array
+ * @param size size of arrays
+ * @return dsp_val_t maximal absolute error
+ */
+dsp_val_t max_abs_error(const dsp_val_t *sig, const dsp_val_t *ref_sig, const dsp_size_t size)
+{
+    dsp_size_t i;
+    dsp_val_t err = 0.0;
+
+    for(i = 0; i < size; i++) {
+        if(fabs(*(sig + i) - *(ref_sig + i)) > err) {
+            err = fabs(*(sig + i) - *(ref_sig + i));
+        }
+    }
+
+    return err;
+}
+
+
+/**
+ * @brief Compare two signal values for qsort, ascending order
+ * 
+ * @param a pointer to first value
+ * @param b pointer to second value
+ * @return int negative, zero or positive
+ */
+int compare_val(const void *a, const void *b)
+{
+    dsp_val_t va = *(const dsp_val_t *)a;
+    dsp_val_t vb = *(const dsp_val_t *)b;
+
+    return (va > vb) - (va < vb);
+}
+
+
+/**
+ * @brief Task of the execution context test, counts the runs of the task
+ * 
+ * @param arg int array of run counters
+ * @param task task index
+ */
+void exec_test_task(void *arg, dsp_size_t task)
+{
+    *((int *)arg + task) += 1;
+}
@@ -0,0 +1,457 @@
+/**
+ * @file stream.c
+ * @author Istvan Milak (istvan.milak@gmail.com)
+ * @brief Streaming processor of signal files of any size
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2020
+ *
+ * Usage: dsp_stream [-c chunk_len] [-n channel] [-o output.dsig] input.dsig op [op ...]
+ *
+ * Operations, applied in the given order:
+ *  lp:<cutoff_hz>:<len>            low-pass windowed-sinc filter (Blackman window)
+ *  hp:<cutoff_hz>:<len>            high-pass windowed-sinc filter
+ *  bp:<low_hz>:<high_hz>:<len>     band-pass windowed-sinc filter
+ *  conv:<kernel.dsig>              convolution with the kernel file (channel 0)
+ *  decim:<factor>                  keep every factor-th sample
+ *  mag:<frame_len>                 DFT magnitude of consecutive frames, frame_len / 2 bins per frame
+ *  stats                           statistic of the stream at this point
+ *
+ * The frequencies are in the unit of the sample rate of the input file (fraction of
+ * the sample rate if the file has no sample rate). Filter outputs have the input length.
+ *
+ * The input (dsp_sigfile.h) is mapped and processed in chunks by a dsp_pipeline, the filter
+ * tails, the decimation phase and the partial DFT frames are carried between the chunks, so
+ * the result is identical up to rounding for any chunk length (the FFT block of the filters
+ * follows the chunk length, the sums are grouped differently). A reader thread loads the next chunk while
+ * the current one is processed (double buffering), processed pages are dropped from the memory.
+ * Single channel float64 input is used in place, other inputs are converted into the chunk buffers.
+ * Memory use: 2 chunk buffers + pipeline buffers, independent of the input length.
+ *
+ * The output (-o) is a float64 signal file, the throughput and the statistics are reported on stderr.
+ * Exit code: 0 ok, 1 error, 2 usage.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dsp_common.h"
+#include "dsp_stat.h"
+#include "dsp_filter.h"
+#include "dsp_pipeline.h"
+#include "dsp_sigfile.h"
+
+#ifdef DSP_USE_PTHREAD
+    #include <pthread.h>
+#endif
+
+
+#define STREAM_DEFAULT_CHUNK    65536
+#define STREAM_MAX_STATS        8
+#define STREAM_PAGE_SAMPLES     512     // samples of a 4 KiB page, read ahead touches one per page
+
+
+/*
+One chunk of the double buffer
+*/
+typedef struct {
+    dsp_val_t *data;        // chunk samples: own buffer or pointer into the mapping
+    dsp_val_t *buf;         // own buffer, chunk_len long
+    dsp_size_t start;       // first sample index
+    dsp_size_t len;         // number of samples, 0: end of input
+    int full;               // filled by the reader, not yet processed
+} stream_slot_t;
+
+
+/*
+Chunk reader
+*/
+typedef struct {
+    dsp_sigfile_t *sf;
+    dsp_size_t channel;
+    dsp_size_t chunk_len;
+    dsp_val_t *view;        // zero-copy view, NULL if the input is converted
+    stream_slot_t slot[2];
+    int stop;               // processing stopped before the end of input
+#ifdef DSP_USE_PTHREAD
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+} stream_reader_t;
+
+
+static volatile dsp_val_t sink;
+
+static double now_ns(void);
+static void stream_free(stream_reader_t *rd, dsp_pipeline_t *pl, dsp_sigfile_t *sf);
+static void stream_fill(stream_reader_t *rd, stream_slot_t *slot, dsp_size_t start);
+static int stream_add_op(dsp_pipeline_t *pl, char *op, char *prev_op, dsp_val_t *sample_rate,
+                         dsp_stat_acc_t *acc, char **acc_name, dsp_size_t *n_acc);
+#ifdef DSP_USE_PTHREAD
+static void *stream_reader_thread(void *arg);
+#endif
+
+
+int main(int argc, char **argv)
+{
+    dsp_size_t chunk_len = STREAM_DEFAULT_CHUNK, channel = 0, i, n_acc = 0, total_in = 0, total_out = 0, out_len;
+    char *in_path = NULL, *out_path = NULL, *acc_name[STREAM_MAX_STATS];
+    dsp_stat_acc_t acc[STREAM_MAX_STATS];
+    dsp_sig_stats_t stats;
+    dsp_sigfile_t *sf;
+    dsp_sigfile_writer_t *wr = NULL;
+    dsp_pipeline_t *pl;
+    dsp_val_t sample_rate, *out;
+    stream_reader_t rd;
+    stream_slot_t *slot;
+    double t_start, t_sec;
+    int s, op_first = 0, rc = 0;
+
+    for(i = 1; i < (dsp_size_t)argc && op_first == 0; i++) {
+        if(strcmp(argv[i], "-c") == 0 && i + 1 < (dsp_size_t)argc) {
+            chunk_len = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-n") == 0 && i + 1 < (dsp_size_t)argc) {
+            channel = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "-o") == 0 && i + 1 < (dsp_size_t)argc) {
+            out_path = argv[++i];
+        } else if(argv[i][0] != '-' && in_path == NULL) {
+            in_path = argv[i];
+            op_first = (int)i + 1;
+        } else {
+            break;
+        }
+    }
+    if(in_path == NULL || op_first >= argc || chunk_len == 0) {
+        fprintf(stderr, "usage: %s [-c chunk_len] [-n channel] [-o output.dsig] input.dsig op [op ...]\n"
+                        "ops: lp:<cutoff_hz>:<len> hp:<cutoff_hz>:<len> bp:<low_hz>:<high_hz>:<len>\n"
+                        "     conv:<kernel.dsig> decim:<factor> mag:<frame_len> stats\n", argv[0]);
+        return 2;
+    }
+
+    sf = dsp_sigfile_open(in_path);
+    if(sf == NULL || channel >= sf->channels) {
+        fprintf(stderr, "can not open %s (or no channel %lu)\n", in_path, (unsigned long)channel);
+        dsp_sigfile_close(sf);
+        return 1;
+    }
+
+    /*operation chain*/
+    pl = dsp_pipeline_create(chunk_len);
+    if(pl == NULL) {
+        fprintf(stderr, "memory allocation error\n");
+        dsp_sigfile_close(sf);
+        return 1;
+    }
+    sample_rate = sf->sample_rate;
+    for(s = op_first; s < argc; s++) {
+        if(stream_add_op(pl, argv[s], (s > op_first) ? argv[s - 1] : "input", &sample_rate,
+                         acc, acc_name, &n_acc) != 0) {
+            fprintf(stderr, "invalid operation: %s\n", argv[s]);
+            dsp_pipeline_destroy(pl);
+            dsp_sigfile_close(sf);
+            return 2;
+        }
+    }
+
+    if(out_path != NULL) {
+        wr = dsp_sigfile_writer_open(out_path, DSP_SIGFILE_F64, 1, sample_rate);
+        if(wr == NULL) {
+            fprintf(stderr, "can not create %s\n", out_path);
+            dsp_pipeline_destroy(pl);
+            dsp_sigfile_close(sf);
+            return 1;
+        }
+    }
+
+    /*reader*/
+    memset(&rd, 0, sizeof(rd));
+    rd.sf = sf;
+    rd.channel = channel;
+    rd.chunk_len = chunk_len;
+    rd.view = (sf->channels == 1) ? dsp_sigfile_view(sf) : NULL;
+    for(s = 0; s < 2; s++) {
+        rd.slot[s].buf = (dsp_val_t *) malloc(chunk_len * sizeof(dsp_val_t));
+        if(rd.slot[s].buf == NULL) {
+            fprintf(stderr, "memory allocation error\n");
+            dsp_sigfile_writer_close(wr);
+            stream_free(&rd, pl, sf);
+            return 1;
+        }
+    }
+
+    t_start = now_ns();
+
+#ifdef DSP_USE_PTHREAD
+    pthread_mutex_init(&rd.lock, NULL);
+    pthread_cond_init(&rd.cond, NULL);
+    if(pthread_create(&rd.thread, NULL, stream_reader_thread, &rd) != 0) {
+        fprintf(stderr, "reader thread start error\n");
+        pthread_mutex_destroy(&rd.lock);
+        pthread_cond_destroy(&rd.cond);
+        dsp_sigfile_writer_close(wr);
+        stream_free(&rd, pl, sf);
+        return 1;
+    }
+#endif
+
+    for(s = 0; ; s ^= 1) {
+        slot = rd.slot + s;
+
+#ifdef DSP_USE_PTHREAD
+        pthread_mutex_lock(&rd.lock);
+        while(!slot->full) {
+            pthread_cond_wait(&rd.cond, &rd.lock);
+        }
+        pthread_mutex_unlock(&rd.lock);
+#else
+        stream_fill(&rd, slot, total_in);
+#endif
+
+        if(slot->len == 0) {
+            break;
+        }
+
+        out = dsp_pipeline_process(pl, slot->data, slot->len, &out_len);
+        if(wr != NULL && out_len > 0 && dsp_sigfile_writer_append(wr, out, out_len) != 0) {
+            fprintf(stderr, "write error\n");
+            rc = 1;
+        }
+        dsp_sigfile_release(sf, slot->start, slot->len);
+        total_in += slot->len;
+        total_out += out_len;
+
+#ifdef DSP_USE_PTHREAD
+        pthread_mutex_lock(&rd.lock);
+        slot->full = 0;
+        pthread_cond_broadcast(&rd.cond);
+        pthread_mutex_unlock(&rd.lock);
+#endif
+        if(rc != 0) {
+            break;
+        }
+    }
+
+#ifdef DSP_USE_PTHREAD
+    /*the reader stops at the end of input or at the stop flag*/
+    pthread_mutex_lock(&rd.lock);
+    rd.stop = 1;
+    pthread_cond_broadcast(&rd.cond);
+    pthread_mutex_unlock(&rd.lock);
+    pthread_join(rd.thread, NULL);
+    pthread_mutex_destroy(&rd.lock);
+    pthread_cond_destroy(&rd.cond);
+#endif
+
+    if(dsp_sigfile_writer_close(wr) != 0) {
+        fprintf(stderr, "write error\n");
+        rc = 1;
+    }
+    t_sec = (now_ns() - t_start) * 1e-9;
+
+    fprintf(stderr, "input:      %s, %lu samples, %lu channel(s), %.1f Hz\n", in_path,
+            (unsigned long)sf->len, (unsigned long)sf->channels, sf->sample_rate);
+    fprintf(stderr, "processed:  %lu samples in %lu chunks of %lu, output %lu samples\n",
+            (unsigned long)total_in, (unsigned long)((total_in + chunk_len - 1) / chunk_len),
+            (unsigned long)chunk_len, (unsigned long)total_out);
+    fprintf(stderr, "buffers:    %.1f KiB (2 chunks + pipeline), %s input\n",
+            (2.0 * chunk_len + 2.0 * pl->buf_len) * sizeof(dsp_val_t) / 1024.0,
+            (rd.view != NULL) ? "zero-copy" : "converted");
+    fprintf(stderr, "time:       %.3f s, %.3f Msamples/s, %.1f MB/s\n", t_sec,
+            (t_sec > 0.0) ? total_in / t_sec * 1e-6 : 0.0,
+            (t_sec > 0.0) ? total_in * dsp_sigfile_dtype_size(sf->dtype) * sf->channels / t_sec * 1e-6 : 0.0);
+    for(i = 0; i < n_acc; i++) {
+        dsp_stat_acc_finalize(acc + i, &stats);
+        fprintf(stderr, "stats after %-16s n: %lu mean: %g std_dev: %g min: %g max: %g\n", acc_name[i],
+                (unsigned long)(acc + i)->count, stats.mean, stats.std_dev, stats.min, stats.max);
+    }
+
+    stream_free(&rd, pl, sf);
+    return rc;
+}
+
+
+/*
+Free the chunk buffers, the pipeline and the input file
+*/
+static void stream_free(stream_reader_t *rd, dsp_pipeline_t *pl, dsp_sigfile_t *sf)
+{
+    int s;
+
+    for(s = 0; s < 2; s++) {
+        free(rd->slot[s].buf);
+    }
+    dsp_pipeline_destroy(pl);
+    dsp_sigfile_close(sf);
+}
+
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+
+/**
+ * @brief Load one chunk: pointer into the mapping with the pages touched, or converted copy
+ *
+ * @param rd reader
+ * @param slot destination slot
+ * @param start first sample
+ */
+static void stream_fill(stream_reader_t *rd, stream_slot_t *slot, dsp_size_t start)
+{
+    dsp_size_t i, len;
+    dsp_val_t sum = 0.0;
+
+    slot->start = start;
+    if(start >= rd->sf->len) {
+        slot->len = 0;
+        return;
+    }
+    len = rd->sf->len - start;
+    len = (len < rd->chunk_len) ? len : rd->chunk_len;
+
+    if(rd->view != NULL) {
+        /*page faults are taken here, not in the processing thread*/
+        slot->data = rd->view + start;
+        for(i = 0; i < len; sum += *(slot->data + i), i += STREAM_PAGE_SAMPLES);
+        sink = sum;
+    } else {
+        dsp_sigfile_read(rd->sf, slot->buf, rd->channel, start, len);
+        slot->data = slot->buf;
+    }
+    slot->len = len;
+}
+
+
+#ifdef DSP_USE_PTHREAD
+/**
+ * @brief Reader thread: fills the slots alternately until the end of input or the stop flag
+ *
+ * @param arg reader
+ * @return void* NULL
+ */
+static void *stream_reader_thread(void *arg)
+{
+    stream_reader_t *rd = (stream_reader_t *)arg;
+    stream_slot_t *slot;
+    dsp_size_t pos = 0;
+    int s;
+
+    for(s = 0; ; s ^= 1) {
+        slot = rd->slot + s;
+
+        pthread_mutex_lock(&rd->lock);
+        while(slot->full && !rd->stop) {
+            pthread_cond_wait(&rd->cond, &rd->lock);
+        }
+        if(rd->stop) {
+            pthread_mutex_unlock(&rd->lock);
+            break;
+        }
+        pthread_mutex_unlock(&rd->lock);
+
+        stream_fill(rd, slot, pos);
+        pos += slot->len;
+
+        pthread_mutex_lock(&rd->lock);
+        slot->full = 1;
+        pthread_cond_broadcast(&rd->cond);
+        pthread_mutex_unlock(&rd->lock);
+
+        if(slot->len == 0) {
+            break;
+        }
+    }
+    return NULL;
+}
+#endif
+
+
+/**
+ * @brief Parse one operation and append its stages
+ *
+ * @param pl pipeline
+ * @param op operation argument
+ * @param prev_op previous operation argument, name of the statistic
+ * @param sample_rate sample rate of the stream at this point, updated
+ * @param acc statistic accumulators
+ * @param acc_name operation of the accumulators
+ * @param n_acc number of used accumulators, updated
+ * @return int 0 on success, -1 on invalid operation or allocation error
+ */
+static int stream_add_op(dsp_pipeline_t *pl, char *op, char *prev_op, dsp_val_t *sample_rate,
+                         dsp_stat_acc_t *acc, char **acc_name, dsp_size_t *n_acc)
+{
+    double f1, f2;
+    unsigned long n;
+    char path[1024];
+    dsp_val_t fs = (*sample_rate > 0.0) ? *sample_rate : 1.0;
+    dsp_val_t *kernel;
+    dsp_sigfile_t *kf;
+    int rc;
+
+    if(sscanf(op, "lp:%lf:%lu", &f1, &n) == 2 && n > 0) {
+        kernel = (dsp_val_t *) malloc(n * sizeof(dsp_val_t));
+        if(kernel == NULL) {
+            return -1;
+        }
+        dsp_lp_win_sinc_filter(kernel, fs, f1, dsp_blackman_window, n);
+    } else if(sscanf(op, "hp:%lf:%lu", &f1, &n) == 2 && n > 0) {
+        kernel = (dsp_val_t *) malloc(n * sizeof(dsp_val_t));
+        if(kernel == NULL) {
+            return -1;
+        }
+        dsp_hp_win_sinc_filter(kernel, fs, f1, dsp_blackman_window, n);
+    } else if(sscanf(op, "bp:%lf:%lf:%lu", &f1, &f2, &n) == 3 && n > 0) {
+        kernel = (dsp_val_t *) malloc(n * sizeof(dsp_val_t));
+        if(kernel == NULL) {
+            return -1;
+        }
+        dsp_bp_win_sinc_filter(kernel, fs, f1, f2, dsp_blackman_window, n);
+    } else if(sscanf(op, "conv:%1023s", path) == 1) {
+        kf = dsp_sigfile_open(path);
+        if(kf == NULL || kf->len == 0) {
+            dsp_sigfile_close(kf);
+            return -1;
+        }
+        n = kf->len;
+        kernel = (dsp_val_t *) malloc(n * sizeof(dsp_val_t));
+        if(kernel == NULL) {
+            dsp_sigfile_close(kf);
+            return -1;
+        }
+        dsp_sigfile_read(kf, kernel, 0, 0, n);
+        dsp_sigfile_close(kf);
+    } else if(sscanf(op, "decim:%lu", &n) == 1) {
+        if(*sample_rate > 0.0 && n > 0) {
+            *sample_rate /= n;
+        }
+        return dsp_pipeline_add_decimate(pl, n);
+    } else if(sscanf(op, "mag:%lu", &n) == 1) {
+        *sample_rate = 0.0;
+        if(dsp_pipeline_add_dft(pl, n) != 0) {
+            return -1;
+        }
+        return dsp_pipeline_add_magnitude(pl, n / 2);
+    } else if(strcmp(op, "stats") == 0 && *n_acc < STREAM_MAX_STATS) {
+        dsp_stat_acc_init(acc + *n_acc, 2);
+        *(acc_name + *n_acc) = prev_op;
+        return dsp_pipeline_add_stats(pl, acc + (*n_acc)++);
+    } else {
+        return -1;
+    }
+
+    /*filters: the kernel is copied by the stage*/
+    rc = dsp_pipeline_add_fir(pl, kernel, n, DSP_FIR_PATH_AUTO);
+    free(kernel);
+    return rc;
+}